@@ -0,0 +1,398 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>  // NOLINT
+#include <stdexcept>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include "lite/api/paddle_api.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite_api {
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+void* MutableData(Tensor* tensor, PrecisionType precision) {
+  switch (precision) {
+    case PrecisionType::kFloat:
+      return tensor->mutable_data<float>();
+    case PrecisionType::kFP64:
+      return tensor->mutable_data<double>();
+    case PrecisionType::kInt64:
+      return tensor->mutable_data<int64_t>();
+    case PrecisionType::kInt32:
+      return tensor->mutable_data<int32_t>();
+    case PrecisionType::kInt16:
+      return tensor->mutable_data<int16_t>();
+    case PrecisionType::kInt8:
+      return tensor->mutable_data<int8_t>();
+    case PrecisionType::kUInt8:
+      return tensor->mutable_data<uint8_t>();
+    case PrecisionType::kBool:
+      return tensor->mutable_data<bool>();
+    default:
+      LOG(FATAL) << "Unsupported precision of batching input: "
+                 << PrecisionToStr(precision);
+  }
+  return nullptr;
+}
+
+int64_t Production(const shape_t& shape, size_t begin = 0) {
+  int64_t res = 1;
+  for (size_t i = begin; i < shape.size(); i++) {
+    res *= shape[i];
+  }
+  return res;
+}
+
+// Number of samples held by a tensor, which is the number of sequences of
+// the first LoD level for LoD tensors, or the first dimension otherwise.
+int64_t NumSamples(const HostTensor& tensor) {
+  if (!tensor.lod.empty()) {
+    return static_cast<int64_t>(tensor.lod[0].size()) - 1;
+  }
+  return tensor.shape[0];
+}
+
+// Rows of the first dimension covered by samples [begin, end) of a LoD
+// tensor, which walks down all the LoD levels.
+std::pair<uint64_t, uint64_t> LoDRowRange(const lod_t& lod,
+                                          uint64_t begin,
+                                          uint64_t end) {
+  for (auto& level : lod) {
+    begin = level[begin];
+    end = level[end];
+  }
+  return std::make_pair(begin, end);
+}
+
+}  // namespace
+
+class BatchingPredictor::Impl {
+ public:
+  Impl(const std::shared_ptr<PaddlePredictor>& predictor,
+       const BatchingOptions& options)
+      : predictor_(predictor), options_(options) {
+    CHECK(predictor_) << "The predictor of BatchingPredictor can not be null.";
+    CHECK_GT(options_.max_batch_size, 0);
+    std::sort(options_.batch_buckets.begin(), options_.batch_buckets.end());
+    num_inputs_ = predictor_->GetInputNames().size();
+    num_outputs_ = predictor_->GetOutputNames().size();
+    worker_ = std::thread(&Impl::Work, this);
+  }
+
+  ~Impl() {
+    std::deque<Request> pending;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+      pending.swap(queue_);
+    }
+    cv_.notify_all();
+    for (auto& request : pending) {
+      request.promise.set_exception(std::make_exception_ptr(
+          std::runtime_error("BatchingPredictor is destroyed.")));
+    }
+    worker_.join();
+  }
+
+  std::future<std::vector<HostTensor>> Submit(std::vector<HostTensor> inputs) {
+    Request request;
+    auto future = request.promise.get_future();
+    if (inputs.size() != num_inputs_) {
+      request.promise.set_exception(std::make_exception_ptr(
+          std::invalid_argument("The number of inputs is not matched.")));
+      return future;
+    }
+    // Inputs without a batch dimension can not be concatenated.
+    for (auto& input : inputs) {
+      if (input.shape.empty()) {
+        request.promise.set_exception(std::make_exception_ptr(
+            std::invalid_argument("The inputs of the request have no batch "
+                                  "dimension.")));
+        return future;
+      }
+    }
+    request.num_samples = NumSamples(inputs[0]);
+    for (auto& input : inputs) {
+      if (NumSamples(input) != request.num_samples ||
+          static_cast<size_t>(Production(input.shape)) *
+                  PrecisionTypeLength(input.precision) !=
+              input.data.size()) {
+        request.promise.set_exception(std::make_exception_ptr(
+            std::invalid_argument("The inputs of the request are invalid.")));
+        return future;
+      }
+    }
+    request.inputs = std::move(inputs);
+    request.submit_time = Clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stop_ || queue_.size() >= options_.max_queue_size) {
+      lock.unlock();
+      request.promise.set_exception(std::make_exception_ptr(
+          std::runtime_error("The queue of BatchingPredictor is full.")));
+      return future;
+    }
+    queue_.push_back(std::move(request));
+    lock.unlock();
+    cv_.notify_one();
+    return future;
+  }
+
+  BatchingMetrics metrics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return metrics_;
+  }
+
+ private:
+  struct Request {
+    std::vector<HostTensor> inputs;
+    int64_t num_samples{0};
+    Clock::time_point submit_time;
+    std::promise<std::vector<HostTensor>> promise;
+  };
+
+  // Requests can be batched together only if all the inputs agree on the
+  // dimensions other than the first one, and on the depth of the LoD.
+  static bool Compatible(const Request& a, const Request& b) {
+    for (size_t i = 0; i < a.inputs.size(); i++) {
+      auto& x = a.inputs[i];
+      auto& y = b.inputs[i];
+      if (x.precision != y.precision || x.lod.size() != y.lod.size() ||
+          x.shape.size() != y.shape.size()) {
+        return false;
+      }
+      if (!std::equal(
+              x.shape.begin() + 1, x.shape.end(), y.shape.begin() + 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void Work() {
+    while (true) {
+      std::vector<Request> batch;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (stop_) return;
+        batch.push_back(std::move(queue_.front()));
+        queue_.pop_front();
+        int64_t num_samples = batch[0].num_samples;
+        auto deadline = batch[0].submit_time +
+                        std::chrono::microseconds(options_.max_delay_us);
+        while (!stop_ && num_samples < options_.max_batch_size) {
+          if (queue_.empty()) {
+            if (cv_.wait_until(lock, deadline) == std::cv_status::timeout) {
+              break;
+            }
+            continue;
+          }
+          auto& next = queue_.front();
+          if (num_samples + next.num_samples > options_.max_batch_size ||
+              !Compatible(batch[0], next)) {
+            break;
+          }
+          num_samples += next.num_samples;
+          batch.push_back(std::move(next));
+          queue_.pop_front();
+        }
+      }
+      Process(&batch);
+    }
+  }
+
+  // Concatenate the i-th inputs of all the requests into the i-th input of
+  // the predictor, and pad it to `batch_size` samples.
+  void Feed(const std::vector<Request>& batch, size_t i, int64_t batch_size) {
+    auto& first = batch[0].inputs[i];
+    size_t row_bytes = Production(first.shape, 1) *
+                       PrecisionTypeLength(first.precision);
+    shape_t shape = first.shape;
+    lod_t lod(first.lod.size(), std::vector<uint64_t>{0});
+    int64_t rows = 0;
+    for (auto& request : batch) {
+      auto& input = request.inputs[i];
+      rows += input.shape[0];
+      for (size_t level = 0; level < input.lod.size(); level++) {
+        uint64_t offset = lod[level].back();
+        for (size_t k = 1; k < input.lod[level].size(); k++) {
+          lod[level].push_back(offset + input.lod[level][k]);
+        }
+      }
+    }
+    int64_t padded_rows =
+        lod.empty() ? rows + (batch_size - batch_samples_) : rows;
+    shape[0] = padded_rows;
+    auto tensor = predictor_->GetInput(i);
+    tensor->Resize(shape);
+    tensor->SetLoD(lod);
+    auto* dst = static_cast<char*>(MutableData(tensor.get(), first.precision));
+    for (auto& request : batch) {
+      auto& data = request.inputs[i].data;
+      std::memcpy(dst, data.data(), data.size());
+      dst += data.size();
+    }
+    std::memset(dst, 0, (padded_rows - rows) * row_bytes);
+  }
+
+  // Split an output of the predictor into the requests, by the first LoD
+  // level if it holds one sequence per sample, or by the first dimension if
+  // it holds one row per sample. Otherwise the output is not batch-major,
+  // and it can not be told which part belongs to which request.
+  void Fetch(const std::vector<Request>& batch,
+             size_t i,
+             int64_t batch_size,
+             std::vector<std::vector<HostTensor>>* outputs) {
+    auto tensor = predictor_->GetOutput(i);
+    auto shape = tensor->shape();
+    auto lod = tensor->lod();
+    auto precision = tensor->precision();
+    auto* src = reinterpret_cast<const char*>(tensor->data<int8_t>());
+    size_t row_bytes = Production(shape, 1) * PrecisionTypeLength(precision);
+    bool split_by_lod =
+        !shape.empty() && !lod.empty() &&
+        static_cast<int64_t>(lod[0].size()) - 1 == batch_samples_;
+    bool split_by_rows =
+        !split_by_lod && !shape.empty() && shape[0] == batch_size;
+    if (!split_by_lod && !split_by_rows) {
+      throw std::runtime_error("The output " + std::to_string(i) +
+                               " of the predictor is not batch-major.");
+    }
+    uint64_t sample = 0;
+    for (size_t r = 0; r < batch.size(); r++) {
+      HostTensor out;
+      out.precision = precision;
+      out.shape = shape;
+      uint64_t num_samples = batch[r].num_samples;
+      uint64_t begin = sample;
+      uint64_t end = sample + num_samples;
+      if (split_by_lod) {
+        auto range = LoDRowRange(lod, sample, sample + num_samples);
+        begin = range.first;
+        end = range.second;
+        out.lod.resize(lod.size());
+        uint64_t first = sample;
+        uint64_t last = sample + num_samples;
+        for (size_t level = 0; level < lod.size(); level++) {
+          for (uint64_t k = first; k <= last; k++) {
+            out.lod[level].push_back(lod[level][k] - lod[level][first]);
+          }
+          first = lod[level][first];
+          last = lod[level][last];
+        }
+      }
+      out.shape[0] = end - begin;
+      out.data.assign(src + begin * row_bytes, src + end * row_bytes);
+      (*outputs)[r].push_back(std::move(out));
+      sample += num_samples;
+    }
+  }
+
+  void Process(std::vector<Request>* batch) {
+    auto start = Clock::now();
+    batch_samples_ = 0;
+    bool has_lod = false;
+    for (auto& request : *batch) {
+      batch_samples_ += request.num_samples;
+    }
+    for (auto& input : (*batch)[0].inputs) {
+      has_lod = has_lod || !input.lod.empty();
+    }
+    int64_t batch_size = batch_samples_;
+    if (!has_lod) {
+      for (auto bucket : options_.batch_buckets) {
+        if (bucket >= batch_samples_) {
+          batch_size = bucket;
+          break;
+        }
+      }
+    }
+    std::vector<std::vector<HostTensor>> outputs(batch->size());
+    try {
+      for (size_t i = 0; i < num_inputs_; i++) {
+        Feed(*batch, i, batch_size);
+      }
+      predictor_->Run();
+      for (size_t i = 0; i < num_outputs_; i++) {
+        Fetch(*batch, i, batch_size, &outputs);
+      }
+    } catch (...) {
+      for (auto& request : *batch) {
+        request.promise.set_exception(std::current_exception());
+      }
+      return;
+    }
+    auto end = Clock::now();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      metrics_.num_requests += batch->size();
+      metrics_.num_batches++;
+      metrics_.num_samples += batch_samples_;
+      metrics_.num_padded_samples += batch_size - batch_samples_;
+      for (auto& request : *batch) {
+        metrics_.queue_time_us +=
+            std::chrono::duration<double, std::micro>(start -
+                                                      request.submit_time)
+                .count();
+      }
+      metrics_.compute_time_us +=
+          std::chrono::duration<double, std::micro>(end - start).count();
+    }
+    for (size_t r = 0; r < batch->size(); r++) {
+      (*batch)[r].promise.set_value(std::move(outputs[r]));
+    }
+  }
+
+  std::shared_ptr<PaddlePredictor> predictor_;
+  BatchingOptions options_;
+  size_t num_inputs_{0};
+  size_t num_outputs_{0};
+  // Number of samples of the running batch before padding.
+  int64_t batch_samples_{0};
+  bool stop_{false};
+  std::deque<Request> queue_;
+  BatchingMetrics metrics_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread worker_;
+};
+
+BatchingPredictor::BatchingPredictor(
+    const std::shared_ptr<PaddlePredictor>& predictor,
+    const BatchingOptions& options)
+    : impl_(new Impl(predictor, options)) {}
+
+BatchingPredictor::~BatchingPredictor() = default;
+
+std::future<std::vector<HostTensor>> BatchingPredictor::Predict(
+    std::vector<HostTensor> inputs) {
+  return impl_->Submit(std::move(inputs));
+}
+
+BatchingMetrics BatchingPredictor::metrics() const { return impl_->metrics(); }
+
+}  // namespace lite_api
+}  // namespace paddle
@@ -15,6 +15,10 @@
 #include "lite/api/cxx_api.h"
 
 #include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <cstring>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -22,15 +26,141 @@
 #include <vector>
 
 #include "lite/api/paddle_use_passes.h"
+#include "lite/core/device_info.h"
+#include "lite/core/version.h"
 #include "lite/utils/io.h"
 
 namespace paddle {
 namespace lite {
 
+namespace {
+
+// A 64-bit content hash for the cache key, it only has to tell models
+// apart and reads 8 bytes a step to keep up with the disk.
+class ContentHasher {
+ public:
+  void Update(const char *data, size_t size) {
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+      uint64_t word;
+      std::memcpy(&word, data + i, sizeof(word));
+      Mix(word);
+    }
+    for (; i < size; ++i) {
+      Mix(static_cast<unsigned char>(data[i]));
+    }
+    Mix(size);
+  }
+
+  void Update(const std::string &s) { Update(s.data(), s.size()); }
+
+  bool UpdateFile(const std::string &path) {
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (!fp) return false;
+    std::vector<char> chunk(1 << 20);
+    size_t size = 0;
+    while ((size = fread(chunk.data(), 1, chunk.size(), fp)) > 0) {
+      Update(chunk.data(), size);
+    }
+    fclose(fp);
+    return true;
+  }
+
+  std::string HexDigest() const {
+    char digest[17];
+    snprintf(digest,
+             sizeof(digest),
+             "%016llx",
+             static_cast<unsigned long long>(hash_));  // NOLINT
+    return digest;
+  }
+
+ private:
+  void Mix(uint64_t word) {
+    hash_ = (hash_ ^ word) * 0x100000001b3ULL;
+    hash_ ^= hash_ >> 29;
+  }
+
+  uint64_t hash_{0xcbf29ce484222325ULL};
+};
+
+std::string CpuFeatures() {
+  std::string features;
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+  if (__builtin_cpu_supports("avx")) features += "avx,";
+  if (__builtin_cpu_supports("avx2")) features += "avx2,";
+  if (__builtin_cpu_supports("fma")) features += "fma,";
+  if (__builtin_cpu_supports("avx512f")) features += "avx512f,";
+#endif
+#ifdef LITE_WITH_ARM
+  auto &device = DeviceInfo::Global();
+  features += "arch" + std::to_string(static_cast<int>(device.arch())) + ",";
+  if (device.has_dot()) features += "dot,";
+  if (device.has_fp16()) features += "fp16,";
+#endif
+  return features;
+}
+
+}  // namespace
+
 std::vector<std::string> GetAllOps() {
   return OpLiteFactory::Global().GetAllOps();
 }
 
+std::string OptimizedModelCachePath(const lite_api::CxxConfig &config,
+                                    const std::vector<Place> &valid_places,
+                                    const std::vector<std::string> &passes,
+                                    const std::string &cpu_features) {
+  ContentHasher hasher;
+  for (auto &place : valid_places) {
+    // Device programs may hold compiled subgraphs, which are not saved.
+    if (place.target != TARGET(kHost) && place.target != TARGET(kX86) &&
+        place.target != TARGET(kARM) && place.target != TARGET(kAny)) {
+      LOG(WARNING) << "The optimized program for " << place.DebugString()
+                   << " is not cached.";
+      return "";
+    }
+    hasher.Update(place.DebugString());
+  }
+  for (auto &pass : passes) {
+    hasher.Update(pass);
+  }
+  hasher.Update(std::to_string(config.quant_model()) + "/" +
+                std::to_string(static_cast<int>(config.quant_type())) + "/" +
+                std::to_string(config.sparse_model()) + "/" +
+                std::to_string(config.sparse_threshold()));
+  hasher.Update(cpu_features);
+  hasher.Update(version());
+
+  if (config.is_model_from_memory()) {
+    hasher.Update(config.get_model_buffer().get_program());
+    hasher.Update(config.get_model_buffer().get_params());
+  } else if (!config.model_file().empty()) {
+    if (!hasher.UpdateFile(config.model_file()) ||
+        !hasher.UpdateFile(config.param_file())) {
+      return "";
+    }
+  } else {
+    // Uncombined model, hash every file of the model dir.
+    std::vector<std::string> files;
+    DIR *dir = opendir(config.model_dir().c_str());
+    if (!dir) return "";
+    while (dirent *entry = readdir(dir)) {
+      std::string name(entry->d_name);
+      if (name[0] == '.') continue;
+      files.push_back(name);
+    }
+    closedir(dir);
+    std::sort(files.begin(), files.end());
+    for (auto &name : files) {
+      hasher.Update(name);
+      hasher.UpdateFile(config.model_dir() + "/" + name);
+    }
+  }
+  return config.optimized_model_cache_dir() + "/" + hasher.HexDigest();
+}
+
 bool IsQuantizedMode(const std::shared_ptr<cpp::ProgramDesc> &program_desc) {
   const std::vector<std::string> quant_dequant_op = {
       "fake_quantize_abs_max",
@@ -68,6 +198,29 @@ bool IsQuantizedMode(const std::shared_ptr<cpp::ProgramDesc> &program_desc) {
   return is_quantized_model;
 }
 
+// The places kernels are picked from: the given ones, host kernels of the
+// same precisions and ARM int8 kernels for quantized models.
+std::vector<Place> ExpandValidPlaces(
+    const std::vector<Place> &valid_places,
+    const std::shared_ptr<cpp::ProgramDesc> &program_desc) {
+  std::vector<Place> inner_places = valid_places;
+  for (auto &valid_place : valid_places) {
+    if (valid_place.target == TARGET(kOpenCL)) continue;
+    inner_places.emplace_back(
+        Place(TARGET(kHost), valid_place.precision, valid_place.layout));
+  }
+
+  if (IsQuantizedMode(program_desc)) {
+    for (auto &valid_place : valid_places) {
+      if (valid_place.target == TARGET(kARM)) {
+        inner_places.insert(inner_places.begin(),
+                            Place{TARGET(kARM), PRECISION(kInt8)});
+      }
+    }
+  }
+  return inner_places;
+}
+
 void Predictor::SaveModel(const std::string &dir,
                           lite_api::LiteModelType model_type,
                           bool record_info) {
@@ -174,10 +327,7 @@ lite::Tensor *Predictor::GetInput(size_t offset) {
   CHECK(input_names_.size() > offset)
       << "The network has " << input_names_.size() << " inputs"
       << ", the offset should be less than this.";
-  auto *in_var = exec_scope_->FindVar(input_names_[offset]);
-  CHECK(in_var) << "no fatch variable " << input_names_[offset]
-                << " in exec_scope";
-  return in_var->GetMutable<lite::Tensor>();
+  return input_tensors_[offset];
 }
 #else
 lite::Tensor *Predictor::GetInput(size_t offset) {
@@ -236,6 +386,20 @@ void Predictor::PrepareFeedFetch() {
     output_names_[fetchs[i]->GetAttr<int>("col")] =
         fetchs[i]->Input("X").front();
   }
+#if !defined(LITE_WITH_FPGA) && !defined(LITE_WITH_METAL)
+  input_tensors_.clear();
+  output_tensors_.clear();
+  for (auto &name : input_names_) {
+    auto *in_var = exec_scope_->FindVar(name);
+    CHECK(in_var) << "no feed variable " << name << " in exec_scope";
+    input_tensors_.push_back(in_var->GetMutable<lite::Tensor>());
+  }
+  for (auto &name : output_names_) {
+    auto *out_var = exec_scope_->FindVar(name);
+    CHECK(out_var) << "no fetch variable " << name << " in exec_scope";
+    output_tensors_.push_back(out_var->GetMutable<lite::Tensor>());
+  }
+#endif
   for (size_t i = 0; i < feeds.size(); i++) {
     input_precisions_[i] = GetInput(i)->precision();
   }
@@ -246,20 +410,11 @@ const lite::Tensor *Predictor::GetOutput(size_t offset) const {
   CHECK(output_names_.size() > offset)
       << "The network has " << output_names_.size() << " outputs"
       << ", the offset should be less than this.";
-  const std::string name = output_names_.at(offset);
-  auto *out_var = exec_scope_->FindVar(name);
-  CHECK(out_var) << "no fatch variable " << name << " in exec_scope";
-  return out_var->GetMutable<lite::Tensor>();
+  return output_tensors_[offset];
 }
 
 std::vector<const lite::Tensor *> Predictor::GetOutputs() const {
-  std::vector<const lite::Tensor *> outputs;
-  size_t out_size = output_names_.size();
-  for (size_t i = 0; i < out_size; i++) {
-    const std::string name = output_names_.at(i);
-    outputs.push_back(GetTensor(name));
-  }
-  return outputs;
+  return output_tensors_;
 }
 #else
 const lite::Tensor *Predictor::GetOutput(size_t offset) const {
@@ -293,6 +448,31 @@ void Predictor::Build(const lite_api::CxxConfig &config,
                       const std::vector<Place> &valid_places,
                       const std::vector<std::string> &passes,
                       lite_api::LiteModelType model_type) {
+  std::string cache_path;
+  if (!config.optimized_model_cache_dir().empty()) {
+    cache_path =
+        OptimizedModelCachePath(config, valid_places, passes, CpuFeatures());
+    if (!cache_path.empty() && IsFileExists(cache_path + ".nb")) {
+      LOG(INFO) << "Load the optimized program from " << cache_path << ".nb";
+      // The places and op versions come from the model, whose topology is
+      // all that is read of it.
+      std::shared_ptr<cpp::ProgramDesc> model_desc;
+      if (model_type == lite_api::LiteModelType::kProtobuf) {
+        model_desc = std::make_shared<cpp::ProgramDesc>();
+        bool combined_param =
+            config.is_model_from_memory() ||
+            (!config.model_file().empty() && !config.param_file().empty());
+        LoadProgramPb(config.model_dir(),
+                      config.model_file(),
+                      model_desc.get(),
+                      combined_param,
+                      config.get_model_buffer());
+      }
+      BuildFromOptimizedModel(cache_path + ".nb", valid_places, model_desc);
+      return;
+    }
+  }
+
   if (config.is_model_from_memory()) {
     LOG(INFO) << "Load model from memory.";
     Build(config.model_dir(),
@@ -311,6 +491,45 @@ void Predictor::Build(const lite_api::CxxConfig &config,
           passes,
           model_type);
   }
+
+  if (!cache_path.empty()) {
+    // Write to a private file and rename it, so concurrent builds never
+    // load a partial one.
+    MkDirRecur(config.optimized_model_cache_dir());
+    auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    std::string tmp_path = cache_path + ".tmp" + std::to_string(stamp);
+    SaveModel(tmp_path, lite_api::LiteModelType::kNaiveBuffer);
+    if (std::rename((tmp_path + ".nb").c_str(),
+                    (cache_path + ".nb").c_str()) != 0) {
+      LOG(WARNING) << "Failed to cache the optimized program to "
+                   << cache_path << ".nb";
+      std::remove((tmp_path + ".nb").c_str());
+    } else {
+      LOG(INFO) << "Cached the optimized program to " << cache_path << ".nb";
+    }
+  }
+}
+
+void Predictor::BuildFromOptimizedModel(
+    const std::string &model_file,
+    const std::vector<Place> &valid_places,
+    std::shared_ptr<cpp::ProgramDesc> model_desc) {
+  LoadModelNaiveFromFile(model_file, scope_.get(), program_desc_.get());
+  if (!model_desc) {
+    model_desc = program_desc_;
+  }
+  // The kernels were picked already, RuntimeProgram creates them from
+  // kKernelTypeAttr.
+  valid_places_ = ExpandValidPlaces(valid_places, model_desc);
+  Program program(program_desc_, scope_, valid_places_);
+  exec_scope_ = program.exec_scope();
+  program_.reset(new RuntimeProgram(program_desc_, exec_scope_, kRootBlockIdx));
+  if (model_desc->HasVersion()) {
+    program_->set_version(model_desc->Version());
+  }
+  program_generated_ = true;
+  PrepareFeedFetch();
+  CheckPaddleOpVersions(model_desc);
 }
 void Predictor::Build(const std::string &model_path,
                       const std::string &model_file,
@@ -350,21 +569,8 @@ void Predictor::Build(const std::shared_ptr<cpp::ProgramDesc> &program_desc,
                       const std::vector<std::string> &passes) {
   program_desc_ = program_desc;
   // `inner_places` is used to optimize passes
-  std::vector<Place> inner_places = valid_places;
-  for (auto &valid_place : valid_places) {
-    if (valid_place.target == TARGET(kOpenCL)) continue;
-    inner_places.emplace_back(
-        Place(TARGET(kHost), valid_place.precision, valid_place.layout));
-  }
-
-  if (IsQuantizedMode(program_desc_)) {
-    for (auto &valid_place : valid_places) {
-      if (valid_place.target == TARGET(kARM)) {
-        inner_places.insert(inner_places.begin(),
-                            Place{TARGET(kARM), PRECISION(kInt8)});
-      }
-    }
-  }
+  std::vector<Place> inner_places =
+      ExpandValidPlaces(valid_places, program_desc_);
 
   Program program(program_desc_, scope_, inner_places);
   valid_places_ = inner_places;
@@ -504,6 +710,137 @@ bool Predictor::TryShrinkMemory() {
   return true;
 }
 
+void Predictor::PlanMemory() {
+  if (program_->block_size() != 1) {
+    VLOG(3) << "Memory planning skipped, the program has sub-blocks.";
+    return;
+  }
+  // Same as MemoryOptimizePass, the variables of these ops are left alone.
+  const std::set<std::string> invalid_op_types = {"feed",
+                                                  "fetch",
+                                                  "subgraph",
+                                                  "lod_reset",
+                                                  "merge_lod_tensor",
+                                                  "merge_lod_tensor_infer"};
+  std::set<std::string> invalid_var_names;
+  // The first and the last instruction every variable is used by.
+  std::map<std::string, std::pair<int, int>> lifecycles;
+  const auto &insts = program_->instructions(kRootBlockIdx);
+  for (int i = 0; i < static_cast<int>(insts.size()); ++i) {
+    const auto *op_info = insts[i].op()->op_info();
+    auto var_names = op_info->input_names();
+    auto output_names = op_info->output_names();
+    var_names.insert(
+        var_names.end(), output_names.begin(), output_names.end());
+    if (invalid_op_types.count(op_info->Type())) {
+      invalid_var_names.insert(var_names.begin(), var_names.end());
+      continue;
+    }
+    for (auto &var_name : var_names) {
+      auto it = lifecycles.find(var_name);
+      if (it == lifecycles.end()) {
+        lifecycles.emplace(var_name, std::make_pair(i, i));
+      } else {
+        it->second.second = i;
+      }
+    }
+  }
+
+  struct Block {
+    Tensor *tensor;
+    int begin;
+    int end;
+    size_t size;
+    size_t offset;
+  };
+  std::map<TargetType, std::vector<Block>> blocks;
+  for (auto &item : lifecycles) {
+    if (invalid_var_names.count(item.first)) continue;
+    auto *var = exec_scope_->FindLocalVar(item.first);
+    if (!var || !var->IsType<lite::Tensor>()) continue;
+    auto *tensor = var->GetMutable<lite::Tensor>();
+    auto target = tensor->target();
+    if (tensor->persistable() || !tensor->own_data() ||
+        tensor->memory_size() == 0 ||
+        (target != TARGET(kHost) && target != TARGET(kX86) &&
+         target != TARGET(kARM))) {
+      continue;
+    }
+    blocks[target].push_back({tensor,
+                              item.second.first,
+                              item.second.second,
+                              tensor->memory_size(),
+                              0});
+  }
+  // Tensors sharing memory, e.g. the in-place outputs of reshape or the views
+  // of split, are not planned: they may outlive the lifecycle of their name.
+  std::vector<std::pair<const char *, const char *>> ranges;
+  for (auto &var_name : exec_scope_->LocalVarNames()) {
+    auto *var = exec_scope_->FindLocalVar(var_name);
+    if (!var->IsType<lite::Tensor>()) continue;
+    const auto &tensor = var->Get<lite::Tensor>();
+    if (tensor.memory_size() == 0 || !tensor.raw_data()) continue;
+    const char *begin = static_cast<const char *>(tensor.raw_data());
+    ranges.emplace_back(begin, begin + tensor.memory_size());
+  }
+  auto is_shared = [&ranges](const Tensor *tensor) {
+    const char *begin = static_cast<const char *>(tensor->raw_data());
+    const char *end = begin + tensor->memory_size();
+    int overlaps = 0;
+    for (auto &range : ranges) {
+      if (range.first < end && begin < range.second) ++overlaps;
+    }
+    return overlaps > 1;
+  };
+
+  const size_t kAlignment = 64;
+  for (auto &item : blocks) {
+    std::vector<Block> planned;
+    for (auto &block : item.second) {
+      if (!is_shared(block.tensor)) planned.push_back(block);
+    }
+    if (planned.size() < 2) continue;
+    // Greedy by size: every block takes the lowest offset clear of the
+    // larger blocks whose lifecycles overlap its own.
+    std::stable_sort(planned.begin(),
+                     planned.end(),
+                     [](const Block &a, const Block &b) {
+                       return a.size > b.size;
+                     });
+    size_t arena_size = 0;
+    size_t total_size = 0;
+    for (size_t i = 0; i < planned.size(); ++i) {
+      auto &block = planned[i];
+      std::vector<std::pair<size_t, size_t>> taken;
+      for (size_t j = 0; j < i; ++j) {
+        if (planned[j].begin <= block.end && block.begin <= planned[j].end) {
+          taken.emplace_back(planned[j].offset,
+                             planned[j].offset + planned[j].size);
+        }
+      }
+      std::sort(taken.begin(), taken.end());
+      size_t offset = 0;
+      for (auto &range : taken) {
+        if (offset + block.size <= range.first) break;
+        offset = (std::max)(
+            offset, (range.second + kAlignment - 1) / kAlignment * kAlignment);
+      }
+      block.offset = offset;
+      arena_size = (std::max)(arena_size, offset + block.size);
+      total_size += block.size;
+    }
+    Tensor arena;
+    arena.Resize({static_cast<int64_t>(arena_size)});
+    arena.mutable_data(item.first, arena_size);
+    for (auto &block : planned) {
+      block.tensor->ShareDataWith(arena, block.offset, block.size);
+    }
+    VLOG(3) << "Planned " << planned.size() << " tensors of "
+            << TargetToStr(item.first) << " into " << arena_size
+            << " bytes instead of " << total_size << ".";
+  }
+}
+
 void Predictor::CheckInputValid() {
   for (size_t idx = 0; idx < input_precisions_.size(); ++idx) {
     if (GetInput(idx)->precision() != input_precisions_[idx]) {
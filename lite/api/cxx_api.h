@@ -38,6 +38,15 @@ static const char TAILORD_KERNELS_LIST_NAME[] = ".tailored_kernels_list";
 
 std::vector<std::string> GetAllOps();
 
+// Returns the path of the cached optimized program of |config| without the
+// ".nb" suffix, or an empty string when the program can not be cached. The
+// key covers the model, places, passes and options, the library version and
+// |cpu_features|.
+std::string OptimizedModelCachePath(const lite_api::CxxConfig& config,
+                                    const std::vector<Place>& valid_places,
+                                    const std::vector<std::string>& passes,
+                                    const std::string& cpu_features);
+
 /*
  * Predictor for inference, input a model, it will optimize and execute it.
  */
@@ -185,6 +194,13 @@ class LITE_API Predictor {
   /// \return a boolean variable.
   bool TryShrinkMemory();
 
+  // Packs the non-persistable host tensors of the root block into one arena
+  // per target, by the sizes they took in the last run and the instructions
+  // they live between, so tensors of disjoint lifecycles share memory. For
+  // programs whose later inputs are at most as large as the last ones, a
+  // tensor which outgrows its window moves to memory of its own.
+  void PlanMemory();
+
   // Get offset-th col of feed inputs.
   lite::Tensor* GetInput(size_t offset);
   // get input by name.
@@ -239,6 +255,14 @@ class LITE_API Predictor {
   // would be called in Run().
   void CheckInputValid();
 
+  // Build the runtime program from an optimized naive buffer model, without
+  // running the optimizer. |model_desc| is the topology of the source model,
+  // which gives the places and op versions as in Build; the optimized program
+  // stands in for it when null.
+  void BuildFromOptimizedModel(const std::string& model_file,
+                               const std::vector<Place>& valid_places,
+                               std::shared_ptr<cpp::ProgramDesc> model_desc);
+
  private:
   std::shared_ptr<cpp::ProgramDesc> program_desc_;
   std::shared_ptr<Scope> scope_;
@@ -247,6 +271,10 @@ class LITE_API Predictor {
   bool program_generated_{false};
   std::vector<std::string> input_names_;
   std::vector<std::string> output_names_;
+  // Resolved once in PrepareFeedFetch, feeding and fetching by offset or by
+  // name does no scope lookup.
+  std::vector<lite::Tensor*> input_tensors_;
+  std::vector<const lite::Tensor*> output_tensors_;
   std::vector<Place> valid_places_;
   std::vector<PrecisionType> input_precisions_;
 };
@@ -255,10 +283,11 @@ class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
  public:
   CxxPaddleApiImpl() {
     raw_predictor_ = std::make_shared<Predictor>();
+    active_predictor_ = raw_predictor_;
     status_is_cloned_ = false;
   }
   explicit CxxPaddleApiImpl(const std::shared_ptr<Predictor>& raw_predictor)
-      : raw_predictor_(raw_predictor) {
+      : raw_predictor_(raw_predictor), active_predictor_(raw_predictor) {
     status_is_cloned_ = true;
   }
   virtual ~CxxPaddleApiImpl();
@@ -307,8 +336,22 @@ class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
       lite_api::LiteModelType model_type = lite_api::LiteModelType::kProtobuf,
       bool record_info = false) override;
 
+ private:
+  // Create a runtime program for every shape bucket, warm it up at the
+  // shapes of the bucket and plan its memory by them.
+  void PrepareShapeBuckets(
+      const std::vector<std::vector<lite_api::shape_t>>& buckets);
+  // Share the inputs with the predictor of the smallest shape bucket which
+  // holds them, return raw_predictor_ if none does.
+  std::shared_ptr<Predictor> RouteToShapeBucket();
+
  private:
   std::shared_ptr<Predictor> raw_predictor_;
+  // The predictor which served the last run, outputs are read from it.
+  std::shared_ptr<Predictor> active_predictor_;
+  std::vector<std::pair<std::vector<lite_api::shape_t>,
+                        std::shared_ptr<Predictor>>>
+      shape_buckets_;
   lite_api::CxxConfig config_;
   std::mutex mutex_;
   bool status_is_cloned_;
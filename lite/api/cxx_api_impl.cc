@@ -13,14 +13,18 @@
 // limitations under the License.
 
 #include "lite/api/cxx_api.h"
+#include <cstring>
+#include <functional>
 #include <memory>
 #include <mutex>  //NOLINT
+#include <numeric>
 #include <string>
 #include "lite/api/paddle_api.h"
 #include "lite/core/device_info.h"
 #include "lite/core/optimizer/mir/pass_manager.h"
 #include "lite/core/optimizer/mir/post_quant_dynamic_pass.h"
 #include "lite/core/optimizer/mir/sparse_conv_detect_pass.h"
+#include "lite/core/profile/memory_profiler.h"
 #include "lite/core/version.h"
 #ifdef LITE_USE_THREAD_POOL
 #include "lite/core/parallel_defines.h"
@@ -30,6 +34,9 @@
 #include "lite/api/paddle_use_passes.h"
 #endif
 
+#if (defined LITE_WITH_X86) && !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+#include "lite/backends/x86/parallel.h"
+#endif
 #if (defined LITE_WITH_X86) && (defined PADDLE_WITH_MKLML) && \
     !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
 #if !defined(__APPLE__)
@@ -44,11 +51,23 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
   config_ = config;
   mode_ = config.power_mode();
   threads_ = config.threads();
+  if (config.trace_profile()) {
+    lite_api::EnableTraceProfile(true,
+                                 config.trace_profile_events_per_thread());
+  }
 #ifdef LITE_USE_THREAD_POOL
   int thread_num = ThreadPool::Init(threads_);
   if (thread_num > 1) {
     ThreadPool::AcquireThreadPool();
   }
+#endif
+#if (defined LITE_WITH_X86) && !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+  // Bind before loading, so that the weights are first touched, and placed,
+  // on the NUMA node of the cpus that will compute with them. The caller gets
+  // its own affinity back when Init returns.
+  x86::ThreadAffinityGuard caller_affinity;
+  x86::BindThreads(config.x86_math_bind_policy(),
+                   config.x86_math_num_threads());
 #endif
   if (!status_is_cloned_) {
     auto places = config.valid_places();
@@ -112,7 +131,10 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
       VLOG(1) << "add pass:" << passes[0];
     }
 
-    if (config.quant_model()) {
+    if (config.quant_model() &&
+        config.quant_type() == lite_api::QuantType::QUANT_BF16) {
+      passes.push_back("x86_bf16_weight_pass");
+    } else if (config.quant_model()) {
       passes.push_back("post_quant_dynamic_pass");
       auto *pass = mir::PassManager::Global().LookUp<mir::PostQuantDynamicPass>(
           "post_quant_dynamic_pass");
@@ -132,11 +154,17 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
       sparse_detect_pass->SetSparseThreshold(1.5);
     }
 
-    raw_predictor_->Build(config, places, passes);
+    {
+      // Everything allocated while loading and optimizing the model holds
+      // weights.
+      profile::MemoryTagScope memory_tag(profile::MemoryTag::kWeight);
+      raw_predictor_->Build(config, places, passes);
+    }
   } else {
     raw_predictor_->PrepareFeedFetch();
     CHECK(raw_predictor_) << "The Predictor can not be nullptr in Clone mode.";
   }
+  active_predictor_ = raw_predictor_;
 
 #ifdef LITE_WITH_NPU
   // Store the model-level configuration into scope for kernels, and use
@@ -184,6 +212,10 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
           << real_num_threads;
 #endif
 
+  if (!config.shape_buckets().empty()) {
+    PrepareShapeBuckets(config.shape_buckets());
+  }
+
 #ifdef LITE_WITH_XPU
   auto preferred_inputs = config.preferred_inputs_for_warmup();
   for (auto &preferred_input : preferred_inputs) {
@@ -245,7 +277,7 @@ std::unique_ptr<lite_api::Tensor> CxxPaddleApiImpl::GetInput(int i) {
 
 std::unique_ptr<const lite_api::Tensor> CxxPaddleApiImpl::GetOutput(
     int i) const {
-  const auto *x = raw_predictor_->GetOutput(i);
+  const auto *x = active_predictor_->GetOutput(i);
   return std::unique_ptr<lite_api::Tensor>(new lite_api::Tensor(x));
 }
 
@@ -265,7 +297,78 @@ void CxxPaddleApiImpl::Run() {
 #ifdef LITE_WITH_ARM
   lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
 #endif
-  raw_predictor_->Run();
+#if (defined LITE_WITH_X86) && !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+  x86::BindRunningThread(config_.x86_math_bind_policy(),
+                         config_.x86_math_num_threads());
+#endif
+  active_predictor_ =
+      shape_buckets_.empty() ? raw_predictor_ : RouteToShapeBucket();
+  active_predictor_->Run();
+}
+
+void CxxPaddleApiImpl::PrepareShapeBuckets(
+    const std::vector<std::vector<lite_api::shape_t>> &buckets) {
+  auto precisions = raw_predictor_->GetInputPrecisions();
+  for (auto &bucket : buckets) {
+    CHECK_EQ(bucket.size(), precisions.size())
+        << "Every shape bucket should hold the shapes of all the inputs.";
+    auto predictor = raw_predictor_->Clone();
+    predictor->PrepareFeedFetch();
+    for (size_t i = 0; i < bucket.size(); i++) {
+      auto precision = precisions[i] == PRECISION(kUnk) ? PRECISION(kFloat)
+                                                         : precisions[i];
+      auto *input = predictor->GetInput(i);
+      input->Resize(bucket[i]);
+      input->set_precision(precision);
+      size_t size = input->numel() * lite_api::PrecisionTypeLength(precision);
+      memset(input->mutable_data(TARGET(kHost), size), 0, size);
+    }
+    // The warm-up run infers the shapes of every tensor for the bucket and
+    // prepares the kernels for them, the memory is then planned by the
+    // tensor sizes at those shapes.
+    predictor->Run();
+    predictor->PlanMemory();
+    shape_buckets_.emplace_back(bucket, predictor);
+  }
+}
+
+std::shared_ptr<Predictor> CxxPaddleApiImpl::RouteToShapeBucket() {
+  auto holds = [this](const std::vector<lite_api::shape_t> &bucket) {
+    for (size_t i = 0; i < bucket.size(); i++) {
+      auto dims = raw_predictor_->GetInput(i)->dims();
+      if (dims.size() != bucket[i].size()) return false;
+      for (size_t j = 0; j < dims.size(); j++) {
+        if (dims[j] > bucket[i][j]) return false;
+      }
+    }
+    return true;
+  };
+  auto volume = [](const std::vector<lite_api::shape_t> &bucket) {
+    int64_t res = 0;
+    for (auto &shape : bucket) {
+      res += std::accumulate(
+          shape.begin(), shape.end(), int64_t(1), std::multiplies<int64_t>());
+    }
+    return res;
+  };
+  std::shared_ptr<Predictor> predictor = raw_predictor_;
+  int64_t best_volume = -1;
+  for (auto &bucket : shape_buckets_) {
+    int64_t bucket_volume = volume(bucket.first);
+    if (holds(bucket.first) &&
+        (best_volume < 0 || bucket_volume < best_volume)) {
+      predictor = bucket.second;
+      best_volume = bucket_volume;
+    }
+  }
+  if (predictor != raw_predictor_) {
+    for (size_t i = 0; i < shape_buckets_[0].first.size(); i++) {
+      predictor->GetInput(i)->ShareDataWith(*raw_predictor_->GetInput(i));
+    }
+  } else {
+    VLOG(3) << "No shape bucket holds the inputs, run the default program.";
+  }
+  return predictor;
 }
 
 std::shared_ptr<lite_api::PaddlePredictor> CxxPaddleApiImpl::Clone() {
@@ -289,7 +392,7 @@ std::string CxxPaddleApiImpl::GetVersion() const { return version(); }
 
 std::unique_ptr<const lite_api::Tensor> CxxPaddleApiImpl::GetTensor(
     const std::string &name) const {
-  auto *x = raw_predictor_->GetTensor(name);
+  auto *x = active_predictor_->GetTensor(name);
   return std::unique_ptr<const lite_api::Tensor>(new lite_api::Tensor(x));
 }
 
@@ -312,6 +415,9 @@ void CxxPaddleApiImpl::SaveOptimizedModel(const std::string &model_dir,
 }
 
 bool CxxPaddleApiImpl::TryShrinkMemory() {
+  for (auto &bucket : shape_buckets_) {
+    bucket.second->TryShrinkMemory();
+  }
   return raw_predictor_->TryShrinkMemory();
 }
 
@@ -82,10 +82,7 @@ Tensor* LightPredictor::GetInput(size_t offset) {
   CHECK(input_names_.size() > offset)
       << "The network has " << input_names_.size() << " inputs"
       << ", the offset should be less than this.";
-  auto* in_var = program_->exec_scope()->FindVar(input_names_[offset]);
-  CHECK(in_var) << "no fatch variable " << input_names_[offset]
-                << " in exec_scope";
-  return in_var->GetMutable<lite::Tensor>();
+  return input_tensors_[offset];
 }
 #else
 Tensor* LightPredictor::GetInput(size_t offset) {
@@ -120,10 +117,7 @@ const Tensor* LightPredictor::GetOutput(size_t offset) {
   CHECK(output_names_.size() > offset)
       << "The network has " << output_names_.size() << " outputs"
       << ", the offset should be less than this.";
-  auto* out_var = program_->exec_scope()->FindVar(output_names_.at(offset));
-  CHECK(out_var) << "no fatch variable " << output_names_.at(offset)
-                 << " in exec_scope";
-  return out_var->GetMutable<lite::Tensor>();
+  return output_tensors_[offset];
 }
 #else
 const lite::Tensor* LightPredictor::GetOutput(size_t offset) {
@@ -173,6 +167,22 @@ void LightPredictor::PrepareFeedFetch() {
     output_names_[fetchs[i]->GetAttr<int>("col")] =
         fetchs[i]->Input("X").front();
   }
+  input_tensors_.clear();
+  output_tensors_.clear();
+#if !defined(LITE_WITH_FPGA) && !defined(LITE_WITH_METAL)
+  for (auto& name : input_names_) {
+    auto* in_var = program_->exec_scope()->FindVar(name);
+    CHECK(in_var) << "no feed variable " << name << " in exec_scope";
+    input_tensors_.push_back(in_var->GetMutable<lite::Tensor>());
+  }
+#endif
+#if !defined(LITE_WITH_METAL)
+  for (auto& name : output_names_) {
+    auto* out_var = program_->exec_scope()->FindVar(name);
+    CHECK(out_var) << "no fetch variable " << name << " in exec_scope";
+    output_tensors_.push_back(out_var->GetMutable<lite::Tensor>());
+  }
+#endif
   for (size_t i = 0; i < feeds.size(); i++) {
     input_precisions_[i] = GetInput(i)->precision();
   }
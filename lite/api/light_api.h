@@ -136,6 +136,9 @@ class LITE_API LightPredictor {
   std::shared_ptr<cpp::ProgramDesc> program_desc_;
   std::vector<std::string> input_names_;
   std::vector<std::string> output_names_;
+  // Resolved once in PrepareFeedFetch.
+  std::vector<lite::Tensor*> input_tensors_;
+  std::vector<lite::Tensor*> output_tensors_;
   std::vector<PrecisionType> input_precisions_;
 };
 
@@ -173,6 +176,9 @@ class LightPredictorImpl : public lite_api::PaddlePredictor {
 
  private:
   std::unique_ptr<lite::LightPredictor> raw_predictor_;
+  // Threads are bound by these at their first Run.
+  lite_api::X86BindPolicy x86_bind_policy_{lite_api::X86_BIND_NONE};
+  int x86_num_threads_{1};
 };
 
 }  // namespace lite
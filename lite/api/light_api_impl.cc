@@ -22,8 +22,12 @@
 #include "lite/api/paddle_use_ops.h"
 #endif
 #include "lite/core/parallel_defines.h"
+#include "lite/core/profile/memory_profiler.h"
 #include "lite/core/thread_pool.h"
 
+#if (defined LITE_WITH_X86) && !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+#include "lite/backends/x86/parallel.h"
+#endif
 #if (defined LITE_WITH_X86) && (defined PADDLE_WITH_MKLML) && \
     !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
 #include "lite/backends/x86/mklml.h"
@@ -33,6 +37,17 @@ namespace paddle {
 namespace lite {
 
 void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
+  profile::MemoryTagScope memory_tag(profile::MemoryTag::kWeight);
+#if (defined LITE_WITH_X86) && !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+  // Bind before loading, so that the weights are first touched, and placed,
+  // on the NUMA node of the cpus that will compute with them. The caller gets
+  // its own affinity back when Init returns.
+  x86::ThreadAffinityGuard caller_affinity;
+  x86::BindThreads(config.x86_math_bind_policy(),
+                   config.x86_math_num_threads());
+  x86_bind_policy_ = config.x86_math_bind_policy();
+  x86_num_threads_ = config.x86_math_num_threads();
+#endif
   // LightPredictor Only support NaiveBuffer backend in publish lib
   if (config.lite_model_file().empty()) {
     raw_predictor_.reset(
@@ -47,6 +62,10 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
   }
   mode_ = config.power_mode();
   threads_ = config.threads();
+  if (config.trace_profile()) {
+    lite_api::EnableTraceProfile(true,
+                                 config.trace_profile_events_per_thread());
+  }
 #ifdef LITE_USE_THREAD_POOL
   int thread_num = ThreadPool::Init(threads_);
   if (thread_num > 1) {
@@ -141,6 +160,9 @@ std::unique_ptr<const lite_api::Tensor> LightPredictorImpl::GetOutput(
 void LightPredictorImpl::Run() {
 #ifdef LITE_WITH_ARM
   lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
+#endif
+#if (defined LITE_WITH_X86) && !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+  x86::BindRunningThread(x86_bind_policy_, x86_num_threads_);
 #endif
   raw_predictor_->Run();
 }
@@ -14,10 +14,18 @@
 
 #include "lite/api/paddle_api.h"
 
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <exception>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
 #include <utility>
 
 #include "lite/core/context.h"
 #include "lite/core/device_info.h"
+#include "lite/core/profile/memory_profiler.h"
+#include "lite/core/profile/perf_counter.h"
+#include "lite/core/profile/trace_profiler.h"
 #include "lite/core/target_wrapper.h"
 #include "lite/core/tensor.h"
 
@@ -73,6 +81,67 @@ bool IsOpenCLBackendValid(bool check_fp16_valid) {
   return opencl_valid;
 }
 
+void EnableTraceProfile(bool enabled, int events_per_thread) {
+  auto& profiler = lite::profile::TraceProfiler::Global();
+  if (enabled) {
+    profiler.Enable(static_cast<size_t>(events_per_thread));
+  } else {
+    profiler.Disable();
+  }
+}
+
+void ClearTraceProfile() { lite::profile::TraceProfiler::Global().Clear(); }
+
+bool SaveTraceProfile(const std::string& trace_path,
+                      const std::string& summary_path) {
+  auto& profiler = lite::profile::TraceProfiler::Global();
+  bool saved = true;
+  if (!trace_path.empty()) {
+    saved = profiler.SaveChromeTrace(trace_path) && saved;
+  }
+  if (!summary_path.empty()) {
+    saved = profiler.SaveSummary(summary_path) && saved;
+  }
+  return saved;
+}
+
+bool EnablePerfCounters(bool enabled) {
+  auto& profiler = lite::profile::PerfCounterProfiler::Global();
+  if (!enabled) {
+    profiler.Disable();
+    return true;
+  }
+  return profiler.Enable();
+}
+
+void ClearPerfCounters() {
+  lite::profile::PerfCounterProfiler::Global().Clear();
+}
+
+std::string PerfCounterSummary() {
+  return lite::profile::PerfCounterProfiler::Global().Summary();
+}
+
+void EnableMemoryProfile(bool enabled) {
+  auto& profiler = lite::profile::MemoryProfiler::Global();
+  if (enabled) {
+    profiler.Enable();
+  } else {
+    profiler.Disable();
+  }
+}
+
+void ClearMemoryProfile() { lite::profile::MemoryProfiler::Global().Clear(); }
+
+size_t MemoryProfilePeakBytes() {
+  return lite::profile::MemoryProfiler::Global().peak_bytes();
+}
+
+std::string MemoryProfileReport(int top_n) {
+  return lite::profile::MemoryProfiler::Global().Report(
+      static_cast<size_t>(top_n));
+}
+
 Tensor::Tensor(void *raw) : raw_tensor_(raw) {}
 
 // TODO(Superjomn) refine this by using another `const void* const_raw`;
@@ -104,6 +173,16 @@ void Tensor::ShareExternalMemory(void *data,
   tensor(raw_tensor_)->ResetBuffer(buf, memory_size);
 }
 
+void Tensor::ReleaseExternalMemory() {
+  auto *raw = tensor(raw_tensor_);
+  if (raw->own_data()) {
+    return;
+  }
+  auto buf = std::make_shared<lite::Buffer>();
+  buf->ResetLazy(raw->target(), raw->memory_size());
+  raw->ResetBuffer(buf, raw->memory_size());
+}
+
 template <typename T>
 T *Tensor::mutable_data(TargetType type) const {
   return tensor(raw_tensor_)->mutable_data<T>(type);
@@ -289,6 +368,158 @@ void PaddlePredictor::SaveOptimizedModel(const std::string &model_dir,
       << "The SaveOptimizedModel API is only supported by CxxConfig predictor.";
 }
 
+class AsyncPredictor::Impl {
+ public:
+  Impl(const std::vector<std::shared_ptr<PaddlePredictor>> &predictors,
+       size_t max_queue_size)
+      : max_queue_size_(max_queue_size) {
+    CHECK(!predictors.empty()) << "AsyncPredictor needs at least one worker.";
+    for (auto &predictor : predictors) {
+      CHECK(predictor) << "The predictor of AsyncPredictor can not be null.";
+      workers_.emplace_back(&Impl::Work, this, predictor);
+    }
+  }
+
+  ~Impl() {
+    std::deque<Request> cancelled;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+      cancelled.swap(queue_);
+    }
+    cv_.notify_all();
+    for (auto &request : cancelled) {
+      request.callback(AsyncRunStatus::kCancelled);
+    }
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  int64_t Submit(const IOBinder &feed,
+                 const IOBinder &fetch,
+                 const AsyncRunCallback &callback) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stop_ || queue_.size() >= max_queue_size_) {
+      lock.unlock();
+      callback(AsyncRunStatus::kRejected);
+      return -1;
+    }
+    int64_t id = next_id_++;
+    queue_.push_back(Request{id, feed, fetch, callback});
+    lock.unlock();
+    cv_.notify_one();
+    return id;
+  }
+
+  bool Cancel(int64_t id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (auto it = queue_.begin(); it != queue_.end(); ++it) {
+      if (it->id == id) {
+        auto callback = std::move(it->callback);
+        queue_.erase(it);
+        lock.unlock();
+        callback(AsyncRunStatus::kCancelled);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  size_t num_pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+  }
+
+  size_t num_workers() const { return workers_.size(); }
+
+ private:
+  struct Request {
+    int64_t id;
+    IOBinder feed;
+    IOBinder fetch;
+    AsyncRunCallback callback;
+  };
+
+  void Work(std::shared_ptr<PaddlePredictor> predictor) {
+    while (true) {
+      Request request;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) return;
+        request = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      auto status = AsyncRunStatus::kSuccess;
+      try {
+        if (request.feed) request.feed(predictor.get());
+        predictor->Run();
+        if (request.fetch) request.fetch(predictor.get());
+      } catch (const std::exception &e) {
+        LOG(ERROR) << "AsyncPredictor request " << request.id
+                   << " failed: " << e.what();
+        status = AsyncRunStatus::kFailed;
+      }
+      request.callback(status);
+    }
+  }
+
+  const size_t max_queue_size_;
+  int64_t next_id_{0};
+  bool stop_{false};
+  std::deque<Request> queue_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<std::thread> workers_;
+};
+
+AsyncPredictor::AsyncPredictor(
+    const std::vector<std::shared_ptr<PaddlePredictor>> &predictors,
+    size_t max_queue_size)
+    : impl_(new Impl(predictors, max_queue_size)) {}
+
+AsyncPredictor::AsyncPredictor(
+    const std::shared_ptr<PaddlePredictor> &predictor,
+    int num_workers,
+    size_t max_queue_size) {
+  CHECK(predictor) << "The predictor of AsyncPredictor can not be null.";
+  std::vector<std::shared_ptr<PaddlePredictor>> predictors{predictor};
+  for (int i = 1; i < num_workers; i++) {
+    predictors.push_back(predictor->Clone());
+  }
+  impl_.reset(new Impl(predictors, max_queue_size));
+}
+
+AsyncPredictor::~AsyncPredictor() = default;
+
+std::future<AsyncRunStatus> AsyncPredictor::RunAsync(const IOBinder &feed,
+                                                     const IOBinder &fetch,
+                                                     int64_t *request_id) {
+  auto promise = std::make_shared<std::promise<AsyncRunStatus>>();
+  auto future = promise->get_future();
+  int64_t id = impl_->Submit(feed, fetch, [promise](AsyncRunStatus status) {
+    promise->set_value(status);
+  });
+  if (request_id) *request_id = id;
+  return future;
+}
+
+int64_t AsyncPredictor::RunAsync(const IOBinder &feed,
+                                 const IOBinder &fetch,
+                                 const AsyncRunCallback &callback) {
+  return impl_->Submit(
+      feed, fetch, callback ? callback : [](AsyncRunStatus) {});
+}
+
+bool AsyncPredictor::Cancel(int64_t request_id) {
+  return impl_->Cancel(request_id);
+}
+
+size_t AsyncPredictor::num_pending() const { return impl_->num_pending(); }
+
+size_t AsyncPredictor::num_workers() const { return impl_->num_workers(); }
+
 template <typename ConfigT>
 std::shared_ptr<PaddlePredictor> CreatePaddlePredictor(const ConfigT &) {
   return std::shared_ptr<PaddlePredictor>();
@@ -408,6 +639,12 @@ void ConfigBase::set_x86_math_num_threads(int threads) {
   x86_math_num_threads_ = threads;
 }
 int ConfigBase::x86_math_num_threads() const { return x86_math_num_threads_; }
+void ConfigBase::set_x86_math_bind_policy(X86BindPolicy policy) {
+  x86_math_bind_policy_ = policy;
+}
+X86BindPolicy ConfigBase::x86_math_bind_policy() const {
+  return x86_math_bind_policy_;
+}
 #endif
 
 void ConfigBase::set_subgraph_model_cache_buffers(
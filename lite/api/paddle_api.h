@@ -19,6 +19,8 @@
 
 #ifndef PADDLE_LITE_API_H_  // NOLINT
 #define PADDLE_LITE_API_H_
+#include <functional>
+#include <future>  // NOLINT
 #include <map>
 #include <memory>
 #include <string>
@@ -45,6 +47,34 @@ enum class L3CacheSetMethod {
 // return true if current device supports OpenCL model
 LITE_API bool IsOpenCLBackendValid(bool check_fp16_valid = false);
 
+// Runtime trace profiler: records one span per instruction and per thread
+// pool task on every thread. It is compiled into all builds and costs a
+// single atomic load per instruction while disabled.
+LITE_API void EnableTraceProfile(bool enabled, int events_per_thread = 65536);
+LITE_API void ClearTraceProfile();
+// Writes the recorded spans as Chrome trace-event JSON (`trace_path`) and a
+// per-op CSV summary (`summary_path`). Empty paths are skipped.
+LITE_API bool SaveTraceProfile(const std::string& trace_path,
+                               const std::string& summary_path = "");
+
+// Hardware performance counters (cycles, instructions, LLC misses, branch
+// misses and FP ops) sampled around each instruction with perf_event_open on
+// Linux. Returns false when the counters are not permitted or not supported.
+LITE_API bool EnablePerfCounters(bool enabled);
+LITE_API void ClearPerfCounters();
+// Per-op CSV with the counters, IPC, achieved GFLOPS and bytes per flop.
+LITE_API std::string PerfCounterSummary();
+
+// Memory profiler: accounts every TargetMalloc/TargetFree by tag (weight,
+// activation, workspace) and by the instruction that was running, and keeps
+// a snapshot of the live set at the high-water mark.
+LITE_API void EnableMemoryProfile(bool enabled);
+LITE_API void ClearMemoryProfile();
+LITE_API size_t MemoryProfilePeakBytes();
+// Human readable report: per-tag totals, the `top_n` largest allocations at
+// the peak and the live memory after each instruction.
+LITE_API std::string MemoryProfileReport(int top_n = 10);
+
 struct LITE_API Tensor {
   explicit Tensor(void* raw);
   explicit Tensor(const void* raw);
@@ -65,6 +95,11 @@ struct LITE_API Tensor {
   // during the prediction process.
   void ShareExternalMemory(void* data, size_t memory_size, TargetType target);
 
+  // Stop using the memory set by ShareExternalMemory, if any: the tensor gets
+  // memory of its own with the same size, whose content is undefined, so the
+  // external memory may be freed afterwards.
+  void ReleaseExternalMemory();
+
   template <typename T, TargetType type = TargetType::kHost>
   void CopyFromCpu(const T* data);
 
@@ -140,6 +175,115 @@ class LITE_API PaddlePredictor {
   lite_api::PowerMode mode_{lite_api::LITE_POWER_NO_BIND};
 };
 
+/// Status of a request submitted to AsyncPredictor.
+enum class AsyncRunStatus {
+  kSuccess = 0,
+  kCancelled = 1,  // Cancelled before it was started.
+  kRejected = 2,   // The queue is full or the executor is stopping.
+  kFailed = 3,     // An exception was raised while serving the request.
+};
+
+/// Binds the inputs or outputs of one request. It is invoked on the worker
+/// thread with the predictor which serves the request.
+using IOBinder = std::function<void(PaddlePredictor*)>;
+using AsyncRunCallback = std::function<void(AsyncRunStatus)>;
+
+/// AsyncPredictor runs requests on a fixed set of worker threads, each of
+/// which owns one predictor. Requests wait in a bounded FIFO queue, so that a
+/// few I/O threads can drive many concurrent inferences without blocking.
+class LITE_API AsyncPredictor {
+ public:
+  /// Every predictor is served by a dedicated worker thread.
+  explicit AsyncPredictor(
+      const std::vector<std::shared_ptr<PaddlePredictor>>& predictors,
+      size_t max_queue_size = 64);
+  /// Clone `predictor` to create `num_workers` workers, which is only
+  /// supported by the predictors created from CxxConfig.
+  AsyncPredictor(const std::shared_ptr<PaddlePredictor>& predictor,
+                 int num_workers,
+                 size_t max_queue_size = 64);
+  /// Pending requests are cancelled, running ones are waited for.
+  ~AsyncPredictor();
+
+  /// Submit a request, the id used by `Cancel` is written to `request_id`
+  /// if it is not null, or -1 if the request is rejected.
+  std::future<AsyncRunStatus> RunAsync(const IOBinder& feed,
+                                       const IOBinder& fetch,
+                                       int64_t* request_id = nullptr);
+  /// Submit a request, `callback` is invoked on the worker thread when it
+  /// finishes, or on the calling thread if it is rejected.
+  /// Return the id of the request, or -1 if it is rejected.
+  int64_t RunAsync(const IOBinder& feed,
+                   const IOBinder& fetch,
+                   const AsyncRunCallback& callback);
+  /// Remove a request which has not been started from the queue.
+  bool Cancel(int64_t request_id);
+
+  size_t num_pending() const;
+  size_t num_workers() const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/// A tensor on the host which owns its data, used to carry the inputs and
+/// outputs of BatchingPredictor requests.
+struct LITE_API HostTensor {
+  shape_t shape;
+  PrecisionType precision{PrecisionType::kFloat};
+  lod_t lod;
+  std::vector<char> data;
+};
+
+struct LITE_API BatchingOptions {
+  // The max number of samples run in one batch.
+  int max_batch_size{8};
+  // How long to wait for more requests after the first one of a batch.
+  int max_delay_us{1000};
+  // If not empty, a batch is padded with zeros to the smallest bucket size
+  // which holds it, so that the predictor only sees a few distinct shapes.
+  // Padding is skipped for batches with LoD inputs.
+  std::vector<int> batch_buckets{};
+  // Requests beyond it are rejected.
+  size_t max_queue_size{256};
+};
+
+struct LITE_API BatchingMetrics {
+  int64_t num_requests{0};
+  int64_t num_batches{0};
+  int64_t num_samples{0};
+  int64_t num_padded_samples{0};
+  // Time from submitting to the start of the batch, summed over requests.
+  double queue_time_us{0.};
+  // Time to feed, run and fetch, summed over batches.
+  double compute_time_us{0.};
+};
+
+/// BatchingPredictor collects concurrent requests into one batch along the
+/// first dimension (or the first LoD level for LoD inputs), runs the
+/// predictor once, and scatters the outputs back to the requests. Inputs
+/// without a batch dimension are rejected, and a batch fails if one of its
+/// outputs is not split the same way, with one row or sequence per sample.
+class LITE_API BatchingPredictor {
+ public:
+  explicit BatchingPredictor(const std::shared_ptr<PaddlePredictor>& predictor,
+                             const BatchingOptions& options = {});
+  /// Pending requests are failed, the running batch is waited for.
+  ~BatchingPredictor();
+
+  /// `inputs` are ordered as `GetInputNames()` of the predictor, and the
+  /// outputs are ordered as `GetOutputNames()`. The future holds an
+  /// exception if the request is rejected or fails.
+  std::future<std::vector<HostTensor>> Predict(std::vector<HostTensor> inputs);
+
+  BatchingMetrics metrics() const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
 /// Base class for all the configs.
 class LITE_API ConfigBase {
   std::string model_dir_;
@@ -174,6 +318,7 @@ class LITE_API ConfigBase {
   std::string nnadapter_subgraph_partition_config_buffer_{};
   int device_id_{0};
   int x86_math_num_threads_ = 1;
+  X86BindPolicy x86_math_bind_policy_{X86_BIND_NONE};
 
   std::string metal_path_;
   bool metal_use_mps_{false};
@@ -181,6 +326,9 @@ class LITE_API ConfigBase {
   void* metal_device_{nullptr};
   bool metal_use_memory_reuse_{false};
 
+  bool trace_profile_{false};
+  int trace_profile_events_per_thread_{65536};
+
  public:
   explicit ConfigBase(PowerMode mode = LITE_POWER_NO_BIND, int threads = 1);
   // set Model_dir
@@ -283,6 +431,11 @@ class LITE_API ConfigBase {
   // set x86_math_num_threads
   void set_x86_math_num_threads(int threads);
   int x86_math_num_threads() const;
+  // set how the x86 math threads are pinned to cpus. The thread creating the
+  // predictor is pinned only while the model is loaded, a thread calling Run
+  // is pinned with its OpenMP workers at its first run and stays pinned
+  void set_x86_math_bind_policy(X86BindPolicy policy);
+  X86BindPolicy x86_math_bind_policy() const;
 
   void set_metal_lib_path(const std::string& path);
   void set_metal_use_mps(bool flag);
@@ -295,6 +448,18 @@ class LITE_API ConfigBase {
   bool metal_use_aggressive() const { return metal_use_aggressive_; }
   void* metal_device() const { return metal_device_; }
   bool metal_use_memory_reuse() const { return metal_use_memory_reuse_; }
+
+  // Enable the trace profiler when the predictor is created, see
+  // EnableTraceProfile. It can also be enabled by setting the environment
+  // variable PADDLE_LITE_TRACE_PROFILE=1.
+  void set_trace_profile(bool enabled, int events_per_thread = 65536) {
+    trace_profile_ = enabled;
+    trace_profile_events_per_thread_ = events_per_thread;
+  }
+  bool trace_profile() const { return trace_profile_; }
+  int trace_profile_events_per_thread() const {
+    return trace_profile_events_per_thread_;
+  }
 };
 
 class LITE_API CxxModelBuffer {
@@ -327,8 +492,10 @@ class LITE_API CxxConfig : public ConfigBase {
   QuantType quant_type_{QuantType::QUANT_INT16};
   bool sparse_model_{false};  // Enable sparse_conv_detect_pass in opt
   float sparse_threshold_{0.6f};
+  std::string optimized_model_cache_dir_;
   std::map<int, std::vector<std::shared_ptr<void>>>
       preferred_inputs_for_warmup_;
+  std::vector<std::vector<shape_t>> shape_buckets_{};
 #ifdef LITE_WITH_CUDA
   bool multi_stream_{false};
 #endif
@@ -436,6 +603,20 @@ class LITE_API CxxConfig : public ConfigBase {
     return preferred_inputs_for_warmup_;
   }
 
+  // Set shape buckets for inputs of dynamic shapes, each bucket holds the
+  // max shapes of all the inputs ordered as GetInputNames(). A runtime
+  // program is created and warmed up with zero inputs for every bucket, and
+  // its tensors are packed into one arena by their sizes at the bucket
+  // shapes. Each run is routed to the smallest bucket which holds its
+  // inputs, so the kernels and memory of a bucket are planned only once.
+  // TryShrinkMemory releases the arenas, later runs allocate per tensor.
+  void set_shape_buckets(const std::vector<std::vector<shape_t>>& buckets) {
+    shape_buckets_ = buckets;
+  }
+  const std::vector<std::vector<shape_t>>& shape_buckets() const {
+    return shape_buckets_;
+  }
+
   void set_quant_model(bool quant_model) { quant_model_ = quant_model; }
   bool quant_model() const { return quant_model_; }
   void set_quant_type(QuantType quant_type) { quant_type_ = quant_type; }
@@ -447,6 +628,18 @@ class LITE_API CxxConfig : public ConfigBase {
     sparse_threshold_ = sparse_threshold;
   }
   float sparse_threshold() const { return sparse_threshold_; }
+
+  // Set a directory to cache the optimized program in. The first build
+  // saves it there as a naive buffer model, keyed by the content of the
+  // model, the valid places and passes, the quant and sparse settings, the
+  // CPU features and the library version. Later builds with the same key
+  // load it and skip the optimizer. Any change of the key misses the cache.
+  void set_optimized_model_cache_dir(const std::string& dir) {
+    optimized_model_cache_dir_ = dir;
+  }
+  const std::string& optimized_model_cache_dir() const {
+    return optimized_model_cache_dir_;
+  }
 };
 
 /// MobileConfig is the config for the light weight predictor, it will skip
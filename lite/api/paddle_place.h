@@ -100,6 +100,14 @@ typedef enum {
   LITE_POWER_RAND_LOW = 5
 } PowerMode;
 
+// How the x86 math threads are pinned to logical cpus.
+typedef enum {
+  X86_BIND_NONE = 0,      // leave the threads to the os scheduler
+  X86_BIND_COMPACT = 1,   // fill the cores of a socket, SMT siblings included
+  X86_BIND_SCATTER = 2,   // spread the threads over the sockets in turn
+  X86_BIND_PHYSICAL = 3,  // one thread per physical core, siblings unused
+} X86BindPolicy;
+
 typedef enum {
   CL_TUNE_NONE = 0,
   CL_TUNE_RAPID = 1,
@@ -168,6 +176,9 @@ static size_t PrecisionTypeLength(PrecisionType type) {
 enum class QuantType : int {
   QUANT_INT8,
   QUANT_INT16,
+  // bfloat16 weights read directly by the x86 fc, mul and lookup_table
+  // kernels.
+  QUANT_BF16,
 };
 
 template <typename T>
@@ -54,6 +54,7 @@ USE_MIR_PASS(lite_scales_fuse_pass);
 USE_MIR_PASS(lite_scaleacts_fuse_pass);
 USE_MIR_PASS(lite_sequence_reverse_embedding_fuse_pass);
 USE_MIR_PASS(lite_elementwise_activation_fuse_pass);
+USE_MIR_PASS(lite_elementwise_chain_fuse_pass);
 USE_MIR_PASS(lite_elementwise_scale_fuse_pass);
 USE_MIR_PASS(lite_conv_scale_fuse_pass);
 USE_MIR_PASS(lite_conv_elementwise_tree_fuse_pass);
@@ -113,3 +114,4 @@ USE_MIR_PASS(__xpu__dynamic_lstm_fuse_pass);
 USE_MIR_PASS(__xpu__multi_softmax_fuse_pass);
 USE_MIR_PASS(__xpu__max_pooling_pad_zero_detect_fuse_pass);
 USE_MIR_PASS(x86_int8_attribute_pass);
+USE_MIR_PASS(x86_bf16_weight_pass);
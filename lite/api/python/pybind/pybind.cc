@@ -256,7 +256,9 @@ void BindLiteTensor(py::module *m) {
   py::class_<Tensor> tensor(*m, "Tensor");
 
   tensor.def("resize", &Tensor::Resize)
-      .def("numpy", [](Tensor &self) { return TensorToPyArray(self); })
+      .def("numpy",
+           [](Tensor &self, bool copy) { return TensorToPyArray(self, copy); },
+           py::arg("copy") = false)
       .def("shape", &Tensor::shape)
       .def("target", &Tensor::target)
       .def("precision", &Tensor::precision)
@@ -265,6 +267,10 @@ void BindLiteTensor(py::module *m) {
       .def("from_numpy",
            SetTensorFromPyArray,
            py::arg("array"),
+           py::arg("place") = TargetType::kHost)
+      .def("share_numpy",
+           ShareTensorWithPyArray,
+           py::arg("array"),
            py::arg("place") = TargetType::kHost);
 
 #define DO_GETTER_ONCE(data_type__, name__)                           \
@@ -283,6 +289,7 @@ void BindLiteTensor(py::module *m) {
       [](Tensor &self,                                                   \
          const std::vector<data_type__> &data,                           \
          TargetType type = TargetType::kHost) {                          \
+        self.ReleaseExternalMemory();                                    \
         if (type == TargetType::kHost || type == TargetType::kARM) {     \
           self.CopyFromCpu<data_type__, TargetType::kHost>(data.data()); \
         } else if (type == TargetType::kCUDA) {                          \
@@ -305,13 +312,65 @@ void BindLiteTensor(py::module *m) {
 #undef DATA_GETTER_SETTER_ONCE
 }
 
+////////////////////////////////////////////////////////////////
+// Function Name: PredictFromPyDict
+// Usage: Feed inputs from a dict of {input_name: numpy.array},
+//        run the predictor with the GIL released, and return the
+//        outputs as a dict of {output_name: numpy.array}.
+////////////////////////////////////////////////////////////////
+template <typename PredictorT>
+py::dict PredictFromPyDict(PredictorT *self,
+                           const py::dict &inputs,
+                           bool share_memory,
+                           bool copy_outputs) {
+  // Holds the arrays shared by input tensors until the run finishes.
+  std::vector<py::array> shared_arrays;
+  std::vector<std::unique_ptr<Tensor>> shared_inputs;
+  shared_arrays.reserve(inputs.size());
+  for (auto item : inputs) {
+    auto name = item.first.cast<std::string>();
+    auto array = py::reinterpret_borrow<py::object>(item.second);
+    auto input = self->GetInputByName(name);
+    if (share_memory) {
+      shared_arrays.emplace_back(
+          ShareTensorWithPyArray(input.get(), array, TargetType::kHost));
+      shared_inputs.emplace_back(std::move(input));
+    } else {
+      SetTensorFromPyArray(input.get(), array, TargetType::kHost);
+    }
+  }
+  {
+    py::gil_scoped_release release;
+    self->Run();
+  }
+  // The arrays, or their contiguous copies, die with this call: the inputs
+  // must not keep pointing at them.
+  for (auto &input : shared_inputs) {
+    input->ReleaseExternalMemory();
+  }
+  py::dict outputs;
+  auto output_names = self->GetOutputNames();
+  for (size_t i = 0; i < output_names.size(); i++) {
+    auto output = self->GetOutput(i);
+    outputs[py::str(output_names[i])] = TensorToPyArray(*output, copy_outputs);
+  }
+  return outputs;
+}
+
 #ifndef LITE_ON_TINY_PUBLISH
 void BindLiteCxxPredictor(py::module *m) {
   py::class_<CxxPaddleApiImpl>(*m, "CxxPredictor")
       .def(py::init<>())
       .def("get_input", &CxxPaddleApiImpl::GetInput)
       .def("get_output", &CxxPaddleApiImpl::GetOutput)
-      .def("run", &CxxPaddleApiImpl::Run)
+      .def("run",
+           &CxxPaddleApiImpl::Run,
+           py::call_guard<py::gil_scoped_release>())
+      .def("predict",
+           &PredictFromPyDict<CxxPaddleApiImpl>,
+           py::arg("inputs"),
+           py::arg("share_memory") = true,
+           py::arg("copy_outputs") = true)
       .def("get_version", &CxxPaddleApiImpl::GetVersion)
       .def("save_optimized_model",
            [](CxxPaddleApiImpl &self, const std::string &output_dir) {
@@ -326,7 +385,14 @@ void BindLiteLightPredictor(py::module *m) {
       .def(py::init<>())
       .def("get_input", &LightPredictorImpl::GetInput)
       .def("get_output", &LightPredictorImpl::GetOutput)
-      .def("run", &LightPredictorImpl::Run)
+      .def("run",
+           &LightPredictorImpl::Run,
+           py::call_guard<py::gil_scoped_release>())
+      .def("predict",
+           &PredictFromPyDict<LightPredictorImpl>,
+           py::arg("inputs"),
+           py::arg("share_memory") = true,
+           py::arg("copy_outputs") = true)
       .def("get_version", &LightPredictorImpl::GetVersion);
 }
 
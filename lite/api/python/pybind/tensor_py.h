@@ -94,6 +94,13 @@ inline py::array TensorToPyArray(const Tensor &tensor,
 
   const void *tensor_buf_ptr = static_cast<const void *>(tensor.data<int8_t>());
   std::string py_dtype_str = TensorDTypeToPyDTypeStr(tensor.precision());
+  if (need_deep_copy) {
+    py::array array(py::dtype(py_dtype_str.c_str()), py_dims, py_strides);
+    std::memcpy(array.mutable_data(), tensor_buf_ptr, numel * sizeof_dtype);
+    return array;
+  }
+  // The returned array is a view of the tensor's memory, which is
+  // overwritten by the next `run` of the predictor.
   auto base = py::cast(std::move(tensor));
   return py::array(py::dtype(py_dtype_str.c_str()),
                    py_dims,
@@ -117,6 +124,9 @@ void SetTensorFromPyArrayT(
     dims.push_back(static_cast<int>(array.shape()[i]));
   }
   self->Resize(dims);
+  // Do not copy into an array shared by a previous share_numpy(), which
+  // may be gone by now.
+  self->ReleaseExternalMemory();
 
   auto dst = self->mutable_data<T>(place);
   std::memcpy(dst, array.data(), array.nbytes());
@@ -160,6 +170,70 @@ void SetTensorFromPyArray(Tensor *self,
   }
 }
 
+////////////////////////////////////////////////////////////////
+// Function Name: ShareTensorWithPyArrayT
+// Usage: Make tensor share the memory of a numpy array of specified
+//        precision. The array must be kept alive until the run of
+//        the predictor finishes.
+////////////////////////////////////////////////////////////////
+template <typename T>
+void ShareTensorWithPyArrayT(
+    Tensor *self,
+    const py::array_t<T, py::array::c_style | py::array::forcecast> &array,
+    const TargetType &place) {
+  std::vector<int64_t> dims;
+  dims.reserve(array.ndim());
+  for (decltype(array.ndim()) i = 0; i < array.ndim(); ++i) {
+    dims.push_back(static_cast<int64_t>(array.shape()[i]));
+  }
+  // Clear the memory size recorded by the previous feed, otherwise
+  // `ShareExternalMemory` refuses an array smaller than the last one.
+  self->Resize({0});
+  self->mutable_data<T>(place);
+  auto *data = const_cast<void *>(static_cast<const void *>(array.data()));
+  self->ShareExternalMemory(data, array.nbytes(), place);
+  self->Resize(dims);
+  self->SetPrecision(lite_api::PrecisionTypeTrait<T>::Type());
+}
+
+////////////////////////////////////////////////////////////////
+// Function Name: ShareTensorWithPyArray
+// Usage: Feed a tensor with input numpy array without copying.
+//        Arrays which are not C-contiguous are converted into a
+//        contiguous one first.
+// Return: the array whose memory is shared by tensor, it should
+//         be kept alive until the run of the predictor finishes.
+////////////////////////////////////////////////////////////////
+py::array ShareTensorWithPyArray(Tensor *self,
+                                 const py::object &obj,
+                                 const TargetType &place) {
+  CHECK(place == TargetType::kHost || place == TargetType::kX86 ||
+        place == TargetType::kARM)
+      << "Only host memory can be shared with numpy array.";
+  auto array = obj.cast<py::array>();
+#define SHARE_TENSOR_WITH_PY_ARRAY(T)                                     \
+  if (py::isinstance<py::array_t<T>>(array)) {                            \
+    py::array_t<T, py::array::c_style | py::array::forcecast> contiguous( \
+        array);                                                           \
+    ShareTensorWithPyArrayT<T>(self, contiguous, place);                  \
+    return std::move(contiguous);                                         \
+  }
+  SHARE_TENSOR_WITH_PY_ARRAY(float)
+  SHARE_TENSOR_WITH_PY_ARRAY(int)
+  SHARE_TENSOR_WITH_PY_ARRAY(int64_t)
+  SHARE_TENSOR_WITH_PY_ARRAY(double)
+  SHARE_TENSOR_WITH_PY_ARRAY(int8_t)
+  SHARE_TENSOR_WITH_PY_ARRAY(int16_t)
+  SHARE_TENSOR_WITH_PY_ARRAY(uint8_t)
+  SHARE_TENSOR_WITH_PY_ARRAY(bool)
+#undef SHARE_TENSOR_WITH_PY_ARRAY
+  LOG(FATAL) << "Input object type error or incompatible array data type. "
+                "tensor.share_numpy(numpy.array) supports numpy array input "
+                "in bool, float32, float64, int8, int16, int32, int64 or "
+                "uint8, please check your input or input array data type.";
+  return py::array();
+}
+
 }  // namespace pybind
 }  // namespace lite
 }  // namespace paddle
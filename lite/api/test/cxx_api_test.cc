@@ -13,14 +13,18 @@
 // limitations under the License.
 
 #include "lite/api/cxx_api.h"
+#include <dirent.h>
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
 #include <vector>
 #include "lite/api/paddle_use_kernels.h"
 #include "lite/api/paddle_use_ops.h"
 #include "lite/api/paddle_use_passes.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/tensor.h"
+#include "lite/utils/io.h"
 
 // For training.
 DEFINE_string(startup_program_path, "", "");
@@ -101,6 +105,88 @@ TEST(CXXApi, clone_predictor) {
   }
 }
 
+std::vector<std::string> ListFiles(const std::string& dir) {
+  std::vector<std::string> files;
+  DIR* dir_fd = opendir(dir.c_str());
+  if (!dir_fd) return files;
+  while (dirent* entry = readdir(dir_fd)) {
+    std::string name(entry->d_name);
+    if (name[0] != '.') files.push_back(name);
+  }
+  closedir(dir_fd);
+  return files;
+}
+
+std::vector<float> RunOnes(Predictor* predictor) {
+  auto* input_tensor = predictor->GetInput(0);
+  input_tensor->Resize(std::vector<int64_t>({1, 100}));
+  auto* data = input_tensor->mutable_data<float>();
+  for (int i = 0; i < 100; i++) {
+    data[i] = 1;
+  }
+  predictor->Run();
+  auto* output_tensor = predictor->GetOutput(0);
+  return std::vector<float>(
+      output_tensor->data<float>(),
+      output_tensor->data<float>() + output_tensor->numel());
+}
+
+TEST(CXXApi, optimized_model_cache) {
+  std::vector<Place> valid_places({Place{TARGET(kX86), PRECISION(kFloat)}});
+  std::string cache_dir = FLAGS_optimized_model + ".cache";
+  MkDirRecur(cache_dir);
+  for (auto& name : ListFiles(cache_dir)) {
+    std::remove((cache_dir + "/" + name).c_str());
+  }
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_optimized_model_cache_dir(cache_dir);
+
+  // The first build optimizes and writes the cache, the second loads it.
+  Predictor miss;
+  miss.Build(config, valid_places);
+  ASSERT_EQ(ListFiles(cache_dir).size(), 1u);
+  Predictor hit;
+  hit.Build(config, valid_places);
+  EXPECT_EQ(ListFiles(cache_dir).size(), 1u);
+  auto expected = RunOnes(&miss);
+  auto outputs = RunOnes(&hit);
+  ASSERT_EQ(outputs.size(), expected.size());
+  for (size_t i = 0; i < outputs.size(); i++) {
+    EXPECT_EQ(outputs[i], expected[i]) << i;
+  }
+  // A clone of the cached program runs the same.
+  outputs = RunOnes(hit.Clone().get());
+  for (size_t i = 0; i < outputs.size(); i++) {
+    EXPECT_EQ(outputs[i], expected[i]) << i;
+  }
+
+  // A model with one changed byte of a parameter misses.
+  std::string model_dir = FLAGS_optimized_model + ".modified";
+  MkDirRecur(model_dir);
+  auto files = ListFiles(FLAGS_model_dir);
+  for (auto& name : files) {
+    std::vector<char> contents;
+    ASSERT_TRUE(ReadFile(FLAGS_model_dir + "/" + name, &contents));
+    if (name != "__model__" && name != "model" && !contents.empty()) {
+      contents.back() ^= 1;
+    }
+    ASSERT_TRUE(WriteFile(model_dir + "/" + name, contents));
+  }
+  config.set_model_dir(model_dir);
+  Predictor modified;
+  modified.Build(config, valid_places);
+  EXPECT_EQ(ListFiles(cache_dir).size(), 2u);
+  config.set_model_dir(FLAGS_model_dir);
+
+  // Other CPU features, e.g. a machine without avx512, get another entry.
+  EXPECT_EQ(OptimizedModelCachePath(config, valid_places, {}, "avx,avx2,"),
+            OptimizedModelCachePath(config, valid_places, {}, "avx,avx2,"));
+  EXPECT_NE(OptimizedModelCachePath(config, valid_places, {}, "avx,avx2,"),
+            OptimizedModelCachePath(
+                config, valid_places, {}, "avx,avx2,avx512f,"));
+}
+
 /*TEST(CXXTrainer, train) {
   Place place({TARGET(kHost), PRECISION(kFloat), DATALAYOUT(kNCHW)});
   std::vector<Place> valid_places({place});
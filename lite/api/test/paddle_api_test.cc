@@ -15,6 +15,13 @@
 #include "lite/api/paddle_api.h"
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 #include "lite/utils/io.h"
 #include "lite/utils/log/cp_logging.h"
 
@@ -110,6 +117,379 @@ TEST(CxxApi, share_external_data) {
   EXPECT_NEAR(out[1], -28.8729, 1e-3);
 }
 
+TEST(CxxApi, shape_buckets) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+  config.set_shape_buckets({{{2, 100}}, {{4, 100}}});
+  auto bucketed = lite_api::CreatePaddlePredictor(config);
+
+  // In the buckets, at their max shapes and beyond them.
+  for (int64_t batch : {1, 3, 4, 2, 8, 1}) {
+    std::vector<float> data(batch * 100);
+    for (size_t i = 0; i < data.size(); i++) {
+      data[i] = (batch + 1) * static_cast<float>(i % 100);
+    }
+    std::vector<std::vector<float>> outputs;
+    for (auto& p : {predictor, bucketed}) {
+      auto input_tensor = p->GetInput(0);
+      input_tensor->Resize({batch, 100});
+      input_tensor->CopyFromCpu<float, TargetType::kHost>(data.data());
+      p->Run();
+      auto output = p->GetOutput(0);
+      ASSERT_EQ(output->shape()[0], batch);
+      int64_t numel = 1;
+      for (auto d : output->shape()) numel *= d;
+      outputs.emplace_back(output->data<float>(),
+                           output->data<float>() + numel);
+    }
+    ASSERT_EQ(outputs[0].size(), outputs[1].size());
+    for (size_t i = 0; i < outputs[0].size(); i++) {
+      EXPECT_NEAR(outputs[1][i], outputs[0][i], 1e-5)
+          << "batch " << batch << ", element " << i;
+    }
+  }
+}
+
+TEST(CxxApi, run_async) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+  AsyncPredictor async_predictor(predictor, 2, 8);
+  EXPECT_EQ(async_predictor.num_workers(), 2u);
+
+  std::vector<float> external_data(100 * 100);
+  for (int i = 0; i < 100 * 100; i++) {
+    external_data[i] = i;
+  }
+  auto feed = [&](PaddlePredictor* p) {
+    auto input_tensor = p->GetInput(0);
+    input_tensor->Resize(std::vector<int64_t>({100, 100}));
+    input_tensor->CopyFromCpu<float, TargetType::kHost>(external_data.data());
+  };
+
+  const int num_requests = 8;
+  std::vector<std::vector<float>> results(num_requests);
+  std::vector<std::future<AsyncRunStatus>> futures;
+  for (int i = 0; i < num_requests; i++) {
+    auto fetch = [&results, i](PaddlePredictor* p) {
+      auto output = p->GetOutput(0);
+      results[i].assign(output->data<float>(), output->data<float>() + 2);
+    };
+    futures.push_back(async_predictor.RunAsync(feed, fetch));
+  }
+  for (int i = 0; i < num_requests; i++) {
+    EXPECT_EQ(futures[i].get(), AsyncRunStatus::kSuccess);
+    EXPECT_NEAR(results[i][0], 50.2132, 1e-3);
+    EXPECT_NEAR(results[i][1], -28.8729, 1e-3);
+  }
+  EXPECT_EQ(async_predictor.num_pending(), 0u);
+  EXPECT_FALSE(async_predictor.Cancel(0));
+}
+
+// Runs a request on the only worker of `async_predictor` and holds it in its
+// feed until `release` is set, so that the following requests stay queued.
+std::future<AsyncRunStatus> BlockWorker(AsyncPredictor* async_predictor,
+                                        const IOBinder& feed,
+                                        std::shared_future<void> release) {
+  auto started = std::make_shared<std::promise<void>>();
+  auto started_future = started->get_future();
+  auto future = async_predictor->RunAsync(
+      [feed, started, release](PaddlePredictor* p) {
+        started->set_value();
+        release.wait();
+        feed(p);
+      },
+      nullptr);
+  started_future.wait();
+  return future;
+}
+
+TEST(CxxApi, run_async_queue_bound) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+  const size_t max_queue_size = 3;
+  AsyncPredictor async_predictor(predictor, 1, max_queue_size);
+  std::vector<float> input(100, 1.f);
+  auto feed = [&input](PaddlePredictor* p) {
+    auto input_tensor = p->GetInput(0);
+    input_tensor->Resize({1, 100});
+    input_tensor->CopyFromCpu<float, TargetType::kHost>(input.data());
+  };
+
+  std::promise<void> release;
+  auto running = BlockWorker(&async_predictor, feed, release.get_future());
+  // The running request does not count, the queue takes exactly
+  // `max_queue_size` more.
+  EXPECT_EQ(async_predictor.num_pending(), 0u);
+  std::vector<std::future<AsyncRunStatus>> futures;
+  for (size_t i = 0; i < max_queue_size; i++) {
+    int64_t id = -1;
+    futures.push_back(async_predictor.RunAsync(feed, nullptr, &id));
+    EXPECT_GE(id, 0);
+    EXPECT_EQ(async_predictor.num_pending(), i + 1);
+  }
+  int64_t id = 0;
+  auto rejected = async_predictor.RunAsync(feed, nullptr, &id);
+  EXPECT_EQ(id, -1);
+  EXPECT_EQ(async_predictor.num_pending(), max_queue_size);
+
+  release.set_value();
+  EXPECT_EQ(running.get(), AsyncRunStatus::kSuccess);
+  for (auto& future : futures) {
+    EXPECT_EQ(future.get(), AsyncRunStatus::kSuccess);
+  }
+  EXPECT_EQ(rejected.get(), AsyncRunStatus::kRejected);
+  EXPECT_EQ(async_predictor.num_pending(), 0u);
+}
+
+TEST(CxxApi, run_async_reject) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+  AsyncPredictor async_predictor(predictor, 1, 1);
+  std::vector<float> input(100, 1.f);
+  auto feed = [&input](PaddlePredictor* p) {
+    auto input_tensor = p->GetInput(0);
+    input_tensor->Resize({1, 100});
+    input_tensor->CopyFromCpu<float, TargetType::kHost>(input.data());
+  };
+
+  std::promise<void> release;
+  auto running = BlockWorker(&async_predictor, feed, release.get_future());
+  auto queued = async_predictor.RunAsync(feed, nullptr);
+
+  // A rejected request never reaches the predictor, and its callback is
+  // invoked on the calling thread before RunAsync returns.
+  bool fed = false;
+  auto status = AsyncRunStatus::kSuccess;
+  auto caller = std::this_thread::get_id();
+  std::thread::id callback_thread;
+  int64_t id = async_predictor.RunAsync(
+      [&fed](PaddlePredictor*) { fed = true; },
+      nullptr,
+      [&](AsyncRunStatus s) {
+        status = s;
+        callback_thread = std::this_thread::get_id();
+      });
+  EXPECT_EQ(id, -1);
+  EXPECT_EQ(status, AsyncRunStatus::kRejected);
+  EXPECT_EQ(callback_thread, caller);
+  EXPECT_FALSE(async_predictor.Cancel(id));
+
+  release.set_value();
+  EXPECT_EQ(running.get(), AsyncRunStatus::kSuccess);
+  EXPECT_EQ(queued.get(), AsyncRunStatus::kSuccess);
+  EXPECT_FALSE(fed);
+
+  // Once the queue drains, requests are accepted again.
+  EXPECT_EQ(async_predictor.RunAsync(feed, nullptr).get(),
+            AsyncRunStatus::kSuccess);
+}
+
+TEST(CxxApi, run_async_cancel) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+  AsyncPredictor async_predictor(predictor, 1, 8);
+  std::vector<float> input(100, 1.f);
+  auto feed = [&input](PaddlePredictor* p) {
+    auto input_tensor = p->GetInput(0);
+    input_tensor->Resize({1, 100});
+    input_tensor->CopyFromCpu<float, TargetType::kHost>(input.data());
+  };
+
+  std::promise<void> release;
+  auto running = BlockWorker(&async_predictor, feed, release.get_future());
+  const int num_requests = 3;
+  std::vector<int64_t> ids(num_requests, -1);
+  std::vector<bool> fetched(num_requests, false);
+  std::vector<std::future<AsyncRunStatus>> futures;
+  for (int i = 0; i < num_requests; i++) {
+    futures.push_back(async_predictor.RunAsync(
+        feed, [&fetched, i](PaddlePredictor*) { fetched[i] = true; }, &ids[i]));
+  }
+  ASSERT_EQ(async_predictor.num_pending(), 3u);
+
+  // Only queued requests can be cancelled, and only once.
+  EXPECT_TRUE(async_predictor.Cancel(ids[1]));
+  EXPECT_EQ(futures[1].get(), AsyncRunStatus::kCancelled);
+  EXPECT_EQ(async_predictor.num_pending(), 2u);
+  EXPECT_FALSE(async_predictor.Cancel(ids[1]));
+
+  release.set_value();
+  EXPECT_EQ(running.get(), AsyncRunStatus::kSuccess);
+  EXPECT_EQ(futures[0].get(), AsyncRunStatus::kSuccess);
+  EXPECT_EQ(futures[2].get(), AsyncRunStatus::kSuccess);
+  EXPECT_TRUE(fetched[0]);
+  EXPECT_FALSE(fetched[1]);
+  EXPECT_TRUE(fetched[2]);
+  // Finished requests can not be cancelled either.
+  EXPECT_FALSE(async_predictor.Cancel(ids[0]));
+}
+
+TEST(CxxApi, batching) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+  // Different data per request, and the outputs of running each alone.
+  const int num_requests = 3;
+  std::vector<HostTensor> inputs(num_requests);
+  std::vector<std::vector<float>> expected(num_requests);
+  for (int r = 0; r < num_requests; r++) {
+    inputs[r].shape = {1, 100};
+    inputs[r].data.resize(100 * sizeof(float));
+    auto* data = reinterpret_cast<float*>(inputs[r].data.data());
+    for (int i = 0; i < 100; i++) {
+      data[i] = (r + 1) * i;
+    }
+    auto input_tensor = predictor->GetInput(0);
+    input_tensor->Resize({1, 100});
+    std::memcpy(
+        input_tensor->mutable_data<float>(), data, 100 * sizeof(float));
+    predictor->Run();
+    auto output = predictor->GetOutput(0);
+    int64_t numel = 1;
+    for (auto d : output->shape()) numel *= d;
+    expected[r].assign(output->data<float>(), output->data<float>() + numel);
+  }
+
+  BatchingOptions options;
+  options.max_batch_size = 4;
+  options.max_delay_us = 10000;
+  options.batch_buckets = {4};
+  BatchingPredictor batching_predictor(predictor, options);
+
+  std::vector<std::future<std::vector<HostTensor>>> futures;
+  for (int r = 0; r < num_requests; r++) {
+    futures.push_back(batching_predictor.Predict({inputs[r]}));
+  }
+  for (int r = 0; r < num_requests; r++) {
+    auto outputs = futures[r].get();
+    ASSERT_EQ(outputs.size(), 1u);
+    EXPECT_EQ(outputs[0].shape[0], 1);
+    ASSERT_EQ(outputs[0].data.size(), expected[r].size() * sizeof(float));
+    auto* out = reinterpret_cast<const float*>(outputs[0].data.data());
+    for (size_t i = 0; i < expected[r].size(); i++) {
+      EXPECT_NEAR(
+          out[i], expected[r][i], 1e-3 * std::abs(expected[r][i]) + 1e-4)
+          << "request " << r << ", element " << i;
+    }
+  }
+  auto metrics = batching_predictor.metrics();
+  EXPECT_EQ(metrics.num_requests, num_requests);
+  EXPECT_EQ(metrics.num_samples, num_requests);
+  // Every batch is padded to the bucket of 4 samples.
+  EXPECT_EQ((metrics.num_samples + metrics.num_padded_samples) % 4, 0);
+
+  // A scalar input has no batch dimension to concatenate along.
+  HostTensor scalar;
+  scalar.data.resize(sizeof(float));
+  EXPECT_THROW(batching_predictor.Predict({scalar}).get(),
+               std::invalid_argument);
+}
+
+TEST(CxxApi, batching_lod) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+  // Two sequences of 1 and 2 rows, then one sequence of 2 rows, and the
+  // outputs of running each alone.
+  const int num_requests = 2;
+  std::vector<HostTensor> inputs(num_requests);
+  inputs[0].shape = {3, 100};
+  inputs[0].lod = {{0, 1, 3}};
+  inputs[1].shape = {2, 100};
+  inputs[1].lod = {{0, 2}};
+  std::vector<std::vector<float>> expected(num_requests);
+  for (int r = 0; r < num_requests; r++) {
+    int64_t numel = inputs[r].shape[0] * 100;
+    inputs[r].data.resize(numel * sizeof(float));
+    auto* data = reinterpret_cast<float*>(inputs[r].data.data());
+    for (int64_t i = 0; i < numel; i++) {
+      data[i] = (r + 1) * (i % 100) - 0.5f * (i / 100);
+    }
+    auto input_tensor = predictor->GetInput(0);
+    input_tensor->Resize(inputs[r].shape);
+    input_tensor->SetLoD(inputs[r].lod);
+    std::memcpy(
+        input_tensor->mutable_data<float>(), data, numel * sizeof(float));
+    predictor->Run();
+    auto output = predictor->GetOutput(0);
+    ASSERT_EQ(output->lod(), inputs[r].lod);
+    int64_t out_numel = 1;
+    for (auto d : output->shape()) out_numel *= d;
+    expected[r].assign(output->data<float>(),
+                       output->data<float>() + out_numel);
+  }
+
+  // The two requests hold 3 samples, which closes the batch at once.
+  BatchingOptions options;
+  options.max_batch_size = 3;
+  options.max_delay_us = 1000000;
+  options.batch_buckets = {4};
+  BatchingPredictor batching_predictor(predictor, options);
+
+  std::vector<std::future<std::vector<HostTensor>>> futures;
+  for (int r = 0; r < num_requests; r++) {
+    futures.push_back(batching_predictor.Predict({inputs[r]}));
+  }
+  for (int r = 0; r < num_requests; r++) {
+    auto outputs = futures[r].get();
+    ASSERT_EQ(outputs.size(), 1u);
+    EXPECT_EQ(outputs[0].lod, inputs[r].lod) << "request " << r;
+    EXPECT_EQ(outputs[0].shape[0], inputs[r].shape[0]) << "request " << r;
+    ASSERT_EQ(outputs[0].data.size(), expected[r].size() * sizeof(float));
+    auto* out = reinterpret_cast<const float*>(outputs[0].data.data());
+    for (size_t i = 0; i < expected[r].size(); i++) {
+      EXPECT_NEAR(
+          out[i], expected[r][i], 1e-3 * std::abs(expected[r][i]) + 1e-4)
+          << "request " << r << ", element " << i;
+    }
+  }
+  auto metrics = batching_predictor.metrics();
+  EXPECT_EQ(metrics.num_requests, num_requests);
+  EXPECT_EQ(metrics.num_batches, 1);
+  EXPECT_EQ(metrics.num_samples, 3);
+  // Batches with LoD inputs are never padded.
+  EXPECT_EQ(metrics.num_padded_samples, 0);
+}
+
 // Demo1 for Mobile Devices :Load model from file and run
 #ifdef LITE_WITH_LIGHT_WEIGHT_FRAMEWORK
 TEST(LightApi, run) {
@@ -24,7 +24,16 @@
 #include "lite/core/version.h"
 #include "lite/utils/timer.h"
 
+namespace {
+// Breakdown of the time to the first result, in ms.
+struct StartupTime {
+  float pre_main{-1.f};
+  float opt{0.f};
+} startup_time;
+}  // namespace
+
 int main(int argc, char* argv[]) {
+  startup_time.pre_main = paddle::lite_api::ProcessCpuTimeMs();
   return paddle::lite_api::Benchmark(argc, argv);
 }
 
@@ -56,7 +65,10 @@ int Benchmark(int argc, char** argv) {
       }
       opt_model_path = path + "/opt";
     }
+    lite::Timer opt_timer;
+    opt_timer.Start();
     OutputOptModel(opt_model_path);
+    startup_time.opt = opt_timer.Stop();
   }
 
   // Get input shapes
@@ -83,8 +95,13 @@ void Run(const std::string& model_file,
   // Set backend config info
   SetBackendConfig(config);
 
+  if (FLAGS_enable_memory_profile) {
+    EnableMemoryProfile(true);
+  }
   auto predictor = CreatePaddlePredictor(config);
   float init_time = timer.Stop();
+  size_t init_memory = MemoryProfilePeakBytes();
+  float load_rss = PeakRssKb();
 
   // Set inputs
   for (size_t i = 0; i < input_shapes.size(); i++) {
@@ -211,10 +228,29 @@ void Run(const std::string& model_file,
   ss << "min   = " << std::setw(12) << perf_vct.front() << std::endl;
   ss << "max   = " << std::setw(12) << perf_vct.back() << std::endl;
   ss << "avg   = " << std::setw(12) << perf_avg << std::endl;
+  ss << "\nStartup Time(unit: ms):\n";
+  if (startup_time.pre_main >= 0.f) {
+    ss << "pre_main = " << std::setw(12) << startup_time.pre_main
+       << "(cpu time of loading and op/kernel registration)" << std::endl;
+  }
+  ss << "opt      = " << std::setw(12) << startup_time.opt
+     << "(load and optimize the origin model)" << std::endl;
+  ss << "load     = " << std::setw(12) << init_time << std::endl;
+  if (load_rss >= 0.f) {
+    ss << "load_rss = " << std::setw(12) << load_rss
+       << "(kB, peak resident memory after loading)" << std::endl;
+  }
+  ss << "first    = " << std::setw(12) << first_time << std::endl;
+  ss << "total    = " << std::setw(12)
+     << std::max(startup_time.pre_main, 0.f) + startup_time.opt + init_time +
+            first_time
+     << std::endl;
   if (FLAGS_enable_memory_profile) {
     ss << "\nMemory Usage(unit: kB):\n";
-    ss << "init  = " << std::setw(12) << "Not supported yet" << std::endl;
-    ss << "avg   = " << std::setw(12) << "Not supported yet" << std::endl;
+    ss << "init  = " << std::setw(12) << init_memory / 1024.f << std::endl;
+    ss << "peak  = " << std::setw(12) << MemoryProfilePeakBytes() / 1024.f
+       << std::endl;
+    ss << MemoryProfileReport();
   }
   std::cout << ss.str() << std::endl;
   StoreBenchmarkResult(ss.str());
@@ -29,6 +29,10 @@
 #include "lite/utils/log/cp_logging.h"
 #include "lite/utils/model_util.h"
 #include "lite/utils/string.h"
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#include <time.h>
+#endif
 
 namespace paddle {
 namespace lite_api {
@@ -67,6 +71,36 @@ std::string GetDeviceInfo() {
 }
 #endif  // __ANDROID__
 
+// CPU time the process has consumed so far in ms. Called first thing in
+// main it measures the dynamic loading and the static initializers, which
+// register every op and kernel. Returns -1 when it is not available.
+float ProcessCpuTimeMs() {
+#if !defined(_WIN32)
+  struct timespec ts;
+  if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) == 0) {
+    return ts.tv_sec * 1000.f + ts.tv_nsec / 1e6f;
+  }
+#endif
+  return -1.f;
+}
+
+// Peak resident set size of the process so far in kB. Read right after the
+// predictor is created it is the memory high-water mark of model loading.
+// Returns -1 when it is not available.
+float PeakRssKb() {
+#if !defined(_WIN32)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024.f;  // bytes on macOS
+#else
+    return static_cast<float>(usage.ru_maxrss);
+#endif
+  }
+#endif
+  return -1.f;
+}
+
 void StoreBenchmarkResult(const std::string res) {
   if (!FLAGS_result_path.empty()) {
     std::ofstream fs(FLAGS_result_path, std::ios::app);
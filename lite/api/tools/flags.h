@@ -88,14 +88,12 @@ static const char opencl_tune_mode_msg[] =
 static const char enable_op_time_profile_msg[] =
     "Whether to run with op time profiling. Not supported yet";
 static const char enable_memory_profile_msg[] =
-    "Whether to report the memory usage by periodically "
-    "checking the memory footprint. Internally, a separate thread "
-    " will be spawned for this periodic check. Therefore, "
-    "the performance benchmark result could be affected. Not supported yet.";
+    "Whether to report the memory usage. Every allocation is accounted by "
+    "tag (weight, activation, workspace) and by the op that was running, "
+    "and the live set at the peak is reported.";
 static const char memory_check_interval_ms_msg[] =
-    "The interval in millisecond between two consecutive memory "
-    "footprint checks. This is only used when "
-    "--enable_memory_profile is set to true. Not supported yet.";
+    "Deprecated. Memory is accounted on every allocation when "
+    "--enable_memory_profile is set to true, so no periodic check is needed.";
 
 // Others
 
@@ -53,6 +53,8 @@ void OptBase::SetQuantType(const std::string& quant_type) {
     opt_config_.set_quant_type(lite_api::QuantType::QUANT_INT8);
   } else if (quant_type == "QUANT_INT16") {
     opt_config_.set_quant_type(lite_api::QuantType::QUANT_INT16);
+  } else if (quant_type == "QUANT_BF16") {
+    opt_config_.set_quant_type(lite_api::QuantType::QUANT_BF16);
   } else {
     OPT_LOG_FATAL << "Unsupported quant type: " << quant_type;
   }
@@ -390,7 +392,7 @@ void OptBase::PrintExecutableBinHelpInfo() {
       "        `--record_tailoring_info=(true|false)`\n"
       "  Arguments of mode quantization in opt:\n"
       "        `--quant_model=(true|false)`\n"
-      "        `--quant_type=(QUANT_INT8|QUANT_INT16)`\n"
+      "        `--quant_type=(QUANT_INT8|QUANT_INT16|QUANT_BF16)`\n"
       "  Arguements of sparse convolution in opt: \n"
       "        `--sparse_model=(true|false)`\n"
       "        `--sparse_threshold=(float)`\n"
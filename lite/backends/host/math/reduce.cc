@@ -13,226 +13,414 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include "lite/backends/host/math/reduce.h"
-#include "lite/core/tensor.h"
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include "lite/backends/host/parallel.h"
+#include "lite/utils/log/cp_logging.h"
 
 namespace paddle {
 namespace lite {
 namespace host {
 namespace math {
 
-template <typename T, typename Functor>
-void reduce_n(const T* src,
-              T* dst,
-              int num_in,
-              int channel_in,
-              int height_in,
-              int width_in) {
-  int hw_size = height_in * width_in;
-  int chw_size = channel_in * hw_size;
-  int data_index, src_index;
-  Functor functor;
-  for (int c = 0; c < channel_in; ++c) {
-    for (int h = 0; h < height_in; ++h) {
-      for (int w = 0; w < width_in; ++w) {
-        data_index = c * hw_size + h * width_in + w;
-        dst[data_index] = src[data_index];
-        for (int n = 1; n < num_in; ++n) {
-          src_index = n * chw_size + data_index;
-          dst[data_index] = functor(dst[data_index], src[src_index]);
-        }
+namespace {
+
+// Elements a single parallel task should touch at least; smaller reductions
+// run on the calling thread.
+const int64_t kMinTaskSize = 16 * 1024;
+// Number of inner elements reduced together by one task.
+const int64_t kInnerBlock = 1024;
+
+struct SumOp {
+  template <typename T>
+  static inline T Apply(T a, T b) {
+    return a + b;
+  }
+#ifdef __AVX__
+  static inline __m256 Apply(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+#endif
+};
+
+struct ProdOp {
+  template <typename T>
+  static inline T Apply(T a, T b) {
+    return a * b;
+  }
+  static inline bool Apply(bool a, bool b) { return a && b; }
+#ifdef __AVX__
+  static inline __m256 Apply(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+#endif
+};
+
+struct MaxOp {
+  template <typename T>
+  static inline T Apply(T a, T b) {
+    return a > b ? a : b;
+  }
+#ifdef __AVX__
+  static inline __m256 Apply(__m256 a, __m256 b) { return _mm256_max_ps(a, b); }
+#endif
+};
+
+struct MinOp {
+  template <typename T>
+  static inline T Apply(T a, T b) {
+    return a < b ? a : b;
+  }
+#ifdef __AVX__
+  static inline __m256 Apply(__m256 a, __m256 b) { return _mm256_min_ps(a, b); }
+#endif
+};
+
+struct AndOp {
+  template <typename T>
+  static inline T Apply(T a, T b) {
+    return static_cast<T>(a && b);
+  }
+#ifdef __AVX__
+  static inline __m256 Apply(__m256 a, __m256 b) {
+    __m256 vzero = _mm256_setzero_ps();
+    __m256 vmask = _mm256_and_ps(_mm256_cmp_ps(a, vzero, _CMP_NEQ_UQ),
+                                 _mm256_cmp_ps(b, vzero, _CMP_NEQ_UQ));
+    return _mm256_and_ps(vmask, _mm256_set1_ps(1.f));
+  }
+#endif
+};
+
+struct OrOp {
+  template <typename T>
+  static inline T Apply(T a, T b) {
+    return static_cast<T>(a || b);
+  }
+#ifdef __AVX__
+  static inline __m256 Apply(__m256 a, __m256 b) {
+    __m256 vzero = _mm256_setzero_ps();
+    __m256 vmask = _mm256_or_ps(_mm256_cmp_ps(a, vzero, _CMP_NEQ_UQ),
+                                _mm256_cmp_ps(b, vzero, _CMP_NEQ_UQ));
+    return _mm256_and_ps(vmask, _mm256_set1_ps(1.f));
+  }
+#endif
+};
+
+// Splits [0, work) into tasks of at least kMinTaskSize elements, where every
+// work item touches `cost` elements.
+void parallel_for(int64_t work,
+                  int64_t cost,
+                  const std::function<void(int64_t, int64_t)>& func) {
+  int64_t grain =
+      std::max<int64_t>(1, kMinTaskSize / std::max<int64_t>(cost, 1));
+  RunParallelFor(0, work, grain, func);
+}
+
+template <typename T, typename Op>
+struct ReduceBlock {
+  // Reduces `reduce` contiguous elements.
+  static T Row(const T* src, int64_t reduce) {
+    T res = src[0];
+    for (int64_t r = 1; r < reduce; ++r) {
+      res = Op::Apply(res, src[r]);
+    }
+    return res;
+  }
+
+  // dst[i] = op over r of src[r * stride + i], for i in [0, len).
+  static void Cols(
+      const T* src, T* dst, int64_t reduce, int64_t stride, int64_t len) {
+    std::memcpy(dst, src, len * sizeof(T));
+    for (int64_t r = 1; r < reduce; ++r) {
+      const T* src_r = src + r * stride;
+      for (int64_t i = 0; i < len; ++i) {
+        dst[i] = Op::Apply(dst[i], src_r[i]);
       }
     }
   }
-}
+};
 
-template <typename T, typename Functor>
-void reduce_c(const T* src,
-              T* dst,
-              int num_in,
-              int channel_in,
-              int height_in,
-              int width_in) {
-  int hw_size = height_in * width_in;
-  int chw_size = hw_size * channel_in;
-  int data_index, src_index0, src_index;
-  Functor functor;
-  for (int n = 0; n < num_in; ++n) {
-    for (int h = 0; h < height_in; ++h) {
-      for (int w = 0; w < width_in; ++w) {
-        data_index = n * hw_size + h * width_in + w;
-        src_index0 = n * chw_size + h * width_in + w;
-        dst[data_index] = src[src_index0];
-        for (int c = 1; c < channel_in; ++c) {
-          src_index = src_index0 + c * hw_size;
-          dst[data_index] = functor(dst[data_index], src[src_index]);
-        }
+#ifdef __AVX__
+template <typename Op>
+struct ReduceBlock<float, Op> {
+  static float Row(const float* src, int64_t reduce) {
+    int64_t r = 0;
+    float res = src[0];
+    if (reduce >= 16) {
+      __m256 vacc0 = _mm256_loadu_ps(src);
+      __m256 vacc1 = _mm256_loadu_ps(src + 8);
+      for (r = 16; r + 16 <= reduce; r += 16) {
+        vacc0 = Op::Apply(vacc0, _mm256_loadu_ps(src + r));
+        vacc1 = Op::Apply(vacc1, _mm256_loadu_ps(src + r + 8));
       }
+      float lanes[8];
+      _mm256_storeu_ps(lanes, Op::Apply(vacc0, vacc1));
+      res = lanes[0];
+      for (int k = 1; k < 8; ++k) {
+        res = Op::Apply(res, lanes[k]);
+      }
+    } else {
+      r = 1;
+    }
+    for (; r < reduce; ++r) {
+      res = Op::Apply(res, src[r]);
     }
+    return res;
   }
-}
 
-template <typename T, typename Functor>
-void reduce_h(const T* src,
-              T* dst,
-              int num_in,
-              int channel_in,
-              int height_in,
-              int width_in) {
-  int cw_size = channel_in * width_in;
-  int chw_size = cw_size * height_in;
-  int hw_size = height_in * width_in;
-  int data_index, src_index, src_index0;
-  Functor functor;
-  for (int n = 0; n < num_in; ++n) {
-    for (int c = 0; c < channel_in; ++c) {
-      for (int w = 0; w < width_in; ++w) {
-        data_index = n * cw_size + c * width_in + w;
-        src_index0 = n * chw_size + c * hw_size + w;
-        dst[data_index] = src[src_index0];
-        for (int h = 1; h < height_in; ++h) {
-          src_index = src_index0 + h * width_in;
-          dst[data_index] = functor(dst[data_index], src[src_index]);
-        }
+  // Keeps 32 columns in registers while walking the reduced axis.
+  static void Cols(const float* src,
+                   float* dst,
+                   int64_t reduce,
+                   int64_t stride,
+                   int64_t len) {
+    int64_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+      const float* src_i = src + i;
+      __m256 vacc0 = _mm256_loadu_ps(src_i);
+      __m256 vacc1 = _mm256_loadu_ps(src_i + 8);
+      __m256 vacc2 = _mm256_loadu_ps(src_i + 16);
+      __m256 vacc3 = _mm256_loadu_ps(src_i + 24);
+      for (int64_t r = 1; r < reduce; ++r) {
+        const float* src_r = src_i + r * stride;
+        vacc0 = Op::Apply(vacc0, _mm256_loadu_ps(src_r));
+        vacc1 = Op::Apply(vacc1, _mm256_loadu_ps(src_r + 8));
+        vacc2 = Op::Apply(vacc2, _mm256_loadu_ps(src_r + 16));
+        vacc3 = Op::Apply(vacc3, _mm256_loadu_ps(src_r + 24));
+      }
+      _mm256_storeu_ps(dst + i, vacc0);
+      _mm256_storeu_ps(dst + i + 8, vacc1);
+      _mm256_storeu_ps(dst + i + 16, vacc2);
+      _mm256_storeu_ps(dst + i + 24, vacc3);
+    }
+    for (; i + 8 <= len; i += 8) {
+      __m256 vacc = _mm256_loadu_ps(src + i);
+      for (int64_t r = 1; r < reduce; ++r) {
+        vacc = Op::Apply(vacc, _mm256_loadu_ps(src + r * stride + i));
+      }
+      _mm256_storeu_ps(dst + i, vacc);
+    }
+    for (; i < len; ++i) {
+      float res = src[i];
+      for (int64_t r = 1; r < reduce; ++r) {
+        res = Op::Apply(res, src[r * stride + i]);
       }
+      dst[i] = res;
     }
   }
+};
+#endif
+
+template <typename T, typename Op>
+void reduce_pass(
+    const T* src, T* dst, int64_t outer, int64_t reduce, int64_t inner) {
+  if (inner == 1) {
+    parallel_for(outer, reduce, [&](int64_t begin, int64_t end) {
+      for (int64_t o = begin; o < end; ++o) {
+        dst[o] = ReduceBlock<T, Op>::Row(src + o * reduce, reduce);
+      }
+    });
+    return;
+  }
+  int64_t blocks = (inner + kInnerBlock - 1) / kInnerBlock;
+  int64_t cost = reduce * std::min(inner, kInnerBlock);
+  parallel_for(outer * blocks, cost, [&](int64_t begin, int64_t end) {
+    for (int64_t t = begin; t < end; ++t) {
+      int64_t o = t / blocks;
+      int64_t i = (t % blocks) * kInnerBlock;
+      int64_t len = std::min(kInnerBlock, inner - i);
+      ReduceBlock<T, Op>::Cols(src + o * reduce * inner + i,
+                               dst + o * inner + i,
+                               reduce,
+                               inner,
+                               len);
+    }
+  });
 }
 
-template <typename T, typename Functor>
-void reduce_w(const T* src,
-              T* dst,
-              int num_in,
-              int channel_in,
-              int height_in,
-              int width_in) {
-  int ch_size = channel_in * height_in;
-  int hw_size = height_in * width_in;
-  int chw_size = ch_size * width_in;
-  int data_index = 0;
-  int src_index0 = 0;
-  int src_index = 0;
-  Functor functor;
-  for (int n = 0; n < num_in; ++n) {
-    for (int c = 0; c < channel_in; ++c) {
-      for (int h = 0; h < height_in; ++h) {
-        data_index = n * ch_size + c * height_in + h;
-        src_index0 = n * chw_size + c * hw_size + h * width_in;
-        dst[data_index] = src[src_index0];
-        for (int w = 0; w < width_in; ++w) {
-          src_index = src_index0 + w;
-          dst[data_index] = functor(dst[data_index], src[src_index]);
-        }
+// log(sum(exp(x))) computed as max + log(sum(exp(x - max))).
+template <typename T>
+void logsumexp_pass(
+    const T* src, T* dst, int64_t outer, int64_t reduce, int64_t inner) {
+  reduce_pass<T, MaxOp>(src, dst, outer, reduce, inner);
+  parallel_for(outer * inner, reduce, [&](int64_t begin, int64_t end) {
+    for (int64_t t = begin; t < end; ++t) {
+      double max_val = static_cast<double>(dst[t]);
+      if (std::isinf(max_val)) {
+        continue;
       }
+      const T* src_t = src + (t / inner) * reduce * inner + t % inner;
+      double sum = 0.;
+      for (int64_t r = 0; r < reduce; ++r) {
+        sum += std::exp(static_cast<double>(src_t[r * inner]) - max_val);
+      }
+      dst[t] = static_cast<T>(max_val + std::log(sum));
     }
-  }
+  });
 }
 
-template <typename T, typename Functor>
-void reduce_nc(const T* src,
-               T* dst,
-               int num_in,
-               int channel_in,
-               int height_in,
-               int width_in) {
-  // reduce n first.
-  DDimLite ddimA({1, channel_in, height_in, width_in});
-  lite::Tensor tensor_tmp;
-  tensor_tmp.Resize(ddimA);
-  T* tmp_out = tensor_tmp.mutable_data<T>();
-  reduce_n<T, Functor>(src, tmp_out, num_in, channel_in, height_in, width_in);
-  reduce_c<T, Functor>(tmp_out, dst, 1, channel_in, height_in, width_in);
+template <typename T>
+void scale_by_count(T* dst, int64_t num, int64_t count) {
+  for (int64_t i = 0; i < num; ++i) {
+    dst[i] = static_cast<T>(dst[i] / static_cast<T>(count));
+  }
 }
 
-template <typename T, typename Functor>
-void reduce_ch(const T* src,
-               T* dst,
-               int num_in,
-               int channel_in,
-               int height_in,
-               int width_in) {
-  // reduce c first
-  DDimLite ddimA({num_in, 1, height_in, width_in});
-  lite::Tensor tensor_tmp;
-  tensor_tmp.Resize(ddimA);
-  T* tmp_out = tensor_tmp.mutable_data<T>();
-  reduce_c<T, Functor>(src, tmp_out, num_in, channel_in, height_in, width_in);
-  reduce_h<T, Functor>(tmp_out, dst, num_in, 1, height_in, width_in);
+template <>
+void scale_by_count<float>(float* dst, int64_t num, int64_t count) {
+  float scale = 1.f / static_cast<float>(count);
+  for (int64_t i = 0; i < num; ++i) {
+    dst[i] *= scale;
+  }
 }
 
-template <typename T, typename Functor>
-void reduce_hw(const T* src,
-               T* dst,
-               int num_in,
-               int channel_in,
-               int height_in,
-               int width_in) {
-  // reduce h first
-  DDimLite ddimA({num_in, channel_in, 1, width_in});
-  lite::Tensor tensor_tmp;
-  tensor_tmp.Resize(ddimA);
-  T* tmp_out = tensor_tmp.mutable_data<T>();
-  reduce_h<T, Functor>(src, tmp_out, num_in, channel_in, height_in, width_in);
-  reduce_w<T, Functor>(tmp_out, dst, num_in, channel_in, 1, width_in);
+}  // namespace
+
+template <typename T>
+void reduce_outer_inner(const T* src,
+                        T* dst,
+                        int64_t outer,
+                        int64_t reduce,
+                        int64_t inner,
+                        ReduceType type) {
+  switch (type) {
+    case ReduceType::kSum:
+      reduce_pass<T, SumOp>(src, dst, outer, reduce, inner);
+      break;
+    case ReduceType::kMean:
+      reduce_pass<T, SumOp>(src, dst, outer, reduce, inner);
+      scale_by_count(dst, outer * inner, reduce);
+      break;
+    case ReduceType::kMax:
+      reduce_pass<T, MaxOp>(src, dst, outer, reduce, inner);
+      break;
+    case ReduceType::kMin:
+      reduce_pass<T, MinOp>(src, dst, outer, reduce, inner);
+      break;
+    case ReduceType::kProd:
+      reduce_pass<T, ProdOp>(src, dst, outer, reduce, inner);
+      break;
+    case ReduceType::kAll:
+      reduce_pass<T, AndOp>(src, dst, outer, reduce, inner);
+      break;
+    case ReduceType::kAny:
+      reduce_pass<T, OrOp>(src, dst, outer, reduce, inner);
+      break;
+    case ReduceType::kLogSumExp:
+      logsumexp_pass<T>(src, dst, outer, reduce, inner);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported reduce type: " << static_cast<int>(type);
+  }
 }
 
-template <typename T, typename Functor>
-void reduce_all(const T* src, T* dst, int num_all) {
-  dst[0] = src[0];
-  Functor functor;
-  for (int i = 1; i < num_all; i++) {
-    dst[0] = functor(dst[0], src[i]);
+template <typename T>
+void reduce_axes(const T* src,
+                 T* dst,
+                 const std::vector<int64_t>& x_dims,
+                 const std::vector<int>& dims,
+                 ReduceType type) {
+  const int rank = static_cast<int>(x_dims.size());
+  std::vector<bool> reduced(rank, dims.empty());
+  for (int dim : dims) {
+    int axis = dim < 0 ? dim + rank : dim;
+    CHECK(axis >= 0 && axis < rank) << "Invalid reduce axis " << dim
+                                    << " for a tensor of rank " << rank;
+    reduced[axis] = true;
+  }
+
+  // Drop unit axes and merge neighbours with the same role, e.g. reducing
+  // {1, 2} of [N, C, H, W] becomes a single [N, C * H, W] pass.
+  std::vector<int64_t> sizes;
+  std::vector<bool> roles;
+  int64_t out_num = 1;
+  int64_t count = 1;
+  for (int i = 0; i < rank; ++i) {
+    if (reduced[i]) {
+      count *= x_dims[i];
+    } else {
+      out_num *= x_dims[i];
+    }
+    if (x_dims[i] == 1) {
+      continue;
+    }
+    if (!sizes.empty() && roles.back() == reduced[i]) {
+      sizes.back() *= x_dims[i];
+    } else {
+      sizes.push_back(x_dims[i]);
+      roles.push_back(reduced[i]);
+    }
+  }
+  if (out_num == 0) {
+    return;
+  }
+  if (count == 0) {
+    std::fill(dst, dst + out_num, static_cast<T>(0));
+    return;
+  }
+
+  // Each pass reduces the largest remaining group, which shrinks the
+  // intermediate buffer fastest.
+  ReduceType pass_type = type == ReduceType::kMean ? ReduceType::kSum : type;
+  int groups = static_cast<int>(std::count(roles.begin(), roles.end(), true));
+  if (groups == 0) {
+    std::memcpy(dst, src, out_num * sizeof(T));
+  }
+  std::unique_ptr<T[]> buffers[2];
+  const T* in = src;
+  for (int pass = 0; groups > 0; ++pass, --groups) {
+    int k = -1;
+    for (int i = 0; i < static_cast<int>(sizes.size()); ++i) {
+      if (roles[i] && (k < 0 || sizes[i] > sizes[k])) {
+        k = i;
+      }
+    }
+    int64_t outer = 1;
+    int64_t inner = 1;
+    for (int i = 0; i < k; ++i) {
+      outer *= sizes[i];
+    }
+    for (int i = k + 1; i < static_cast<int>(sizes.size()); ++i) {
+      inner *= sizes[i];
+    }
+    T* out = dst;
+    if (groups > 1) {
+      buffers[pass % 2].reset(new T[outer * inner]);
+      out = buffers[pass % 2].get();
+    }
+    reduce_outer_inner(in, out, outer, sizes[k], inner, pass_type);
+    in = out;
+
+    sizes.erase(sizes.begin() + k);
+    roles.erase(roles.begin() + k);
+    if (k > 0 && k < static_cast<int>(sizes.size()) &&
+        roles[k - 1] == roles[k]) {
+      sizes[k - 1] *= sizes[k];
+      sizes.erase(sizes.begin() + k);
+      roles.erase(roles.begin() + k);
+    }
+  }
+  if (type == ReduceType::kMean) {
+    scale_by_count(dst, out_num, count);
   }
 }
 
-#define ReduceFuncs(DTYPE, FUNC)                         \
-  template void reduce_n<DTYPE, FUNC>(const DTYPE* src,  \
-                                      DTYPE* dst,        \
-                                      int num_in,        \
-                                      int channel_in,    \
-                                      int height_in,     \
-                                      int width_in);     \
-  template void reduce_c<DTYPE, FUNC>(const DTYPE* src,  \
-                                      DTYPE* dst,        \
-                                      int num_in,        \
-                                      int channel_in,    \
-                                      int height_in,     \
-                                      int width_in);     \
-  template void reduce_h<DTYPE, FUNC>(const DTYPE* src,  \
-                                      DTYPE* dst,        \
-                                      int num_in,        \
-                                      int channel_in,    \
-                                      int height_in,     \
-                                      int width_in);     \
-  template void reduce_w<DTYPE, FUNC>(const DTYPE* src,  \
-                                      DTYPE* dst,        \
-                                      int num_in,        \
-                                      int channel_in,    \
-                                      int height_in,     \
-                                      int width_in);     \
-  template void reduce_nc<DTYPE, FUNC>(const DTYPE* src, \
-                                       DTYPE* dst,       \
-                                       int num_in,       \
-                                       int channel_in,   \
-                                       int height_in,    \
-                                       int width_in);    \
-  template void reduce_ch<DTYPE, FUNC>(const DTYPE* src, \
-                                       DTYPE* dst,       \
-                                       int num_in,       \
-                                       int channel_in,   \
-                                       int height_in,    \
-                                       int width_in);    \
-  template void reduce_hw<DTYPE, FUNC>(const DTYPE* src, \
-                                       DTYPE* dst,       \
-                                       int num_in,       \
-                                       int channel_in,   \
-                                       int height_in,    \
-                                       int width_in);    \
-  template void reduce_all<DTYPE, FUNC>(                 \
-      const DTYPE* src, DTYPE* dst, int num_all);
-
-ReduceFuncs(bool, LogicalAnd);
-ReduceFuncs(bool, LogicalOr);
-#undef ReduceFuncs
+#define INSTANTIATE_REDUCE(T)                               \
+  template void reduce_axes<T>(const T*,                    \
+                               T*,                          \
+                               const std::vector<int64_t>&, \
+                               const std::vector<int>&,     \
+                               ReduceType);                 \
+  template void reduce_outer_inner<T>(                      \
+      const T*, T*, int64_t, int64_t, int64_t, ReduceType);
+
+INSTANTIATE_REDUCE(float);
+INSTANTIATE_REDUCE(int);
+INSTANTIATE_REDUCE(int64_t);
+INSTANTIATE_REDUCE(bool);
+#undef INSTANTIATE_REDUCE
 
 }  // namespace math
 }  // namespace host
@@ -14,77 +14,48 @@ limitations under the License. */
 
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 namespace paddle {
 namespace lite {
 namespace host {
 namespace math {
 
-struct LogicalAnd {
-  inline bool operator()(const bool a, const bool b) { return a && b; }
-};
-
-struct LogicalOr {
-  inline bool operator()(const bool a, const bool b) { return a || b; }
+enum class ReduceType {
+  kSum = 0,
+  kMean,
+  kMax,
+  kMin,
+  kProd,
+  kAll,
+  kAny,
+  kLogSumExp,
 };
 
-template <typename T, typename Functor>
-void reduce_n(const T* src,
-              T* dst,
-              int num_in,
-              int channel_in,
-              int height_in,
-              int width_in);
-
-template <typename T, typename Functor>
-void reduce_c(const T* src,
-              T* dst,
-              int num_in,
-              int channel_in,
-              int height_in,
-              int width_in);
-
-template <typename T, typename Functor>
-void reduce_h(const T* src,
-              T* dst,
-              int num_in,
-              int channel_in,
-              int height_in,
-              int width_in);
-
-template <typename T, typename Functor>
-void reduce_w(const T* src,
-              T* dst,
-              int num_in,
-              int channel_in,
-              int height_in,
-              int width_in);
-
-template <typename T, typename Functor>
-void reduce_nc(const T* src,
-               T* dst,
-               int num_in,
-               int channel_in,
-               int height_in,
-               int width_in);
-
-template <typename T, typename Functor>
-void reduce_ch(const T* src,
-               T* dst,
-               int num_in,
-               int channel_in,
-               int height_in,
-               int width_in);
-
-template <typename T, typename Functor>
-void reduce_hw(const T* src,
-               T* dst,
-               int num_in,
-               int channel_in,
-               int height_in,
-               int width_in);
-
-template <typename T, typename Functor>
-void reduce_all(const T* src, T* dst, int num_all);
+/* Reduce `src` of shape `x_dims` over the axes in `dims` and write the result
+ * to `dst` in row-major order of the remaining axes. Negative axes count from
+ * the back and an empty `dims` reduces over all axes.
+ *
+ * Adjacent axes with the same role are merged first, so any axis set becomes
+ * a short sequence of (outer, reduce, inner) passes. Each pass vectorizes the
+ * inner dimension and runs the outer blocks in parallel.
+ */
+template <typename T>
+void reduce_axes(const T* src,
+                 T* dst,
+                 const std::vector<int64_t>& x_dims,
+                 const std::vector<int>& dims,
+                 ReduceType type);
+
+/* One (outer, reduce, inner) pass: dst[o][i] = op_r(src[o][r][i]). */
+template <typename T>
+void reduce_outer_inner(const T* src,
+                        T* dst,
+                        int64_t outer,
+                        int64_t reduce,
+                        int64_t inner,
+                        ReduceType type);
 
 }  // namespace math
 }  // namespace host
@@ -0,0 +1,183 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/backends/host/math/reduce.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// Walks every element of |x| and folds it into its output element.
+static std::vector<double> reduce_ref(const std::vector<float>& x,
+                                      const std::vector<int64_t>& x_dims,
+                                      const std::vector<int>& dims,
+                                      ReduceType type) {
+  const int rank = x_dims.size();
+  std::vector<bool> reduced(rank, dims.empty());
+  for (int dim : dims) {
+    reduced[dim < 0 ? dim + rank : dim] = true;
+  }
+  int64_t out_num = 1;
+  int64_t count = 1;
+  for (int i = 0; i < rank; ++i) {
+    (reduced[i] ? count : out_num) *= x_dims[i];
+  }
+  auto out_index = [&](int64_t index) {
+    int64_t out = 0;
+    int64_t stride = 1;
+    for (int i = rank - 1; i >= 0; --i) {
+      int64_t idx = index % x_dims[i];
+      index /= x_dims[i];
+      if (!reduced[i]) {
+        out += idx * stride;
+        stride *= x_dims[i];
+      }
+    }
+    return out;
+  };
+
+  std::vector<double> max(out_num, -std::numeric_limits<double>::infinity());
+  std::vector<double> out(out_num);
+  switch (type) {
+    case ReduceType::kMax:
+      std::fill(out.begin(), out.end(), -1e30);
+      break;
+    case ReduceType::kMin:
+      std::fill(out.begin(), out.end(), 1e30);
+      break;
+    case ReduceType::kProd:
+      std::fill(out.begin(), out.end(), 1.);
+      break;
+    default:
+      break;
+  }
+  for (size_t i = 0; i < x.size(); ++i) {
+    int64_t o = out_index(i);
+    max[o] = std::max(max[o], static_cast<double>(x[i]));
+  }
+  for (size_t i = 0; i < x.size(); ++i) {
+    int64_t o = out_index(i);
+    double v = x[i];
+    switch (type) {
+      case ReduceType::kSum:
+      case ReduceType::kMean:
+        out[o] += v;
+        break;
+      case ReduceType::kMax:
+        out[o] = std::max(out[o], v);
+        break;
+      case ReduceType::kMin:
+        out[o] = std::min(out[o], v);
+        break;
+      case ReduceType::kProd:
+        out[o] *= v;
+        break;
+      case ReduceType::kLogSumExp:
+        out[o] += std::exp(v - max[o]);
+        break;
+      default:
+        break;
+    }
+  }
+  for (int64_t o = 0; o < out_num; ++o) {
+    if (type == ReduceType::kMean) {
+      out[o] /= count;
+    } else if (type == ReduceType::kLogSumExp) {
+      out[o] = max[o] + std::log(out[o]);
+    }
+  }
+  return out;
+}
+
+static void check_reduce(const std::vector<int64_t>& x_dims,
+                         const std::vector<int>& dims,
+                         ReduceType type) {
+  int64_t num = 1;
+  for (auto d : x_dims) {
+    num *= d;
+  }
+  std::vector<float> x(num);
+  for (int64_t i = 0; i < num; ++i) {
+    // Close to 1 so that products stay finite.
+    x[i] = type == ReduceType::kProd ? 1.f + ((i * 7) % 13 - 6) * 1e-3f
+                                     : ((i * 37) % 101) / 10.f - 5.f;
+  }
+  auto ref = reduce_ref(x, x_dims, dims, type);
+  std::vector<float> out(ref.size());
+  reduce_axes(x.data(), out.data(), x_dims, dims, type);
+  for (size_t i = 0; i < ref.size(); ++i) {
+    ASSERT_NEAR(out[i], ref[i], 1e-4 * std::max(1., std::abs(ref[i])))
+        << "type " << static_cast<int>(type) << ", element " << i;
+  }
+}
+
+TEST(reduce_host, axes) {
+  const std::vector<ReduceType> types = {ReduceType::kSum,
+                                         ReduceType::kMean,
+                                         ReduceType::kMax,
+                                         ReduceType::kMin,
+                                         ReduceType::kProd,
+                                         ReduceType::kLogSumExp};
+  const std::vector<std::vector<int>> axes = {
+      {0, 2}, {1, 3}, {0, 3}, {-1}, {-3, -1}, {-4, 1}, {2}, {}};
+  for (auto type : types) {
+    for (auto& dims : axes) {
+      check_reduce({2, 3, 4, 5}, dims, type);
+      // Large enough to be split across threads.
+      check_reduce({8, 67, 9, 40}, dims, type);
+      // Unit axes are dropped before merging.
+      check_reduce({3, 1, 17, 1}, dims, type);
+    }
+  }
+}
+
+TEST(reduce_host, bool) {
+  std::vector<int64_t> x_dims = {3, 4, 5};
+  std::vector<char> x(60);
+  for (int i = 0; i < 60; ++i) {
+    x[i] = i % 7 != 0;
+  }
+  const bool* src = reinterpret_cast<const bool*>(x.data());
+  bool all[4];
+  bool any[4];
+  bool prod[4];
+  reduce_axes(src, all, x_dims, {0, -1}, ReduceType::kAll);
+  reduce_axes(src, any, x_dims, {0, -1}, ReduceType::kAny);
+  reduce_axes(src, prod, x_dims, {0, -1}, ReduceType::kProd);
+  for (int j = 0; j < 4; ++j) {
+    bool ref_all = true;
+    bool ref_any = false;
+    for (int i = 0; i < 3; ++i) {
+      for (int k = 0; k < 5; ++k) {
+        ref_all = ref_all && x[(i * 4 + j) * 5 + k];
+        ref_any = ref_any || x[(i * 4 + j) * 5 + k];
+      }
+    }
+    EXPECT_EQ(all[j], ref_all);
+    EXPECT_EQ(any[j], ref_any);
+    EXPECT_EQ(prod[j], ref_all);
+  }
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,55 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include "lite/core/parallel_defines.h"
+#if defined(LITE_WITH_X86) && !defined(LITE_USE_THREAD_POOL)
+#include "lite/backends/x86/parallel.h"
+#endif
+
+namespace paddle {
+namespace lite {
+namespace host {
+
+// Runs f(b, e) over [begin, end) split into ranges of at least |grain|
+// iterations. The x86 build hands it to the OpenMP pool that the x86
+// kernels share, the others to LITE_PARALLEL.
+inline void RunParallelFor(int64_t begin,
+                           int64_t end,
+                           int64_t grain,
+                           const std::function<void(int64_t, int64_t)>& f) {
+  grain = (std::max<int64_t>)(grain, 1);
+  if (end - begin <= grain) {
+    f(begin, end);
+    return;
+  }
+#if defined(LITE_WITH_X86) && !defined(LITE_USE_THREAD_POOL)
+  lite::x86::RunParallelFor(begin, end, grain, f);
+#else
+  int tasks = static_cast<int>((end - begin + grain - 1) / grain);
+  LITE_PARALLEL_BEGIN(t, tid, tasks) {
+    int64_t b = begin + t * grain;
+    f(b, (std::min)(end, b + grain));
+  }
+  LITE_PARALLEL_END();
+#endif
+}
+
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
@@ -30,7 +30,31 @@
 #include <unistd.h>
 #endif  // _WIN32
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+#define LITE_X86_CPUID
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
 #include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>  // NOLINT
+#include <tuple>
 #include "lite/utils/log/cp_logging.h"
 
 #include "lite/utils/env.h"
@@ -167,6 +191,294 @@ bool MayIUse(const cpu_isa_t cpu_isa) {
 }
 #endif
 
+namespace {
+
+#ifdef __linux__
+// Read the first token of a sysfs file, empty if it does not exist.
+std::string ReadSysfs(const std::string& path) {
+  std::ifstream file(path);
+  std::string value;
+  if (file.is_open()) file >> value;
+  return value;
+}
+
+int ReadSysfsInt(const std::string& path, int fallback) {
+  std::string value = ReadSysfs(path);
+  return value.empty() ? fallback : std::atoi(value.c_str());
+}
+
+size_t SysfsCacheSize(int level) {
+  const std::string dir = "/sys/devices/system/cpu/cpu0/cache/index";
+  for (int i = 0;; ++i) {
+    const std::string index = dir + std::to_string(i);
+    const std::string type = ReadSysfs(index + "/type");
+    if (type.empty()) break;
+    if (type == "Instruction") continue;
+    if (ReadSysfsInt(index + "/level", 0) == level) {
+      return ParseCacheSize(ReadSysfs(index + "/size"));
+    }
+  }
+  return 0;
+}
+#endif  // __linux__
+
+#ifdef LITE_X86_CPUID
+void Cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#if defined(_MSC_VER)
+  int r[4];
+  __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+  for (int i = 0; i < 4; ++i) regs[i] = static_cast<uint32_t>(r[i]);
+#else
+  __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Walk the deterministic cache parameters, leaf 0x4 on Intel and
+// 0x8000001d on AMD, which share the same layout.
+size_t CpuidCacheSize(int level) {
+  uint32_t regs[4];
+  for (uint32_t leaf : {0x4u, 0x8000001du}) {
+    Cpuid(leaf & 0x80000000u, 0, regs);
+    if (regs[0] < leaf) continue;
+    for (uint32_t i = 0; i < 16; ++i) {
+      Cpuid(leaf, i, regs);
+      uint32_t type = regs[0] & 0x1f;
+      if (type == 0) break;
+      if (type == 2) continue;  // instruction cache
+      if (((regs[0] >> 5) & 0x7) != static_cast<uint32_t>(level)) continue;
+      size_t ways = ((regs[1] >> 22) & 0x3ff) + 1;
+      size_t partitions = ((regs[1] >> 12) & 0x3ff) + 1;
+      size_t line = (regs[1] & 0xfff) + 1;
+      size_t sets = static_cast<size_t>(regs[2]) + 1;
+      return ways * partitions * line * sets;
+    }
+  }
+  return 0;
+}
+#endif  // LITE_X86_CPUID
+
+size_t CacheSize(int level) {
+  size_t size = 0;
+#if defined(__APPLE__)
+  const char* names[] = {"hw.l1dcachesize", "hw.l2cachesize", "hw.l3cachesize"};
+  int64_t value = 0;
+  size_t len = sizeof(value);
+  if (sysctlbyname(names[level - 1], &value, &len, NULL, 0) == 0) {
+    size = static_cast<size_t>(value);
+  }
+#elif defined(__linux__)
+  size = SysfsCacheSize(level);
+#endif
+#ifdef LITE_X86_CPUID
+  if (size == 0) size = CpuidCacheSize(level);
+#endif
+  return size;
+}
+
+CpuTopology ProbeCpuTopology() {
+  CpuTopology topology;
+#ifdef __linux__
+  std::map<int, int> node_of_cpu;
+  for (int node : ParseIdList(ReadSysfs("/sys/devices/system/node/online"))) {
+    const std::string list = ReadSysfs("/sys/devices/system/node/node" +
+                                       std::to_string(node) + "/cpulist");
+    for (int cpu : ParseIdList(list)) node_of_cpu[cpu] = node;
+  }
+  // Only the cpus the process is allowed to run on, e.g. in a container.
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  bool has_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+  std::map<std::pair<int, int>, int> core_index;
+  for (int cpu : ParseIdList(ReadSysfs("/sys/devices/system/cpu/online"))) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) continue;
+    if (has_mask && !CPU_ISSET(cpu, &allowed)) continue;
+    const std::string dir =
+        "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+    int socket = ReadSysfsInt(dir + "physical_package_id", 0);
+    int core_id = ReadSysfsInt(dir + "core_id", cpu);
+    auto core = core_index.emplace(std::make_pair(socket, core_id),
+                                   core_index.size());
+    auto node = node_of_cpu.find(cpu);
+    topology.cpus.push_back({cpu,
+                             core.first->second,
+                             socket,
+                             node == node_of_cpu.end() ? 0 : node->second});
+  }
+#endif  // __linux__
+  if (topology.cpus.empty()) {
+    int num_cpus =
+        (std::max)(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    for (int cpu = 0; cpu < num_cpus; ++cpu) {
+      topology.cpus.push_back({cpu, cpu, 0, 0});
+    }
+  }
+  std::set<int> cores, sockets, nodes;
+  for (const auto& cpu : topology.cpus) {
+    cores.insert(cpu.core);
+    sockets.insert(cpu.socket);
+    nodes.insert(cpu.node);
+  }
+  topology.num_cores = cores.size();
+  topology.num_sockets = sockets.size();
+  topology.num_nodes = nodes.size();
+  VLOG(3) << "x86 topology: " << topology.cpus.size() << " logical cpus, "
+          << topology.num_cores << " cores, " << topology.num_sockets
+          << " sockets, " << topology.num_nodes << " numa nodes";
+  return topology;
+}
+
+}  // namespace
+
+std::vector<int> ParseIdList(const std::string& list) {
+  std::vector<int> ids;
+  std::stringstream ss(list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    if (range.empty()) continue;
+    auto dash = range.find('-');
+    int first = std::atoi(range.substr(0, dash).c_str());
+    int last = dash == std::string::npos
+                   ? first
+                   : std::atoi(range.substr(dash + 1).c_str());
+    for (int id = first; id <= last; ++id) ids.push_back(id);
+  }
+  return ids;
+}
+
+size_t ParseCacheSize(const std::string& size) {
+  if (size.empty()) return 0;
+  size_t value = std::strtoull(size.c_str(), nullptr, 10);
+  switch (size.back()) {
+    case 'K':
+      return value << 10;
+    case 'M':
+      return value << 20;
+    case 'G':
+      return value << 30;
+    default:
+      return value;
+  }
+}
+
+std::string CpuModelName() {
+  static std::string name = [] {
+    std::string brand;
+#ifdef LITE_X86_CPUID
+    // The brand string is spread over the eax..edx of three extended leaves.
+    uint32_t regs[4];
+    Cpuid(0x80000000u, 0, regs);
+    if (regs[0] >= 0x80000004u) {
+      char text[49] = {0};
+      for (uint32_t i = 0; i < 3; ++i) {
+        Cpuid(0x80000002u + i, 0, regs);
+        std::memcpy(text + 16 * i, regs, sizeof(regs));
+      }
+      brand = text;
+    }
+#endif
+    auto begin = brand.find_first_not_of(' ');
+    if (begin == std::string::npos) return std::string("unknown");
+    return brand.substr(begin, brand.find_last_not_of(' ') - begin + 1);
+  }();
+  return name;
+}
+
+size_t CpuL1CacheSize() {
+  static size_t size = CacheSize(1);
+  return size;
+}
+
+size_t CpuL2CacheSize() {
+  static size_t size = CacheSize(2);
+  return size;
+}
+
+size_t CpuL3CacheSize() {
+  static size_t size = CacheSize(3);
+  return size;
+}
+
+const CpuTopology& GetCpuTopology() {
+  static CpuTopology topology = ProbeCpuTopology();
+  return topology;
+}
+
+std::vector<int> CpuBindOrder(lite_api::X86BindPolicy policy) {
+  return CpuBindOrder(GetCpuTopology(), policy);
+}
+
+std::vector<int> CpuBindOrder(const CpuTopology& topology,
+                              lite_api::X86BindPolicy policy) {
+  std::vector<int> order;
+  if (policy == lite_api::X86_BIND_NONE) return order;
+  // Sorted by socket and core, the SMT siblings of a core are adjacent.
+  auto cpus = topology.cpus;
+  std::stable_sort(cpus.begin(),
+                   cpus.end(),
+                   [](const CpuTopology::LogicalCpu& a,
+                      const CpuTopology::LogicalCpu& b) {
+                     return std::tie(a.socket, a.core, a.id) <
+                            std::tie(b.socket, b.core, b.id);
+                   });
+  if (policy == lite_api::X86_BIND_COMPACT) {
+    for (const auto& cpu : cpus) order.push_back(cpu.id);
+    return order;
+  }
+  // The first logical cpu of every core, then the remaining siblings.
+  std::vector<CpuTopology::LogicalCpu> firsts, siblings;
+  for (size_t i = 0; i < cpus.size(); ++i) {
+    bool first = i == 0 || cpus[i].core != cpus[i - 1].core;
+    (first ? firsts : siblings).push_back(cpus[i]);
+  }
+  if (policy == lite_api::X86_BIND_PHYSICAL) {
+    for (const auto& cpu : firsts) order.push_back(cpu.id);
+    return order;
+  }
+  // X86_BIND_SCATTER: take the sockets in turn, physical cores first.
+  std::map<int, std::vector<int>> by_socket;
+  for (const auto& cpu : firsts) by_socket[cpu.socket].push_back(cpu.id);
+  for (const auto& cpu : siblings) by_socket[cpu.socket].push_back(cpu.id);
+  for (size_t k = 0; order.size() < cpus.size(); ++k) {
+    for (const auto& socket : by_socket) {
+      if (k < socket.second.size()) order.push_back(socket.second[k]);
+    }
+  }
+  return order;
+}
+
+bool BindCurrentThread(int cpu) {
+#ifdef __linux__
+  if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(cpu, &mask);
+  return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+  return false;
+#endif
+}
+
+ThreadAffinityGuard::ThreadAffinityGuard() {
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) != 0) return;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &mask)) cpus_.push_back(cpu);
+  }
+#endif
+}
+
+ThreadAffinityGuard::~ThreadAffinityGuard() {
+#ifdef __linux__
+  if (cpus_.empty()) return;
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (int cpu : cpus_) CPU_SET(cpu, &mask);
+  sched_setaffinity(0, sizeof(mask), &mask);
+#endif
+}
+
 }  // namespace x86
 }  // namespace lite
 }  // namespace paddle
@@ -15,6 +15,9 @@
 #pragma once
 
 #include <stddef.h>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_place.h"
 
 #ifdef _WIN32
 #if defined(__AVX2__)
@@ -75,6 +78,68 @@ typedef enum {
 // May I use some instruction
 bool MayIUse(const cpu_isa_t cpu_isa);
 
+//! Get the cpu brand string, e.g. "Intel(R) Xeon(R) Gold 6148 CPU @ 2.40GHz",
+//! or "unknown" when it can not be read.
+std::string CpuModelName();
+
+//! Parse a sysfs cpu or node list such as "0-3,8,10-11".
+std::vector<int> ParseIdList(const std::string& list);
+
+//! Parse a sysfs cache size such as "48K" or "32M" into bytes, 0 if empty.
+size_t ParseCacheSize(const std::string& size);
+
+//! Get the size in bytes of the L1 data cache of a core, 0 if unknown.
+size_t CpuL1CacheSize();
+
+//! Get the size in bytes of the L2 cache of a core, 0 if unknown.
+size_t CpuL2CacheSize();
+
+//! Get the size in bytes of one L3 cache, which is shared by the cores of a
+//! socket (or of a core complex), 0 if unknown.
+size_t CpuL3CacheSize();
+
+// The logical cpus the process may run on, read from sysfs on Linux. Each
+// physical core with SMT shows up as several logical cpus of the same core.
+struct CpuTopology {
+  struct LogicalCpu {
+    int id;      // the os cpu number, as used by sched_setaffinity
+    int core;    // physical core, unique in the machine
+    int socket;  // physical package
+    int node;    // NUMA node
+  };
+  std::vector<LogicalCpu> cpus;
+  int num_cores{0};
+  int num_sockets{0};
+  int num_nodes{0};
+};
+
+//! Get the topology, probed once. Falls back to one socket and one node of
+//! single-thread cores when sysfs is not available.
+const CpuTopology& GetCpuTopology();
+
+//! Get the logical cpus to pin threads on, the i-th thread goes to the
+//! (i % size)-th cpu. Empty for X86_BIND_NONE.
+std::vector<int> CpuBindOrder(lite_api::X86BindPolicy policy);
+
+//! Same as above, for the given topology.
+std::vector<int> CpuBindOrder(const CpuTopology& topology,
+                              lite_api::X86BindPolicy policy);
+
+//! Pin the calling thread to the logical cpu. Returns false if it is not
+//! supported on the platform or refused by the os.
+bool BindCurrentThread(int cpu);
+
+//! Save the cpu affinity of the calling thread, and restore it when the guard
+//! goes out of scope.
+class ThreadAffinityGuard {
+ public:
+  ThreadAffinityGuard();
+  ~ThreadAffinityGuard();
+
+ private:
+  std::vector<int> cpus_;
+};
+
 }  // namespace x86
 }  // namespace lite
 }  // namespace paddle
@@ -0,0 +1,68 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/jit/autotune.h"
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <limits>
+#include <string>
+#include "lite/backends/x86/jit/helper.h"
+#include "lite/utils/env.h"
+
+namespace paddle {
+namespace lite {
+namespace jit {
+
+namespace {
+// Each timed round runs about this long, so tiny kernels are not lost in
+// the clock resolution and big ones do not stall the first run.
+constexpr double kRoundNs = 50000.;
+constexpr int kMaxReps = 1000;
+constexpr int kRounds = 3;
+}  // namespace
+
+bool AutotuneEnabled() {
+  static bool enabled = GetBoolFromEnv("jit_autotune");
+  return enabled;
+}
+
+double TimeKernel(const std::function<void(int)>& run) {
+  using Clock = std::chrono::steady_clock;
+  auto elapsed_ns = [&run](int reps) {
+    auto start = Clock::now();
+    run(reps);
+    return std::chrono::duration<double, std::nano>(Clock::now() - start)
+        .count();
+  };
+  // The first call also warms up the caches and any lazy setup.
+  double once = (std::max)(elapsed_ns(1), 1.);
+  int reps = static_cast<int>((std::min)(static_cast<double>(kMaxReps),
+                                         (std::max)(1., kRoundNs / once)));
+  double best = std::numeric_limits<double>::max();
+  for (int i = 0; i < kRounds; ++i) {
+    best = (std::min)(best, elapsed_ns(reps) / reps);
+  }
+  return best;
+}
+
+std::string TunedKernelKey(KernelType type,
+                           size_t data_size,
+                           int64_t attr_key) {
+  return std::string(to_string(type)) + "_f" + std::to_string(data_size * 8) +
+         "_" + std::to_string(attr_key);
+}
+
+}  // namespace jit
+}  // namespace lite
+}  // namespace paddle
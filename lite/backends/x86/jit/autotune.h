@@ -0,0 +1,273 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/backends/x86/jit/kernel_base.h"
+
+namespace paddle {
+namespace lite {
+namespace jit {
+
+// Whether KernelFuncs picks the implementation of a new attr by timing all
+// the candidates, enabled by the env jit_autotune.
+bool AutotuneEnabled();
+
+// Runs |run| a few times and returns the best nanoseconds per call. The
+// argument of |run| is how many calls to make in a row.
+double TimeKernel(const std::function<void(int)>& run);
+
+// The key of a tuned choice, e.g. "kVRelu_f32_64".
+std::string TunedKernelKey(KernelType type,
+                           size_t data_size,
+                           int64_t attr_key);
+
+namespace autotune {
+
+using BenchRun = std::function<void(int)>;
+
+template <typename T>
+std::shared_ptr<std::vector<T>> Buffer(int64_t size) {
+  std::shared_ptr<std::vector<T>> buf(new std::vector<T>(size));
+  for (int64_t i = 0; i < size; ++i) {
+    (*buf)[i] = static_cast<T>((i % 17) - 8) / static_cast<T>(8);
+  }
+  return buf;
+}
+
+// Each bench builds the inputs a kernel family needs for an attr and
+// returns a BenchRun calling the function on them.
+
+// x, y, z, n and a, x, y, n
+template <typename T>
+struct XYZNBench {
+  static BenchRun Make(void (*func)(const T*, const T*, T*, int), int n) {
+    auto x = Buffer<T>(n);
+    auto y = Buffer<T>(n);
+    auto z = Buffer<T>(n);
+    return [=](int reps) {
+      for (int i = 0; i < reps; ++i) func(x->data(), y->data(), z->data(), n);
+    };
+  }
+};
+
+// x, y, n and x, returned value, n
+template <typename T>
+struct XYNBench {
+  static BenchRun Make(void (*func)(const T*, T*, int), int n) {
+    auto x = Buffer<T>(n);
+    auto y = Buffer<T>(n);
+    return [=](int reps) {
+      for (int i = 0; i < reps; ++i) func(x->data(), y->data(), n);
+    };
+  }
+};
+
+template <typename T>
+struct VBroadcastBench {
+  static BenchRun Make(void (*func)(const T*, T*, int64_t, int64_t),
+                       int64_t x_len) {
+    const int64_t y_h = 16;
+    auto x = Buffer<T>(x_len);
+    auto y = Buffer<T>(y_h * x_len);
+    return [=](int reps) {
+      for (int i = 0; i < reps; ++i) func(x->data(), y->data(), y_h, x_len);
+    };
+  }
+};
+
+template <typename T>
+struct SeqPoolBench {
+  static BenchRun Make(void (*func)(const T*, T*, const seq_pool_attr_t*),
+                       const seq_pool_attr_t& attr) {
+    // The height is only known when the kernel is called.
+    seq_pool_attr_t bench_attr = attr;
+    bench_attr.h = (std::max)(attr.h, 8);
+    auto x = Buffer<T>(bench_attr.h * attr.w);
+    auto y = Buffer<T>(attr.w);
+    return [=](int reps) {
+      for (int i = 0; i < reps; ++i) func(x->data(), y->data(), &bench_attr);
+    };
+  }
+};
+
+template <typename T>
+struct EmbSeqPoolBench {
+  static BenchRun Make(
+      void (*func)(const T*, const int64_t*, T*, const emb_seq_pool_attr_t*),
+      const emb_seq_pool_attr_t& attr) {
+    // All the ids point to row 0, so one row of the table is enough.
+    auto table = Buffer<T>(attr.table_width);
+    auto out = Buffer<T>(attr.out_width);
+    std::shared_ptr<std::vector<int64_t>> idx(
+        new std::vector<int64_t>(attr.index_height * attr.index_width, 0));
+    return [=](int reps) {
+      for (int i = 0; i < reps; ++i) {
+        func(table->data(), idx->data(), out->data(), &attr);
+      }
+    };
+  }
+};
+
+template <typename T>
+struct MatMulBench {
+  static BenchRun Make(
+      void (*func)(const T*, const T*, T*, const matmul_attr_t*),
+      const matmul_attr_t& attr) {
+    auto a = Buffer<T>(attr.m * attr.k);
+    auto b = Buffer<T>(attr.k * attr.n);
+    auto c = Buffer<T>(attr.m * attr.n);
+    return [=](int reps) {
+      for (int i = 0; i < reps; ++i) {
+        func(a->data(), b->data(), c->data(), &attr);
+      }
+    };
+  }
+};
+
+template <typename T>
+struct LayerNormBench {
+  static BenchRun Make(
+      void (*func)(T*, T*, T*, T*, const T*, const T*, int, const float, int),
+      int right) {
+    const int height = 4;
+    auto x = Buffer<T>(height * right);
+    auto out = Buffer<T>(height * right);
+    auto mean = Buffer<T>(height);
+    auto var = Buffer<T>(height);
+    auto scale = Buffer<T>(right);
+    auto bias = Buffer<T>(right);
+    return [=](int reps) {
+      for (int i = 0; i < reps; ++i) {
+        func(x->data(),
+             out->data(),
+             mean->data(),
+             var->data(),
+             scale->data(),
+             bias->data(),
+             height,
+             1e-5f,
+             right);
+      }
+    };
+  }
+};
+
+template <typename T>
+struct SoftmaxBench {
+  static BenchRun Make(void (*func)(const T*, T*, int, int, int), int n) {
+    auto x = Buffer<T>(n);
+    auto y = Buffer<T>(n);
+    return [=](int reps) {
+      for (int i = 0; i < reps; ++i) func(x->data(), y->data(), n, 1, 1);
+    };
+  }
+};
+
+template <typename T>
+struct LSTMBench {
+  static BenchRun Make(void (*func)(lstm_t*, const lstm_attr_t*),
+                       const lstm_attr_t& attr) {
+    auto gates = Buffer<T>(4 * attr.d);
+    auto ct_1 = Buffer<T>(attr.d);
+    auto ct = Buffer<T>(attr.d);
+    auto ht = Buffer<T>(attr.d);
+    auto wp = Buffer<T>(3 * attr.d);
+    auto checked = Buffer<T>(2 * attr.d);
+    return [=](int reps) {
+      lstm_t step;
+      step.gates = gates->data();
+      step.ct_1 = ct_1->data();
+      step.ct = ct->data();
+      step.ht = ht->data();
+      step.wp = wp->data();
+      step.checked = checked->data();
+      for (int i = 0; i < reps; ++i) func(&step, &attr);
+    };
+  }
+};
+
+template <typename T>
+struct GRUBench {
+  static BenchRun Make(void (*func)(gru_t*, const gru_attr_t*),
+                       const gru_attr_t& attr) {
+    auto gates = Buffer<T>(3 * attr.d);
+    auto ht_1 = Buffer<T>(attr.d);
+    auto ht = Buffer<T>(attr.d);
+    return [=](int reps) {
+      gru_t step;
+      step.gates = gates->data();
+      step.ht_1 = ht_1->data();
+      step.ht = ht->data();
+      for (int i = 0; i < reps; ++i) func(&step, &attr);
+    };
+  }
+};
+
+}  // namespace autotune
+
+// Maps a kernel type to its bench. Kernels without one, such as
+// CRFDecoding and Sgd, keep the default choice.
+template <KernelType KT, typename T>
+struct KernelBench {
+  template <typename Func, typename Attr>
+  static autotune::BenchRun Make(Func, const Attr&) {
+    return nullptr;
+  }
+};
+
+#define DECLARE_KERNEL_BENCH(type, bench) \
+  template <typename T>                   \
+  struct KernelBench<k##type, T> : public autotune::bench<T> {}
+
+DECLARE_KERNEL_BENCH(VMul, XYZNBench);
+DECLARE_KERNEL_BENCH(VAdd, XYZNBench);
+DECLARE_KERNEL_BENCH(VAddRelu, XYZNBench);
+DECLARE_KERNEL_BENCH(VSub, XYZNBench);
+DECLARE_KERNEL_BENCH(VScal, XYZNBench);
+DECLARE_KERNEL_BENCH(VAddBias, XYZNBench);
+
+DECLARE_KERNEL_BENCH(VRelu, XYNBench);
+DECLARE_KERNEL_BENCH(VIdentity, XYNBench);
+DECLARE_KERNEL_BENCH(VSquare, XYNBench);
+DECLARE_KERNEL_BENCH(VExp, XYNBench);
+DECLARE_KERNEL_BENCH(VSigmoid, XYNBench);
+DECLARE_KERNEL_BENCH(VTanh, XYNBench);
+DECLARE_KERNEL_BENCH(VCopy, XYNBench);
+DECLARE_KERNEL_BENCH(HMax, XYNBench);
+DECLARE_KERNEL_BENCH(HSum, XYNBench);
+
+DECLARE_KERNEL_BENCH(VBroadcast, VBroadcastBench);
+DECLARE_KERNEL_BENCH(SeqPool, SeqPoolBench);
+DECLARE_KERNEL_BENCH(EmbSeqPool, EmbSeqPoolBench);
+DECLARE_KERNEL_BENCH(MatMul, MatMulBench);
+DECLARE_KERNEL_BENCH(LayerNorm, LayerNormBench);
+DECLARE_KERNEL_BENCH(Softmax, SoftmaxBench);
+
+DECLARE_KERNEL_BENCH(LSTMCtHt, LSTMBench);
+DECLARE_KERNEL_BENCH(LSTMC1H1, LSTMBench);
+DECLARE_KERNEL_BENCH(GRUH1, GRUBench);
+DECLARE_KERNEL_BENCH(GRUHtPart1, GRUBench);
+DECLARE_KERNEL_BENCH(GRUHtPart2, GRUBench);
+
+#undef DECLARE_KERNEL_BENCH
+
+}  // namespace jit
+}  // namespace lite
+}  // namespace paddle
@@ -43,6 +43,8 @@ class MatMulJitCode : public JitCode {
     return base;
   }
   void genCode() override;
+  // Already zmm code, so it stays ahead of the avx512 more kernel.
+  int Priority() const override { return 1; }
 
  private:
   int m_, n_, k_;
@@ -14,11 +14,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <string>
 #include <utility>  // for std::move
 #include <vector>
+#include "lite/backends/x86/jit/autotune.h"
 #include "lite/backends/x86/jit/gen_base.h"
 #include "lite/backends/x86/jit/kernel_base.h"
 #include "lite/backends/x86/jit/kernel_key.h"
@@ -103,7 +105,8 @@ inline typename KernelTuple::func_type GetReferFunc() {
 template <typename KernelTuple, typename PlaceType>
 std::vector<const Kernel*> GetAllCandidateKernels(
     const typename KernelTuple::attr_type& attr) {
-  // the search order shoudl be jitcode > more > refer
+  // the search order is jitcode and more by descending Priority(), then
+  // refer
   std::vector<const Kernel*> res;
   auto jitker = GetJitCode<KernelTuple, PlaceType>(attr);
   if (jitker) {
@@ -123,6 +126,10 @@ std::vector<const Kernel*> GetAllCandidateKernels(
       }
     }
   }
+  std::stable_sort(
+      res.begin(), res.end(), [](const Kernel* a, const Kernel* b) {
+        return a->Priority() > b->Priority();
+      });
 
   // The last implementation should be reference function on CPUPlace.
   auto ref = GetReferKernel<KernelTuple>();
@@ -174,6 +181,51 @@ typename KernelTuple::func_type GetDefaultBestFunc(
   return funcs[0];
 }
 
+// Times every candidate on scratch inputs shaped like |attr| and returns the
+// fastest one. The choice is kept in TunedKernelPool, so each attr is only
+// timed once per process, or once per cpu model with a cache file.
+template <typename KernelTuple, typename PlaceType = lite::fluid::CPUPlace>
+typename KernelTuple::func_type GetTunedBestFunc(
+    const typename KernelTuple::attr_type& attr) {
+  using T = typename KernelTuple::data_type;
+  using Attr = typename KernelTuple::attr_type;
+  using Bench = KernelBench<KernelTuple::kernel_type, T>;
+  auto funcs = GetAllCandidateFuncsWithTypes<KernelTuple, PlaceType>(attr);
+  CHECK_GE(funcs.size(), 1UL);
+  if (funcs.size() == 1) {
+    return funcs[0].second;
+  }
+  auto key = TunedKernelKey(KernelTuple::kernel_type,
+                            sizeof(T),
+                            JitCodeKey<Attr>(attr));
+  auto& tuned = TunedKernelPool::Instance();
+  std::string impl_type;
+  if (tuned.Find(key, &impl_type)) {
+    for (auto& func : funcs) {
+      if (func.first == impl_type) {
+        return func.second;
+      }
+    }
+  }
+  size_t best = 0;
+  double best_ns = -1;
+  for (size_t i = 0; i < funcs.size(); ++i) {
+    auto run = Bench::Make(funcs[i].second, attr);
+    if (!run) {
+      return funcs[0].second;
+    }
+    double ns = TimeKernel(run);
+    VLOG(4) << key << " " << funcs[i].first << ": " << ns << " ns";
+    if (best_ns < 0 || ns < best_ns) {
+      best = i;
+      best_ns = ns;
+    }
+  }
+  VLOG(3) << "Tuned " << key << " to " << funcs[best].first;
+  tuned.Insert(key, funcs[best].first);
+  return funcs[best].second;
+}
+
 template <typename KernelTuple, typename PlaceType>
 class KernelFuncs {
  public:
@@ -191,8 +243,11 @@ class KernelFuncs {
     if (Has(key)) {
       return funcs_.at(key);
     }
-    // If do not have this attr in cache then get the default best
-    auto func = GetDefaultBestFunc<KernelTuple, PlaceType>(attr);
+    // If do not have this attr in cache then get the default best, or the
+    // fastest one on this machine when autotune is enabled
+    auto func = AutotuneEnabled()
+                    ? GetTunedBestFunc<KernelTuple, PlaceType>(attr)
+                    : GetDefaultBestFunc<KernelTuple, PlaceType>(attr);
     Insert(key, func);
     return func;
   }
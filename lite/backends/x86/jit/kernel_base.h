@@ -334,6 +334,10 @@ class Kernel {
   Kernel() = default;
   virtual ~Kernel() = default;
   virtual const char* ImplType() const = 0;
+  // The jitcode and more kernels of one type are tried from the highest
+  // priority down. With the same priority the jitcode goes first and the
+  // more kernels keep their registration order.
+  virtual int Priority() const { return 0; }
 };
 
 template <typename KernelTuple>
@@ -13,9 +13,19 @@
  * limitations under the License. */
 
 #include "lite/backends/x86/jit/kernel_pool.h"
+#include <cstdio>
+#include <fstream>
 #include <map>
 #include <memory>  // for shared_ptr
 #include <string>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/utils/env.h"
+#include "lite/utils/log/cp_logging.h"
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace paddle {
 namespace lite {
@@ -36,6 +46,122 @@ ReferKernelPool& ReferKernelPool::Instance() {
   return g_refer_kernel_pool;
 }
 
+TunedKernelPool& TunedKernelPool::Instance() {
+  static TunedKernelPool g_tuned_kernel_pool;
+  return g_tuned_kernel_pool;
+}
+
+namespace {
+
+// Saving rewrites the whole file, so choices are written in groups.
+constexpr int kSaveBatch = 16;
+
+using TunedMap = std::map<std::string, std::map<std::string, std::string>>;
+
+// One choice per line: cpu model, kernel key and impl type split by tabs.
+// The entries of other cpu models are kept so a file can be shared.
+void ReadCacheFile(const std::string& path, TunedMap* tuned) {
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    auto first = line.find('\t');
+    auto second = line.find('\t', first + 1);
+    if (first == std::string::npos || second == std::string::npos) {
+      continue;
+    }
+    auto model = line.substr(0, first);
+    auto key = line.substr(first + 1, second - first - 1);
+    (*tuned)[model][key] = line.substr(second + 1);
+  }
+}
+
+int ProcessId() {
+#ifdef _WIN32
+  return _getpid();
+#else
+  return getpid();
+#endif
+}
+
+}  // namespace
+
+TunedKernelPool::TunedKernelPool()
+    : TunedKernelPool(GetStringFromEnv("jit_autotune_cache")) {}
+
+TunedKernelPool::TunedKernelPool(const std::string& cache_file)
+    : cache_file_(cache_file), cpu_model_(x86::CpuModelName()) {
+  if (!cache_file_.empty()) {
+    ReadCacheFile(cache_file_, &tuned_);
+    VLOG(3) << "Loaded " << tuned_[cpu_model_].size()
+            << " tuned jit kernels for " << cpu_model_ << " from "
+            << cache_file_;
+  }
+}
+
+TunedKernelPool::~TunedKernelPool() { Flush(); }
+
+bool TunedKernelPool::Find(const std::string& key, std::string* impl_type) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& tuned = tuned_[cpu_model_];
+  auto iter = tuned.find(key);
+  if (iter == tuned.end()) {
+    return false;
+  }
+  *impl_type = iter->second;
+  return true;
+}
+
+void TunedKernelPool::Insert(const std::string& key,
+                             const std::string& impl_type) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  tuned_[cpu_model_][key] = impl_type;
+  if (!cache_file_.empty() && ++unsaved_ >= kSaveBatch) {
+    Save();
+  }
+}
+
+void TunedKernelPool::Flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!cache_file_.empty() && unsaved_ > 0) {
+    Save();
+  }
+}
+
+void TunedKernelPool::Save() {
+  // Other processes may have saved to the file since it was read, keep their
+  // choices too, ours win on the same key.
+  TunedMap merged;
+  ReadCacheFile(cache_file_, &merged);
+  for (auto& model : tuned_) {
+    for (auto& kernel : model.second) {
+      merged[model.first][kernel.first] = kernel.second;
+    }
+  }
+  tuned_.swap(merged);
+  unsaved_ = 0;
+  // Write aside and rename, so a reader never sees a partial file. The name
+  // is per process, so concurrent savers do not write the same file.
+  const std::string tmp_file =
+      cache_file_ + ".tmp." + std::to_string(ProcessId());
+  {
+    std::ofstream file(tmp_file);
+    if (!file.is_open()) {
+      LOG(WARNING) << "Can not write the jit autotune cache " << tmp_file;
+      return;
+    }
+    for (auto& model : tuned_) {
+      for (auto& kernel : model.second) {
+        file << model.first << '\t' << kernel.first << '\t' << kernel.second
+             << '\n';
+      }
+    }
+  }
+  if (std::rename(tmp_file.c_str(), cache_file_.c_str()) != 0) {
+    LOG(WARNING) << "Can not update the jit autotune cache " << cache_file_;
+    std::remove(tmp_file.c_str());
+  }
+}
+
 }  // namespace jit
 }  // namespace lite
 }  // namespace paddle
@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <map>
 #include <memory>  // for unique_ptr
+#include <mutex>   // NOLINT
 #include <string>
 #include <unordered_map>
 #include <utility>  // for move
@@ -112,6 +114,33 @@ class ReferKernelPool {
   KernelMap pool_;
 };
 
+// The implementation picked by runtime benchmark for each kernel and attr,
+// shared by all threads. With the env jit_autotune_cache set to a file the
+// choices are loaded from and saved to it, keyed by the cpu model. New
+// choices are saved in batches, and the rest when the pool is destroyed.
+class TunedKernelPool {
+ public:
+  static TunedKernelPool& Instance();
+  TunedKernelPool();
+  // Uses |cache_file| instead of the env, nothing is saved if it is empty.
+  explicit TunedKernelPool(const std::string& cache_file);
+  ~TunedKernelPool();
+  bool Find(const std::string& key, std::string* impl_type);
+  void Insert(const std::string& key, const std::string& impl_type);
+  // Save the choices not saved yet.
+  void Flush();
+
+ private:
+  void Save();
+
+  std::mutex mutex_;
+  std::string cache_file_;
+  std::string cpu_model_;
+  int unsaved_{0};
+  // cpu model -> (kernel key -> impl type)
+  std::map<std::string, std::map<std::string, std::string>> tuned_;
+};
+
 }  // namespace jit
 }  // namespace lite
 }  // namespace paddle
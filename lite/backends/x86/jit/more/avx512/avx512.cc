@@ -0,0 +1,551 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/jit/more/avx512/avx512.h"
+#include <immintrin.h>
+#include <cmath>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/backends/x86/jit/macro.h"
+#include "lite/backends/x86/jit/registry.h"
+#include "lite/utils/log/cp_logging.h"
+
+// Lets the zmm code live in a library built for a lower ISA; the kernels
+// are only selected at runtime when the CPU reports avx512f.
+#if defined(__GNUC__) && !defined(__AVX512F__)
+#define LITE_AVX512 __attribute__((target("avx512f")))
+#else
+#define LITE_AVX512
+#endif
+
+namespace paddle {
+namespace lite {
+namespace jit {
+namespace more {
+namespace avx512 {
+
+namespace {
+
+constexpr int kBlock = ZMM_FLOAT_BLOCK;
+
+inline __mmask16 TailMask(int rest) {
+  return static_cast<__mmask16>((1u << rest) - 1);
+}
+
+// Cephes exp, the same polynomial as the jitcode kernels.
+LITE_AVX512 inline __m512 Exp(__m512 x) {
+  x = _mm512_min_ps(x, _mm512_set1_ps(88.3762626647949f));
+  x = _mm512_max_ps(x, _mm512_set1_ps(-88.3762626647949f));
+  __m512 fx = _mm512_fmadd_ps(
+      x, _mm512_set1_ps(1.44269504088896341f), _mm512_set1_ps(0.5f));
+  fx = _mm512_roundscale_ps(fx, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+  x = _mm512_fnmadd_ps(fx, _mm512_set1_ps(0.693359375f), x);
+  x = _mm512_fnmadd_ps(fx, _mm512_set1_ps(-2.12194440e-4f), x);
+  __m512 y = _mm512_set1_ps(1.9875691500E-4f);
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(1.3981999507E-3f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(8.3334519073E-3f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(4.1665795894E-2f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(1.6666665459E-1f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(5.0000001201E-1f));
+  y = _mm512_fmadd_ps(y, _mm512_mul_ps(x, x), x);
+  y = _mm512_add_ps(y, _mm512_set1_ps(1.f));
+  return _mm512_scalef_ps(y, fx);
+}
+
+// Clamps like the refer kernel, so both saturate at the same inputs.
+LITE_AVX512 inline __m512 Sigmoid(__m512 x) {
+  x = _mm512_min_ps(x, _mm512_set1_ps(SIGMOID_THRESHOLD_MAX));
+  x = _mm512_max_ps(x, _mm512_set1_ps(SIGMOID_THRESHOLD_MIN));
+  __m512 one = _mm512_set1_ps(1.f);
+  __m512 e = Exp(_mm512_sub_ps(_mm512_setzero_ps(), x));
+  return _mm512_div_ps(one, _mm512_add_ps(one, e));
+}
+
+// tanh(x) = 2 * sigmoid(2x) - 1
+LITE_AVX512 inline __m512 Tanh(__m512 x) {
+  __m512 two = _mm512_set1_ps(2.f);
+  return _mm512_fmsub_ps(
+      two, Sigmoid(_mm512_mul_ps(two, x)), _mm512_set1_ps(1.f));
+}
+
+LITE_AVX512 inline __m512 Act(KernelType type, __m512 x) {
+  switch (type) {
+    case kVSigmoid:
+      return Sigmoid(x);
+    case kVRelu:
+      return _mm512_max_ps(x, _mm512_setzero_ps());
+    case kVTanh:
+      return Tanh(x);
+    case kVIdentity:
+      return x;
+    default:
+      LOG(FATAL) << "Not support type: " << type;
+  }
+  return x;
+}
+
+LITE_AVX512 inline float ReduceMax(__m512 x) {
+  __m256 v = _mm256_max_ps(_mm512_castps512_ps256(x),
+                           _mm256_castpd_ps(_mm512_extractf64x4_pd(
+                               _mm512_castps_pd(x), 1)));
+  __m128 r = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  r = _mm_max_ps(r, _mm_movehl_ps(r, r));
+  r = _mm_max_ss(r, _mm_shuffle_ps(r, r, 1));
+  return _mm_cvtss_f32(r);
+}
+
+LITE_AVX512 inline float ReduceSum(__m512 x) {
+  __m256 v = _mm256_add_ps(_mm512_castps512_ps256(x),
+                           _mm256_castpd_ps(_mm512_extractf64x4_pd(
+                               _mm512_castps_pd(x), 1)));
+  __m128 r = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  r = _mm_add_ps(r, _mm_movehl_ps(r, r));
+  r = _mm_add_ss(r, _mm_shuffle_ps(r, r, 1));
+  return _mm_cvtss_f32(r);
+}
+
+// Applies |op| on every zmm block of x, the tail through a masked block.
+template <typename Op>
+LITE_AVX512 inline void ApplyXYN(const T* x, T* y, int n, Op op) {
+  int i = 0;
+  for (; i + kBlock <= n; i += kBlock) {
+    _mm512_storeu_ps(y + i, op(_mm512_loadu_ps(x + i)));
+  }
+  if (i < n) {
+    __mmask16 mask = TailMask(n - i);
+    _mm512_mask_storeu_ps(y + i, mask, op(_mm512_maskz_loadu_ps(mask, x + i)));
+  }
+}
+
+struct ReluOp {
+  LITE_AVX512 __m512 operator()(__m512 x) const {
+    return _mm512_max_ps(x, _mm512_setzero_ps());
+  }
+};
+
+struct SquareOp {
+  LITE_AVX512 __m512 operator()(__m512 x) const { return _mm512_mul_ps(x, x); }
+};
+
+struct ExpOp {
+  LITE_AVX512 __m512 operator()(__m512 x) const { return Exp(x); }
+};
+
+struct SigmoidOp {
+  LITE_AVX512 __m512 operator()(__m512 x) const { return Sigmoid(x); }
+};
+
+struct TanhOp {
+  LITE_AVX512 __m512 operator()(__m512 x) const { return Tanh(x); }
+};
+
+}  // namespace
+
+LITE_AVX512 void VRelu(const T* x, T* y, int n) {
+  ApplyXYN(x, y, n, ReluOp());
+}
+
+LITE_AVX512 void VSquare(const T* x, T* y, int n) {
+  ApplyXYN(x, y, n, SquareOp());
+}
+
+LITE_AVX512 void VExp(const T* x, T* y, int n) { ApplyXYN(x, y, n, ExpOp()); }
+
+LITE_AVX512 void VSigmoid(const T* x, T* y, int n) {
+  ApplyXYN(x, y, n, SigmoidOp());
+}
+
+LITE_AVX512 void VTanh(const T* x, T* y, int n) {
+  ApplyXYN(x, y, n, TanhOp());
+}
+
+// Each block of x is loaded once and stored down all the rows.
+LITE_AVX512 void VBroadcast(const T* x, T* y, int64_t y_h, int64_t x_len) {
+  for (int64_t j = 0; j < x_len; j += kBlock) {
+    __mmask16 mask = x_len - j >= kBlock ? 0xFFFF : TailMask(x_len - j);
+    __m512 v = _mm512_maskz_loadu_ps(mask, x + j);
+    T* dst = y + j;
+    for (int64_t h = 0; h < y_h; ++h, dst += x_len) {
+      _mm512_mask_storeu_ps(dst, mask, v);
+    }
+  }
+}
+
+// A(M,K) * B(K,N) = C(M,N). Each row of C is built 16 columns at a time
+// with the whole k loop in a zmm accumulator.
+LITE_AVX512 void MatMul(const T* a,
+                        const T* b,
+                        T* c,
+                        const matmul_attr_t* attr) {
+  const int m = attr->m;
+  const int n = attr->n;
+  const int k = attr->k;
+  for (int i = 0; i < m; ++i) {
+    const T* pa = a + i * k;
+    T* pc = c + i * n;
+    int j = 0;
+    for (; j + 4 * kBlock <= n; j += 4 * kBlock) {
+      __m512 acc0 = _mm512_setzero_ps();
+      __m512 acc1 = _mm512_setzero_ps();
+      __m512 acc2 = _mm512_setzero_ps();
+      __m512 acc3 = _mm512_setzero_ps();
+      const T* pb = b + j;
+      for (int p = 0; p < k; ++p, pb += n) {
+        __m512 va = _mm512_set1_ps(pa[p]);
+        acc0 = _mm512_fmadd_ps(va, _mm512_loadu_ps(pb), acc0);
+        acc1 = _mm512_fmadd_ps(va, _mm512_loadu_ps(pb + kBlock), acc1);
+        acc2 = _mm512_fmadd_ps(va, _mm512_loadu_ps(pb + 2 * kBlock), acc2);
+        acc3 = _mm512_fmadd_ps(va, _mm512_loadu_ps(pb + 3 * kBlock), acc3);
+      }
+      _mm512_storeu_ps(pc + j, acc0);
+      _mm512_storeu_ps(pc + j + kBlock, acc1);
+      _mm512_storeu_ps(pc + j + 2 * kBlock, acc2);
+      _mm512_storeu_ps(pc + j + 3 * kBlock, acc3);
+    }
+    for (; j < n; j += kBlock) {
+      __mmask16 mask = n - j >= kBlock ? 0xFFFF : TailMask(n - j);
+      __m512 acc = _mm512_setzero_ps();
+      const T* pb = b + j;
+      for (int p = 0; p < k; ++p, pb += n) {
+        acc = _mm512_fmadd_ps(
+            _mm512_set1_ps(pa[p]), _mm512_maskz_loadu_ps(mask, pb), acc);
+      }
+      _mm512_mask_storeu_ps(pc + j, mask, acc);
+    }
+  }
+}
+
+LITE_AVX512 void SeqPool(const T* x, T* y, const seq_pool_attr_t* attr) {
+  const int h = attr->h;
+  const int w = attr->w;
+  T scalar = static_cast<T>(1);
+  if (attr->type == SeqPoolType::kAvg) {
+    scalar = scalar / static_cast<T>(h);
+  } else if (attr->type == SeqPoolType::kSqrt) {
+    scalar = scalar / std::sqrt(static_cast<T>(h));
+  }
+  const __m512 scale = _mm512_set1_ps(scalar);
+  for (int j = 0; j < w; j += kBlock) {
+    __mmask16 mask = w - j >= kBlock ? 0xFFFF : TailMask(w - j);
+    __m512 acc = _mm512_setzero_ps();
+    const T* src = x + j;
+    for (int i = 0; i < h; ++i, src += w) {
+      acc = _mm512_add_ps(acc, _mm512_maskz_loadu_ps(mask, src));
+    }
+    _mm512_mask_storeu_ps(y + j, mask, _mm512_mul_ps(acc, scale));
+  }
+}
+
+LITE_AVX512 void EmbSeqPool(const T* table,
+                            const int64_t* idx,
+                            T* out,
+                            const emb_seq_pool_attr_t* attr) {
+  CHECK_EQ(attr->table_width * attr->index_width, attr->out_width);
+  const int64_t tw = attr->table_width;
+  const int64_t iw = attr->index_width;
+  for (int64_t i = 0; i < attr->index_height * iw; ++i) {
+    CHECK_LT(idx[i], attr->table_height) << "idx value: " << idx[i]
+                                         << " i: " << i;
+    CHECK_GE(idx[i], 0) << "idx value: " << idx[i] << " i: " << i;
+  }
+  // Every output slice sums its rows in registers and is stored once.
+  for (int64_t w = 0; w < iw; ++w) {
+    T* dst = out + w * tw;
+    for (int64_t j = 0; j < tw; j += kBlock) {
+      __mmask16 mask = tw - j >= kBlock ? 0xFFFF : TailMask(tw - j);
+      __m512 acc = _mm512_setzero_ps();
+      for (int64_t h = 0; h < attr->index_height; ++h) {
+        const T* row = table + idx[h * iw + w] * tw + j;
+        acc = _mm512_add_ps(acc, _mm512_maskz_loadu_ps(mask, row));
+      }
+      _mm512_mask_storeu_ps(dst + j, mask, acc);
+    }
+  }
+}
+
+LITE_AVX512 void LayerNorm(T* x,
+                           T* out,
+                           T* mean,
+                           T* var,
+                           const T* scale,
+                           const T* bias,
+                           int height,
+                           const float epsilon,
+                           int right) {
+  for (int i = 0; i < height; ++i) {
+    const T* px = x + i * right;
+    T* po = out + i * right;
+    __m512 sum = _mm512_setzero_ps();
+    for (int j = 0; j < right; j += kBlock) {
+      __mmask16 mask = right - j >= kBlock ? 0xFFFF : TailMask(right - j);
+      sum = _mm512_add_ps(sum, _mm512_maskz_loadu_ps(mask, px + j));
+    }
+    mean[i] = ReduceSum(sum) / right;
+    const __m512 mean_vec = _mm512_set1_ps(mean[i]);
+    __m512 sq = _mm512_setzero_ps();
+    for (int j = 0; j < right; j += kBlock) {
+      __mmask16 mask = right - j >= kBlock ? 0xFFFF : TailMask(right - j);
+      __m512 diff = _mm512_maskz_sub_ps(
+          mask, _mm512_maskz_loadu_ps(mask, px + j), mean_vec);
+      sq = _mm512_fmadd_ps(diff, diff, sq);
+    }
+    var[i] = ReduceSum(sq) / right;
+    const __m512 rstd = _mm512_set1_ps(1.f / std::sqrt(var[i] + epsilon));
+    for (int j = 0; j < right; j += kBlock) {
+      __mmask16 mask = right - j >= kBlock ? 0xFFFF : TailMask(right - j);
+      __m512 v = _mm512_mul_ps(
+          _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, px + j), mean_vec), rstd);
+      if (scale) {
+        v = _mm512_mul_ps(v, _mm512_maskz_loadu_ps(mask, scale + j));
+      }
+      if (bias) {
+        v = _mm512_add_ps(v, _mm512_maskz_loadu_ps(mask, bias + j));
+      }
+      _mm512_mask_storeu_ps(po + j, mask, v);
+    }
+  }
+}
+
+// remain is the product of dimension shapes after the axis dimension
+LITE_AVX512 void Softmax(const T* x, T* y, int n, int bs, int remain) {
+  for (int i = 0; i < bs; ++i, x += n, y += n) {
+    __m512 max_vec = _mm512_set1_ps(x[0]);
+    for (int j = 0; j < n; j += kBlock) {
+      __mmask16 mask = n - j >= kBlock ? 0xFFFF : TailMask(n - j);
+      max_vec = _mm512_mask_max_ps(
+          max_vec, mask, max_vec, _mm512_maskz_loadu_ps(mask, x + j));
+    }
+    const __m512 neg_max = _mm512_set1_ps(-ReduceMax(max_vec));
+    __m512 sum = _mm512_setzero_ps();
+    for (int j = 0; j < n; j += kBlock) {
+      __mmask16 mask = n - j >= kBlock ? 0xFFFF : TailMask(n - j);
+      __m512 e = _mm512_maskz_mov_ps(
+          mask,
+          Exp(_mm512_add_ps(_mm512_maskz_loadu_ps(mask, x + j), neg_max)));
+      sum = _mm512_add_ps(sum, e);
+      _mm512_mask_storeu_ps(y + j, mask, e);
+    }
+    if (remain == 1) {
+      const __m512 inv = _mm512_set1_ps(1.f / ReduceSum(sum));
+      for (int j = 0; j < n; j += kBlock) {
+        __mmask16 mask = n - j >= kBlock ? 0xFFFF : TailMask(n - j);
+        __m512 v = _mm512_maskz_loadu_ps(mask, y + j);
+        _mm512_mask_storeu_ps(y + j, mask, _mm512_mul_ps(v, inv));
+      }
+    } else {
+      // Strided sums, kept scalar to follow the refer kernel exactly.
+      for (int j = 0; j < remain; ++j) {
+        T* py = y + j;
+        T scalar = py[0];
+        for (int k = remain; k < n; k += remain) scalar += std::abs(py[k]);
+        scalar = static_cast<T>(1) / scalar;
+        for (int k = 0; k < n - j; k += remain) py[k] *= scalar;
+      }
+    }
+  }
+}
+
+// Gates are laid out as W_ch, W_ih, W_fh, W_oh. Every block runs the whole
+// cell in registers instead of passing the gates through memory per step.
+LITE_AVX512 void LSTMCtHt(lstm_t* step, const lstm_attr_t* attr) {
+  const T* gates = reinterpret_cast<const T*>(step->gates);
+  const T* ct_1 = reinterpret_cast<const T*>(step->ct_1);
+  T* ct = reinterpret_cast<T*>(step->ct);
+  T* ht = reinterpret_cast<T*>(step->ht);
+  const T* wp = reinterpret_cast<const T*>(step->wp);
+  const int d = attr->d;
+  for (int j = 0; j < d; j += kBlock) {
+    __mmask16 mask = d - j >= kBlock ? 0xFFFF : TailMask(d - j);
+    __m512 c = _mm512_maskz_loadu_ps(mask, gates + j);
+    __m512 ig = _mm512_maskz_loadu_ps(mask, gates + d + j);
+    __m512 fg = _mm512_maskz_loadu_ps(mask, gates + 2 * d + j);
+    __m512 og = _mm512_maskz_loadu_ps(mask, gates + 3 * d + j);
+    __m512 c_1 = _mm512_maskz_loadu_ps(mask, ct_1 + j);
+    if (attr->use_peephole) {
+      ig = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, wp + j), c_1, ig);
+      fg = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, wp + d + j), c_1, fg);
+    }
+    // C_t = act_cand(c) * act_gate(i) + C_t-1 * act_gate(f)
+    __m512 c_t = _mm512_fmadd_ps(Act(attr->act_cand, c),
+                                 Act(attr->act_gate, ig),
+                                 _mm512_mul_ps(c_1, Act(attr->act_gate, fg)));
+    if (attr->use_peephole) {
+      og =
+          _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, wp + 2 * d + j), c_t, og);
+    }
+    // H_t = act_cell(C_t) * act_gate(o)
+    __m512 h_t =
+        _mm512_mul_ps(Act(attr->act_cell, c_t), Act(attr->act_gate, og));
+    _mm512_mask_storeu_ps(ct + j, mask, c_t);
+    _mm512_mask_storeu_ps(ht + j, mask, h_t);
+  }
+}
+
+// compute c1 and h1 without c0 or h0
+LITE_AVX512 void LSTMC1H1(lstm_t* step, const lstm_attr_t* attr) {
+  const T* gates = reinterpret_cast<const T*>(step->gates);
+  T* ct = reinterpret_cast<T*>(step->ct);
+  T* ht = reinterpret_cast<T*>(step->ht);
+  const T* wp = reinterpret_cast<const T*>(step->wp);
+  const int d = attr->d;
+  for (int j = 0; j < d; j += kBlock) {
+    __mmask16 mask = d - j >= kBlock ? 0xFFFF : TailMask(d - j);
+    __m512 c = _mm512_maskz_loadu_ps(mask, gates + j);
+    __m512 ig = _mm512_maskz_loadu_ps(mask, gates + d + j);
+    __m512 og = _mm512_maskz_loadu_ps(mask, gates + 3 * d + j);
+    __m512 c_t =
+        _mm512_mul_ps(Act(attr->act_cand, c), Act(attr->act_gate, ig));
+    if (attr->use_peephole) {
+      og =
+          _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, wp + 2 * d + j), c_t, og);
+    }
+    __m512 h_t =
+        _mm512_mul_ps(Act(attr->act_cell, c_t), Act(attr->act_gate, og));
+    _mm512_mask_storeu_ps(ct + j, mask, c_t);
+    _mm512_mask_storeu_ps(ht + j, mask, h_t);
+  }
+}
+
+// compute h1 without h0
+LITE_AVX512 void GRUH1(gru_t* step, const gru_attr_t* attr) {
+  const T* gates = reinterpret_cast<const T*>(step->gates);
+  T* ht = reinterpret_cast<T*>(step->ht);
+  const int d = attr->d;
+  for (int j = 0; j < d; j += kBlock) {
+    __mmask16 mask = d - j >= kBlock ? 0xFFFF : TailMask(d - j);
+    __m512 u = Act(attr->act_gate, _mm512_maskz_loadu_ps(mask, gates + j));
+    __m512 s =
+        Act(attr->act_cand, _mm512_maskz_loadu_ps(mask, gates + 2 * d + j));
+    _mm512_mask_storeu_ps(ht + j, mask, _mm512_mul_ps(u, s));
+  }
+}
+
+// compute the first part of GRU: ht = act_gate(r) * ht_1
+LITE_AVX512 void GRUHtPart1(gru_t* step, const gru_attr_t* attr) {
+  const T* gates = reinterpret_cast<const T*>(step->gates);
+  T* ht = reinterpret_cast<T*>(step->ht);
+  const T* ht_1 = reinterpret_cast<const T*>(step->ht_1);
+  const int d = attr->d;
+  for (int j = 0; j < d; j += kBlock) {
+    __mmask16 mask = d - j >= kBlock ? 0xFFFF : TailMask(d - j);
+    __m512 r = Act(attr->act_gate, _mm512_maskz_loadu_ps(mask, gates + d + j));
+    _mm512_mask_storeu_ps(
+        ht + j, mask, _mm512_mul_ps(r, _mm512_maskz_loadu_ps(mask, ht_1 + j)));
+  }
+}
+
+// compute the second part of GRU:
+// ht = act_gate(u) * act_cand(s) + (1-act_gate(u)) * ht_1
+LITE_AVX512 void GRUHtPart2(gru_t* step, const gru_attr_t* attr) {
+  const T* gates = reinterpret_cast<const T*>(step->gates);
+  T* ht = reinterpret_cast<T*>(step->ht);
+  const T* ht_1 = reinterpret_cast<const T*>(step->ht_1);
+  const int d = attr->d;
+  for (int j = 0; j < d; j += kBlock) {
+    __mmask16 mask = d - j >= kBlock ? 0xFFFF : TailMask(d - j);
+    __m512 u = Act(attr->act_gate, _mm512_maskz_loadu_ps(mask, gates + j));
+    __m512 s =
+        Act(attr->act_cand, _mm512_maskz_loadu_ps(mask, gates + 2 * d + j));
+    __m512 h_1 = _mm512_maskz_loadu_ps(mask, ht_1 + j);
+    // u * s + (1 - u) * ht_1 = u * (s - ht_1) + ht_1
+    _mm512_mask_storeu_ps(
+        ht + j, mask, _mm512_fmadd_ps(u, _mm512_sub_ps(s, h_1), h_1));
+  }
+}
+
+namespace {
+inline bool HasAVX512() { return x86::MayIUse(x86::avx512f); }
+}  // namespace
+
+bool VReluKernel::CanBeUsed(const int& d) const { return HasAVX512(); }
+
+bool VSquareKernel::CanBeUsed(const int& d) const { return HasAVX512(); }
+
+bool VExpKernel::CanBeUsed(const int& d) const { return HasAVX512(); }
+
+bool VSigmoidKernel::CanBeUsed(const int& d) const { return HasAVX512(); }
+
+bool VTanhKernel::CanBeUsed(const int& d) const { return HasAVX512(); }
+
+bool VBroadcastKernel::CanBeUsed(const int64_t& d) const {
+  return HasAVX512();
+}
+
+// Large products are left to the blas kernels.
+bool MatMulKernel::CanBeUsed(const matmul_attr_t& attr) const {
+  return HasAVX512() && attr.n >= kBlock && attr.k < 512;
+}
+
+bool SeqPoolKernel::CanBeUsed(const seq_pool_attr_t& attr) const {
+  return HasAVX512();
+}
+
+bool EmbSeqPoolKernel::CanBeUsed(const emb_seq_pool_attr_t& attr) const {
+  return HasAVX512() && attr.pool_type == SeqPoolType::kSum;
+}
+
+bool LayerNormKernel::CanBeUsed(const int& d) const {
+  return HasAVX512() && d >= kBlock;
+}
+
+bool SoftmaxKernel::CanBeUsed(const int& d) const { return HasAVX512(); }
+
+bool LSTMCtHtKernel::CanBeUsed(const lstm_attr_t& attr) const {
+  return HasAVX512();
+}
+
+bool LSTMC1H1Kernel::CanBeUsed(const lstm_attr_t& attr) const {
+  return HasAVX512();
+}
+
+bool GRUH1Kernel::CanBeUsed(const gru_attr_t& attr) const {
+  return HasAVX512();
+}
+
+bool GRUHtPart1Kernel::CanBeUsed(const gru_attr_t& attr) const {
+  return HasAVX512();
+}
+
+bool GRUHtPart2Kernel::CanBeUsed(const gru_attr_t& attr) const {
+  return HasAVX512();
+}
+
+}  // namespace avx512
+}  // namespace more
+}  // namespace jit
+}  // namespace lite
+}  // namespace paddle
+
+namespace avx512 = paddle::lite::jit::more::avx512;
+
+#define REGISTER_MORE_KERNEL(func) \
+  REGISTER_JITKERNEL_MORE(k##func, avx512, avx512::func##Kernel)
+
+REGISTER_MORE_KERNEL(VRelu);
+REGISTER_MORE_KERNEL(VSquare);
+REGISTER_MORE_KERNEL(VExp);
+REGISTER_MORE_KERNEL(VSigmoid);
+REGISTER_MORE_KERNEL(VTanh);
+REGISTER_MORE_KERNEL(VBroadcast);
+REGISTER_MORE_KERNEL(MatMul);
+REGISTER_MORE_KERNEL(SeqPool);
+REGISTER_MORE_KERNEL(EmbSeqPool);
+REGISTER_MORE_KERNEL(LayerNorm);
+REGISTER_MORE_KERNEL(Softmax);
+REGISTER_MORE_KERNEL(LSTMCtHt);
+REGISTER_MORE_KERNEL(LSTMC1H1);
+REGISTER_MORE_KERNEL(GRUH1);
+REGISTER_MORE_KERNEL(GRUHtPart1);
+REGISTER_MORE_KERNEL(GRUHtPart2);
+
+#undef REGISTER_MORE_KERNEL
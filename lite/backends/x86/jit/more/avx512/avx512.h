@@ -0,0 +1,96 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <type_traits>
+#include "lite/backends/x86/jit/kernel_base.h"
+
+namespace paddle {
+namespace lite {
+namespace jit {
+namespace more {
+namespace avx512 {
+using T = float;
+
+// Kernels on the 512-bit zmm registers. They are compiled for avx512f
+// whatever the global SIMD flags are, and only picked on CPUs reporting it.
+
+void VRelu(const T* x, T* y, int n);
+void VSquare(const T* x, T* y, int n);
+void VExp(const T* x, T* y, int n);
+void VSigmoid(const T* x, T* y, int n);
+void VTanh(const T* x, T* y, int n);
+
+void VBroadcast(const T* x, T* y, int64_t y_h, int64_t x_len);
+void MatMul(const T* a, const T* b, T* c, const matmul_attr_t* attr);
+void SeqPool(const T* x, T* y, const seq_pool_attr_t* attr);
+void EmbSeqPool(const T* table,
+                const int64_t* idx,
+                T* out,
+                const emb_seq_pool_attr_t* attr);
+void LayerNorm(T* x,
+               T* out,
+               T* mean,
+               T* var,
+               const T* scale,
+               const T* bias,
+               int height,
+               const float epsilon,
+               int right);
+void Softmax(const T* x, T* y, int n, int bs, int remain);
+
+void LSTMCtHt(lstm_t* step, const lstm_attr_t* attr);
+void LSTMC1H1(lstm_t* step, const lstm_attr_t* attr);
+void GRUH1(gru_t* step, const gru_attr_t* attr);
+void GRUHtPart1(gru_t* step, const gru_attr_t* attr);
+void GRUHtPart2(gru_t* step, const gru_attr_t* attr);
+
+#define DECLARE_MORE_KERNEL(name)                                             \
+  class name##Kernel : public KernelMore<name##Tuple<T>> {                    \
+   public:                                                                    \
+    name##Kernel() { this->func = name; }                                     \
+    bool CanBeUsed(const typename name##Tuple<T>::attr_type&) const override; \
+    const char* ImplType() const override { return "AVX512"; }                \
+    int Priority() const override { return 1; }                               \
+  }
+
+// XYN
+DECLARE_MORE_KERNEL(VRelu);
+DECLARE_MORE_KERNEL(VSquare);
+DECLARE_MORE_KERNEL(VExp);
+DECLARE_MORE_KERNEL(VSigmoid);
+DECLARE_MORE_KERNEL(VTanh);
+
+DECLARE_MORE_KERNEL(VBroadcast);
+DECLARE_MORE_KERNEL(MatMul);
+DECLARE_MORE_KERNEL(SeqPool);
+DECLARE_MORE_KERNEL(EmbSeqPool);
+DECLARE_MORE_KERNEL(LayerNorm);
+DECLARE_MORE_KERNEL(Softmax);
+
+DECLARE_MORE_KERNEL(LSTMCtHt);
+DECLARE_MORE_KERNEL(LSTMC1H1);
+
+DECLARE_MORE_KERNEL(GRUH1);
+DECLARE_MORE_KERNEL(GRUHtPart1);
+DECLARE_MORE_KERNEL(GRUHtPart2);
+
+#undef DECLARE_MORE_KERNEL
+
+}  // namespace avx512
+}  // namespace more
+}  // namespace jit
+}  // namespace lite
+}  // namespace paddle
@@ -22,13 +22,154 @@
 #include <smmintrin.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
+#include "lite/backends/x86/jit/helper.h"
+#include "lite/backends/x86/jit/kernel_base.h"
+#include "lite/backends/x86/jit/kernels.h"
 
 namespace paddle {
 namespace lite {
 namespace x86 {
 namespace math {
 
+namespace {
+
+// The jit activation code is unrolled for the exact length, so long inputs
+// go through one kernel of this size and a second one for the tail.
+constexpr int kJitActBlock = 1024;
+
+constexpr float kSqrt1_2 = 0.70710678118654752f;
+
+template <typename KernelTuple>
+void JitActivate(const typename KernelTuple::data_type* din,
+                 typename KernelTuple::data_type* dout,
+                 int size) {
+  auto& cache =
+      lite::jit::KernelFuncs<KernelTuple, lite::fluid::CPUPlace>::Cache();
+  int blocks = size / kJitActBlock;
+  if (blocks > 0) {
+    auto block_func = cache.At(kJitActBlock);
+    for (int i = 0; i < blocks; ++i) {
+      block_func(din + i * kJitActBlock, dout + i * kJitActBlock, kJitActBlock);
+    }
+  }
+  int tail = size - blocks * kJitActBlock;
+  if (tail > 0) {
+    int offset = blocks * kJitActBlock;
+    cache.At(tail)(din + offset, dout + offset, tail);
+  }
+}
+
+#ifdef __AVX__
+// erf(x) after Abramowitz and Stegun 7.1.26, max error 1.5e-7.
+inline __m256 erf256_ps(__m256 x) {
+  const __m256 sign_mask = _mm256_set1_ps(-0.f);
+  const __m256 one = _mm256_set1_ps(1.f);
+  __m256 sign = _mm256_and_ps(x, sign_mask);
+  __m256 ax = _mm256_andnot_ps(sign_mask, x);
+  __m256 t = _mm256_div_ps(
+      one, _mm256_add_ps(one, _mm256_mul_ps(_mm256_set1_ps(0.3275911f), ax)));
+  __m256 poly = _mm256_set1_ps(1.061405429f);
+  poly = _mm256_add_ps(_mm256_mul_ps(poly, t), _mm256_set1_ps(-1.453152027f));
+  poly = _mm256_add_ps(_mm256_mul_ps(poly, t), _mm256_set1_ps(1.421413741f));
+  poly = _mm256_add_ps(_mm256_mul_ps(poly, t), _mm256_set1_ps(-0.284496736f));
+  poly = _mm256_add_ps(_mm256_mul_ps(poly, t), _mm256_set1_ps(0.254829592f));
+  poly = _mm256_mul_ps(poly, t);
+  __m256 e = exp256_ps(_mm256_sub_ps(_mm256_setzero_ps(),
+                                     _mm256_mul_ps(ax, ax)));
+  __m256 y = _mm256_sub_ps(one, _mm256_mul_ps(poly, e));
+  return _mm256_or_ps(y, sign);
+}
+#endif
+
+}  // namespace
+
+template <>
+void vrelu(const float* din, float* dout, int size) {
+  JitActivate<lite::jit::VReluTuple<float>>(din, dout, size);
+}
+
+template <>
+void vsigmoid(const float* din, float* dout, int size) {
+  JitActivate<lite::jit::VSigmoidTuple<float>>(din, dout, size);
+}
+
+template <>
+void vtanh(const float* din, float* dout, int size) {
+  JitActivate<lite::jit::VTanhTuple<float>>(din, dout, size);
+}
+
+template <>
+void vsquare(const float* din, float* dout, int size) {
+  JitActivate<lite::jit::VSquareTuple<float>>(din, dout, size);
+}
+
+template <>
+void gelu(const float* din, float* dout, int size) {
+  int i = 0;
+#ifdef __AVX__
+  const __m256 vhalf = _mm256_set1_ps(0.5f);
+  const __m256 vone = _mm256_set1_ps(1.f);
+  const __m256 vsqrt1_2 = _mm256_set1_ps(kSqrt1_2);
+  for (; i + 8 <= size; i += 8) {
+    __m256 vx = _mm256_loadu_ps(din + i);
+    __m256 verf = erf256_ps(_mm256_mul_ps(vx, vsqrt1_2));
+    __m256 vres = _mm256_mul_ps(_mm256_mul_ps(vx, vhalf),
+                                _mm256_add_ps(vone, verf));
+    _mm256_storeu_ps(dout + i, vres);
+  }
+#endif
+  for (; i < size; ++i) {
+    float x = din[i];
+    dout[i] = 0.5f * x * (1.f + std::erf(x * kSqrt1_2));
+  }
+}
+
+template <>
+void swish(const float* din, float* dout, int size, float beta) {
+  int i = 0;
+#ifdef __AVX__
+  const __m256 vone = _mm256_set1_ps(1.f);
+  const __m256 vneg_beta = _mm256_set1_ps(-beta);
+  for (; i + 8 <= size; i += 8) {
+    __m256 vx = _mm256_loadu_ps(din + i);
+    __m256 ve = exp256_ps(_mm256_mul_ps(vx, vneg_beta));
+    _mm256_storeu_ps(dout + i, _mm256_div_ps(vx, _mm256_add_ps(vone, ve)));
+  }
+#endif
+  for (; i < size; ++i) {
+    dout[i] = din[i] / (1.f + std::exp(-beta * din[i]));
+  }
+}
+
+template <>
+void hard_swish(const float* din,
+                float* dout,
+                int size,
+                float threshold,
+                float scale,
+                float offset) {
+  int i = 0;
+#ifdef __AVX__
+  const __m256 vzero = _mm256_setzero_ps();
+  const __m256 vthreshold = _mm256_set1_ps(threshold);
+  const __m256 vscale = _mm256_set1_ps(scale);
+  const __m256 voffset = _mm256_set1_ps(offset);
+  for (; i + 8 <= size; i += 8) {
+    __m256 vx = _mm256_loadu_ps(din + i);
+    __m256 vclip = _mm256_min_ps(
+        _mm256_max_ps(_mm256_add_ps(vx, voffset), vzero), vthreshold);
+    _mm256_storeu_ps(dout + i,
+                     _mm256_div_ps(_mm256_mul_ps(vclip, vx), vscale));
+  }
+#endif
+  for (; i < size; ++i) {
+    float clip = (std::min)((std::max)(0.f, din[i] + offset), threshold);
+    dout[i] = clip * din[i] / scale;
+  }
+}
+
 template <>
 void mish(const float* din, float* dout, int size, float threshold) {
 #ifdef __AVX__
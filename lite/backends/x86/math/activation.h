@@ -14,11 +14,60 @@
 
 #pragma once
 
+#include <cstdint>
+#include "lite/backends/x86/parallel.h"
+
 namespace paddle {
 namespace lite {
 namespace x86 {
 namespace math {
 
+// Minimum elements per thread. Cheap activations are bound by memory
+// bandwidth and need long chunks to pay for the fork, transcendental ones
+// get there much sooner.
+constexpr int64_t kActGrainLight = 32768;
+constexpr int64_t kActGrainHeavy = 4096;
+
+// Runs act(din, dout, n) over |size| elements split across the OpenMP
+// threads, each thread taking at least |grain| elements.
+template <typename T, typename Act>
+void ParallelActivate(
+    const T* din, T* dout, int64_t size, int64_t grain, Act act) {
+  RunParallelFor(0, size, grain, [&](int64_t begin, int64_t end) {
+    act(din + begin, dout + begin, static_cast<int>(end - begin));
+  });
+}
+
+// relu, sigmoid, tanh and square on the jit vector kernels.
+template <typename T>
+void vrelu(const T* din, T* dout, int size);
+
+template <typename T>
+void vsigmoid(const T* din, T* dout, int size);
+
+template <typename T>
+void vtanh(const T* din, T* dout, int size);
+
+template <typename T>
+void vsquare(const T* din, T* dout, int size);
+
+// gelu(x) = 0.5 * x * (1 + erf(x / sqrt(2)))
+template <typename T>
+void gelu(const T* din, T* dout, int size);
+
+// swish(x) = x / (1 + exp(-beta * x))
+template <typename T>
+void swish(const T* din, T* dout, int size, float beta);
+
+// hard_swish(x) = min(max(0, x + offset), threshold) * x / scale
+template <typename T>
+void hard_swish(const T* din,
+                T* dout,
+                int size,
+                float threshold,
+                float scale,
+                float offset);
+
 template <typename T>
 void mish(const T* din, T* dout, int size, float threshold);
 
@@ -0,0 +1,457 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/avx/pooling.h"
+#include <immintrin.h>
+#include <algorithm>
+#include <cfloat>
+#include "lite/backends/x86/math/pooling.h"
+#include "lite/backends/x86/parallel.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+// Minimum input elements per thread.
+constexpr int64_t kPoolGrain = 16384;
+
+// Runs f(plane) for the |planes| planes of |plane_size| input elements.
+template <typename Func>
+void ParallelPlanes(int64_t planes, int64_t plane_size, Func f) {
+  int64_t grain =
+      (std::max<int64_t>)(1, kPoolGrain / (std::max<int64_t>)(plane_size, 1));
+  RunParallelFor(0, planes, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) f(i);
+  });
+}
+
+struct MaxOp {
+  static constexpr bool kAvg = false;
+  static float Init() { return -FLT_MAX; }
+  static __m256 InitM256() { return _mm256_set1_ps(-FLT_MAX); }
+  static float Compute(float y, float x) { return y > x ? y : x; }
+  static __m256 Compute(__m256 y, __m256 x) { return _mm256_max_ps(y, x); }
+  static float Reduce(__m256 v) {
+    __m128 r =
+        _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    r = _mm_max_ps(r, _mm_movehl_ps(r, r));
+    r = _mm_max_ss(r, _mm_shuffle_ps(r, r, 1));
+    return _mm_cvtss_f32(r);
+  }
+};
+
+struct AvgOp {
+  static constexpr bool kAvg = true;
+  static float Init() { return 0.f; }
+  static __m256 InitM256() { return _mm256_setzero_ps(); }
+  static float Compute(float y, float x) { return y + x; }
+  static __m256 Compute(__m256 y, __m256 x) { return _mm256_add_ps(y, x); }
+  static float Reduce(__m256 v) {
+    __m128 r =
+        _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    r = _mm_add_ps(r, _mm_movehl_ps(r, r));
+    r = _mm_add_ss(r, _mm_shuffle_ps(r, r, 1));
+    return _mm_cvtss_f32(r);
+  }
+};
+
+// One output of a window clipped to [hs, he) x [ws, we).
+template <typename Op>
+inline float PoolWindow(
+    const float* in, int win, int hs, int he, int ws, int we, int pool_size) {
+  float res = Op::Init();
+  for (int h = hs; h < he; ++h) {
+    for (int w = ws; w < we; ++w) {
+      res = Op::Compute(res, in[h * win + w]);
+    }
+  }
+  return Op::kAvg ? res / pool_size : res;
+}
+
+template <int K, int S, typename Op>
+void PoolingKxK(const float* din,
+                float* dout,
+                int num,
+                int ch,
+                int hin,
+                int win,
+                int hout,
+                int wout,
+                int pad_top,
+                int pad_left,
+                bool exclusive) {
+  const int in_size = hin * win;
+  const int out_size = hout * wout;
+  // The first output column whose window starts inside the row.
+  const int ow_begin = (std::min)((pad_left + S - 1) / S, wout);
+  ParallelPlanes(num * ch, in_size, [&](int64_t plane) {
+    const float* in = din + plane * in_size;
+    float* out = dout + plane * out_size;
+    for (int oh = 0; oh < hout; ++oh) {
+      int hs = oh * S - pad_top;
+      int he = (std::min)(hs + K, hin);
+      hs = (std::max)(hs, 0);
+      const int rows = he - hs;
+      const int full_size = exclusive ? rows * K : K * K;
+      float* out_row = out + oh * wout;
+      auto scalar = [&](int ow) {
+        int ws = ow * S - pad_left;
+        int we = (std::min)(ws + K, win);
+        ws = (std::max)(ws, 0);
+        int size = exclusive ? rows * (we - ws) : K * K;
+        out_row[ow] = PoolWindow<Op>(in, win, hs, he, ws, we, size);
+      };
+      int ow = 0;
+      for (; ow < ow_begin; ++ow) scalar(ow);
+      for (; ow + 8 <= wout; ow += 8) {
+        const int ws = ow * S - pad_left;
+        // The loads of the last tap must stay in the row.
+        if (ws + K - 1 + 8 * S > win) break;
+        __m256 acc = Op::InitM256();
+        for (int h = hs; h < he; ++h) {
+          const float* p = in + h * win + ws;
+          for (int kw = 0; kw < K; ++kw) {
+            if (S == 1) {
+              acc = Op::Compute(acc, _mm256_loadu_ps(p + kw));
+            } else {
+              // Even columns of p[0, 16) in the order 0 2 8 10 4 6 12 14.
+              __m256 even = _mm256_shuffle_ps(_mm256_loadu_ps(p + kw),
+                                              _mm256_loadu_ps(p + kw + 8),
+                                              _MM_SHUFFLE(2, 0, 2, 0));
+              acc = Op::Compute(acc, even);
+            }
+          }
+        }
+        if (S == 2) {
+          __m256d pairs = _mm256_castps_pd(acc);
+          pairs = _mm256_permute4x64_pd(pairs, _MM_SHUFFLE(3, 1, 2, 0));
+          acc = _mm256_castpd_ps(pairs);
+        }
+        if (Op::kAvg) {
+          acc = _mm256_div_ps(acc, _mm256_set1_ps(full_size));
+        }
+        _mm256_storeu_ps(out_row + ow, acc);
+      }
+      for (; ow < wout; ++ow) scalar(ow);
+    }
+  });
+}
+
+template <int K, int S>
+void PoolingKxK(const float* din,
+                float* dout,
+                int num,
+                int ch,
+                int hin,
+                int win,
+                int hout,
+                int wout,
+                int pad_top,
+                int pad_left,
+                bool exclusive,
+                const std::string& pooling_type) {
+  if (pooling_type == "max") {
+    PoolingKxK<K, S, MaxOp>(
+        din, dout, num, ch, hin, win, hout, wout, pad_top, pad_left, true);
+  } else {
+    PoolingKxK<K, S, AvgOp>(
+        din, dout, num, ch, hin, win, hout, wout, pad_top, pad_left, exclusive);
+  }
+}
+
+template <typename Op>
+void PoolingGlobal(const float* din, float* dout, int num, int ch, int size) {
+  ParallelPlanes(num * ch, size, [&](int64_t plane) {
+    const float* in = din + plane * size;
+    __m256 acc0 = Op::InitM256();
+    __m256 acc1 = Op::InitM256();
+    int i = 0;
+    for (; i + 16 <= size; i += 16) {
+      acc0 = Op::Compute(acc0, _mm256_loadu_ps(in + i));
+      acc1 = Op::Compute(acc1, _mm256_loadu_ps(in + i + 8));
+    }
+    for (; i + 8 <= size; i += 8) {
+      acc0 = Op::Compute(acc0, _mm256_loadu_ps(in + i));
+    }
+    float res = Op::Reduce(Op::Compute(acc0, acc1));
+    for (; i < size; ++i) res = Op::Compute(res, in[i]);
+    dout[plane] = Op::kAvg ? res / size : res;
+  });
+}
+
+template <typename Op>
+void PoolingAdaptive(const float* din,
+                     float* dout,
+                     int num,
+                     int ch,
+                     int hin,
+                     int win,
+                     int hout,
+                     int wout) {
+  const int in_size = hin * win;
+  const int out_size = hout * wout;
+  int64_t grain =
+      (std::max<int64_t>)(1, kPoolGrain / (std::max<int64_t>)(in_size, 1));
+  RunParallelFor(0, num * ch, grain, [&](int64_t begin, int64_t end) {
+    std::vector<float> row(win);
+    for (int64_t plane = begin; plane < end; ++plane) {
+      const float* in = din + plane * in_size;
+      float* out = dout + plane * out_size;
+      for (int oh = 0; oh < hout; ++oh) {
+        const int hs = AdaptStartIndex(oh, hin, hout);
+        const int he = AdaptEndIndex(oh, hin, hout);
+        int w = 0;
+        for (; w + 8 <= win; w += 8) {
+          __m256 acc = Op::InitM256();
+          for (int h = hs; h < he; ++h) {
+            acc = Op::Compute(acc, _mm256_loadu_ps(in + h * win + w));
+          }
+          _mm256_storeu_ps(row.data() + w, acc);
+        }
+        for (; w < win; ++w) {
+          float acc = Op::Init();
+          for (int h = hs; h < he; ++h) acc = Op::Compute(acc, in[h * win + w]);
+          row[w] = acc;
+        }
+        for (int ow = 0; ow < wout; ++ow) {
+          const int ws = AdaptStartIndex(ow, win, wout);
+          const int we = AdaptEndIndex(ow, win, wout);
+          float res = Op::Init();
+          for (w = ws; w < we; ++w) res = Op::Compute(res, row[w]);
+          out[oh * wout + ow] = Op::kAvg ? res / ((he - hs) * (we - ws)) : res;
+        }
+      }
+    }
+  });
+}
+
+template <typename Op>
+void PoolingPack8(const float* din,
+                  float* dout,
+                  int num,
+                  int ch_block,
+                  int hin,
+                  int win,
+                  int hout,
+                  int wout,
+                  const std::vector<int>& ksize,
+                  const std::vector<int>& strides,
+                  const std::vector<int>& paddings,
+                  bool exclusive,
+                  bool adaptive) {
+  const int in_size = hin * win * 8;
+  const int out_size = hout * wout * 8;
+  ParallelPlanes(num * ch_block, in_size, [&](int64_t plane) {
+    const float* in = din + plane * in_size;
+    float* out = dout + plane * out_size;
+    for (int oh = 0; oh < hout; ++oh) {
+      int hs, he;
+      if (adaptive) {
+        hs = AdaptStartIndex(oh, hin, hout);
+        he = AdaptEndIndex(oh, hin, hout);
+      } else {
+        hs = oh * strides[0] - paddings[0];
+        he = (std::min)(hs + ksize[0], hin);
+        hs = (std::max)(hs, 0);
+      }
+      for (int ow = 0; ow < wout; ++ow) {
+        int ws, we;
+        if (adaptive) {
+          ws = AdaptStartIndex(ow, win, wout);
+          we = AdaptEndIndex(ow, win, wout);
+        } else {
+          ws = ow * strides[1] - paddings[2];
+          we = (std::min)(ws + ksize[1], win);
+          ws = (std::max)(ws, 0);
+        }
+        __m256 acc = Op::InitM256();
+        for (int h = hs; h < he; ++h) {
+          const float* p = in + (h * win + ws) * 8;
+          for (int w = ws; w < we; ++w, p += 8) {
+            acc = Op::Compute(acc, _mm256_loadu_ps(p));
+          }
+        }
+        if (Op::kAvg) {
+          int pool_size = (exclusive || adaptive) ? (he - hs) * (we - ws)
+                                                  : ksize[0] * ksize[1];
+          acc = _mm256_div_ps(acc, _mm256_set1_ps(pool_size));
+        }
+        _mm256_storeu_ps(out + (oh * wout + ow) * 8, acc);
+      }
+    }
+  });
+}
+
+}  // namespace
+
+void pooling2x2s2_m256(const float* din,
+                       float* dout,
+                       int num,
+                       int ch,
+                       int hin,
+                       int win,
+                       int hout,
+                       int wout,
+                       int pad_top,
+                       int pad_left,
+                       bool exclusive,
+                       const std::string& pooling_type) {
+  PoolingKxK<2, 2>(din,
+                   dout,
+                   num,
+                   ch,
+                   hin,
+                   win,
+                   hout,
+                   wout,
+                   pad_top,
+                   pad_left,
+                   exclusive,
+                   pooling_type);
+}
+
+void pooling3x3s1_m256(const float* din,
+                       float* dout,
+                       int num,
+                       int ch,
+                       int hin,
+                       int win,
+                       int hout,
+                       int wout,
+                       int pad_top,
+                       int pad_left,
+                       bool exclusive,
+                       const std::string& pooling_type) {
+  PoolingKxK<3, 1>(din,
+                   dout,
+                   num,
+                   ch,
+                   hin,
+                   win,
+                   hout,
+                   wout,
+                   pad_top,
+                   pad_left,
+                   exclusive,
+                   pooling_type);
+}
+
+void pooling3x3s2_m256(const float* din,
+                       float* dout,
+                       int num,
+                       int ch,
+                       int hin,
+                       int win,
+                       int hout,
+                       int wout,
+                       int pad_top,
+                       int pad_left,
+                       bool exclusive,
+                       const std::string& pooling_type) {
+  PoolingKxK<3, 2>(din,
+                   dout,
+                   num,
+                   ch,
+                   hin,
+                   win,
+                   hout,
+                   wout,
+                   pad_top,
+                   pad_left,
+                   exclusive,
+                   pooling_type);
+}
+
+void pooling_global_m256(const float* din,
+                         float* dout,
+                         int num,
+                         int ch,
+                         int hin,
+                         int win,
+                         const std::string& pooling_type) {
+  if (pooling_type == "max") {
+    PoolingGlobal<MaxOp>(din, dout, num, ch, hin * win);
+  } else {
+    PoolingGlobal<AvgOp>(din, dout, num, ch, hin * win);
+  }
+}
+
+void pooling_adaptive_m256(const float* din,
+                           float* dout,
+                           int num,
+                           int ch,
+                           int hin,
+                           int win,
+                           int hout,
+                           int wout,
+                           const std::string& pooling_type) {
+  if (pooling_type == "max") {
+    PoolingAdaptive<MaxOp>(din, dout, num, ch, hin, win, hout, wout);
+  } else {
+    PoolingAdaptive<AvgOp>(din, dout, num, ch, hin, win, hout, wout);
+  }
+}
+
+void pooling_pack8_m256(const float* din,
+                        float* dout,
+                        int num,
+                        int ch_block,
+                        int hin,
+                        int win,
+                        int hout,
+                        int wout,
+                        const std::vector<int>& ksize,
+                        const std::vector<int>& strides,
+                        const std::vector<int>& paddings,
+                        bool exclusive,
+                        bool adaptive,
+                        const std::string& pooling_type) {
+  if (pooling_type == "max") {
+    PoolingPack8<MaxOp>(din,
+                        dout,
+                        num,
+                        ch_block,
+                        hin,
+                        win,
+                        hout,
+                        wout,
+                        ksize,
+                        strides,
+                        paddings,
+                        exclusive,
+                        adaptive);
+  } else {
+    PoolingPack8<AvgOp>(din,
+                        dout,
+                        num,
+                        ch_block,
+                        hin,
+                        win,
+                        hout,
+                        wout,
+                        ksize,
+                        strides,
+                        paddings,
+                        exclusive,
+                        adaptive);
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,112 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// All the functions below match Pool2dFunctor: windows are clipped to the
+// input, max starts from -FLT_MAX, and avg divides by the clipped window
+// size when exclusive (or adaptive), by the full window size otherwise.
+// Only the top and left paddings are needed, the bottom and right ones are
+// already part of the output size. Planes are split across the threads.
+
+// NCHW pooling with a square window, eight output columns at a time.
+void pooling2x2s2_m256(const float* din,
+                       float* dout,
+                       int num,
+                       int ch,
+                       int hin,
+                       int win,
+                       int hout,
+                       int wout,
+                       int pad_top,
+                       int pad_left,
+                       bool exclusive,
+                       const std::string& pooling_type);
+
+void pooling3x3s1_m256(const float* din,
+                       float* dout,
+                       int num,
+                       int ch,
+                       int hin,
+                       int win,
+                       int hout,
+                       int wout,
+                       int pad_top,
+                       int pad_left,
+                       bool exclusive,
+                       const std::string& pooling_type);
+
+void pooling3x3s2_m256(const float* din,
+                       float* dout,
+                       int num,
+                       int ch,
+                       int hin,
+                       int win,
+                       int hout,
+                       int wout,
+                       int pad_top,
+                       int pad_left,
+                       bool exclusive,
+                       const std::string& pooling_type);
+
+// NCHW pooling of each whole plane to one value.
+void pooling_global_m256(const float* din,
+                         float* dout,
+                         int num,
+                         int ch,
+                         int hin,
+                         int win,
+                         const std::string& pooling_type);
+
+// NCHW adaptive pooling. The window rows are reduced first over the whole
+// width, then each window reduces its columns of that row.
+void pooling_adaptive_m256(const float* din,
+                           float* dout,
+                           int num,
+                           int ch,
+                           int hin,
+                           int win,
+                           int hout,
+                           int wout,
+                           const std::string& pooling_type);
+
+// Pooling of any window on the blocked layout [num, ch_block, h, w, 8] made
+// by pack8_m256, one ymm register holding eight channels.
+void pooling_pack8_m256(const float* din,
+                        float* dout,
+                        int num,
+                        int ch_block,
+                        int hin,
+                        int win,
+                        int hout,
+                        int wout,
+                        const std::vector<int>& ksize,
+                        const std::vector<int>& strides,
+                        const std::vector<int>& paddings,
+                        bool exclusive,
+                        bool adaptive,
+                        const std::string& pooling_type);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
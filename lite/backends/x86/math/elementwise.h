@@ -13,14 +13,77 @@
 // limitations under the License.
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include "lite/backends/x86/math/elementwise_common_broadcast_config.h"
+#include "lite/backends/x86/parallel.h"
 
 namespace paddle {
 namespace lite {
 namespace x86 {
 namespace math {
 
+// Minimum elements per thread. Elementwise ops are bound by memory
+// bandwidth, so shorter chunks cost more in the fork than they save.
+constexpr int64_t kElementwiseGrain = 32768;
+
+template <class Config>
+void elementwise_range_to_range_parallel(const typename Config::T* dinx,
+                                         const typename Config::T* diny,
+                                         typename Config::T* dout,
+                                         int num) {
+  RunParallelFor(0, num, kElementwiseGrain, [&](int64_t begin, int64_t end) {
+    elementwise_range_to_range<Config>(dinx + begin,
+                                       diny + begin,
+                                       dout + begin,
+                                       static_cast<int>(end - begin));
+  });
+}
+
+// Broadcasts y of shape [channels] over x of shape [batch, channels, num],
+// or x over y when |inv| is set.
+template <class Config>
+void elementwise_broadcast_parallel(const typename Config::T* dinx,
+                                    const typename Config::T* diny,
+                                    typename Config::T* dout,
+                                    int batch,
+                                    int channels,
+                                    int num,
+                                    bool inv) {
+  if (num == 1) {
+    // [batch, channels] against [channels]: each batch is a plain
+    // elementwise op on contiguous rows.
+    int64_t grain =
+        (std::max<int64_t>)(1, kElementwiseGrain / (std::max)(channels, 1));
+    RunParallelFor(0, batch, grain, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        int64_t offset = i * channels;
+        const auto* dinx_ptr = inv ? dinx : dinx + offset;
+        const auto* diny_ptr = inv ? diny + offset : diny;
+        elementwise_range_to_range<Config>(
+            dinx_ptr, diny_ptr, dout + offset, channels);
+      }
+    });
+    return;
+  }
+  int64_t rows = static_cast<int64_t>(batch) * channels;
+  int64_t grain =
+      (std::max<int64_t>)(1, kElementwiseGrain / (std::max)(num, 1));
+  RunParallelFor(0, rows, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t r = begin; r < end; ++r) {
+      int j = static_cast<int>(r % channels);
+      int64_t offset = r * num;
+      if (inv) {
+        elementwise_one_to_range<Config>(
+            dinx + j, diny + offset, dout + offset, num);
+      } else {
+        elementwise_range_to_one<Config>(
+            dinx + offset, diny + j, dout + offset, num);
+      }
+    }
+  });
+}
+
 #define ElementWiseFunc(op)                                                    \
   template <typename T>                                                        \
   void Elementwise_##op(const T* dinx,                                         \
@@ -30,124 +93,52 @@ namespace math {
                         bool has_active,                                       \
                         std::string act_type) {                                \
     if (act_type == "tanh") {                                                  \
-      lite::x86::math::elementwise_range_to_range<                             \
+      lite::x86::math::elementwise_range_to_range_parallel<                    \
           MergeConfig<op##Config<T>, ActiveConfig<ActiveType::TANH, T>>>(      \
           dinx, diny, dout, num);                                              \
     } else if (act_type == "relu") {                                           \
-      lite::x86::math::elementwise_range_to_range<                             \
+      lite::x86::math::elementwise_range_to_range_parallel<                    \
           MergeConfig<op##Config<T>, ActiveConfig<ActiveType::RELU, T>>>(      \
           dinx, diny, dout, num);                                              \
     } else if (act_type == "sigmoid") {                                        \
-      lite::x86::math::elementwise_range_to_range<                             \
+      lite::x86::math::elementwise_range_to_range_parallel<                    \
           MergeConfig<op##Config<T>, ActiveConfig<ActiveType::SIGMOID, T>>>(   \
           dinx, diny, dout, num);                                              \
     } else {                                                                   \
-      lite::x86::math::elementwise_range_to_range<                             \
+      lite::x86::math::elementwise_range_to_range_parallel<                    \
           MergeConfig<op##Config<T>, ActiveConfig<ActiveType::NO_ACTIVE, T>>>( \
           dinx, diny, dout, num);                                              \
     }                                                                          \
   }
 
-#define ElementWiseFuncBCast(op)                                      \
-  template <typename T>                                               \
-  void Elementwise_Broadcast_##op(const T* dinx,                      \
-                                  const T* diny,                      \
-                                  T* dout,                            \
-                                  int batch,                          \
-                                  int channels,                       \
-                                  int num,                            \
-                                  bool has_active,                    \
-                                  std::string act_type,               \
-                                  bool inv) {                         \
-    if (act_type == "tanh") {                                         \
-      for (int i = 0; i < batch; ++i) {                               \
-        for (int j = 0; j < channels; ++j) {                          \
-          int offset = (i * channels + j) * num;                      \
-          auto* dout_ptr = dout + offset;                             \
-          if (inv) {                                                  \
-            const auto* dinx_ptr = dinx + j;                          \
-            const auto* diny_ptr = diny + offset;                     \
-            lite::x86::math::elementwise_one_to_range<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::TANH, T>>>(      \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          } else {                                                    \
-            const auto* dinx_ptr = dinx + offset;                     \
-            const auto* diny_ptr = diny + j;                          \
-            lite::x86::math::elementwise_range_to_one<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::TANH, T>>>(      \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          }                                                           \
-        }                                                             \
-      }                                                               \
-    } else if (act_type == "relu") {                                  \
-      for (int i = 0; i < batch; ++i) {                               \
-        for (int j = 0; j < channels; ++j) {                          \
-          int offset = (i * channels + j) * num;                      \
-          auto* dout_ptr = dout + offset;                             \
-          if (inv) {                                                  \
-            const auto* dinx_ptr = dinx + j;                          \
-            const auto* diny_ptr = diny + offset;                     \
-            lite::x86::math::elementwise_one_to_range<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::RELU, T>>>(      \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          } else {                                                    \
-            const auto* dinx_ptr = dinx + offset;                     \
-            const auto* diny_ptr = diny + j;                          \
-            lite::x86::math::elementwise_range_to_one<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::RELU, T>>>(      \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          }                                                           \
-        }                                                             \
-      }                                                               \
-    } else if (act_type == "sigmoid") {                               \
-      for (int i = 0; i < batch; ++i) {                               \
-        for (int j = 0; j < channels; ++j) {                          \
-          int offset = (i * channels + j) * num;                      \
-          auto* dout_ptr = dout + offset;                             \
-          if (inv) {                                                  \
-            const auto* dinx_ptr = dinx + j;                          \
-            const auto* diny_ptr = diny + offset;                     \
-            lite::x86::math::elementwise_one_to_range<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::SIGMOID, T>>>(   \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          } else {                                                    \
-            const auto* dinx_ptr = dinx + offset;                     \
-            const auto* diny_ptr = diny + j;                          \
-            lite::x86::math::elementwise_range_to_one<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::SIGMOID, T>>>(   \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          }                                                           \
-        }                                                             \
-      }                                                               \
-    } else {                                                          \
-      for (int i = 0; i < batch; ++i) {                               \
-        for (int j = 0; j < channels; ++j) {                          \
-          int offset = (i * channels + j) * num;                      \
-          auto* dout_ptr = dout + offset;                             \
-          if (inv) {                                                  \
-            const auto* dinx_ptr = dinx + j;                          \
-            const auto* diny_ptr = diny + offset;                     \
-            lite::x86::math::elementwise_one_to_range<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::NO_ACTIVE, T>>>( \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          } else {                                                    \
-            const auto* dinx_ptr = dinx + offset;                     \
-            const auto* diny_ptr = diny + j;                          \
-            lite::x86::math::elementwise_range_to_one<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::NO_ACTIVE, T>>>( \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          }                                                           \
-        }                                                             \
-      }                                                               \
-    }                                                                 \
+#define ElementWiseFuncBCast(op)                                               \
+  template <typename T>                                                        \
+  void Elementwise_Broadcast_##op(const T* dinx,                               \
+                                  const T* diny,                               \
+                                  T* dout,                                     \
+                                  int batch,                                   \
+                                  int channels,                                \
+                                  int num,                                     \
+                                  bool has_active,                             \
+                                  std::string act_type,                        \
+                                  bool inv) {                                  \
+    if (act_type == "tanh") {                                                  \
+      lite::x86::math::elementwise_broadcast_parallel<                         \
+          MergeConfig<op##Config<T>, ActiveConfig<ActiveType::TANH, T>>>(      \
+          dinx, diny, dout, batch, channels, num, inv);                        \
+    } else if (act_type == "relu") {                                           \
+      lite::x86::math::elementwise_broadcast_parallel<                         \
+          MergeConfig<op##Config<T>, ActiveConfig<ActiveType::RELU, T>>>(      \
+          dinx, diny, dout, batch, channels, num, inv);                        \
+    } else if (act_type == "sigmoid") {                                        \
+      lite::x86::math::elementwise_broadcast_parallel<                         \
+          MergeConfig<op##Config<T>, ActiveConfig<ActiveType::SIGMOID, T>>>(   \
+          dinx, diny, dout, batch, channels, num, inv);                        \
+    } else {                                                                   \
+      lite::x86::math::elementwise_broadcast_parallel<                         \
+          MergeConfig<op##Config<T>, ActiveConfig<ActiveType::NO_ACTIVE, T>>>( \
+          dinx, diny, dout, batch, channels, num, inv);                        \
+    }                                                                          \
   }
 
 // marco func add
@@ -0,0 +1,176 @@
+/* Copyright (c) 2018 paddlepaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "lite/backends/x86/math/gemm_bf16.h"
+#include <algorithm>
+#include <vector>
+#include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/parallel.h"
+#include "lite/utils/bfloat16.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+// Batches up to this size use the streaming kernel.
+constexpr int kStreamMaxM = 4;
+// Columns per streaming block, four ymm accumulators per row.
+constexpr int kStreamBlock = 32;
+// Bytes of widened B per GEMM panel when the L2 size is unknown.
+constexpr int64_t kDefaultPanelBytes = 512 * 1024;
+
+// Keep a widened panel in about half of the private L2 of a core.
+int64_t PanelBytes(const X86Context& context) {
+  int64_t l2 = static_cast<int64_t>(context.l2_cache_size());
+  return l2 > 0 ? l2 / 2 : kDefaultPanelBytes;
+}
+
+#ifdef __AVX2__
+inline __m256 load_bf16x8(const uint16_t* src) {
+  __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+  __m256i wide = _mm256_slli_epi32(_mm256_cvtepu16_epi32(half), 16);
+  return _mm256_castsi256_ps(wide);
+}
+#endif
+
+void stream_block(int M,
+                  int K,
+                  int N,
+                  const float* A,
+                  const uint16_t* B,
+                  int ldb,
+                  float* C,
+                  int n0) {
+#ifdef __AVX2__
+  __m256 acc[kStreamMaxM][4];
+  for (int m = 0; m < M; ++m) {
+    for (int j = 0; j < 4; ++j) acc[m][j] = _mm256_setzero_ps();
+  }
+  for (int k = 0; k < K; ++k) {
+    const uint16_t* b = B + static_cast<int64_t>(k) * ldb + n0;
+    __m256 b0 = load_bf16x8(b);
+    __m256 b1 = load_bf16x8(b + 8);
+    __m256 b2 = load_bf16x8(b + 16);
+    __m256 b3 = load_bf16x8(b + 24);
+    for (int m = 0; m < M; ++m) {
+      __m256 a = _mm256_set1_ps(A[m * K + k]);
+      acc[m][0] = _mm256_fmadd_ps(a, b0, acc[m][0]);
+      acc[m][1] = _mm256_fmadd_ps(a, b1, acc[m][1]);
+      acc[m][2] = _mm256_fmadd_ps(a, b2, acc[m][2]);
+      acc[m][3] = _mm256_fmadd_ps(a, b3, acc[m][3]);
+    }
+  }
+  for (int m = 0; m < M; ++m) {
+    float* c = C + m * N + n0;
+    for (int j = 0; j < 4; ++j) _mm256_storeu_ps(c + j * 8, acc[m][j]);
+  }
+#else
+  float acc[kStreamMaxM][kStreamBlock] = {{0.f}};
+  for (int k = 0; k < K; ++k) {
+    const uint16_t* b = B + static_cast<int64_t>(k) * ldb + n0;
+    for (int m = 0; m < M; ++m) {
+      float a = A[m * K + k];
+      for (int j = 0; j < kStreamBlock; ++j) {
+        acc[m][j] += a * BFloat16ToFloat(b[j]);
+      }
+    }
+  }
+  for (int m = 0; m < M; ++m) {
+    std::copy(acc[m], acc[m] + kStreamBlock, C + m * N + n0);
+  }
+#endif
+}
+
+void stream_tail(int M,
+                 int K,
+                 int N,
+                 const float* A,
+                 const uint16_t* B,
+                 int ldb,
+                 float* C,
+                 int n0) {
+  for (int m = 0; m < M; ++m) {
+    for (int n = n0; n < N; ++n) {
+      float sum = 0.f;
+      for (int k = 0; k < K; ++k) {
+        sum += A[m * K + k] *
+               BFloat16ToFloat(B[static_cast<int64_t>(k) * ldb + n]);
+      }
+      C[m * N + n] = sum;
+    }
+  }
+}
+
+}  // namespace
+
+void bf16_to_fp32(const uint16_t* src, float* dst, int64_t n) {
+  int64_t i = 0;
+#ifdef __AVX2__
+  for (; i + 7 < n; i += 8) {
+    _mm256_storeu_ps(dst + i, load_bf16x8(src + i));
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i] = BFloat16ToFloat(src[i]);
+  }
+}
+
+void matmul_bf16(const X86Context& context,
+                 int M,
+                 int N,
+                 int K,
+                 const float* A,
+                 const uint16_t* B,
+                 int ldb,
+                 float* C) {
+  if (M <= kStreamMaxM) {
+    int blocks = N / kStreamBlock;
+    lite::x86::RunParallelFor(0, blocks, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        stream_block(M, K, N, A, B, ldb, C, i * kStreamBlock);
+      }
+    });
+    stream_tail(M, K, N, A, B, ldb, C, blocks * kStreamBlock);
+    return;
+  }
+
+  auto blas = GetBlas<lite::TargetType::kX86, float>(context);
+  int64_t width =
+      PanelBytes(context) / (static_cast<int64_t>(K) * sizeof(float));
+  width = std::max<int64_t>(16, width / 16 * 16);
+  int panel_width = static_cast<int>(std::min<int64_t>(width, N));
+  std::vector<float> panel(static_cast<size_t>(K) * panel_width);
+  for (int n0 = 0; n0 < N; n0 += panel_width) {
+    int w = std::min(panel_width, N - n0);
+    float* dst = panel.data();
+    lite::x86::RunParallelFor(0, K, [&](int64_t begin, int64_t end) {
+      for (int64_t k = begin; k < end; ++k) {
+        bf16_to_fp32(B + k * ldb + n0, dst + k * w, w);
+      }
+    });
+    blas.GEMM(false, false, M, w, K, 1.f, A, K, dst, w, 0.f, C + n0, N);
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,43 @@
+/* Copyright (c) 2018 paddlepaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#pragma once
+
+#include <stdint.h>
+#include "lite/core/context.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// Widens n bfloat16 values (raw bits) to float.
+void bf16_to_fp32(const uint16_t* src, float* dst, int64_t n);
+
+// C(MxN) = A(MxK) * B(KxN), A and C are dense row-major float, B holds
+// bfloat16 bits with a row stride of ldb. Small batches stream B through
+// FMA directly, larger ones widen B panel by panel and call GEMM.
+void matmul_bf16(const X86Context& context,
+                 int M,
+                 int N,
+                 int K,
+                 const float* A,
+                 const uint16_t* B,
+                 int ldb,
+                 float* C);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
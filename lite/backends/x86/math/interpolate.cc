@@ -13,498 +13,283 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include "lite/backends/x86/math/interpolate.h"
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+#include <algorithm>
+#include <cstring>
 #include <string>
+#include <utility>
 #include <vector>
 #include "lite/backends/x86/math/math_function.h"
+#include "lite/backends/x86/parallel.h"
 
 namespace paddle {
 namespace lite {
 namespace x86 {
 namespace math {
 
-void bilinear_interp(const float* input_data,
-                     float* output_data,
-                     const float ratio_h,
-                     const float ratio_w,
-                     const int h_in,
-                     const int w_in,
-                     const int n,
-                     const int c,
-                     const int h_out,
-                     const int w_out,
-                     const bool align_corners,
-                     const bool align_mode) {
-  int* buf = static_cast<int*>(lite::host::malloc(
-      sizeof(int) * (w_out + h_out + w_out * 2 + h_out * 2)));
-
-  int* xofs = buf;
-  int* yofs = buf + w_out;
-
-  float* alpha = reinterpret_cast<float*>(buf + w_out + h_out);
-  float* beta = reinterpret_cast<float*>(buf + w_out + h_out + w_out * 2);
-
-  float fx = 0.0f;
-  float fy = 0.0f;
-  int sx = 0;
-  int sy = 0;
-  if (align_corners) {
-    // calculate x axis coordinate
-    for (int dx = 0; dx < w_out; dx++) {
-      fx = dx * ratio_w;
-      sx = static_cast<int>(fx);
-      fx -= sx;
-      xofs[dx] = sx;
-      alpha[dx * 2] = 1.f - fx;
-      alpha[dx * 2 + 1] = fx;
-    }
-    // calculate y axis coordinate
-    for (int dy = 0; dy < h_out; dy++) {
-      fy = dy * ratio_h;
-      sy = static_cast<int>(fy);
-      fy -= sy;
-      yofs[dy] = sy;
-      beta[dy * 2] = 1.f - fy;
-      beta[dy * 2 + 1] = fy;
-    }
-  } else {
-    // calculate x axis coordinate
-    for (int dx = 0; dx < w_out; dx++) {
-      fx = align_mode ? ratio_w * dx : ratio_w * (dx + 0.5f) - 0.5f;
-      fx = fx < 0 ? 0.f : fx;
-      sx = static_cast<int>(fx);
-      fx -= sx;
-      xofs[dx] = sx;
-      alpha[dx * 2] = 1.f - fx;
-      alpha[dx * 2 + 1] = fx;
-    }
-    // calculate y axis coordinate
-    for (int dy = 0; dy < h_out; dy++) {
-      fy = align_mode ? ratio_h * dy : ratio_h * (dy + 0.5f) - 0.5f;
-      fy = fy < 0 ? 0.f : fy;
-      sy = static_cast<int>(fy);
-      fy -= sy;
-      yofs[dy] = sy;
-      beta[dy * 2] = 1.f - fy;
-      beta[dy * 2 + 1] = fy;
-    }
-  }
-  // output w , h boundary
-  int w_bound = w_out;
-  int h_bound = h_out;
-  if (ratio_w > 0 && ratio_h > 0) {
-    if (align_corners) {
-      w_bound = ceil((w_in - 1) / ratio_w);
-      h_bound = ceil((h_in - 1) / ratio_h);
+namespace {
+
+// Minimum output elements per thread.
+constexpr int64_t kInterpGrain = 16384;
+
+// The bilinear taps of every output position along one axis.
+void bilinear_axis(int in_size,
+                   int out_size,
+                   float ratio,
+                   bool align_corners,
+                   int align_mode,
+                   std::vector<int>* idx0,
+                   std::vector<int>* idx1,
+                   std::vector<float>* w0,
+                   std::vector<float>* w1) {
+  idx0->resize(out_size);
+  idx1->resize(out_size);
+  w0->resize(out_size);
+  w1->resize(out_size);
+  for (int i = 0; i < out_size; ++i) {
+    float f = 0.f;
+    if (align_corners || align_mode) {
+      f = ratio * i;
     } else {
-      w_bound = ceil((w_in - 0.5f) / ratio_w - 0.5f);
-      h_bound = ceil((h_in - 0.5f) / ratio_h - 0.5f);
+      f = ratio * (i + 0.5f) - 0.5f;
+      f = f < 0 ? 0.f : f;
     }
+    int s = static_cast<int>(f);
+    f -= s;
+    s = (std::min)(s, in_size - 1);
+    (*idx0)[i] = s;
+    (*idx1)[i] = (std::min)(s + 1, in_size - 1);
+    (*w0)[i] = 1.f - f;
+    (*w1)[i] = f;
   }
-  int in_stride = h_in * w_in;
-  int out_stride = h_out * w_out;
-  int total = n * c;
-
-#ifdef PADDLE_WITH_MKLML
-#pragma omp parallel for
-#endif
-  for (int nc = 0; nc < total; ++nc) {
-    const float* src = input_data + nc * in_stride;
-    float* dst = output_data + nc * out_stride;
-    const float* betap = beta;
-
-    float* rowsbuf0 =
-        static_cast<float*>(lite::host::malloc(sizeof(int) * w_out));
-    float* rowsbuf1 =
-        static_cast<float*>(lite::host::malloc(sizeof(int) * w_out));
-    float* rows0 = rowsbuf0;
-    float* rows1 = rowsbuf1;
-    // h_bound loop
-    for (int dy = 0; dy < h_bound; dy++) {
-      int sy = yofs[dy];
-
-      const float* s0 = src + sy * w_in;
-      const float* s1 = src + (sy + 1) * w_in;
-
-      const float* alphap = alpha;
-      float* rows0p = rows0;
-      float* rows1p = rows1;
-
-      int dx = 0;
-// w_bound loop
-#ifdef __AVX__
-      for (; dx + 3 < w_bound; dx += 4) {
-        int x0 = xofs[dx];
-        int x1 = xofs[dx + 1];
-        int x2 = xofs[dx + 2];
-        int x3 = xofs[dx + 3];
-
-        const float* s0p0 = s0 + x0;
-        const float* s0p1 = s0 + x1;
-        const float* s0p2 = s0 + x2;
-        const float* s0p3 = s0 + x3;
-
-        const float* s0p0_1 = s0p0 + 1;
-        const float* s0p1_1 = s0p1 + 1;
-        const float* s0p2_1 = s0p2 + 1;
-        const float* s0p3_1 = s0p3 + 1;
-
-        const float* s1p0 = s1 + x0;
-        const float* s1p1 = s1 + x1;
-        const float* s1p2 = s1 + x2;
-        const float* s1p3 = s1 + x3;
-
-        const float* s1p0_1 = s1p0 + 1;
-        const float* s1p1_1 = s1p1 + 1;
-        const float* s1p2_1 = s1p2 + 1;
-        const float* s1p3_1 = s1p3 + 1;
-
-        __m256 _a = _mm256_loadu_ps(alphap);
-
-        __m256 _s0p0p3 = _mm256_set_ps(
-            *s0p3_1, *s0p3, *s0p2_1, *s0p2, *s0p1_1, *s0p1, *s0p0_1, *s0p0);
-
-        __m256 _ms0 = _mm256_mul_ps(_s0p0p3, _a);
-        __m256 _s1p0p3 = _mm256_set_ps(
-            *s1p3_1, *s1p3, *s1p2_1, *s1p2, *s1p1_1, *s1p1, *s1p0_1, *s1p0);
-        __m256 _ms1 = _mm256_mul_ps(_s1p0p3, _a);
-
-        __m256 _rows0 = _mm256_hadd_ps(_ms0, _ms0);
-        __m256 _rows1 = _mm256_hadd_ps(_ms1, _ms1);
-
-        __m256 _rs0 = _mm256_castpd_ps(
-            _mm256_permute4x64_pd(_mm256_castps_pd(_rows0), 0b11011000));
-        __m256 _rs1 = _mm256_castpd_ps(
-            _mm256_permute4x64_pd(_mm256_castps_pd(_rows1), 0b11011000));
-        _mm_storeu_ps(rows0p + dx, _mm256_castps256_ps128(_rs0));
-        _mm_storeu_ps(rows1p + dx, _mm256_castps256_ps128(_rs1));
-
-        alphap += 8;
-      }
-#endif
-
-      // w_bound remain loop
-      for (; dx < w_bound; ++dx) {
-        int sx = xofs[dx];
-        const float* s0p = s0 + sx;
-        const float* s1p = s1 + sx;
-
-        float a0 = alphap[0];
-        float a1 = alphap[1];
-        rows0p[dx] = s0p[0] * a0 + s0p[1] * a1;
-        rows1p[dx] = s1p[0] * a0 + s1p[1] * a1;
-
-        alphap += 2;
-      }
-
-      float param0 = *(src + sy * w_in + w_in - 1);
-      float param1 = *(src + (sy + 1) * w_in + w_in - 1);
-      const float buffer0[2] = {param0, param0};
-      const float buffer1[2] = {param1, param1};
-#ifdef __AVX__
-      __m256 _s0p0p3 = _mm256_set1_ps(param0);
-      __m256 _s1p0p3 = _mm256_set1_ps(param1);
-      for (; dx + 3 < w_out; dx += 4) {
-        __m256 _a = _mm256_loadu_ps(alphap);
-
-        __m256 _ms0 = _mm256_mul_ps(_s0p0p3, _a);
-        __m256 _ms1 = _mm256_mul_ps(_s1p0p3, _a);
-
-        __m256 _rows0 = _mm256_hadd_ps(_ms0, _ms0);
-        __m256 _rows1 = _mm256_hadd_ps(_ms1, _ms1);
+}
 
-        __m256 _rs0 = _mm256_castpd_ps(
-            _mm256_permute4x64_pd(_mm256_castps_pd(_rows0), 0b11011000));
-        __m256 _rs1 = _mm256_castpd_ps(
-            _mm256_permute4x64_pd(_mm256_castps_pd(_rows1), 0b11011000));
-        _mm_storeu_ps(rows0p + dx, _mm256_castps256_ps128(_rs0));
-        _mm_storeu_ps(rows1p + dx, _mm256_castps256_ps128(_rs1));
+// The nearest source of every output position along one axis.
+void nearest_axis(int in_size,
+                  int out_size,
+                  float ratio,
+                  bool align_corners,
+                  std::vector<int>* idx) {
+  idx->resize(out_size);
+  for (int i = 0; i < out_size; ++i) {
+    int s = align_corners ? static_cast<int>(ratio * i + 0.5)
+                          : static_cast<int>(ratio * i);
+    (*idx)[i] = (std::min)((std::max)(s, 0), in_size - 1);
+  }
+}
 
-        alphap += 8;
-      }
+// row[i] = src[x0[i]] * a0[i] + src[x1[i]] * a1[i]
+void bilinear_row(const float* src, const InterpTable& table, float* row) {
+  const int* x0 = table.x0.data();
+  const int* x1 = table.x1.data();
+  const float* a0 = table.a0.data();
+  const float* a1 = table.a1.data();
+  int i = 0;
+#ifdef __AVX2__
+  for (; i + 8 <= table.out_w; i += 8) {
+    __m256i i0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x0 + i));
+    __m256i i1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x1 + i));
+    __m256 s0 = _mm256_i32gather_ps(src, i0, 4);
+    __m256 s1 = _mm256_i32gather_ps(src, i1, 4);
+    _mm256_storeu_ps(row + i,
+                     _mm256_add_ps(_mm256_mul_ps(s0, _mm256_loadu_ps(a0 + i)),
+                                   _mm256_mul_ps(s1, _mm256_loadu_ps(a1 + i))));
+  }
 #endif
+  for (; i < table.out_w; ++i) {
+    row[i] = src[x0[i]] * a0[i] + src[x1[i]] * a1[i];
+  }
+}
 
-      // w_bound - w_out remain loop
-      for (; dx < w_out; dx++) {
-        const float* s0p = buffer0;
-        const float* s1p = buffer1;
-
-        float a0 = alphap[0];
-        float a1 = alphap[1];
-        rows0p[dx] = s0p[0] * a0 + s0p[1] * a1;
-        rows1p[dx] = s1p[0] * a0 + s1p[1] * a1;
-
-        alphap += 2;
-      }
-
-      float b0 = betap[0];
-      float b1 = betap[1];
-
-      // output pos
-      float* dp = dst + dy * w_out;
-
-      int nn = 0;
-
+// dst[i] = row0[i] * b0 + row1[i] * b1
+void blend_rows(const float* row0,
+                const float* row1,
+                float b0,
+                float b1,
+                float* dst,
+                int n) {
+  int i = 0;
 #ifdef __AVX__
-      // 8 float
-      __m256 _b0 = _mm256_set1_ps(b0);
-      __m256 _b1 = _mm256_set1_ps(b1);
-      // calculate and store results
-      for (; nn + 7 < w_out; nn += 8) {
-        __m256 _rows0 = _mm256_loadu_ps(rows0p);
-        __m256 _rows1 = _mm256_loadu_ps(rows1p);
-
-        __m256 _d = _mm256_add_ps(_mm256_mul_ps(_rows0, _b0),
-                                  _mm256_mul_ps(_rows1, _b1));
-        _mm256_storeu_ps(dp, _d);
-
-        dp += 8;
-        rows0p += 8;
-        rows1p += 8;
-      }
-
-      // 4 float
-      __m128 _c0 = _mm_set1_ps(b0);
-      __m128 _c1 = _mm_set1_ps(b1);
-      for (; nn + 3 < w_out; nn += 4) {
-        __m128 _rows0 = _mm_loadu_ps(rows0p);
-        __m128 _rows1 = _mm_loadu_ps(rows1p);
-
-        __m128 _d =
-            _mm_add_ps(_mm_mul_ps(_rows0, _c0), _mm_mul_ps(_rows1, _c1));
-        _mm_storeu_ps(dp, _d);
-
-        dp += 4;
-        rows0p += 4;
-        rows1p += 4;
-      }
+  __m256 vb0 = _mm256_set1_ps(b0);
+  __m256 vb1 = _mm256_set1_ps(b1);
+  for (; i + 8 <= n; i += 8) {
+    __m256 r0 = _mm256_loadu_ps(row0 + i);
+    __m256 r1 = _mm256_loadu_ps(row1 + i);
+    _mm256_storeu_ps(
+        dst + i, _mm256_add_ps(_mm256_mul_ps(r0, vb0), _mm256_mul_ps(r1, vb1)));
+  }
 #endif
+  for (; i < n; ++i) {
+    dst[i] = row0[i] * b0 + row1[i] * b1;
+  }
+}
 
-      // calculate and store remain resluts
-      for (; nn < w_out; ++nn) {
-        *dp++ = *rows0p++ * b0 + *rows1p++ * b1;
-      }
-      betap += 2;
-    }  // end h_bound loop
-
-    // h_bound - h_out loop
-    for (int dy = h_bound; dy < h_out; dy++) {
-      int sy = h_in - 1;
-      const float* s0 = src + sy * w_in;
-      const float* alphap = alpha;
-      float* rows0p = rows0;
-      float* rows1p = rows1;
-
-      int dx = 0;
+void nearest_row(const float* src, const InterpTable& table, float* dst) {
+  const int* x0 = table.x0.data();
+  int i = 0;
+  if (table.x_repeat == 1) {
+    std::memcpy(dst, src, sizeof(float) * table.out_w);
+    return;
+  }
 #ifdef __AVX__
-      const float* s1 = s0;
-
-      // w_bound loop
-      for (; dx + 3 < w_bound; dx += 4) {
-        int x0 = xofs[dx];
-        int x1 = xofs[dx + 1];
-        int x2 = xofs[dx + 2];
-        int x3 = xofs[dx + 3];
-
-        const float* s0p0 = s0 + x0;
-        const float* s0p1 = s0 + x1;
-        const float* s0p2 = s0 + x2;
-        const float* s0p3 = s0 + x3;
-
-        const float* s0p0_1 = s0p0 + 1;
-        const float* s0p1_1 = s0p1 + 1;
-        const float* s0p2_1 = s0p2 + 1;
-        const float* s0p3_1 = s0p3 + 1;
-
-        const float* s1p0 = s1 + x0;
-        const float* s1p1 = s1 + x1;
-        const float* s1p2 = s1 + x2;
-        const float* s1p3 = s1 + x3;
-
-        const float* s1p0_1 = s1p0 + 1;
-        const float* s1p1_1 = s1p1 + 1;
-        const float* s1p2_1 = s1p2 + 1;
-        const float* s1p3_1 = s1p3 + 1;
-
-        __m256 _a = _mm256_loadu_ps(alphap);
-
-        __m256 _s0p0p3 = _mm256_set_ps(
-            *s0p3_1, *s0p3, *s0p2_1, *s0p2, *s0p1_1, *s0p1, *s0p0_1, *s0p0);
-        __m256 _ms0 = _mm256_mul_ps(_s0p0p3, _a);
-        __m256 _s1p0p3 = _mm256_set_ps(
-            *s1p3_1, *s1p3, *s1p2_1, *s1p2, *s1p1_1, *s1p1, *s1p0_1, *s1p0);
-        __m256 _ms1 = _mm256_mul_ps(_s1p0p3, _a);
-
-        __m256 _rows0 = _mm256_hadd_ps(_ms0, _ms0);
-        __m256 _rows1 = _mm256_hadd_ps(_ms1, _ms1);
-
-        __m256 _rs0 = _mm256_castpd_ps(
-            _mm256_permute4x64_pd(_mm256_castps_pd(_rows0), 0b11011000));
-        __m256 _rs1 = _mm256_castpd_ps(
-            _mm256_permute4x64_pd(_mm256_castps_pd(_rows1), 0b11011000));
-        _mm_storeu_ps(rows0p + dx, _mm256_castps256_ps128(_rs0));
-        _mm_storeu_ps(rows1p + dx, _mm256_castps256_ps128(_rs1));
-
-        alphap += 8;
-      }
+  if (table.x_repeat == 2) {
+    for (; i + 16 <= table.out_w; i += 16) {
+      __m256 v = _mm256_loadu_ps(src + i / 2);
+      __m256 lo = _mm256_unpacklo_ps(v, v);
+      __m256 hi = _mm256_unpackhi_ps(v, v);
+      _mm256_storeu_ps(dst + i, _mm256_permute2f128_ps(lo, hi, 0x20));
+      _mm256_storeu_ps(dst + i + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+  }
 #endif
-
-      // w_bound remain loop
-      for (; dx < w_bound; ++dx) {
-        int sx = xofs[dx];
-        const float* s0p = s0 + sx;
-        float a0 = alphap[0];
-        float a1 = alphap[1];
-        rows0p[dx] = s0p[0] * a0 + s0p[1] * a1;
-        rows1p[dx] = rows0p[dx];
-
-        alphap += 2;
-      }
-
-      float param = *(src + sy * w_in + w_in - 1);
-      const float buffer1[2] = {param, param};
-
-#ifdef __AVX__
-      __m256 _s0p0p3 = _mm256_set1_ps(param);
-      __m256 _s1p0p3 = _mm256_set1_ps(param);
-
-      // w_bound - w_out loop
-      for (; dx + 3 < w_out; dx += 4) {
-        __m256 _a = _mm256_loadu_ps(alphap);
-
-        __m256 _ms0 = _mm256_mul_ps(_s0p0p3, _a);
-        __m256 _ms1 = _mm256_mul_ps(_s1p0p3, _a);
-
-        __m256 _rows0 = _mm256_hadd_ps(_ms0, _ms0);
-        __m256 _rows1 = _mm256_hadd_ps(_ms1, _ms1);
-
-        __m256 _rs0 = _mm256_castpd_ps(
-            _mm256_permute4x64_pd(_mm256_castps_pd(_rows0), 0b11011000));
-        __m256 _rs1 = _mm256_castpd_ps(
-            _mm256_permute4x64_pd(_mm256_castps_pd(_rows1), 0b11011000));
-        _mm_storeu_ps(rows0p + dx, _mm256_castps256_ps128(_rs0));
-        _mm_storeu_ps(rows1p + dx, _mm256_castps256_ps128(_rs1));
-
-        alphap += 8;
-      }
+#ifdef __AVX2__
+  for (; i + 8 <= table.out_w; i += 8) {
+    __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x0 + i));
+    _mm256_storeu_ps(dst + i, _mm256_i32gather_ps(src, idx, 4));
+  }
 #endif
+  for (; i < table.out_w; ++i) {
+    dst[i] = src[x0[i]];
+  }
+}
 
-      // w_bound - wout remain loop
-      for (; dx < w_out; dx++) {
-        const float* s0p = buffer1;
-        float a0 = alphap[0];
-        float a1 = alphap[1];
-        rows0p[dx] = s0p[0] * a0 + s0p[1] * a1;
-        rows1p[dx] = rows0p[dx];
-        alphap += 2;
-      }
-
-      float b0 = betap[0];
-      float b1 = betap[1];
-
-      float* dp = dst + dy * w_out;
-
-      int nn = 0;
+}  // namespace
+
+bool InterpTable::Matches(const std::string& interpolate_type,
+                          int in_h,
+                          int in_w,
+                          int out_h,
+                          int out_w,
+                          bool align_corners,
+                          int align_mode) const {
+  return this->interpolate_type == interpolate_type && this->in_h == in_h &&
+         this->in_w == in_w && this->out_h == out_h && this->out_w == out_w &&
+         this->align_corners == align_corners &&
+         this->align_mode == align_mode;
+}
 
-#ifdef __AVX__
-      // 8 float
-      __m256 _b0 = _mm256_set1_ps(b0);
-      __m256 _b1 = _mm256_set1_ps(b1);
-      // calculate and store results
-      for (; nn + 7 < w_out; nn += 8) {
-        __m256 _rows0 = _mm256_loadu_ps(rows0p);
-        __m256 _rows1 = _mm256_loadu_ps(rows1p);
+void InterpTable::Build(const std::string& interpolate_type,
+                        int in_h,
+                        int in_w,
+                        int out_h,
+                        int out_w,
+                        bool align_corners,
+                        int align_mode) {
+  this->interpolate_type = interpolate_type;
+  this->in_h = in_h;
+  this->in_w = in_w;
+  this->out_h = out_h;
+  this->out_w = out_w;
+  this->align_corners = align_corners;
+  this->align_mode = align_mode;
 
-        __m256 _d = _mm256_add_ps(_mm256_mul_ps(_rows0, _b0),
-                                  _mm256_mul_ps(_rows1, _b1));
-        _mm256_storeu_ps(dp, _d);
+  float ratio_h = 0.f;
+  float ratio_w = 0.f;
+  if (out_h > 1) {
+    ratio_h = (align_corners) ? static_cast<float>(in_h - 1) / (out_h - 1)
+                              : static_cast<float>(in_h) / out_h;
+  }
+  if (out_w > 1) {
+    ratio_w = (align_corners) ? static_cast<float>(in_w - 1) / (out_w - 1)
+                              : static_cast<float>(in_w) / out_w;
+  }
 
-        dp += 8;
-        rows0p += 8;
-        rows1p += 8;
+  x_repeat = 0;
+  if ("Bilinear" == interpolate_type) {
+    bilinear_axis(
+        in_h, out_h, ratio_h, align_corners, align_mode, &y0, &y1, &b0, &b1);
+    bilinear_axis(
+        in_w, out_w, ratio_w, align_corners, align_mode, &x0, &x1, &a0, &a1);
+  } else {
+    nearest_axis(in_h, out_h, ratio_h, align_corners, &y0);
+    nearest_axis(in_w, out_w, ratio_w, align_corners, &x0);
+    if (out_w % in_w == 0) {
+      x_repeat = out_w / in_w;
+      for (int i = 0; i < out_w; ++i) {
+        if (x0[i] != i / x_repeat) {
+          x_repeat = 0;
+          break;
+        }
       }
+    }
+  }
+}
 
-      // 4 float
-      __m128 _c0 = _mm_set1_ps(b0);
-      __m128 _c1 = _mm_set1_ps(b1);
-      for (; nn + 3 < w_out; nn += 4) {
-        __m128 _rows0 = _mm_loadu_ps(rows0p);
-        __m128 _rows1 = _mm_loadu_ps(rows1p);
-
-        __m128 _d =
-            _mm_add_ps(_mm_mul_ps(_rows0, _c0), _mm_mul_ps(_rows1, _c1));
-        _mm_storeu_ps(dp, _d);
-
-        dp += 4;
-        rows0p += 4;
-        rows1p += 4;
-      }
-#endif
-      // calculate and store remain results
-      for (; nn < w_out; ++nn) {
-        *dp++ = *rows0p++ * b0 + *rows1p++ * b1;
+void bilinear_interp(const float* input_data,
+                     float* output_data,
+                     const int n,
+                     const int c,
+                     const InterpTable& table) {
+  const int w_in = table.in_w;
+  const int w_out = table.out_w;
+  const int in_stride = table.in_h * w_in;
+  const int out_stride = table.out_h * w_out;
+  int64_t grain = (std::max<int64_t>)(
+      1, kInterpGrain / (std::max<int64_t>)(out_stride, 1));
+  RunParallelFor(0, n * c, grain, [&](int64_t begin, int64_t end) {
+    std::vector<float> rows(w_out * 2);
+    for (int64_t nc = begin; nc < end; ++nc) {
+      const float* src = input_data + nc * in_stride;
+      float* dst = output_data + nc * out_stride;
+      float* rows0 = rows.data();
+      float* rows1 = rows.data() + w_out;
+      // The source rows held by rows0 and rows1.
+      int row_y0 = -1;
+      int row_y1 = -1;
+      for (int dy = 0; dy < table.out_h; ++dy) {
+        const int sy0 = table.y0[dy];
+        const int sy1 = table.y1[dy];
+        if (sy0 != row_y0) {
+          if (sy0 == row_y1) {
+            std::swap(rows0, rows1);
+            std::swap(row_y0, row_y1);
+          } else {
+            bilinear_row(src + sy0 * w_in, table, rows0);
+            row_y0 = sy0;
+          }
+        }
+        if (sy1 != row_y1) {
+          bilinear_row(src + sy1 * w_in, table, rows1);
+          row_y1 = sy1;
+        }
+        blend_rows(rows0,
+                   rows1,
+                   table.b0[dy],
+                   table.b1[dy],
+                   dst + dy * w_out,
+                   w_out);
       }
-
-      betap += 2;
-    }  // end h_bound - h_out loop
-    lite::host::free(rowsbuf0);
-    lite::host::free(rowsbuf1);
-  }
-  lite::host::free(buf);
+    }
+  });
 }
 
 void nearest_interp(const float* input_data,
                     float* output_data,
-                    const float ratio_h,
-                    const float ratio_w,
                     const int n,
                     const int c,
-                    const int in_h,
-                    const int in_w,
-                    const int out_h,
-                    const int out_w,
-                    const bool align_corners) {
-  int total_count = n * c;
-  if (align_corners) {
-#ifdef PADDLE_WITH_MKLML
-#if !defined(WIN32)
-#pragma omp parallel for collapse(3)
-#else
-#pragma omp parallel for
-#endif  // WIN32
-#endif  // PADDLE_WITH_MKLML
-    for (int i = 0; i < total_count; ++i) {
-      for (int h = 0; h < out_h; ++h) {
-        for (int w = 0; w < out_w; ++w) {
-          const float* input_data_ptr = input_data + i * in_h * in_w;
-          float* output_data_ptr =
-              output_data + i * out_h * out_w + h * out_w + w;
-          int near_y = static_cast<int>(ratio_h * h + 0.5);
-          int near_x = static_cast<int>(ratio_w * w + 0.5);
-          *output_data_ptr = input_data_ptr[near_y * in_w + near_x];
+                    const InterpTable& table) {
+  const int w_in = table.in_w;
+  const int w_out = table.out_w;
+  const int in_stride = table.in_h * w_in;
+  const int out_stride = table.out_h * w_out;
+  int64_t grain = (std::max<int64_t>)(
+      1, kInterpGrain / (std::max<int64_t>)(out_stride, 1));
+  RunParallelFor(0, n * c, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t nc = begin; nc < end; ++nc) {
+      const float* src = input_data + nc * in_stride;
+      float* dst = output_data + nc * out_stride;
+      for (int dy = 0; dy < table.out_h; ++dy) {
+        float* dst_row = dst + dy * w_out;
+        if (dy > 0 && table.y0[dy] == table.y0[dy - 1]) {
+          std::memcpy(dst_row, dst_row - w_out, sizeof(float) * w_out);
+        } else {
+          nearest_row(src + table.y0[dy] * w_in, table, dst_row);
         }
       }
     }
-  } else {
-#ifdef PADDLE_WITH_MKLML
-#if !defined(WIN32)
-#pragma omp parallel for collapse(3)
-#else
-#pragma omp parallel for
-#endif  // WIN32
-#endif  // PADDLE_WITH_MKLML
-    for (int i = 0; i < total_count; ++i) {
-      for (int h = 0; h < out_h; ++h) {
-        for (int w = 0; w < out_w; ++w) {
-          const float* input_data_ptr = input_data + i * in_h * in_w;
-          float* output_data_ptr =
-              output_data + i * out_h * out_w + h * out_w + w;
-          int near_y = static_cast<int>(ratio_h * h);
-          int near_x = static_cast<int>(ratio_w * w);
-          *output_data_ptr = input_data_ptr[near_y * in_w + near_x];
-        }
-      }
-    }
-  }
+  });
 }
 
 inline std::vector<int> get_new_shape(
@@ -539,7 +324,8 @@ void interpolate(lite::Tensor* input,
                  int out_w,
                  const int align_mode,
                  const bool align_corners,
-                 const std::string interpolate_type) {
+                 const std::string interpolate_type,
+                 InterpTable* table) {
   // format NCHW
   int n = input->dims()[0];
   int c = input->dims()[1];
@@ -567,44 +353,30 @@ void interpolate(lite::Tensor* input,
   }
   output->Resize({n, c, out_h, out_w});
 
-  float ratio_h = 0.f;
-  float ratio_w = 0.f;
-  if (out_h > 1) {
-    ratio_h = (align_corners) ? static_cast<float>(in_h - 1) / (out_h - 1)
-                              : static_cast<float>(in_h) / out_h;
-  }
-  if (out_w > 1) {
-    ratio_w = (align_corners) ? static_cast<float>(in_w - 1) / (out_w - 1)
-                              : static_cast<float>(in_w) / out_w;
+  InterpTable local_table;
+  if (table == nullptr) table = &local_table;
+  if (!table->Matches(interpolate_type,
+                      in_h,
+                      in_w,
+                      out_h,
+                      out_w,
+                      align_corners,
+                      align_mode)) {
+    table->Build(interpolate_type,
+                 in_h,
+                 in_w,
+                 out_h,
+                 out_w,
+                 align_corners,
+                 align_mode);
   }
 
   const float* input_data = input->data<float>();
   float* output_data = output->mutable_data<float>();
   if ("Bilinear" == interpolate_type) {
-    bilinear_interp(input_data,
-                    output_data,
-                    ratio_h,
-                    ratio_w,
-                    in_h,
-                    in_w,
-                    n,
-                    c,
-                    out_h,
-                    out_w,
-                    align_corners,
-                    align_mode);
+    bilinear_interp(input_data, output_data, n, c, *table);
   } else if ("Nearest" == interpolate_type) {
-    nearest_interp(input_data,
-                   output_data,
-                   ratio_h,
-                   ratio_w,
-                   n,
-                   c,
-                   in_h,
-                   in_w,
-                   out_h,
-                   out_w,
-                   align_corners);
+    nearest_interp(input_data, output_data, n, c, *table);
   } else {
     LOG(FATAL) << "Not supported interpolate_type: " << interpolate_type;
   }
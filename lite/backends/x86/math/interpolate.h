@@ -22,30 +22,58 @@ namespace lite {
 namespace x86 {
 namespace math {
 
+// Source positions and weights of every output row and column. They only
+// depend on the shape, so the kernels keep one table across runs and
+// rebuild it when the shape changes.
+struct InterpTable {
+  bool Matches(const std::string& interpolate_type,
+               int in_h,
+               int in_w,
+               int out_h,
+               int out_w,
+               bool align_corners,
+               int align_mode) const;
+
+  void Build(const std::string& interpolate_type,
+             int in_h,
+             int in_w,
+             int out_h,
+             int out_w,
+             bool align_corners,
+             int align_mode);
+
+  std::string interpolate_type;
+  int in_h{-1};
+  int in_w{-1};
+  int out_h{-1};
+  int out_w{-1};
+  bool align_corners{false};
+  int align_mode{-1};
+
+  // Output row i blends the source rows y0[i] and y1[i] by b0[i] and b1[i],
+  // columns likewise. Nearest only uses y0 and x0.
+  std::vector<int> y0, y1, x0, x1;
+  std::vector<float> b0, b1, a0, a1;
+  // Nearest: how many times in a row each source column is repeated when
+  // the width is scaled by an integer, 0 otherwise.
+  int x_repeat{0};
+};
+
+// Two passes per output row: the two source rows are blended along the
+// width into row buffers, which are reused while the source rows stay the
+// same, then blended along the height.
 void bilinear_interp(const float* input_data,
                      float* output_data,
-                     const float ratio_h,
-                     const float ratio_w,
-                     const int in_h,
-                     const int in_w,
                      const int n,
                      const int c,
-                     const int out_h,
-                     const int out_w,
-                     const bool align_corners,
-                     const bool align_mode);
+                     const InterpTable& table);
 
+// Output rows reading the source row of the row above are copied.
 void nearest_interp(const float* input_data,
                     float* output_data,
-                    const float ratio_h,
-                    const float ratio_w,
                     const int n,
                     const int c,
-                    const int in_h,
-                    const int in_w,
-                    const int out_h,
-                    const int out_w,
-                    const bool align_corners);
+                    const InterpTable& table);
 
 void interpolate(lite::Tensor* input,
                  lite::Tensor* out_size,
@@ -57,7 +85,8 @@ void interpolate(lite::Tensor* input,
                  int out_w,
                  const int align_mode,
                  const bool align_corners,
-                 const std::string interpolate_type);
+                 const std::string interpolate_type,
+                 InterpTable* table = nullptr);
 
 }  // namespace math
 }  // namespace x86
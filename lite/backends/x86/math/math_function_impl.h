@@ -17,6 +17,7 @@ limitations under the License. */
 #include "lite/backends/x86/fluid/data_type.h"
 #include "lite/backends/x86/fluid/eigen.h"
 #include "lite/backends/x86/math/math_function.h"
+#include "lite/backends/x86/math/transpose.h"
 
 namespace paddle {
 namespace lite {
@@ -41,16 +42,11 @@ void Transpose<Target, T, Rank>::operator()(
     const lite::TensorLite& in,
     lite::TensorLite* out,
     const std::vector<int>& axis) {
-  Eigen::array<int, Rank> permute;
-  for (int i = 0; i < Rank; i++) {
-    permute[i] = axis[i];
-  }
-  auto eigen_in = lite::fluid::EigenTensor<T, Rank>::From(in);
-  auto eigen_out = lite::fluid::EigenTensor<T, Rank>::From(*out);
-  // auto* dev = context.eigen_device();
-  // eigen_out.device(*dev) = eigen_in.shuffle(permute);
-  eigen_out.device(typename lite::fluid::EigenDevice<Target>::Type()) =
-      eigen_in.shuffle(permute);
+  CHECK_EQ(static_cast<int>(axis.size()), Rank);
+  transpose(in.data<T>(),
+            out->template mutable_data<T>(),
+            in.dims().Vectorize(),
+            axis);
 }
 
 template <lite::TargetType Target, typename T>
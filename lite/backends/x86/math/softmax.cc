@@ -13,7 +13,17 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include "lite/backends/x86/math/softmax.h"
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#ifdef __AVX__
+#include "lite/backends/x86/math/avx/avx_mathfuns.h"
+#endif
 #include "lite/backends/x86/math/softmax_impl.h"
+#include "lite/backends/x86/parallel.h"
 
 namespace paddle {
 namespace lite {
@@ -28,6 +38,268 @@ template class SoftmaxFunctor<lite::TargetType::kX86, float, true>;
 // template class SoftmaxGradFunctor<lite::TargetType::kX86, float>;
 // template class SoftmaxGradFunctor<lite::TargetType::kX86, double>;
 
+namespace {
+
+// Minimum elements per thread.
+constexpr int64_t kSoftmaxGrain = 16384;
+
+// Columns of an [axis_dim, inner] slice handled together when inner > 1:
+// whole AVX vectors, and few enough cache lines per row for the block to
+// stay in L1 along a long axis.
+constexpr int64_t kSoftmaxBlock = 64;
+
+#ifdef __AVX__
+inline float reduce_max_ps(__m256 v) {
+  __m128 m =
+      _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+  m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+  return _mm_cvtss_f32(m);
+}
+
+inline float reduce_add_ps(__m256 v) {
+  __m128 m =
+      _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  m = _mm_add_ps(m, _mm_movehl_ps(m, m));
+  m = _mm_add_ss(m, _mm_shuffle_ps(m, m, 1));
+  return _mm_cvtss_f32(m);
+}
+#endif
+
+float max_row(const float* src, int64_t n) {
+  float res = std::numeric_limits<float>::lowest();
+  int64_t i = 0;
+#ifdef __AVX__
+  if (n >= 8) {
+    __m256 vmax = _mm256_loadu_ps(src);
+    for (i = 8; i + 8 <= n; i += 8) {
+      vmax = _mm256_max_ps(vmax, _mm256_loadu_ps(src + i));
+    }
+    res = reduce_max_ps(vmax);
+  }
+#endif
+  for (; i < n; ++i) {
+    res = (std::max)(res, src[i]);
+  }
+  return res;
+}
+
+// dst[i] = exp(src[i] - max), returns the sum of dst. Without |store| only
+// the sum is computed and |dst| is left alone.
+template <bool store>
+float exp_row(const float* src, float max, float* dst, int64_t n) {
+  float sum = 0.f;
+  int64_t i = 0;
+#ifdef __AVX__
+  __m256 vmax = _mm256_set1_ps(max);
+  __m256 vsum = _mm256_setzero_ps();
+  for (; i + 8 <= n; i += 8) {
+    __m256 v = exp256_ps(_mm256_sub_ps(_mm256_loadu_ps(src + i), vmax));
+    if (store) _mm256_storeu_ps(dst + i, v);
+    vsum = _mm256_add_ps(vsum, v);
+  }
+  sum = reduce_add_ps(vsum);
+#endif
+  for (; i < n; ++i) {
+    float e = std::exp(src[i] - max);
+    if (store) dst[i] = e;
+    sum += e;
+  }
+  return sum;
+}
+
+// dst[i] = src[i] * scale + bias.
+void affine_row(
+    const float* src, float scale, float bias, float* dst, int64_t n) {
+  int64_t i = 0;
+#ifdef __AVX__
+  __m256 vscale = _mm256_set1_ps(scale);
+  __m256 vbias = _mm256_set1_ps(bias);
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(
+        dst + i,
+        _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), vscale), vbias));
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i] = src[i] * scale + bias;
+  }
+}
+
+// |src| may be |dst|: log_softmax only writes it in the last pass.
+void softmax_row(const float* src, float* dst, int64_t n, bool log) {
+  float max = max_row(src, n);
+  if (log) {
+    float sum = exp_row<false>(src, max, dst, n);
+    affine_row(src, 1.f, -(max + std::log(sum)), dst, n);
+  } else {
+    float sum = exp_row<true>(src, max, dst, n);
+    affine_row(dst, 1.f / sum, 0.f, dst, n);
+  }
+}
+
+// max[i] = max(max[i], src[i]).
+void max_cols(const float* src, float* max, int64_t n) {
+  int64_t i = 0;
+#ifdef __AVX__
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(
+        max + i,
+        _mm256_max_ps(_mm256_loadu_ps(max + i), _mm256_loadu_ps(src + i)));
+  }
+#endif
+  for (; i < n; ++i) {
+    max[i] = (std::max)(max[i], src[i]);
+  }
+}
+
+// dst[i] = exp(src[i] - max[i]), sum[i] += dst[i]. Without |store| only
+// the sums are updated.
+template <bool store>
+void exp_cols(const float* src,
+              const float* max,
+              float* dst,
+              float* sum,
+              int64_t n) {
+  int64_t i = 0;
+#ifdef __AVX__
+  for (; i + 8 <= n; i += 8) {
+    __m256 v = exp256_ps(
+        _mm256_sub_ps(_mm256_loadu_ps(src + i), _mm256_loadu_ps(max + i)));
+    if (store) _mm256_storeu_ps(dst + i, v);
+    _mm256_storeu_ps(sum + i, _mm256_add_ps(_mm256_loadu_ps(sum + i), v));
+  }
+#endif
+  for (; i < n; ++i) {
+    float e = std::exp(src[i] - max[i]);
+    if (store) dst[i] = e;
+    sum[i] += e;
+  }
+}
+
+// dst[i] = src[i] * scale[i] with |log| false, src[i] - scale[i] with true.
+void scale_cols(
+    const float* src, const float* scale, float* dst, int64_t n, bool log) {
+  int64_t i = 0;
+#ifdef __AVX__
+  for (; i + 8 <= n; i += 8) {
+    __m256 vsrc = _mm256_loadu_ps(src + i);
+    __m256 vscale = _mm256_loadu_ps(scale + i);
+    _mm256_storeu_ps(dst + i,
+                     log ? _mm256_sub_ps(vsrc, vscale)
+                         : _mm256_mul_ps(vsrc, vscale));
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i] = log ? src[i] - scale[i] : src[i] * scale[i];
+  }
+}
+
+// Softmax along the rows of the [axis_dim, n] block with row stride |ld|,
+// n <= kSoftmaxBlock, one column at a time. |src| may be |dst| as in
+// softmax_row.
+void softmax_cols(const float* src,
+                  float* dst,
+                  int64_t axis_dim,
+                  int64_t ld,
+                  int64_t n,
+                  bool log) {
+  float max[kSoftmaxBlock];
+  float sum[kSoftmaxBlock];
+  std::fill(max, max + n, std::numeric_limits<float>::lowest());
+  std::fill(sum, sum + n, 0.f);
+  for (int64_t k = 0; k < axis_dim; ++k) {
+    max_cols(src + k * ld, max, n);
+  }
+  for (int64_t k = 0; k < axis_dim; ++k) {
+    if (log) {
+      exp_cols<false>(src + k * ld, max, dst + k * ld, sum, n);
+    } else {
+      exp_cols<true>(src + k * ld, max, dst + k * ld, sum, n);
+    }
+  }
+  for (int64_t i = 0; i < n; ++i) {
+    sum[i] = log ? max[i] + std::log(sum[i]) : 1.f / sum[i];
+  }
+  for (int64_t k = 0; k < axis_dim; ++k) {
+    const float* s = log ? src + k * ld : dst + k * ld;
+    scale_cols(s, sum, dst + k * ld, n, log);
+  }
+}
+
+}  // namespace
+
+void softmax(const float* din,
+             float* dout,
+             int64_t outer,
+             int64_t axis_dim,
+             int64_t inner,
+             bool log) {
+  // Nothing to do, and the grains below divide by the dims.
+  if (outer * axis_dim * inner == 0) return;
+  if (inner == 1) {
+    int64_t grain = (std::max<int64_t>)(kSoftmaxGrain / axis_dim, 1);
+    RunParallelFor(0, outer, grain, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        softmax_row(din + i * axis_dim, dout + i * axis_dim, axis_dim, log);
+      }
+    });
+    return;
+  }
+
+  int64_t blocks = (inner + kSoftmaxBlock - 1) / kSoftmaxBlock;
+  int64_t block_size = axis_dim * (std::min)(inner, kSoftmaxBlock);
+  int64_t grain = (std::max<int64_t>)(kSoftmaxGrain / block_size, 1);
+  RunParallelFor(0, outer * blocks, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      int64_t col = (i % blocks) * kSoftmaxBlock;
+      int64_t offset = i / blocks * axis_dim * inner + col;
+      softmax_cols(din + offset,
+                   dout + offset,
+                   axis_dim,
+                   inner,
+                   (std::min)(kSoftmaxBlock, inner - col),
+                   log);
+    }
+  });
+}
+
+void attention_softmax(const float* din,
+                       const float* mask,
+                       float* dout,
+                       int64_t batch,
+                       int64_t heads,
+                       int64_t rows,
+                       int64_t cols,
+                       bool causal) {
+  // Nothing to do, and the grain below divides by cols.
+  if (batch * heads * rows * cols == 0) return;
+  int64_t grain = (std::max<int64_t>)(kSoftmaxGrain / cols, 1);
+  RunParallelFor(
+      0, batch * heads * rows, grain, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; ++i) {
+          const float* src = din + i * cols;
+          float* dst = dout + i * cols;
+          int64_t valid = cols;
+          if (causal) {
+            valid = i % rows + cols - rows + 1;
+            valid = (std::min)((std::max<int64_t>)(valid, 0), cols);
+          }
+          if (mask) {
+            const float* m = mask + i / (heads * rows) * cols;
+            for (int64_t j = 0; j < valid; ++j) {
+              dst[j] = src[j] + m[j];
+            }
+            src = dst;
+          }
+          if (valid > 0) {
+            softmax_row(src, dst, valid, false);
+          }
+          std::fill(dst + valid, dst + cols, 0.f);
+        }
+      });
+}
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
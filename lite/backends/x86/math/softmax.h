@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #pragma once
+#include <cstdint>
 #include "lite/core/context.h"
 #include "lite/core/tensor.h"
 
@@ -33,6 +34,34 @@ class SoftmaxFunctor {
                   lite::Tensor* Y);
 };
 
+// Softmax of |din|, viewed as [outer, axis_dim, inner], along the middle
+// axis, or log_softmax with |log|. Each row takes a max pass, a pass writing
+// exp(x - max) and summing it, then a scaling pass over |dout| while it is
+// still in cache. With inner > 1 the [axis_dim, inner] slices are walked in
+// blocks of columns, so no transpose is needed. Rows or column blocks are
+// split across the threads. log_softmax only sums in the second pass, so
+// |din| may be |dout| either way.
+void softmax(const float* din,
+             float* dout,
+             int64_t outer,
+             int64_t axis_dim,
+             int64_t inner,
+             bool log = false);
+
+// Softmax of attention scores |din|, [batch, heads, rows, cols], along the
+// last axis. |mask|, if not null, is [batch, cols] and added to the scores of
+// every head and row of its batch: 0 keeps a column, a large negative value
+// drops it. With |causal|, row i only sees the columns up to
+// i + cols - rows, and the later ones come out 0.
+void attention_softmax(const float* din,
+                       const float* mask,
+                       float* dout,
+                       int64_t batch,
+                       int64_t heads,
+                       int64_t rows,
+                       int64_t cols,
+                       bool causal);
+
 template <lite::TargetType Target, typename T, typename Enable = void>
 class SoftmaxGradFunctor {
  public:
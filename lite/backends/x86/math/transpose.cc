@@ -0,0 +1,334 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/transpose.h"
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#ifdef __AVX__
+#include "lite/backends/x86/math/avx/conv_utils.h"
+#endif
+#include "lite/backends/x86/fluid/float16.h"
+#include "lite/backends/x86/parallel.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+// Minimum elements per thread.
+constexpr int64_t kTransposeGrain = 16384;
+
+// Side of the blocks the 2D transposes are split into, so that a source
+// block and its destination block stay in L1 together.
+constexpr int64_t kTransposeBlock = 64;
+
+// dst[j * ld_dst + i] = src[i * ld_src + j] for i < rows and j < cols.
+template <typename T>
+void transpose_block_ref(const T* src,
+                         int64_t ld_src,
+                         T* dst,
+                         int64_t ld_dst,
+                         int64_t rows,
+                         int64_t cols) {
+  for (int64_t i = 0; i < rows; ++i) {
+    const T* s = src + i * ld_src;
+    T* d = dst + i;
+    for (int64_t j = 0; j < cols; ++j) {
+      d[j * ld_dst] = s[j];
+    }
+  }
+}
+
+template <typename T>
+void transpose_block(const T* src,
+                     int64_t ld_src,
+                     T* dst,
+                     int64_t ld_dst,
+                     int64_t rows,
+                     int64_t cols) {
+  transpose_block_ref(src, ld_src, dst, ld_dst, rows, cols);
+}
+
+#ifdef __AVX__
+// Eight rows at a time, transposed by 8x8 tiles in registers.
+template <>
+void transpose_block<float>(const float* src,
+                            int64_t ld_src,
+                            float* dst,
+                            int64_t ld_dst,
+                            int64_t rows,
+                            int64_t cols) {
+  int64_t i = 0;
+  for (; i + 8 <= rows; i += 8) {
+    const float* s = src + i * ld_src;
+    float* d = dst + i;
+    int64_t j = 0;
+    for (; j + 8 <= cols; j += 8) {
+      __m256 r0 = _mm256_loadu_ps(s + j);
+      __m256 r1 = _mm256_loadu_ps(s + ld_src + j);
+      __m256 r2 = _mm256_loadu_ps(s + 2 * ld_src + j);
+      __m256 r3 = _mm256_loadu_ps(s + 3 * ld_src + j);
+      __m256 r4 = _mm256_loadu_ps(s + 4 * ld_src + j);
+      __m256 r5 = _mm256_loadu_ps(s + 5 * ld_src + j);
+      __m256 r6 = _mm256_loadu_ps(s + 6 * ld_src + j);
+      __m256 r7 = _mm256_loadu_ps(s + 7 * ld_src + j);
+      transpose8_ps(r0, r1, r2, r3, r4, r5, r6, r7);
+      float* dj = d + j * ld_dst;
+      _mm256_storeu_ps(dj, r0);
+      _mm256_storeu_ps(dj + ld_dst, r1);
+      _mm256_storeu_ps(dj + 2 * ld_dst, r2);
+      _mm256_storeu_ps(dj + 3 * ld_dst, r3);
+      _mm256_storeu_ps(dj + 4 * ld_dst, r4);
+      _mm256_storeu_ps(dj + 5 * ld_dst, r5);
+      _mm256_storeu_ps(dj + 6 * ld_dst, r6);
+      _mm256_storeu_ps(dj + 7 * ld_dst, r7);
+    }
+    transpose_block_ref(s + j, ld_src, d + j * ld_dst, ld_dst, 8, cols - j);
+  }
+  transpose_block_ref(
+      src + i * ld_src, ld_src, dst + i, ld_dst, rows - i, cols);
+}
+#endif
+
+// Steps through some output axes in row-major order, keeping the input and
+// output offsets of the current position.
+class AxisWalker {
+ public:
+  void AddAxis(int64_t dim, int64_t in_stride, int64_t out_stride) {
+    dims_.push_back(dim);
+    in_strides_.push_back(in_stride);
+    out_strides_.push_back(out_stride);
+    idx_.push_back(0);
+  }
+
+  void Seek(int64_t pos) {
+    in_offset_ = 0;
+    out_offset_ = 0;
+    for (int i = static_cast<int>(dims_.size()) - 1; i >= 0; --i) {
+      idx_[i] = pos % dims_[i];
+      pos /= dims_[i];
+      in_offset_ += idx_[i] * in_strides_[i];
+      out_offset_ += idx_[i] * out_strides_[i];
+    }
+  }
+
+  void Next() {
+    for (int i = static_cast<int>(dims_.size()) - 1; i >= 0; --i) {
+      in_offset_ += in_strides_[i];
+      out_offset_ += out_strides_[i];
+      if (++idx_[i] < dims_[i]) return;
+      in_offset_ -= dims_[i] * in_strides_[i];
+      out_offset_ -= dims_[i] * out_strides_[i];
+      idx_[i] = 0;
+    }
+  }
+
+  int64_t in_offset() const { return in_offset_; }
+  int64_t out_offset() const { return out_offset_; }
+
+ private:
+  std::vector<int64_t> dims_;
+  std::vector<int64_t> in_strides_;
+  std::vector<int64_t> out_strides_;
+  std::vector<int64_t> idx_;
+  int64_t in_offset_{0};
+  int64_t out_offset_{0};
+};
+
+template <typename T>
+void copy_all(const T* din, T* dout, int64_t numel) {
+  RunParallelFor(0, numel, kTransposeGrain, [&](int64_t begin, int64_t end) {
+    std::memcpy(dout + begin, din + begin, (end - begin) * sizeof(T));
+  });
+}
+
+// The last axis stays last: copy rows of |inner| elements.
+template <typename T>
+void copy_rows(const T* din,
+               T* dout,
+               const TransposePlan& plan,
+               const std::vector<int64_t>& in_strides) {
+  const int n = plan.axis.size();
+  const int64_t inner = plan.dims[n - 1];
+  AxisWalker outer;
+  int64_t rows = 1;
+  for (int i = 0; i < n - 1; ++i) {
+    outer.AddAxis(plan.dims[plan.axis[i]], in_strides[plan.axis[i]], 0);
+    rows *= plan.dims[plan.axis[i]];
+  }
+  int64_t grain = (std::max<int64_t>)(1, kTransposeGrain / inner);
+  RunParallelFor(0, rows, grain, [&](int64_t begin, int64_t end) {
+    AxisWalker walker = outer;
+    walker.Seek(begin);
+    for (int64_t r = begin; r < end; ++r) {
+      std::memcpy(dout + r * inner,
+                  din + walker.in_offset(),
+                  inner * sizeof(T));
+      walker.Next();
+    }
+  });
+}
+
+// Batches of 2D transposes between input axis |p|, which goes last, and
+// the input last axis, which goes to output axis |q|.
+template <typename T>
+void transpose_2d(const T* din,
+                  T* dout,
+                  const TransposePlan& plan,
+                  const std::vector<int64_t>& in_strides,
+                  const std::vector<int64_t>& out_strides) {
+  const int n = plan.axis.size();
+  const int p = plan.axis[n - 1];
+  const int q = std::find(plan.axis.begin(), plan.axis.end(), n - 1) -
+                plan.axis.begin();
+  const int64_t rows = plan.dims[p];
+  const int64_t cols = plan.dims[n - 1];
+  const int64_t ld_src = in_strides[p];
+  const int64_t ld_dst = out_strides[q];
+  AxisWalker batch;
+  int64_t batches = 1;
+  for (int i = 0; i < n - 1; ++i) {
+    if (i == q) continue;
+    batch.AddAxis(
+        plan.dims[plan.axis[i]], in_strides[plan.axis[i]], out_strides[i]);
+    batches *= plan.dims[plan.axis[i]];
+  }
+  const int64_t row_blocks = (rows + kTransposeBlock - 1) / kTransposeBlock;
+  const int64_t col_blocks = (cols + kTransposeBlock - 1) / kTransposeBlock;
+  const int64_t blocks = row_blocks * col_blocks;
+  int64_t grain = (std::max<int64_t>)(
+      1, kTransposeGrain / (kTransposeBlock * kTransposeBlock));
+  RunParallelFor(0, batches * blocks, grain, [&](int64_t begin, int64_t end) {
+    AxisWalker walker = batch;
+    int64_t b = begin / blocks;
+    walker.Seek(b);
+    for (int64_t u = begin; u < end; ++u) {
+      if (u / blocks != b) {
+        ++b;
+        walker.Next();
+      }
+      int64_t i = (u % blocks) / col_blocks * kTransposeBlock;
+      int64_t j = (u % blocks) % col_blocks * kTransposeBlock;
+      transpose_block(din + walker.in_offset() + i * ld_src + j,
+                      ld_src,
+                      dout + walker.out_offset() + j * ld_dst + i,
+                      ld_dst,
+                      (std::min)(kTransposeBlock, rows - i),
+                      (std::min)(kTransposeBlock, cols - j));
+    }
+  });
+}
+
+}  // namespace
+
+TransposePlan SimplifyTranspose(const std::vector<int64_t>& dims,
+                                const std::vector<int>& axis) {
+  CHECK_EQ(dims.size(), axis.size());
+  // Drop the unit axes.
+  std::vector<int> remap(dims.size(), -1);
+  std::vector<int64_t> kept_dims;
+  for (size_t i = 0; i < dims.size(); ++i) {
+    if (dims[i] != 1) {
+      remap[i] = kept_dims.size();
+      kept_dims.push_back(dims[i]);
+    }
+  }
+  std::vector<int> kept_axis;
+  for (int a : axis) {
+    if (remap[a] >= 0) kept_axis.push_back(remap[a]);
+  }
+  // Merge the runs of input axes that stay in order in the output.
+  std::vector<int> heads;
+  std::vector<int64_t> sizes;
+  for (size_t i = 0; i < kept_axis.size(); ++i) {
+    if (i > 0 && kept_axis[i] == kept_axis[i - 1] + 1) {
+      sizes.back() *= kept_dims[kept_axis[i]];
+    } else {
+      heads.push_back(kept_axis[i]);
+      sizes.push_back(kept_dims[kept_axis[i]]);
+    }
+  }
+  // Number the runs by their place in the input.
+  std::vector<int> order(heads.size());
+  for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+  std::sort(order.begin(), order.end(), [&](int a, int b) {
+    return heads[a] < heads[b];
+  });
+  TransposePlan plan;
+  plan.dims.resize(heads.size());
+  plan.axis.resize(heads.size());
+  for (size_t r = 0; r < order.size(); ++r) {
+    plan.dims[r] = sizes[order[r]];
+    plan.axis[order[r]] = r;
+  }
+  return plan;
+}
+
+template <typename T>
+void transpose(const T* din,
+               T* dout,
+               const std::vector<int64_t>& dims,
+               const std::vector<int>& axis) {
+  int64_t numel = 1;
+  for (auto d : dims) numel *= d;
+  // Nothing to move, and the engines below divide by the dims.
+  if (numel == 0) return;
+  TransposePlan plan = SimplifyTranspose(dims, axis);
+  const int n = plan.axis.size();
+  if (n <= 1) {
+    copy_all(din, dout, numel);
+    return;
+  }
+  std::vector<int64_t> in_strides(n, 1);
+  std::vector<int64_t> out_strides(n, 1);
+  for (int i = n - 2; i >= 0; --i) {
+    in_strides[i] = in_strides[i + 1] * plan.dims[i + 1];
+    out_strides[i] = out_strides[i + 1] * plan.dims[plan.axis[i + 1]];
+  }
+  if (plan.axis[n - 1] == n - 1) {
+    copy_rows(din, dout, plan, in_strides);
+  } else {
+    transpose_2d(din, dout, plan, in_strides, out_strides);
+  }
+}
+
+#define INSTANTIATE_TRANSPOSE(T)                          \
+  template void transpose<T>(const T*,                    \
+                             T*,                          \
+                             const std::vector<int64_t>&, \
+                             const std::vector<int>&);
+
+INSTANTIATE_TRANSPOSE(lite::fluid::float16);
+INSTANTIATE_TRANSPOSE(float);
+INSTANTIATE_TRANSPOSE(double);
+INSTANTIATE_TRANSPOSE(int);
+INSTANTIATE_TRANSPOSE(int64_t);
+INSTANTIATE_TRANSPOSE(bool);
+INSTANTIATE_TRANSPOSE(int16_t);
+INSTANTIATE_TRANSPOSE(uint8_t);
+INSTANTIATE_TRANSPOSE(int8_t);
+
+#undef INSTANTIATE_TRANSPOSE
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
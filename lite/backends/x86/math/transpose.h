@@ -0,0 +1,52 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// The axes left once the unit axes are dropped and the axes that stay next
+// to each other in the output are merged, e.g. [N, C, H, W] with axis
+// {0, 2, 3, 1} becomes [N, C, H*W] with axis {0, 2, 1}.
+struct TransposePlan {
+  std::vector<int64_t> dims;
+  std::vector<int> axis;
+};
+
+TransposePlan SimplifyTranspose(const std::vector<int64_t>& dims,
+                                const std::vector<int>& axis);
+
+// Writes |din| of shape |dims| to |dout| with output axis i taken from input
+// axis axis[i]. Whatever is left after SimplifyTranspose runs as
+//  - one copy, when nothing moves;
+//  - row copies, when the last axis stays last (e.g. 0213, shuffle_channel);
+//  - cache-blocked 2D transposes between the input axis that goes last and
+//    the input last axis, by 8x8 AVX tiles for float, otherwise.
+// The copies or tiles are split across the threads.
+template <typename T>
+void transpose(const T* din,
+               T* dout,
+               const std::vector<int64_t>& dims,
+               const std::vector<int>& axis);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
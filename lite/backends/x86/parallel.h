@@ -15,6 +15,9 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
+#include <vector>
+#include "lite/backends/x86/cpu_info.h"
 #ifdef PADDLE_WITH_MKLML
 #include <omp.h>
 #include "lite/backends/x86/mklml.h"
@@ -72,6 +75,65 @@ static inline void RunParallelFor(const int64_t begin,
   f(begin, end);
 }
 
+// Same as above, but every thread gets at least |grain| iterations, so short
+// ranges stay on the calling thread instead of paying for the fork.
+static inline void RunParallelFor(const int64_t begin,
+                                  const int64_t end,
+                                  const int64_t grain,
+                                  const ThreadHandler& f) {
+  if (begin >= end) {
+    return;
+  }
+
+#ifdef PADDLE_WITH_MKLML
+  int64_t min_chunk = (std::max<int64_t>)(grain, 1);
+  int64_t max_chunks = (std::max<int64_t>)((end - begin) / min_chunk, 1);
+  int64_t num_threads = (std::min)(GetMaxThreads(), max_chunks);
+  if (num_threads > 1) {
+#pragma omp parallel num_threads(num_threads)
+    {
+      // Even split, so that no chunk is shorter than n / num_threads.
+      int64_t tid = omp_get_thread_num();
+      int64_t n = end - begin;
+      f(begin + tid * n / num_threads, begin + (tid + 1) * n / num_threads);
+    }
+    return;
+  }
+#endif
+
+  f(begin, end);
+}
+
+// Pin the calling thread and the OpenMP workers as the policy says. The
+// OpenMP runtime keeps its workers across parallel regions, so the binding
+// stays for the later math calls of the same team size. The calling thread
+// stays pinned to the first cpu; hold a ThreadAffinityGuard to undo that.
+static inline void BindThreads(lite_api::X86BindPolicy policy,
+                               int num_threads) {
+  const std::vector<int> cpus = CpuBindOrder(policy);
+  if (cpus.empty()) return;
+  BindCurrentThread(cpus[0]);
+#ifdef PADDLE_WITH_MKLML
+  int real_num_threads = (std::max)(num_threads, 1);
+#pragma omp parallel num_threads(real_num_threads)
+  { BindCurrentThread(cpus[omp_get_thread_num() % cpus.size()]); }
+#endif
+}
+
+// BindThreads for the thread which runs the predictor. Affinity belongs to
+// a thread, and every thread calling Run leads an OpenMP team of its own, so
+// each of them is bound at its first run, and kept bound.
+static inline void BindRunningThread(lite_api::X86BindPolicy policy,
+                                     int num_threads) {
+  thread_local lite_api::X86BindPolicy bound_policy = lite_api::X86_BIND_NONE;
+  thread_local int bound_num_threads = 0;
+  if (policy == lite_api::X86_BIND_NONE) return;
+  if (policy == bound_policy && num_threads == bound_num_threads) return;
+  BindThreads(policy, num_threads);
+  bound_policy = policy;
+  bound_num_threads = num_threads;
+}
+
 }  // namespace x86
 }  // namespace lite
 }  // namespace paddle
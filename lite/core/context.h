@@ -38,6 +38,9 @@
 #ifdef LITE_WITH_NNADAPTER
 #include "lite/backends/nnadapter/nnadapter_wrapper.h"
 #endif
+#ifdef LITE_WITH_X86
+#include "lite/backends/x86/cpu_info.h"
+#endif
 
 #include <map>
 #include <memory>
@@ -577,6 +580,12 @@ class Context<TargetType::kX86> {
   AVXType avx_level() { return device_avx_level(); }
   FMAType fma_level() { return device_fma_level(); }
 
+  // Cache sizes in bytes for blocking, 0 if unknown. L1 and L2 are private
+  // to a core, L3 is shared by the cores of a socket.
+  size_t l1_cache_size() const { return x86::CpuL1CacheSize(); }
+  size_t l2_cache_size() const { return x86::CpuL2CacheSize(); }
+  size_t l3_cache_size() const { return x86::CpuL3CacheSize(); }
+
  private:
   // overall information
   //
@@ -1201,6 +1201,7 @@ void DeviceInfo::SetRunMode(lite_api::PowerMode mode, int thread_num) {
 #endif
 #endif  // LITE_WITH_LINUX
   //! alloc memory for sgemm in this context
+  profile::MemoryTagScope memory_tag(profile::MemoryTag::kWorkspace);
   workspace_.Resize({llc_size()});
   workspace_.mutable_data<int8_t>();
   arch_ = archs_[active_ids_[0]];
@@ -1210,11 +1211,13 @@ void DeviceInfo::SetCache(int l1size, int l2size, int l3size) {
   SetCacheInfo(0, 1, l1size);
   SetCacheInfo(1, 1, l2size);
   SetCacheInfo(2, 1, l3size);
+  profile::MemoryTagScope memory_tag(profile::MemoryTag::kWorkspace);
   workspace_.Resize({llc_size()});
   workspace_.mutable_data<int8_t>();
 }
 
 bool DeviceInfo::ExtendWorkspace(size_t size) {
+  profile::MemoryTagScope memory_tag(profile::MemoryTag::kWorkspace);
   workspace_.Resize(
       {static_cast<int64_t>(size + static_cast<size_t>(llc_size()))});
   return workspace_.mutable_data<int8_t>() != nullptr;
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "lite/api/paddle_api.h"
+#include "lite/core/profile/memory_profiler.h"
 #include "lite/core/target_wrapper.h"
 #include "lite/core/tensor.h"
 #include "lite/utils/log/cp_logging.h"
@@ -85,6 +86,7 @@ class DeviceInfo {
     l3_cache_method_ = method;
     absolute_l3cache_size_ = absolute_val;
     // Realloc memory for sgemm in this context.
+    profile::MemoryTagScope memory_tag(profile::MemoryTag::kWorkspace);
     workspace_.clear();
     workspace_.Resize({llc_size()});
     workspace_.mutable_data<int8_t>();
@@ -125,6 +127,7 @@ class DeviceInfo {
 
   template <typename T>
   T* workspace_data() {
+    profile::MemoryTagScope memory_tag(profile::MemoryTag::kWorkspace);
     return reinterpret_cast<T*>(workspace_.mutable_data<int8_t>());
   }
   bool ExtendWorkspace(size_t size);
@@ -58,5 +58,33 @@ TEST(tensor, shared_memory) {
 #endif
 }
 
+TEST(tensor, share_data_view) {
+  TensorLite whole;
+  whole.Resize({4, 3});
+  float* whole_data = whole.mutable_data<float>();
+  for (int i = 0; i < 12; ++i) {
+    whole_data[i] = static_cast<float>(i);
+  }
+
+  TensorLite view;
+  view.Resize({2, 3});
+  view.ShareDataWith(whole, 3 * sizeof(float), 6 * sizeof(float));
+  EXPECT_EQ(view.data<float>(), whole_data + 3);
+  EXPECT_EQ(view.data<float>()[0], 3.f);
+  // Writes within the view land in the whole tensor.
+  view.mutable_data<float>()[5] = -1.f;
+  EXPECT_EQ(whole_data[8], -1.f);
+
+  // Growing past the view moves it out, the whole tensor is left alone.
+  view.Resize({3, 3});
+  float* moved = view.mutable_data<float>();
+  EXPECT_NE(moved, whole_data + 3);
+  for (int i = 0; i < 9; ++i) {
+    moved[i] = 100.f;
+  }
+  EXPECT_EQ(whole.data<float>(), whole_data);
+  EXPECT_EQ(whole_data[9], 9.f);
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/core/memory.h"
+#include "lite/core/profile/memory_profiler.h"
 
 #ifdef LITE_WITH_METAL
 #include "lite/backends/metal/target_wrapper.h"
@@ -69,10 +70,16 @@ void* TargetMalloc(TargetType target, size_t size) {
     default:
       LOG(FATAL) << "Unknown supported target " << TargetToStr(target);
   }
+  if (profile::MemoryProfiler::enabled()) {
+    profile::MemoryProfiler::Global().OnMalloc(data, size);
+  }
   return data;
 }
 
 void TargetFree(TargetType target, void* data, std::string free_flag) {
+  if (profile::MemoryProfiler::enabled()) {
+    profile::MemoryProfiler::Global().OnFree(data);
+  }
   switch (target) {
     case TargetType::kHost:
     case TargetType::kX86:
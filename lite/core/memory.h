@@ -14,6 +14,7 @@
 
 #pragma once
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -273,5 +274,41 @@ class Buffer {
   TargetType target_{TargetType::kHost};
 };
 
+// A window of |size| bytes at |offset| into the memory of |parent|, which
+// it keeps alive. Asking for more than the window moves the view to memory
+// of its own instead of reallocating the parent under the other views.
+class ViewBuffer : public Buffer {
+ public:
+  ViewBuffer(const std::shared_ptr<Buffer>& parent, size_t offset, size_t size)
+      : Buffer(static_cast<char*>(parent->data()) + offset,
+               parent->target(),
+               size),
+        parent_(parent) {}
+
+  void ResetLazy(TargetType target, size_t size) override {
+    if (parent_ && (target != target_ || space_ < size)) {
+      parent_.reset();
+      data_ = nullptr;
+      space_ = 0;
+      own_data_ = true;
+    }
+    Buffer::ResetLazy(target, size);
+  }
+
+  // Drops the window, the next ResetLazy allocates memory of its own.
+  void Free() override {
+    if (parent_) {
+      parent_.reset();
+      data_ = nullptr;
+      space_ = 0;
+      own_data_ = true;
+    }
+    Buffer::Free();
+  }
+
+ private:
+  std::shared_ptr<Buffer> parent_;
+};
+
 }  // namespace lite
 }  // namespace paddle
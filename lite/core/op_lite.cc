@@ -84,9 +84,9 @@ std::vector<std::unique_ptr<KernelBase>> OpLite::CreateKernels(
   std::vector<std::unique_ptr<KernelBase>> kernels;
   CHECK(!op_type_.empty()) << "op_type_ should be set first";
 
-  auto pick_kernel = [&](const Place &place) {
+  auto pick_kernel = [&](const Place &place, const std::string &alias) {
     auto ks = KernelRegistry::Global().Create(
-        op_type_, place.target, place.precision, place.layout);
+        op_type_, place.target, place.precision, place.layout, alias);
     VLOG(5) << "pick kernel for " << op_info()->Type() << " "
             << place.DebugString() << " get " << ks.size() << " kernels";
     for (auto &&it : ks) {
@@ -99,8 +99,8 @@ std::vector<std::unique_ptr<KernelBase>> OpLite::CreateKernels(
     Place place;
     std::string op_type, alias;
     KernelBase::ParseKernelType(kernel_type, &op_type, &alias, &place);
-    pick_kernel(place);
-    CHECK(!kernels.empty()) << "no kernel for kernel type " << kernel_type;
+    // The kernel was picked already, only instantiate that one.
+    pick_kernel(place, alias);
     return kernels;
   }
 
@@ -117,7 +117,7 @@ std::vector<std::unique_ptr<KernelBase>> OpLite::CreateKernels(
 
   std::set<TargetType> targets;
   for (auto place : expanded_places) {
-    pick_kernel(place);
+    pick_kernel(place, "");
     targets.insert(place.target);
   }
 
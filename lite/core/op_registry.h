@@ -26,6 +26,7 @@
 #include "lite/core/op_lite.h"
 #include "lite/core/target_wrapper.h"
 #include "lite/utils/all.h"
+#include "lite/utils/container.h"
 #include "lite/utils/macros.h"
 
 using LiteType = paddle::lite::Type;
@@ -75,7 +76,7 @@ class OpLiteFactory {
   // Register a function to create an op
   void RegisterCreator(const std::string& op_type,
                        std::function<std::shared_ptr<OpLite>()> fun) {
-    op_registry_[op_type] = fun;
+    op_registry_.Insert(OpCreator{op_type, fun});
   }
 
   static OpLiteFactory& Global() {
@@ -84,29 +85,42 @@ class OpLiteFactory {
   }
 
   std::shared_ptr<OpLite> Create(const std::string& op_type) const {
-    auto it = op_registry_.find(op_type);
-    if (it == op_registry_.end()) return nullptr;
-    return it->second();
+    auto range = op_registry_.EqualRange(OpCreator{op_type, nullptr});
+    if (range.first == range.second) return nullptr;
+    // The latest registration wins.
+    return (*(range.second - 1))->creator();
   }
 
   std::string DebugString() const {
     STL::stringstream ss;
-    for (const auto& item : op_registry_) {
-      ss << " - " << item.first << "\n";
+    for (const auto& op_type : GetAllOps()) {
+      ss << " - " << op_type << "\n";
     }
     return ss.str();
   }
 
   std::vector<std::string> GetAllOps() const {
     std::vector<std::string> res;
-    for (const auto& op : op_registry_) {
-      res.push_back(op.first);
+    for (const auto* op : op_registry_.Sorted()) {
+      if (res.empty() || res.back() != op->op_type) {
+        res.push_back(op->op_type);
+      }
     }
     return res;
   }
 
  protected:
-  std::map<std::string, std::function<std::shared_ptr<OpLite>()>> op_registry_;
+  struct OpCreator {
+    std::string op_type;
+    std::function<std::shared_ptr<OpLite>()> creator;
+  };
+  struct OpCreatorLess {
+    bool operator()(const OpCreator& a, const OpCreator& b) const {
+      return a.op_type < b.op_type;
+    }
+  };
+  // Sorted by op type.
+  SortedTable<OpCreator, OpCreatorLess> op_registry_;
 };
 
 using LiteOpRegistry = OpLiteFactory;
@@ -129,9 +143,10 @@ class KernelFactory {
                        TargetType target,
                        PrecisionType precision,
                        DataLayoutType layout,
-                       std::function<std::unique_ptr<KernelBase>()> fun) {
-    op_registry_[op_type][std::make_tuple(target, precision, layout)].push_back(
-        fun);
+                       std::function<std::unique_ptr<KernelBase>()> fun,
+                       const std::string& alias = "") {
+    op_registry_.Insert(
+        KernelCreator{op_type, target, precision, layout, alias, fun});
   }
 
   static KernelFactory& Global() {
@@ -144,51 +159,78 @@ class KernelFactory {
    */
   std::list<std::unique_ptr<KernelBase>> Create(const std::string& op_type) {
     std::list<std::unique_ptr<KernelBase>> res;
-    if (op_registry_.find(op_type) == op_registry_.end()) return res;
-    auto& kernel_registry = op_registry_[op_type];
-    for (auto it = kernel_registry.begin(); it != kernel_registry.end(); ++it) {
-      for (auto& fun : it->second) {
-        res.emplace_back(fun());
-      }
+    KernelCreator probe{op_type,
+                        TARGET(kUnk),
+                        PRECISION(kUnk),
+                        DATALAYOUT(kUnk),
+                        "",
+                        nullptr};
+    auto range = op_registry_.EqualRange(probe, OpTypeLess());
+    for (auto it = range.first; it != range.second; ++it) {
+      res.emplace_back((*it)->creator());
     }
     return res;
   }
 
   /**
-   * Create a specific kernel. Return a list for API compatible.
+   * Create a specific kernel. Return a list for API compatible. With a
+   * non-empty `alias` only the kernels registered with it are instantiated.
    */
-  std::list<std::unique_ptr<KernelBase>> Create(const std::string& op_type,
-                                                TargetType target,
-                                                PrecisionType precision,
-                                                DataLayoutType layout) {
+  std::list<std::unique_ptr<KernelBase>> Create(
+      const std::string& op_type,
+      TargetType target,
+      PrecisionType precision,
+      DataLayoutType layout,
+      const std::string& alias = "") {
     std::list<std::unique_ptr<KernelBase>> res;
-    if (op_registry_.find(op_type) == op_registry_.end()) return res;
-    auto& kernel_registry = op_registry_[op_type];
-    auto it = kernel_registry.find(std::make_tuple(target, precision, layout));
-    if (it == kernel_registry.end()) return res;
-    for (auto& fun : it->second) {
-      res.emplace_back(fun());
+    KernelCreator probe{op_type, target, precision, layout, "", nullptr};
+    auto range = op_registry_.EqualRange(probe);
+    for (auto it = range.first; it != range.second; ++it) {
+      // Creators registered without an alias can not be filtered.
+      if (alias.empty() || (*it)->alias.empty() || (*it)->alias == alias) {
+        res.emplace_back((*it)->creator());
+      }
     }
     return res;
   }
 
   std::string DebugString() const {
     STL::stringstream ss;
-    for (const auto& item : op_registry_) {
-      ss << " - " << item.first << "\n";
+    const std::string* last = nullptr;
+    for (const auto* kernel : op_registry_.Sorted()) {
+      if (!last || *last != kernel->op_type) {
+        ss << " - " << kernel->op_type << "\n";
+      }
+      last = &kernel->op_type;
     }
     return ss.str();
   }
 
  protected:
-  // Outer map: op -> a map of kernel.
-  // Inner map: kernel -> creator function.
-  // Each kernel was represented by a combination of <TargetType, PrecisionType,
-  // DataLayoutType>
-  std::map<std::string,
-           std::map<std::tuple<TargetType, PrecisionType, DataLayoutType>,
-                    std::list<std::function<std::unique_ptr<KernelBase>()>>>>
-      op_registry_;
+  struct KernelCreator {
+    std::string op_type;
+    TargetType target;
+    PrecisionType precision;
+    DataLayoutType layout;
+    std::string alias;
+    std::function<std::unique_ptr<KernelBase>()> creator;
+  };
+  struct OpTypeLess {
+    bool operator()(const KernelCreator& a, const KernelCreator& b) const {
+      return a.op_type < b.op_type;
+    }
+  };
+  // Orders by op type, then by the combination of <TargetType,
+  // PrecisionType, DataLayoutType>; kernels of the same combination keep
+  // their registration order.
+  struct KernelCreatorLess {
+    bool operator()(const KernelCreator& a, const KernelCreator& b) const {
+      if (a.op_type != b.op_type) return a.op_type < b.op_type;
+      return std::make_tuple(a.target, a.precision, a.layout) <
+             std::make_tuple(b.target, b.precision, b.layout);
+    }
+  };
+  SortedTable<KernelCreator, KernelCreatorLess> op_registry_;
 };
 
 using KernelRegistry = KernelFactory;
@@ -200,9 +242,10 @@ class KernelRegistrar {
                   TargetType target,
                   PrecisionType precision,
                   DataLayoutType layout,
-                  std::function<std::unique_ptr<KernelBase>()> fun) {
+                  std::function<std::unique_ptr<KernelBase>()> fun,
+                  const std::string& alias = "") {
     KernelFactory::Global().RegisterCreator(
-        op_type, target, precision, layout, fun);
+        op_type, target, precision, layout, fun, alias);
   }
   // Touch function is used to guarantee registrar was initialized.
   void touch() {}
@@ -278,7 +321,8 @@ class ParamTypeDummyRegistry {
             x->set_op_type(#op_type__);                                       \
             x->set_alias(#alias__);                                           \
             return x;                                                         \
-          });                                                                 \
+          },                                                                  \
+          #alias__);                                                          \
   int touch_##op_type__##target__##precision__##layout__##alias__() {         \
     op_type__##target__##precision__##layout__##alias__##_kernel_registry     \
         .touch();                                                             \
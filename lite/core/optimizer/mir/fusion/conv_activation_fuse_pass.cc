@@ -102,4 +102,5 @@ REGISTER_MIR_PASS(lite_conv_activation_fuse_pass,
     .BindTargets({TARGET(kAny)})
     .ExcludeTargets({TARGET(kXPU)})
     .ExcludeTargets({TARGET(kMLU)})
-    .BindKernel("conv2d");
+    .BindKernel("conv2d")
+    .BindOpTypes({"conv2d", "depthwise_conv2d", "conv2d_transpose"});
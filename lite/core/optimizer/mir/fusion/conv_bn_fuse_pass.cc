@@ -48,4 +48,5 @@ void ConvBNFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 
 REGISTER_MIR_PASS(lite_conv_bn_fuse_pass, paddle::lite::mir::ConvBNFusePass)
     .BindTargets({TARGET(kAny)})
-    .ExcludeTargets({TARGET(kXPU), TARGET(kBM), TARGET(kRKNPU)});
+    .ExcludeTargets({TARGET(kXPU), TARGET(kBM), TARGET(kRKNPU)})
+    .BindOpTypes({"batch_norm", "sync_batch_norm"});
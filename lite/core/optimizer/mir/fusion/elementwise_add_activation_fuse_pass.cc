@@ -77,4 +77,5 @@ REGISTER_MIR_PASS(lite_elementwise_activation_fuse_pass,
     .ExcludeTargets({TARGET(kRKNPU)})
     .ExcludeTargets({TARGET(kNNAdapter)})
     .BindKernel("fusion_elementwise_add_activation")
-    .BindKernel("fusion_elementwise_sub_activation");
+    .BindKernel("fusion_elementwise_sub_activation")
+    .BindOpTypes({"elementwise_add", "elementwise_sub", "elementwise_mul"});
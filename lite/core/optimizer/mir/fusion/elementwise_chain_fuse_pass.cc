@@ -0,0 +1,238 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/elementwise_chain_fuse_pass.h"
+#include <list>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+const std::set<std::string> kBinaryOps = {"elementwise_add",
+                                          "elementwise_sub",
+                                          "elementwise_mul",
+                                          "elementwise_div",
+                                          "elementwise_max",
+                                          "elementwise_min"};
+
+const std::set<std::string> kUnaryOps = {"scale",
+                                         "relu",
+                                         "relu6",
+                                         "leaky_relu",
+                                         "sigmoid",
+                                         "tanh",
+                                         "swish",
+                                         "hard_swish",
+                                         "square",
+                                         "gelu"};
+
+bool IsBinary(const Node* node) {
+  return kBinaryOps.count(node->stmt()->op_type()) > 0;
+}
+
+bool IsFloatArg(const Node* node) {
+  auto* type = node->arg()->type;
+  return type != nullptr && type->precision() == PRECISION(kFloat);
+}
+
+template <typename T>
+bool AttrIs(const OpInfo* op_info, const std::string& name, T value) {
+  return op_info->HasAttr(name) && op_info->GetAttr<T>(name) == value;
+}
+
+// Whether the op can be part of a chain: a supported float op without
+// quantization or an already fused epilogue.
+bool IsChainOp(const Node* node) {
+  if (!node->IsStmt()) return false;
+  auto* op_info = node->stmt()->op_info();
+  const auto& op_type = op_info->Type();
+  if (!kBinaryOps.count(op_type) && !kUnaryOps.count(op_type)) return false;
+  if (AttrIs(op_info, "enable_int8", true)) return false;
+  if (AttrIs(op_info, "fuse_scale", true)) return false;
+  if (op_type == "scale" &&
+      (op_info->HasAttr("activation_type") ||
+       (op_info->HasInput("ScaleTensor") &&
+        !op_info->Input("ScaleTensor").empty()))) {
+    return false;
+  }
+  if (op_type == "gelu" && AttrIs(op_info, "approximate", true)) return false;
+  for (auto* var : node->inlinks) {
+    if (!IsFloatArg(var)) return false;
+  }
+  for (auto* var : node->outlinks) {
+    if (!IsFloatArg(var)) return false;
+  }
+  return true;
+}
+
+Node* FindArg(const std::list<Node*>& links, const std::string& name) {
+  for (auto* var : links) {
+    if (var->arg()->name == name) return var;
+  }
+  return nullptr;
+}
+
+// The op after |node| in the chain, or nullptr when the chain ends here.
+Node* NextInChain(const Node* node) {
+  if (node->outlinks.size() != 1) return nullptr;
+  auto* out = node->outlinks.front();
+  if (out->arg()->is_weight || out->outlinks.size() != 1) return nullptr;
+  auto* next = out->outlinks.front();
+  if (!IsChainOp(next)) return nullptr;
+  if (IsBinary(next)) {
+    // The chain value must enter the op once, the other operand is external.
+    auto* op_info = next->stmt()->op_info();
+    bool is_x = op_info->Input("X").front() == out->arg()->name;
+    bool is_y = op_info->Input("Y").front() == out->arg()->name;
+    if (is_x == is_y) return nullptr;
+  }
+  return next;
+}
+
+}  // namespace
+
+void ElementwiseChainFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  for (auto& place : graph->valid_places()) {
+    if (place.target != TARGET(kX86) && place.target != TARGET(kHost)) {
+      return;
+    }
+  }
+  std::set<const Node*> visited;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (visited.count(node) || !IsChainOp(node)) continue;
+    std::vector<Node*> chain{node};
+    for (auto* next = NextInChain(node); next && !visited.count(next);
+         next = NextInChain(next)) {
+      chain.push_back(next);
+    }
+    visited.insert(chain.begin(), chain.end());
+    if (chain.size() >= 2) {
+      FuseChain(graph.get(), chain);
+    }
+  }
+}
+
+void ElementwiseChainFusePass::FuseChain(SSAGraph* graph,
+                                         const std::vector<Node*>& chain) {
+  std::vector<std::string> op_types;
+  std::vector<int> axes;
+  std::vector<int> chain_is_x;
+  std::vector<float> op_attrs;
+  std::vector<Node*> inputs;
+  std::vector<std::string> ext_names;
+  std::set<const Node*> nodes_to_remove;
+
+  auto* head_info = chain.front()->stmt()->op_info();
+  std::string chain_name = head_info->Input("X").front();
+  inputs.push_back(FindArg(chain.front()->inlinks, chain_name));
+  for (auto* node : chain) {
+    auto* op_info = node->stmt()->op_info();
+    const auto& op_type = op_info->Type();
+    op_types.push_back(op_type);
+    float attrs[3] = {0.f, 0.f, 0.f};
+    int axis = -1;
+    int is_x = 1;
+    if (IsBinary(node)) {
+      axis = op_info->GetAttr<int>("axis");
+      is_x = op_info->Input("X").front() == chain_name;
+      auto ext_name = op_info->Input(is_x ? "Y" : "X").front();
+      ext_names.push_back(ext_name);
+      inputs.push_back(FindArg(node->inlinks, ext_name));
+    } else if (op_type == "scale") {
+      attrs[0] = op_info->GetAttr<float>("scale");
+      attrs[1] = op_info->GetAttr<float>("bias");
+      attrs[2] = op_info->GetAttr<bool>("bias_after_scale") ? 1.f : 0.f;
+    } else if (op_type == "leaky_relu") {
+      attrs[0] = op_info->GetAttr<float>("alpha");
+    } else if (op_type == "relu6") {
+      attrs[0] = op_info->GetAttr<float>("threshold");
+    } else if (op_type == "swish") {
+      attrs[0] = op_info->GetAttr<float>("beta");
+    } else if (op_type == "hard_swish") {
+      attrs[0] = op_info->GetAttr<float>("threshold");
+      attrs[1] = op_info->GetAttr<float>("scale");
+      attrs[2] = op_info->GetAttr<float>("offset");
+    }
+    axes.push_back(axis);
+    chain_is_x.push_back(is_x);
+    op_attrs.insert(op_attrs.end(), attrs, attrs + 3);
+    nodes_to_remove.insert(node);
+    if (node != chain.back()) {
+      nodes_to_remove.insert(node->outlinks.front());
+    }
+    chain_name = op_info->Output("Out").front();
+  }
+  auto* out = chain.back()->outlinks.front();
+
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fusion_elementwise_chain");
+  op_desc.SetInput("X", {inputs.front()->arg()->name});
+  if (!ext_names.empty()) {
+    op_desc.SetInput("Y", ext_names);
+  }
+  op_desc.SetOutput("Out", {out->arg()->name});
+  op_desc.SetAttr("op_types", op_types);
+  op_desc.SetAttr("axes", axes);
+  op_desc.SetAttr("chain_is_x", chain_is_x);
+  op_desc.SetAttr("op_attrs", op_attrs);
+
+  auto* scope = chain.front()->stmt()->op()->scope();
+  auto fused_op = LiteOpRegistry::Global().Create("fusion_elementwise_chain");
+  fused_op->Attach(op_desc, scope);
+  auto* fused_node =
+      graph->GraphCreateInstructNode(fused_op, graph->valid_places());
+
+  GraphSafeRemoveNodes(graph, nodes_to_remove);
+  std::set<Node*> linked;
+  for (auto* input : inputs) {
+    if (linked.insert(input).second) {
+      IR_NODE_LINK_TO(input, fused_node);
+    }
+  }
+  IR_NODE_LINK_TO(fused_node, out);
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_elementwise_chain_fuse_pass,
+                  paddle::lite::mir::ElementwiseChainFusePass)
+    .BindTargets({TARGET(kX86)})
+    .BindKernel("fusion_elementwise_chain")
+    .BindOpTypes({"elementwise_add",
+                  "elementwise_sub",
+                  "elementwise_mul",
+                  "elementwise_div",
+                  "elementwise_max",
+                  "elementwise_min",
+                  "scale",
+                  "relu",
+                  "relu6",
+                  "leaky_relu",
+                  "sigmoid",
+                  "tanh",
+                  "swish",
+                  "hard_swish",
+                  "square",
+                  "gelu"});
@@ -0,0 +1,47 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * Fuses a linear chain of float elementwise, scale and activation ops into
+ * one fusion_elementwise_chain op, e.g.
+ *
+ *   x -> elementwise_add(y) -> scale -> relu -> elementwise_mul(z) -> out
+ *
+ * becomes fusion_elementwise_chain(X=x, Y=[y, z]) -> out. Every
+ * intermediate result must feed only the next op of the chain, so trees of
+ * ops are not fused. cast is not fused either, the kernel keeps everything
+ * in float.
+ */
+class ElementwiseChainFusePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  void FuseChain(SSAGraph* graph, const std::vector<Node*>& chain);
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
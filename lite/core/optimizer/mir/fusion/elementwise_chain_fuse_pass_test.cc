@@ -0,0 +1,168 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/core/optimizer/mir/fusion/elementwise_chain_fuse_pass.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+class ElementwiseChainFuseTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    program_desc_ = std::make_shared<cpp::ProgramDesc>();
+    scope_ = std::make_shared<Scope>();
+    block_ = program_desc_->AddBlock<cpp::BlockDesc>();
+    block_->ClearOps();
+    block_->ClearVars();
+  }
+
+  void AddVar(const std::string& name) {
+    auto* var_desc = block_->AddVar<cpp::VarDesc>();
+    var_desc->SetName(name);
+    var_desc->SetPersistable(false);
+    scope_->Var(name)->GetMutable<Tensor>()->Resize({2, 8});
+  }
+
+  cpp::OpDesc* AddUnary(const std::string& type,
+                        const std::string& x,
+                        const std::string& out) {
+    AddVar(out);
+    auto* op_desc = block_->AddOp<cpp::OpDesc>();
+    op_desc->SetType(type);
+    op_desc->SetInput("X", {x});
+    op_desc->SetOutput("Out", {out});
+    return op_desc;
+  }
+
+  void AddBinary(const std::string& type,
+                 const std::string& x,
+                 const std::string& y,
+                 const std::string& out) {
+    auto* op_desc = AddUnary(type, x, out);
+    op_desc->SetInput("Y", {y});
+    op_desc->SetAttr<int>("axis", -1);
+  }
+
+  void AddScale(const std::string& x, const std::string& out) {
+    auto* op_desc = AddUnary("scale", x, out);
+    op_desc->SetAttr<float>("scale", 2.f);
+    op_desc->SetAttr<float>("bias", 1.f);
+    op_desc->SetAttr<bool>("bias_after_scale", true);
+  }
+
+  // Builds the graph, types every variable as a float x86 tensor, as the
+  // type inference passes would, and runs the pass on it.
+  std::unique_ptr<SSAGraph> Fuse() {
+    std::vector<Place> valid_places{{TARGET(kX86), PRECISION(kFloat)}};
+    Program program(program_desc_, scope_, valid_places);
+    std::unique_ptr<SSAGraph> graph(new SSAGraph);
+    graph->Build(program, valid_places);
+    for (auto& node : graph->mutable_nodes()) {
+      if (node.IsArg()) {
+        node.AsArg().type = LiteType::GetTensorTy(TARGET(kX86));
+      }
+    }
+    ElementwiseChainFusePass().Apply(graph);
+    return graph;
+  }
+
+  static std::vector<std::string> StmtTypes(SSAGraph* graph) {
+    std::vector<std::string> types;
+    for (auto* node : graph->StmtTopologicalOrder()) {
+      types.push_back(node->stmt()->op_type());
+    }
+    return types;
+  }
+
+  std::shared_ptr<cpp::ProgramDesc> program_desc_;
+  std::shared_ptr<Scope> scope_;
+  cpp::BlockDesc* block_{nullptr};
+};
+
+TEST_F(ElementwiseChainFuseTest, fuse_chain) {
+  AddVar("x");
+  AddVar("y");
+  AddVar("z");
+  // out = z * relu(scale(x + y))
+  AddBinary("elementwise_add", "x", "y", "t0");
+  AddScale("t0", "t1");
+  AddUnary("relu", "t1", "t2");
+  AddBinary("elementwise_mul", "z", "t2", "out");
+  auto graph = Fuse();
+
+  ASSERT_EQ(StmtTypes(graph.get()),
+            std::vector<std::string>{"fusion_elementwise_chain"});
+  auto* op_info = graph->StmtTopologicalOrder().front()->stmt()->op_info();
+  EXPECT_EQ(op_info->Input("X"), std::vector<std::string>{"x"});
+  EXPECT_EQ(op_info->Input("Y"), (std::vector<std::string>{"y", "z"}));
+  EXPECT_EQ(op_info->Output("Out"), std::vector<std::string>{"out"});
+  EXPECT_EQ(op_info->GetAttr<std::vector<std::string>>("op_types"),
+            (std::vector<std::string>{
+                "elementwise_add", "scale", "relu", "elementwise_mul"}));
+  EXPECT_EQ(op_info->GetAttr<std::vector<int>>("chain_is_x"),
+            (std::vector<int>{1, 1, 1, 0}));
+  EXPECT_EQ(op_info->GetAttr<std::vector<float>>("op_attrs"),
+            (std::vector<float>{
+                0.f, 0.f, 0.f, 2.f, 1.f, 1.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f}));
+  // The intermediate results are gone, the inputs and output are kept.
+  std::vector<std::string> args;
+  for (auto& node : graph->nodes()) {
+    if (node.IsArg()) args.push_back(node.arg()->name);
+  }
+  std::sort(args.begin(), args.end());
+  EXPECT_EQ(args, (std::vector<std::string>{"out", "x", "y", "z"}));
+}
+
+TEST_F(ElementwiseChainFuseTest, stop_at_shared_result) {
+  AddVar("x");
+  AddVar("y");
+  // t1 feeds two ops, so the chain has to end there.
+  AddBinary("elementwise_add", "x", "y", "t0");
+  AddScale("t0", "t1");
+  AddUnary("relu", "t1", "t2");
+  AddUnary("tanh", "t1", "t3");
+  auto graph = Fuse();
+
+  auto types = StmtTypes(graph.get());
+  std::sort(types.begin(), types.end());
+  EXPECT_EQ(types,
+            (std::vector<std::string>{
+                "fusion_elementwise_chain", "relu", "tanh"}));
+}
+
+TEST_F(ElementwiseChainFuseTest, keep_single_op) {
+  AddVar("x");
+  AddVar("y");
+  AddBinary("elementwise_add", "x", "y", "out");
+  auto graph = Fuse();
+
+  EXPECT_EQ(StmtTypes(graph.get()),
+            std::vector<std::string>{"elementwise_add"});
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
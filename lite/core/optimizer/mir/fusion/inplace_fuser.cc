@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include "lite/core/optimizer/mir/fusion/inplace_fuser.h"
+#include <map>
 #include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
 namespace paddle {
@@ -23,6 +26,14 @@ namespace fusion {
 
 void InplaceFuser::BuildPattern() { OpNode("inplace", type_); }
 
+// The ops below only share memory between their inputs and outputs on the
+// kernels of these targets, elsewhere the attr would just keep their
+// variables out of the memory reuse.
+static const std::map<std::string, TargetType> kViewOpTargets{
+    {"concat", TARGET(kX86)},
+    {"slice", TARGET(kX86)},
+    {"split", TARGET(kHost)}};
+
 void InplaceFuser::InsertNewNode(SSAGraph* graph, const key2nodes_t& matched) {
   auto out_var_nodes = matched.at("inplace")->outlinks;
   bool inplace = true;
@@ -32,6 +43,27 @@ void InplaceFuser::InsertNewNode(SSAGraph* graph, const key2nodes_t& matched) {
     }
   }
   auto* stmt = matched.at("inplace")->stmt();
+  auto view_target = kViewOpTargets.find(type_);
+  if (view_target != kViewOpTargets.end() &&
+      stmt->picked_kernel().target() != view_target->second) {
+    return;
+  }
+  if (type_ == "concat") {
+    // concat places its inputs in its output, so they must be distinct
+    // tensors, each written by an op.
+    auto x_names = stmt->op_info()->Input("X");
+    std::set<std::string> x_name_set(x_names.begin(), x_names.end());
+    if (x_name_set.size() != x_names.size()) {
+      inplace = false;
+    }
+    for (auto* in_var_node : matched.at("inplace")->inlinks) {
+      auto& arg = in_var_node->AsArg();
+      if (x_name_set.count(arg.name) &&
+          (arg.is_weight || arg.is_persist || in_var_node->inlinks.empty())) {
+        inplace = false;
+      }
+    }
+  }
   auto op = stmt->op();
   cpp::OpDesc* op_desc = op->mutable_op_info();
   op_desc->SetAttr<bool>("inplace", inplace);
@@ -40,4 +40,5 @@ void InterpolateFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 
 REGISTER_MIR_PASS(lite_interpolate_fuse_pass,
                   paddle::lite::mir::InterpolateFusePass)
-    .BindTargets({TARGET(kAny)});
+    .BindTargets({TARGET(kAny)})
+    .BindOpTypes({"bilinear_interp", "nearest_interp"});
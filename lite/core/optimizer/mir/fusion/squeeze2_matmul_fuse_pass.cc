@@ -33,4 +33,5 @@ void Squeeze2MatmulFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 
 REGISTER_MIR_PASS(lite_squeeze2_matmul_fuse_pass,
                   paddle::lite::mir::Squeeze2MatmulFusePass)
-    .BindTargets({TARGET(kAny)});
+    .BindTargets({TARGET(kAny)})
+    .BindOpTypes({"squeeze2"});
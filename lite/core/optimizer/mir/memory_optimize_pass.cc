@@ -134,7 +134,10 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
                             {"squeeze", {{"X"}, {"Out"}}},
                             {"squeeze2", {{"X"}, {"Out"}}},
                             {"unsqueeze", {{"X"}, {"Out"}}},
-                            {"unsqueeze2", {{"X"}, {"Out"}}}};
+                            {"unsqueeze2", {{"X"}, {"Out"}}},
+                            {"concat", {{"X"}, {"Out"}}},
+                            {"split", {{"X"}, {"Out"}}},
+                            {"slice", {{"Input"}, {"Out"}}}};
     auto inplace_op_node = inplace_op_nodes.find(op_type);
     if (inplace_op_node != inplace_op_nodes.end()) {
       bool inplace = false;
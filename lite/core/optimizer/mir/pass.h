@@ -115,6 +115,15 @@ class Pass {
     }
   }
 
+  // Some passes only rewrite the graphs containing qualified operators, e.g.
+  // a fusion anchored on batch_norm. Bind them so that the pass can be skipped
+  // for the graphs without any of these operators. Empty means always run.
+  void BindOpTypes(const std::set<std::string>& op_types) {
+    bound_op_types_.insert(op_types.begin(), op_types.end());
+  }
+  // Get all bound operator types.
+  const std::set<std::string>& BoundOpTypes() const { return bound_op_types_; }
+
   Kind kind() const { return kind_; }
   bool is_debug_pass() const { return kind_ == Kind::kDebug; }
   bool is_program_pass() const { return kind_ == Kind::kProgramWise; }
@@ -150,6 +159,7 @@ class Pass {
   std::set<TargetType> bound_targets_;
   std::set<TargetType> excluded_targets_;
   std::map<std::string, std::set<lite_api::Place>> bound_kernels_;
+  std::set<std::string> bound_op_types_;
   std::map<std::string, variant<Node, std::vector<Node*>>> pass_attrs_;
 };
 
@@ -48,6 +48,10 @@ class PassRegistry {
                       Place(TARGET(kAny), PRECISION(kAny), DATALAYOUT(kAny)));
     return *this;
   }
+  PassRegistry& BindOpTypes(const std::set<std::string>& op_types) {
+    pass_->BindOpTypes(op_types);
+    return *this;
+  }
   bool Touch() const { return true; }
 
  private:
@@ -89,5 +89,16 @@ bool PassMatchesKernels(const mir::Pass& pass) {
   return true;
 }
 
+bool PassMatchesOpTypes(const mir::Pass& pass, const mir::SSAGraph& graph) {
+  const auto& op_types = pass.BoundOpTypes();
+  if (op_types.empty()) return true;
+  for (const auto& node : graph.nodes()) {
+    if (node.IsStmt() && op_types.count(node.stmt()->op_info()->Type())) {
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace lite
 }  // namespace paddle
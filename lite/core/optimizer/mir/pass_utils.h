@@ -31,5 +31,8 @@ bool PassMatchesTarget(const mir::Pass& pass,
 // Check if the pass hits all necessary operators.
 bool PassMatchesKernels(const mir::Pass& pass);
 
+// Check if the graph has one of the operators the pass is bound to.
+bool PassMatchesOpTypes(const mir::Pass& pass, const mir::SSAGraph& graph);
+
 }  // namespace lite
 }  // namespace paddle
@@ -14,7 +14,9 @@
 
 #include <algorithm>
 #include <array>
+#include <functional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "lite/core/op_lite.h"
@@ -116,18 +118,58 @@ void PatternMatcher::operator()(SSAGraph *graph,
 bool PatternMatcher::MarkPMNodesInGraph(SSAGraph *graph) {
   VLOG(3) << "mark pmnodes in graph";
   if (graph->nodes().empty()) return false;
-  for (auto &node : graph->mutable_nodes()) {
-    for (const auto &pmnode : pattern_.nodes()) {
-      if (pmnode->Tell(&node)) {
-        pmnodes2nodes_[pmnode.get()].insert(&node);
+  // Index the ops by type, so that the PMNodes anchored to an op type only
+  // test the nodes around the ops of that type instead of the whole graph.
+  // Built on the first anchored PMNode, patterns made of tellers only don't
+  // need it.
+  std::unordered_map<std::string, std::vector<Node *>> ops_by_type;
+  bool indexed = false;
+  auto mark = [&](const PMNode *pmnode, Node *node) {
+    if (pmnode->Tell(node)) {
+      pmnodes2nodes_[pmnode].insert(node);
+    }
+  };
+  for (const auto &pmnode : pattern_.nodes()) {
+    if (pmnode->teller_ || pmnode->anchor_ == PMNode::Anchor::kNone) {
+      for (auto &node : graph->mutable_nodes()) {
+        mark(pmnode.get(), &node);
+      }
+      continue;
+    }
+    if (!indexed) {
+      for (auto &node : graph->mutable_nodes()) {
+        if (node.IsStmt()) {
+          ops_by_type[node.stmt()->op_info()->Type()].push_back(&node);
+        }
+      }
+      indexed = true;
+    }
+    auto it = ops_by_type.find(pmnode->anchor_op_type_);
+    if (it == ops_by_type.end()) continue;
+    for (auto *op : it->second) {
+      switch (pmnode->anchor_) {
+        case PMNode::Anchor::kOp:
+          mark(pmnode.get(), op);
+          break;
+        case PMNode::Anchor::kOpInput:
+          for (auto *var : op->inlinks) mark(pmnode.get(), var);
+          break;
+        case PMNode::Anchor::kOpOutput:
+          for (auto *var : op->outlinks) mark(pmnode.get(), var);
+          break;
+        default:
+          break;
       }
     }
   }
-  // Check to early stop if some PMNode can't find matched Node.
-  for (auto &pmnode : pattern_.nodes()) {
-    if (!pmnodes2nodes_.count(pmnode.get())) {
-      VLOG(4) << pmnode->name() << " can't find matched Node, early stop";
-      // return false;
+  // Early stop if some PMNode taking part in an edge can't find matched Node,
+  // no subgraph can be extended through it.
+  for (const auto &edge : pattern_.edges()) {
+    for (const auto *pmnode : {edge.first, edge.second}) {
+      if (!pmnodes2nodes_.count(pmnode)) {
+        VLOG(4) << pmnode->name() << " can't find matched Node, early stop";
+        return false;
+      }
     }
   }
   VLOG(3) << pmnodes2nodes_.size() << " nodes marked";
@@ -191,6 +233,24 @@ struct HitGroup {
   std::set<Node *> nodes_;
 };
 
+// A link between two marked nodes found for one of the extended groups.
+struct EdgeHit {
+  Node *source;
+  Node *target;
+  size_t group;
+
+  bool operator<(const EdgeHit &other) const {
+    std::less<Node *> less;
+    if (source != other.source) return less(source, other.source);
+    if (target != other.target) return less(target, other.target);
+    return group < other.group;
+  }
+  bool operator==(const EdgeHit &other) const {
+    return source == other.source && target == other.target &&
+           group == other.group;
+  }
+};
+
 // Tell whether Node a links to b.
 bool IsNodesLink(Node *a, Node *b) {
   for (auto *node : a->outlinks) {
@@ -230,24 +290,54 @@ std::vector<PatternMatcher::subgraph_t> PatternMatcher::DetectPatterns() {
     cur_groups.clear();
     if (pre_groups.empty()) break;
     // source -> target
-    for (Node *source : pmnodes2nodes_[edge.first]) {
-      for (Node *target : pmnodes2nodes_[edge.second]) {
-        // TODO(Superjomn) add some prune strategies.
-        for (const auto &group : pre_groups) {
-          if (IsNodesLink(source, target)) {
-            HitGroup new_group = group;
-            bool flag = new_group.Match(source, edge.first) &&
-                        new_group.Match(target, edge.second);
-            if (flag) {
-              new_group.Register(source, edge.first);
-              new_group.Register(target, edge.second);
-              cur_groups.push_back(new_group);
-              // TODO(Superjomn) need to unique
+    const auto &sources = pmnodes2nodes_[edge.first];
+    const auto &targets = pmnodes2nodes_[edge.second];
+    // When a group has bound one end of the edge already, only the links of
+    // that node are followed instead of testing every (source, target) pair.
+    std::vector<EdgeHit> hits;
+    for (size_t i = 0; i < pre_groups.size(); ++i) {
+      const auto &roles = pre_groups[i].roles;
+      auto bound_source = roles.find(edge.first);
+      auto bound_target = roles.find(edge.second);
+      if (bound_source != roles.end()) {
+        Node *source = bound_source->second;
+        if (!sources.count(source)) continue;
+        for (auto *target : source->outlinks) {
+          if (targets.count(target)) hits.push_back({source, target, i});
+        }
+      } else if (bound_target != roles.end()) {
+        Node *target = bound_target->second;
+        if (!targets.count(target)) continue;
+        for (auto *source : target->inlinks) {
+          if (sources.count(source) && IsNodesLink(source, target)) {
+            hits.push_back({source, target, i});
+          }
+        }
+      } else {
+        for (Node *source : sources) {
+          for (Node *target : targets) {
+            if (IsNodesLink(source, target)) {
+              hits.push_back({source, target, i});
             }
           }
         }
       }
     }
+    // Keep the (source, target, group) order of an exhaustive scan, since
+    // RemoveOverlappedMatch keeps the earlier one of overlapped matches.
+    std::sort(hits.begin(), hits.end());
+    hits.erase(std::unique(hits.begin(), hits.end()), hits.end());
+    for (const auto &hit : hits) {
+      HitGroup new_group = pre_groups[hit.group];
+      bool flag = new_group.Match(hit.source, edge.first) &&
+                  new_group.Match(hit.target, edge.second);
+      if (flag) {
+        new_group.Register(hit.source, edge.first);
+        new_group.Register(hit.target, edge.second);
+        cur_groups.push_back(new_group);
+        // TODO(Superjomn) need to unique
+      }
+    }
     VLOG(3) << "step " << step << " get records: " << cur_groups.size();
   }
 
@@ -371,6 +461,7 @@ PMNode *PMNode::assert_only_one_output() {
 }
 
 PMNode *PMNode::assert_is_op(const std::string &op_type) {
+  SetAnchor(Anchor::kOp, op_type);
   asserts_.emplace_back([op_type](const Node *x) {
     if (x && x->IsStmt()) {
       auto *op_info = x->stmt()->op_info();
@@ -414,6 +505,7 @@ PMNode *PMNode::assert_is_persistable_var() {
 
 PMNode *PMNode::assert_is_op_output(const std::string &op_type) {
   assert_is_var();
+  SetAnchor(Anchor::kOpOutput, op_type);
   asserts_.emplace_back([=](const Node *x) {
     for (auto *op : x->inlinks) {
       if (op && op->IsStmt()) {
@@ -484,6 +576,7 @@ PMNode *PMNode::assert_is_op_nth_output(const std::string &op_type,
                                         const std::string &argument,
                                         int nth) {
   assert_is_var();
+  SetAnchor(Anchor::kOpOutput, op_type);
   asserts_.emplace_back([=](const Node *x) {
     for (auto *op : x->inlinks) {
       if (op && op->IsStmt() && op->stmt()->op_info()->Type() == op_type &&
@@ -497,6 +590,7 @@ PMNode *PMNode::assert_is_op_nth_output(const std::string &op_type,
 
 PMNode *PMNode::assert_is_op_input(const std::string &op_type) {
   assert_is_var();
+  SetAnchor(Anchor::kOpInput, op_type);
   asserts_.emplace_back([=](const Node *x) {
     for (auto *op : x->outlinks) {
       if (op && op->IsStmt()) {
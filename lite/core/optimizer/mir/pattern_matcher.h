@@ -36,6 +36,7 @@ namespace paddle {
 namespace lite {
 namespace mir {
 class PMPattern;
+class PatternMatcher;
 
 // Some basic terminologies:
 //   - PMPattern: a pattern defined as a data flow graph.
@@ -188,6 +189,17 @@ struct PMNode {
   PMNode(PMNode&& other) = default;
 
   friend class PMPattern;
+  friend class PatternMatcher;
+
+  // Where the candidates of this node can be found through the op-type index
+  // of the graph: the op itself, or the vars it reads or writes. The asserts
+  // still run on every candidate, the anchor only narrows the scan.
+  enum class Anchor { kNone, kOp, kOpInput, kOpOutput };
+  void SetAnchor(Anchor anchor, const std::string& op_type) {
+    if (anchor_ != Anchor::kNone) return;
+    anchor_ = anchor;
+    anchor_op_type_ = op_type;
+  }
 
   // Will removed latter.
   teller_t teller_;
@@ -197,6 +209,8 @@ struct PMNode {
   std::string op_type_;
   Type type_{};
   Role role_{Role::kUnknown};
+  Anchor anchor_{Anchor::kNone};
+  std::string anchor_op_type_;
 };
 
 /*
@@ -264,7 +278,9 @@ class PMPattern {
  * This helper can be used to support fuse(conv+batchnorm => batchnorm e.g.).
  *
  * The algorithm has three phases:
- *   1. Mark the nodes that match the defined PMNodes in a PMPattern,
+ *   1. Mark the nodes that match the defined PMNodes in a PMPattern, PMNodes
+ *      asserted to be (or to link to) an op of some type only test the nodes
+ *      around the ops of that type,
  *   2. Extend a PMNode to subgraphs by deducing the connection relation defined
  *      in PAPattern(the edges),
  *   3. Get the filtered subgraphs and treat them with a pre-defined handler.
@@ -15,6 +15,9 @@
 #include "lite/core/optimizer/mir/pattern_matcher.h"
 
 #include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include "lite/core/op_lite.h"
 
 namespace paddle {
 namespace lite {
@@ -228,6 +231,91 @@ TEST(PatternMatcher, IntermediateCheck) {
   ASSERT_EQ(count, 1);
 }
 
+// An op which only carries its type, enough for the op-type asserts.
+class TypedOp : public OpLite {
+ public:
+  explicit TypedOp(const std::string& type) : OpLite(type) {
+    cpp::OpDesc desc;
+    desc.SetType(type);
+    Attach(desc, &scope_);
+  }
+  std::string DebugString() const override { return Type(); }
+  void AttachKernel(KernelBase* kernel) override {}
+
+ protected:
+  bool AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) override {
+    return true;
+  }
+
+ private:
+  Scope scope_;
+};
+
+Node* AddTypedOp(SSAGraph* g, const std::string& type) {
+  g->mutable_nodes().emplace_back();
+  Node& op = g->mutable_nodes().back();
+  op.AsStmt(type, {}, std::make_shared<TypedOp>(type));
+  return &op;
+}
+
+Node* AddVar(SSAGraph* g, const std::string& name, Node* from, Node* to) {
+  g->mutable_nodes().emplace_back();
+  Node& var = g->mutable_nodes().back();
+  var.AsArg(name);
+  from->outlinks.push_back(&var);
+  var.inlinks.push_back(from);
+  var.outlinks.push_back(to);
+  to->inlinks.push_back(&var);
+  return &var;
+}
+
+TEST(PatternMatcher, OpTypeAnchor) {
+  // mul0 -> var0 -> add -> var1 -> relu0
+  // mul1 -> var2 -> relu1
+  SSAGraph graph;
+  auto* mul0 = AddTypedOp(&graph, "mul");
+  auto* add = AddTypedOp(&graph, "elementwise_add");
+  auto* relu0 = AddTypedOp(&graph, "relu");
+  auto* mul1 = AddTypedOp(&graph, "mul");
+  auto* relu1 = AddTypedOp(&graph, "relu");
+  auto* var0 = AddVar(&graph, "var0", mul0, add);
+  AddVar(&graph, "var1", add, relu0);
+  AddVar(&graph, "var2", mul1, relu1);
+
+  PatternMatcher matcher;
+  auto* mul = matcher.mutable_pattern()->NewNode("mul")->assert_is_op("mul");
+  auto* out = matcher.mutable_pattern()
+                  ->NewNode("out")
+                  ->assert_is_op_output("mul")
+                  ->assert_is_op_input("elementwise_add");
+  auto* elt = matcher.mutable_pattern()
+                  ->NewNode("add")
+                  ->assert_is_op("elementwise_add");
+  out->LinksFrom({mul}).LinksTo({elt});
+
+  int count = 0;
+  matcher(&graph, [&](const PatternMatcher::subgraph_t& g, SSAGraph* graph) {
+    EXPECT_EQ(g.at(mul), mul0);
+    EXPECT_EQ(g.at(out), var0);
+    EXPECT_EQ(g.at(elt), add);
+    ++count;
+  });
+  ASSERT_EQ(count, 1);
+
+  // No candidate for the anchored op type, the matcher stops early.
+  PatternMatcher missing;
+  auto* conv =
+      missing.mutable_pattern()->NewNode("conv")->assert_is_op("conv2d");
+  auto* conv_out =
+      missing.mutable_pattern()->NewNode("out")->assert_is_op_output("conv2d");
+  conv_out->LinksFrom({conv});
+  count = 0;
+  missing(&graph, [&](const PatternMatcher::subgraph_t& g, SSAGraph* graph) {
+    ++count;
+  });
+  ASSERT_EQ(count, 0);
+}
+
 }  // namespace mir
 }  // namespace lite
 }  // namespace paddle
@@ -0,0 +1,147 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/x86_bf16_weight_pass.h"
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/utils/bfloat16.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+struct ConversionError {
+  float max_abs{0.f};
+  float max_rel{0.f};
+  // sqrt(sum((x - bf16(x))^2) / sum(x^2))
+  double rms_rel{0.};
+};
+
+// Replaces the fp32 data of `weight` with its bfloat16 bits.
+ConversionError ConvertToBFloat16(Tensor* weight) {
+  Tensor fp32;
+  fp32.CopyDataFrom(*weight);
+  // Release the fp32 buffer, mutable_data would reuse it.
+  weight->clear();
+  weight->set_precision(PRECISION(kInt16));
+  auto* dst = reinterpret_cast<uint16_t*>(weight->mutable_data<int16_t>());
+  const float* src = fp32.data<float>();
+
+  ConversionError error;
+  double err_sum = 0., ref_sum = 0.;
+  for (int64_t i = 0; i < fp32.numel(); ++i) {
+    dst[i] = FloatToBFloat16(src[i]);
+    float diff = std::fabs(BFloat16ToFloat(dst[i]) - src[i]);
+    error.max_abs = std::max(error.max_abs, diff);
+    if (std::fabs(src[i]) > 1e-30f) {
+      error.max_rel = std::max(error.max_rel, diff / std::fabs(src[i]));
+    }
+    err_sum += static_cast<double>(diff) * diff;
+    ref_sum += static_cast<double>(src[i]) * src[i];
+  }
+  error.rms_rel = ref_sum > 0. ? std::sqrt(err_sum / ref_sum) : 0.;
+  return error;
+}
+
+}  // namespace
+
+void X86BF16WeightPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // Ops whose picked kernel reads bfloat16 weights, and their weight nodes.
+  std::set<Node*> eligible;
+  std::vector<std::pair<Node*, Node*>> candidates;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    auto& stmt = node->AsStmt();
+    auto iter = bf16_ops_.find(stmt.op_type());
+    if (iter == bf16_ops_.end() || stmt.kernels().empty()) continue;
+    const auto& kernel = stmt.kernels().front();
+    if (kernel->target() != TARGET(kX86) ||
+        kernel->precision() != PRECISION(kFloat)) {
+      continue;
+    }
+    const OpInfo* op_info = stmt.op_info();
+    if (op_info->HasAttr("enable_int8") &&
+        op_info->GetAttr<bool>("enable_int8")) {
+      continue;
+    }
+    if (!op_info->HasInput(iter->second) ||
+        op_info->Input(iter->second).empty()) {
+      continue;
+    }
+    std::string weight_name = op_info->Input(iter->second).front();
+    for (auto* in_node : node->inlinks) {
+      if (in_node->IsArg() && in_node->arg()->is_weight &&
+          in_node->arg()->name == weight_name) {
+        eligible.insert(node);
+        candidates.emplace_back(node, in_node);
+        break;
+      }
+    }
+  }
+
+  std::set<Node*> converted;
+  size_t saved_bytes = 0;
+  for (auto& candidate : candidates) {
+    Node* node = candidate.first;
+    Node* weight_node = candidate.second;
+    bool shared = std::any_of(
+        weight_node->outlinks.begin(),
+        weight_node->outlinks.end(),
+        [&](Node* consumer) { return !eligible.count(consumer); });
+    if (shared) {
+      VLOG(3) << "Keep fp32 weight " << weight_node->arg()->name
+              << ", it is shared with another op.";
+      continue;
+    }
+
+    auto& stmt = node->AsStmt();
+    auto* scope = stmt.op()->scope();
+    if (!converted.count(weight_node)) {
+      auto* weight =
+          scope->FindVar(weight_node->arg()->name)->GetMutable<Tensor>();
+      if (weight->precision() != PRECISION(kFloat)) {
+        continue;
+      }
+      ConversionError error = ConvertToBFloat16(weight);
+      saved_bytes += weight->memory_size();
+      converted.insert(weight_node);
+      LOG(INFO) << "bf16 weight " << weight_node->arg()->name << " "
+                << weight->dims() << ": max_abs_err " << error.max_abs
+                << ", max_rel_err " << error.max_rel << ", rms_rel_err "
+                << error.rms_rel;
+    }
+
+    // The kernel keeps a copy of the param, attach both again.
+    OpInfo op_info = *stmt.op_info();
+    op_info.SetAttr<bool>("weight_bf16", true);
+    stmt.op()->Attach(op_info, scope);
+    stmt.op()->AttachKernel(stmt.kernels().front().get());
+  }
+  if (!converted.empty()) {
+    LOG(INFO) << "Stored " << converted.size() << " weights as bf16, saved "
+              << saved_bytes / 1024 << " KB.";
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(x86_bf16_weight_pass, paddle::lite::mir::X86BF16WeightPass)
+    .BindTargets({TARGET(kX86)});
@@ -0,0 +1,48 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+/*
+ * Stores the weights of the x86 fc, mul and lookup_table kernels as bfloat16
+ * (the raw bits in an int16 tensor) and sets the `weight_bf16` attribute of
+ * their ops, so the weights take half of the size in the model and in memory
+ * and the kernels read half of the bytes, up-converting them on the fly.
+ * A weight shared with any other op is kept in fp32. The conversion error
+ * of every weight is logged.
+ *
+ * Enabled by `quant_model` with `QuantType::QUANT_BF16`.
+ */
+class X86BF16WeightPass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  // op type -> the argument of its weight
+  const std::map<std::string, std::string> bf16_ops_{{"fc", "W"},
+                                                     {"mul", "Y"},
+                                                     {"lookup_table", "W"},
+                                                     {"lookup_table_v2", "W"}};
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,176 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/x86_bf16_weight_pass.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp_desc.h"
+#include "lite/utils/bfloat16.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+class X86BF16WeightPassTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    program_desc_ = std::make_shared<cpp::ProgramDesc>();
+    scope_ = std::make_shared<Scope>();
+    block_ = program_desc_->AddBlock<cpp::BlockDesc>();
+    block_->ClearOps();
+    block_->ClearVars();
+  }
+
+  void AddVar(const std::string& name) {
+    auto* var_desc = block_->AddVar<cpp::VarDesc>();
+    var_desc->SetName(name);
+    var_desc->SetPersistable(false);
+    scope_->Var(name)->GetMutable<Tensor>();
+  }
+
+  // Adds a persistable fp32 weight and keeps a copy of its values.
+  void AddWeight(const std::string& name, const std::vector<int64_t>& shape) {
+    auto* var_desc = block_->AddVar<cpp::VarDesc>();
+    var_desc->SetName(name);
+    var_desc->SetPersistable(true);
+    auto* tensor = scope_->Var(name)->GetMutable<Tensor>();
+    tensor->Resize(shape);
+    auto* data = tensor->mutable_data<float>();
+    for (int64_t i = 0; i < tensor->numel(); ++i) {
+      data[i] = static_cast<float>(i % 17) * 0.0371f - 0.3f;
+    }
+    weights_[name] = std::vector<float>(data, data + tensor->numel());
+  }
+
+  cpp::OpDesc* AddOp(const std::string& type,
+                     const std::map<std::string, std::string>& inputs,
+                     const std::string& out) {
+    AddVar(out);
+    auto* op_desc = block_->AddOp<cpp::OpDesc>();
+    op_desc->SetType(type);
+    for (auto& input : inputs) {
+      op_desc->SetInput(input.first, {input.second});
+    }
+    op_desc->SetOutput("Out", {out});
+    return op_desc;
+  }
+
+  // Builds the graph with the x86 kernels picked and runs the pass on it.
+  std::unique_ptr<SSAGraph> Convert() {
+    std::vector<Place> valid_places{{TARGET(kX86), PRECISION(kFloat)}};
+    program_.reset(new Program(program_desc_, scope_, valid_places));
+    std::unique_ptr<SSAGraph> graph(new SSAGraph);
+    graph->Build(*program_, valid_places);
+    X86BF16WeightPass().Apply(graph);
+    return graph;
+  }
+
+  static bool WeightBF16(SSAGraph* graph, const std::string& op_type) {
+    for (auto* node : graph->StmtTopologicalOrder()) {
+      auto* op_info = node->stmt()->op_info();
+      if (op_info->Type() == op_type) {
+        return op_info->HasAttr("weight_bf16") &&
+               op_info->GetAttr<bool>("weight_bf16");
+      }
+    }
+    ADD_FAILURE() << "no " << op_type << " op";
+    return false;
+  }
+
+  void ExpectBF16(const std::string& name) {
+    const auto& tensor = scope_->FindVar(name)->Get<Tensor>();
+    ASSERT_EQ(tensor.precision(), PRECISION(kInt16)) << name;
+    const auto& ref = weights_.at(name);
+    ASSERT_EQ(tensor.numel(), static_cast<int64_t>(ref.size()));
+    const auto* bits = reinterpret_cast<const uint16_t*>(tensor.raw_data());
+    for (size_t i = 0; i < ref.size(); ++i) {
+      EXPECT_EQ(bits[i], FloatToBFloat16(ref[i])) << name << " " << i;
+    }
+  }
+
+  void ExpectFP32(const std::string& name) {
+    const auto& tensor = scope_->FindVar(name)->Get<Tensor>();
+    ASSERT_EQ(tensor.precision(), PRECISION(kFloat)) << name;
+    const auto& ref = weights_.at(name);
+    const auto* data = tensor.data<float>();
+    EXPECT_EQ(std::vector<float>(data, data + tensor.numel()), ref) << name;
+  }
+
+  std::shared_ptr<cpp::ProgramDesc> program_desc_;
+  std::shared_ptr<Scope> scope_;
+  std::unique_ptr<Program> program_;
+  cpp::BlockDesc* block_{nullptr};
+  std::map<std::string, std::vector<float>> weights_;
+};
+
+TEST_F(X86BF16WeightPassTest, convert_weights) {
+  AddVar("x");
+  AddVar("ids");
+  AddWeight("fc_w", {8, 6});
+  AddWeight("fc_b", {6});
+  AddWeight("mul_w", {6, 4});
+  AddWeight("emb_w", {10, 6});
+  AddWeight("emb_v2_w", {10, 6});
+  auto* fc = AddOp("fc", {{"Input", "x"}, {"W", "fc_w"}}, "fc_out");
+  fc->SetInput("Bias", {"fc_b"});
+  fc->SetAttr<int>("in_num_col_dims", 1);
+  auto* mul = AddOp("mul", {{"X", "fc_out"}, {"Y", "mul_w"}}, "mul_out");
+  mul->SetAttr<int>("x_num_col_dims", 1);
+  mul->SetAttr<int>("y_num_col_dims", 1);
+  AddOp("lookup_table", {{"Ids", "ids"}, {"W", "emb_w"}}, "emb_out")
+      ->SetAttr<int64_t>("padding_idx", -1);
+  AddOp("lookup_table_v2", {{"Ids", "ids"}, {"W", "emb_v2_w"}}, "emb_v2_out")
+      ->SetAttr<int64_t>("padding_idx", -1);
+  auto graph = Convert();
+
+  for (std::string op_type :
+       {"fc", "mul", "lookup_table", "lookup_table_v2"}) {
+    EXPECT_TRUE(WeightBF16(graph.get(), op_type)) << op_type;
+  }
+  ExpectBF16("fc_w");
+  ExpectBF16("mul_w");
+  ExpectBF16("emb_w");
+  ExpectBF16("emb_v2_w");
+  // Only the weight itself, the bias stays fp32.
+  ExpectFP32("fc_b");
+}
+
+TEST_F(X86BF16WeightPassTest, keep_shared_weight) {
+  AddVar("x");
+  AddWeight("shared_w", {6, 4});
+  auto* mul = AddOp("mul", {{"X", "x"}, {"Y", "shared_w"}}, "mul_out");
+  mul->SetAttr<int>("x_num_col_dims", 1);
+  mul->SetAttr<int>("y_num_col_dims", 1);
+  // scale reads the same weight as fp32, so it can not be converted.
+  auto* scale = AddOp("scale", {{"X", "shared_w"}}, "scale_out");
+  scale->SetAttr<float>("scale", 2.f);
+  scale->SetAttr<float>("bias", 0.f);
+  scale->SetAttr<bool>("bias_after_scale", true);
+  auto graph = Convert();
+
+  EXPECT_FALSE(WeightBF16(graph.get(), "mul"));
+  ExpectFP32("shared_w");
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -18,6 +18,7 @@
 #include "lite/core/optimizer/mir/type_target_cast_pass.h"
 #include "lite/model_parser/model_parser.h"
 #include "lite/utils/all.h"
+#include "lite/utils/timer.h"
 
 namespace paddle {
 namespace lite {
@@ -55,7 +56,10 @@ std::unique_ptr<RuntimeProgram> Optimizer::Run(Program&& program) {
   InitControlFlowOpUnusedInputsAndOutputsEliminatePass();
   InitControlFlowOpSharedInputsAndOutputsPlaceSyncPass();
 
+  uint64_t start = Timer::GetCurrentUS();
   ApplyPasses(&graphs_);
+  LOG(INFO) << "== Applied " << passes_.size() << " passes in "
+            << (Timer::GetCurrentUS() - start) / 1000.0 << " ms";
 
   exec_scope_ = program.exec_scope();
 
@@ -112,15 +116,29 @@ void Optimizer::ApplyPasses(
       LOG(INFO) << "   - Skip " << pass->name()
                 << " because the target or kernel does not match.";
     } else {
+      uint64_t start = Timer::GetCurrentUS();
+      size_t applied = 0;
+      auto apply = [&](const std::unique_ptr<mir::SSAGraph>& graph) {
+        // Cheap skip for the graphs without any operator the pass rewrites.
+        if (!PassMatchesOpTypes(*pass, *graph)) return;
+        pass->Apply(graph);
+        applied++;
+      };
       // Check the pass whether it is supported for processing subblocks
       if (kSubblockUnsupportedPasses.count(pass->name())) {
-        pass->Apply((*graphes)[kRootBlockIdx]);
+        apply((*graphes)[kRootBlockIdx]);
       } else {
         for (auto& graph : *graphes) {
-          pass->Apply(graph);
+          apply(graph);
         }
       }
-      LOG(INFO) << "== Finished running: " << pass->name();
+      if (applied == 0) {
+        LOG(INFO) << "   - Skip " << pass->name()
+                  << " because no graph has the bound operators.";
+      } else {
+        LOG(INFO) << "== Finished running: " << pass->name() << ", "
+                  << (Timer::GetCurrentUS() - start) / 1000.0 << " ms";
+      }
     }
   }
 }
@@ -168,6 +186,7 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "lite_flatten_fc_fuse_pass",                   //
        "lite_fc_prelu_fuse_pass",                     //
        "lite_elementwise_activation_fuse_pass",
+       "lite_elementwise_chain_fuse_pass",
        "lite_conv_scale_fuse_pass",
        "lite_conv_elementwise_tree_fuse_pass",
        "lite_greater_than_cast_fuse_pass",
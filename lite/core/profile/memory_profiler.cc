@@ -0,0 +1,239 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/profile/memory_profiler.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include "lite/core/profile/trace_profiler.h"
+#include "lite/utils/env.h"
+#include "lite/utils/macros.h"
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+std::atomic<bool> MemoryProfiler::enabled_{
+    GetBoolFromEnv(MEMORY_PROFILE_ENABLED)};
+
+namespace {
+
+LITE_THREAD_LOCAL MemoryTag current_tag = MemoryTag::kOther;
+LITE_THREAD_LOCAL int current_instruction = -1;
+
+std::string InstructionToStr(int id) {
+  if (id < 0) {
+    return "(outside of instructions)";
+  }
+  auto name = TraceProfiler::Global().Name(id);
+  return name.first + " (" + name.second + ")";
+}
+
+}  // namespace
+
+const char* MemoryTagToStr(MemoryTag tag) {
+  switch (tag) {
+    case MemoryTag::kWeight:
+      return "weight";
+    case MemoryTag::kActivation:
+      return "activation";
+    case MemoryTag::kWorkspace:
+      return "workspace";
+    case MemoryTag::kScratch:
+      return "scratch";
+    default:
+      return "other";
+  }
+}
+
+MemoryTagScope::MemoryTagScope(MemoryTag tag) : prev_tag_(current_tag) {
+  current_tag = tag;
+}
+
+MemoryTagScope::~MemoryTagScope() { current_tag = prev_tag_; }
+
+MemoryProfiler& MemoryProfiler::Global() {
+  static MemoryProfiler* profiler = new MemoryProfiler();
+  return *profiler;
+}
+
+void MemoryProfiler::Enable() {
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void MemoryProfiler::Disable() {
+  enabled_.store(false, std::memory_order_relaxed);
+}
+
+void MemoryProfiler::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  peak_ = Snapshot();
+  peak_pending_ = live_bytes_ > 0;
+  peak_pending_instruction_ = -1;
+  instruction_order_.clear();
+  instruction_stats_.clear();
+}
+
+void MemoryProfiler::OnMalloc(const void* ptr, size_t size) {
+  if (ptr == nullptr) {
+    return;
+  }
+  MemoryTag tag = current_tag;
+  if (tag == MemoryTag::kOther && current_instruction >= 0) {
+    tag = MemoryTag::kScratch;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& allocation = live_[ptr];
+  // The pointer was freed while the profiler was disabled.
+  live_bytes_ -= allocation.size;
+  tag_bytes_[static_cast<int>(allocation.tag)] -= allocation.size;
+
+  allocation.size = size;
+  allocation.tag = tag;
+  allocation.instruction = current_instruction;
+  allocation.name.clear();
+  live_bytes_ += size;
+  tag_bytes_[static_cast<int>(tag)] += size;
+  instruction_peak_ = std::max(instruction_peak_, live_bytes_);
+  if (live_bytes_ > peak_.bytes) {
+    peak_pending_ = true;
+    peak_pending_instruction_ = current_instruction;
+  }
+}
+
+void MemoryProfiler::OnFree(const void* ptr) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = live_.find(ptr);
+  if (it == live_.end()) {
+    return;
+  }
+  TakeSnapshotIfPeak();
+  live_bytes_ -= it->second.size;
+  tag_bytes_[static_cast<int>(it->second.tag)] -= it->second.size;
+  live_.erase(it);
+}
+
+void MemoryProfiler::Annotate(const void* ptr,
+                              const std::string& name,
+                              MemoryTag tag) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = live_.find(ptr);
+  if (it == live_.end()) {
+    return;
+  }
+  auto& allocation = it->second;
+  allocation.name = name;
+  if (allocation.tag == MemoryTag::kOther ||
+      allocation.tag == MemoryTag::kScratch) {
+    tag_bytes_[static_cast<int>(allocation.tag)] -= allocation.size;
+    allocation.tag = tag;
+    tag_bytes_[static_cast<int>(tag)] += allocation.size;
+  }
+}
+
+void MemoryProfiler::BeginInstruction(int id) {
+  current_instruction = id;
+  std::lock_guard<std::mutex> lock(mutex_);
+  instruction_peak_ = live_bytes_;
+  if (!instruction_stats_.count(id)) {
+    instruction_order_.push_back(id);
+  }
+}
+
+void MemoryProfiler::EndInstruction(int id) {
+  current_instruction = -1;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& stat = instruction_stats_[id];
+  stat.live_after = live_bytes_;
+  stat.peak_during = instruction_peak_;
+}
+
+void MemoryProfiler::TakeSnapshotIfPeak() {
+  if (!peak_pending_ || live_bytes_ <= peak_.bytes) {
+    return;
+  }
+  peak_.bytes = live_bytes_;
+  peak_.instruction = peak_pending_instruction_;
+  peak_.allocations.assign(live_.begin(), live_.end());
+  peak_pending_ = false;
+}
+
+size_t MemoryProfiler::live_bytes() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return live_bytes_;
+}
+
+size_t MemoryProfiler::peak_bytes() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  TakeSnapshotIfPeak();
+  return peak_.bytes;
+}
+
+std::string MemoryProfiler::Report(size_t top_n) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  TakeSnapshotIfPeak();
+  // Allocations still alive were usually named after the peak was captured,
+  // e.g. the outputs of the instruction running at the peak.
+  auto allocations = peak_.allocations;
+  size_t tag_bytes[static_cast<int>(MemoryTag::kNumTags)]{};
+  for (auto& item : allocations) {
+    auto it = live_.find(item.first);
+    if (it != live_.end() && it->second.size == item.second.size &&
+        it->second.instruction == item.second.instruction) {
+      item.second = it->second;
+    }
+    tag_bytes[static_cast<int>(item.second.tag)] += item.second.size;
+  }
+  std::stable_sort(allocations.begin(),
+                   allocations.end(),
+                   [](const std::pair<const void*, Allocation>& a,
+                      const std::pair<const void*, Allocation>& b) {
+                     return a.second.size > b.second.size;
+                   });
+
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(1) << std::left;
+  os << "===== Memory Profile (unit: KB) =====\n";
+  os << "live: " << live_bytes_ / 1024. << ", peak: " << peak_.bytes / 1024.
+     << " at " << InstructionToStr(peak_.instruction) << "\n";
+  os << "peak by tag:";
+  for (int i = 0; i < static_cast<int>(MemoryTag::kNumTags); ++i) {
+    os << " " << MemoryTagToStr(static_cast<MemoryTag>(i)) << "="
+       << tag_bytes[i] / 1024.;
+  }
+  os << "\n\nTop allocations at peak:\n";
+  os << std::setw(12) << "size" << std::setw(12) << "tag" << std::setw(32)
+     << "name"
+     << " allocated by\n";
+  for (size_t i = 0; i < std::min(top_n, allocations.size()); ++i) {
+    const auto& allocation = allocations[i].second;
+    os << std::setw(12) << allocation.size / 1024. << std::setw(12)
+       << MemoryTagToStr(allocation.tag) << std::setw(32)
+       << (allocation.name.empty() ? "-" : allocation.name) << " "
+       << InstructionToStr(allocation.instruction) << "\n";
+  }
+  os << "\nLive set per instruction (last run):\n";
+  os << std::setw(16) << "live after" << std::setw(16) << "peak during"
+     << "instruction\n";
+  for (int id : instruction_order_) {
+    const auto& stat = instruction_stats_[id];
+    os << std::setw(16) << stat.live_after / 1024. << std::setw(16)
+       << stat.peak_during / 1024. << InstructionToStr(id) << "\n";
+  }
+  return os.str();
+}
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
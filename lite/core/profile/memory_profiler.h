@@ -0,0 +1,157 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Enables memory accounting at startup when set to true/1.
+#define MEMORY_PROFILE_ENABLED "PADDLE_LITE_MEMORY_PROFILE"
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+enum class MemoryTag {
+  kOther = 0,
+  kWeight,
+  kActivation,
+  kWorkspace,
+  // Allocated by a kernel for its own use while running an instruction.
+  kScratch,
+  kNumTags,
+};
+
+const char* MemoryTagToStr(MemoryTag tag);
+
+/*
+ * Tracks the allocations made through TargetMalloc/TargetFree while enabled,
+ * tagged by what they are used for, and reports the peak of the live set:
+ * its size per tag, the instruction running at that moment and the largest
+ * allocations contributing to it.
+ *
+ * The tag of an allocation comes from the innermost MemoryTagScope of the
+ * allocating thread. Allocations made while an instruction runs default to
+ * kScratch and become kActivation once they are found to back one of its
+ * input or output variables. Enable the profiler before creating the
+ * predictor so that the weights are accounted as well.
+ */
+class MemoryProfiler final {
+ public:
+  static MemoryProfiler& Global();
+
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  void Enable();
+  void Disable();
+  // Resets the peak and the per-instruction records, live allocations are
+  // kept.
+  void Clear();
+
+  void OnMalloc(const void* ptr, size_t size);
+  void OnFree(const void* ptr);
+  // Names a tracked allocation, e.g. after the variable it backs. `tag`
+  // replaces kOther and kScratch only.
+  void Annotate(const void* ptr, const std::string& name, MemoryTag tag);
+
+  // `id` is a TraceProfiler id.
+  void BeginInstruction(int id);
+  void EndInstruction(int id);
+
+  size_t live_bytes();
+  size_t peak_bytes();
+  std::string Report(size_t top_n = 10);
+
+ private:
+  struct Allocation {
+    size_t size{0};
+    MemoryTag tag{MemoryTag::kOther};
+    int instruction{-1};
+    std::string name;
+  };
+  struct Snapshot {
+    size_t bytes{0};
+    int instruction{-1};
+    std::vector<std::pair<const void*, Allocation>> allocations;
+  };
+  struct InstructionStat {
+    size_t live_after{0};
+    size_t peak_during{0};
+  };
+
+  MemoryProfiler() = default;
+  // Captures the live set if it is the largest one seen, called before the
+  // live set shrinks. Requires `mutex_`.
+  void TakeSnapshotIfPeak();
+
+  static std::atomic<bool> enabled_;
+
+  std::mutex mutex_;
+  std::unordered_map<const void*, Allocation> live_;
+  size_t live_bytes_{0};
+  size_t tag_bytes_[static_cast<int>(MemoryTag::kNumTags)]{};
+  // The live set is larger than `peak_` and not yet captured.
+  bool peak_pending_{false};
+  int peak_pending_instruction_{-1};
+  Snapshot peak_;
+  size_t instruction_peak_{0};
+  std::vector<int> instruction_order_;
+  std::map<int, InstructionStat> instruction_stats_;
+};
+
+// Sets the tag of the allocations made by the calling thread in this scope.
+class MemoryTagScope final {
+ public:
+  explicit MemoryTagScope(MemoryTag tag);
+  ~MemoryTagScope();
+
+ private:
+  MemoryTagScope(const MemoryTagScope&) = delete;
+  MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+  MemoryTag prev_tag_;
+};
+
+// Marks the calling thread as running instruction `id`, a TraceProfiler id.
+// Negative ids are ignored.
+class MemoryInstructionScope final {
+ public:
+  explicit MemoryInstructionScope(int id) : id_(id) {
+    if (id_ >= 0) {
+      MemoryProfiler::Global().BeginInstruction(id_);
+    }
+  }
+  ~MemoryInstructionScope() {
+    if (id_ >= 0) {
+      MemoryProfiler::Global().EndInstruction(id_);
+    }
+  }
+
+ private:
+  MemoryInstructionScope(const MemoryInstructionScope&) = delete;
+  MemoryInstructionScope& operator=(const MemoryInstructionScope&) = delete;
+
+  int id_;
+};
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,61 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/profile/memory_profiler.h"
+#include <gtest/gtest.h>
+#include <string>
+#include "lite/core/profile/trace_profiler.h"
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+TEST(memory_profiler, peak_and_tags) {
+  auto& profiler = MemoryProfiler::Global();
+  int id = TraceProfiler::Global().Register("memory_profiler_test", "host");
+  profiler.Enable();
+  profiler.Clear();
+  size_t base = profiler.live_bytes();
+
+  static char weight[4096];
+  static char activation[1024];
+  static char scratch[2048];
+  {
+    MemoryTagScope tag(MemoryTag::kWeight);
+    profiler.OnMalloc(weight, sizeof(weight));
+  }
+  {
+    MemoryInstructionScope instruction(id);
+    profiler.OnMalloc(activation, sizeof(activation));
+    profiler.OnMalloc(scratch, sizeof(scratch));
+    profiler.OnFree(scratch);
+    profiler.Annotate(activation, "out", MemoryTag::kActivation);
+  }
+  EXPECT_EQ(profiler.live_bytes(), base + 4096 + 1024);
+  EXPECT_EQ(profiler.peak_bytes(), base + 4096 + 1024 + 2048);
+
+  std::string report = profiler.Report();
+  EXPECT_NE(report.find("memory_profiler_test"), std::string::npos);
+  EXPECT_NE(report.find("weight="), std::string::npos);
+  EXPECT_NE(report.find("out"), std::string::npos);
+
+  profiler.OnFree(activation);
+  profiler.OnFree(weight);
+  profiler.Disable();
+  EXPECT_EQ(profiler.live_bytes(), base);
+}
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,276 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/profile/perf_counter.h"
+#include <chrono>  // NOLINT
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <vector>
+#include "lite/core/profile/trace_profiler.h"
+#include "lite/utils/env.h"
+#include "lite/utils/log/cp_logging.h"
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+#endif
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+std::atomic<bool> PerfCounterProfiler::enabled_{false};
+
+namespace {
+
+#ifdef __linux__
+// Counters read together with one read(2), see PERF_FORMAT_GROUP.
+class CounterGroup {
+ public:
+  ~CounterGroup() {
+    for (int fd : fds_) {
+      close(fd);
+    }
+  }
+
+  // Adds a counter contributing `weight` times its count to `counter`.
+  bool Add(uint32_t type, uint64_t config, PerfCounter counter, double weight) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    int leader = fds_.empty() ? -1 : fds_[0];
+    int fd = static_cast<int>(
+        syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0));
+    if (fd < 0) {
+      return false;
+    }
+    fds_.push_back(fd);
+    slots_.emplace_back(counter, weight);
+    return true;
+  }
+
+  bool empty() const { return fds_.empty(); }
+
+  // Accumulates the counts, scaled for multiplexing, into `sample`.
+  bool Read(PerfCounterSample* sample) const {
+    if (fds_.empty()) {
+      return false;
+    }
+    // nr, time_enabled, time_running, value[nr]
+    uint64_t data[3 + kNumPerfCounters * 4];
+    size_t size = (3 + fds_.size()) * sizeof(uint64_t);
+    if (fds_.size() > kNumPerfCounters * 4 ||
+        read(fds_[0], data, size) != static_cast<ssize_t>(size)) {
+      return false;
+    }
+    double scale = data[2] > 0 ? static_cast<double>(data[1]) / data[2] : 0.;
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      sample->values[slots_[i].first] += slots_[i].second * data[3 + i] * scale;
+      sample->valid[slots_[i].first] = true;
+    }
+    return true;
+  }
+
+ private:
+  std::vector<int> fds_;
+  std::vector<std::pair<PerfCounter, double>> slots_;
+};
+
+bool IsIntelCPU() {
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  char vendor[13];
+  memcpy(vendor, &ebx, 4);
+  memcpy(vendor + 4, &edx, 4);
+  memcpy(vendor + 8, &ecx, 4);
+  vendor[12] = '\0';
+  return strcmp(vendor, "GenuineIntel") == 0;
+#else
+  return false;
+#endif
+}
+
+struct ThreadCounters {
+  ThreadCounters() {
+    if (!core.Add(PERF_TYPE_HARDWARE,
+                  PERF_COUNT_HW_CPU_CYCLES,
+                  kPerfCycles,
+                  1.)) {
+      return;
+    }
+    core.Add(PERF_TYPE_HARDWARE,
+             PERF_COUNT_HW_INSTRUCTIONS,
+             kPerfInstructions,
+             1.);
+    core.Add(PERF_TYPE_HARDWARE,
+             PERF_COUNT_HW_CACHE_MISSES,
+             kPerfLLCMisses,
+             1.);
+    core.Add(PERF_TYPE_HARDWARE,
+             PERF_COUNT_HW_BRANCH_MISSES,
+             kPerfBranchMisses,
+             1.);
+    if (IsIntelCPU()) {
+      // FP_ARITH_INST_RETIRED (event 0xc7): scalar, 128, 256 and 512 bit
+      // packed single precision with 1, 4, 8 and 16 flops per instruction.
+      const std::pair<uint64_t, double> fp_events[] = {
+          {0x02c7, 1.}, {0x08c7, 4.}, {0x20c7, 8.}, {0x80c7, 16.}};
+      for (auto& event : fp_events) {
+        fp.Add(PERF_TYPE_RAW, event.first, kPerfFlops, event.second);
+      }
+    }
+  }
+
+  CounterGroup core;
+  CounterGroup fp;
+};
+#endif  // __linux__
+
+int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+PerfCounterProfiler& PerfCounterProfiler::Global() {
+  static PerfCounterProfiler* profiler = new PerfCounterProfiler();
+  return *profiler;
+}
+
+PerfCounterProfiler::PerfCounterProfiler() {
+  if (GetBoolFromEnv(PERF_COUNTERS_ENABLED)) {
+    Enable();
+  }
+}
+
+bool PerfCounterProfiler::Enable() {
+  PerfCounterSample sample;
+  if (!Read(&sample)) {
+    LOG(WARNING) << "Hardware performance counters are not available, check "
+                    "/proc/sys/kernel/perf_event_paranoid.";
+    return false;
+  }
+  enabled_.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+void PerfCounterProfiler::Disable() {
+  enabled_.store(false, std::memory_order_relaxed);
+}
+
+void PerfCounterProfiler::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.clear();
+}
+
+bool PerfCounterProfiler::Read(PerfCounterSample* sample) {
+#ifdef __linux__
+  static thread_local ThreadCounters counters;
+  sample->time_ns = NowNs();
+  if (!counters.core.Read(sample)) {
+    return false;
+  }
+  counters.fp.Read(sample);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void PerfCounterProfiler::Record(int id,
+                                 const PerfCounterSample& begin,
+                                 const PerfCounterSample& end) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& stat = stats_[id];
+  stat.calls++;
+  stat.time_ns += end.time_ns - begin.time_ns;
+  for (int i = 0; i < kNumPerfCounters; ++i) {
+    if (begin.valid[i] && end.valid[i]) {
+      stat.values[i] += end.values[i] - begin.values[i];
+      stat.valid[i] = true;
+    }
+  }
+}
+
+std::string PerfCounterProfiler::Summary() {
+  std::map<int, Stat> stats;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats = stats_;
+  }
+  auto counter = [](const Stat& stat, PerfCounter index) {
+    std::ostringstream os;
+    if (stat.valid[index]) {
+      os << static_cast<int64_t>(stat.values[index]);
+    } else {
+      os << "n/a";
+    }
+    return os.str();
+  };
+
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(3);
+  os << "name,category,calls,time_ms,cycles,instructions,llc_misses,"
+        "branch_misses,flops,ipc,gflops,bytes_per_flop\n";
+  for (auto& item : stats) {
+    const auto& stat = item.second;
+    auto name = TraceProfiler::Global().Name(item.first);
+    os << name.first << ",\"" << name.second << "\"," << stat.calls << ","
+       << stat.time_ns / 1e6 << "," << counter(stat, kPerfCycles) << ","
+       << counter(stat, kPerfInstructions) << ","
+       << counter(stat, kPerfLLCMisses) << ","
+       << counter(stat, kPerfBranchMisses) << "," << counter(stat, kPerfFlops)
+       << ",";
+    if (stat.valid[kPerfInstructions] && stat.values[kPerfCycles] > 0) {
+      os << stat.values[kPerfInstructions] / stat.values[kPerfCycles];
+    } else {
+      os << "n/a";
+    }
+    os << ",";
+    bool has_flops = stat.valid[kPerfFlops] && stat.values[kPerfFlops] > 0;
+    if (has_flops && stat.time_ns > 0) {
+      os << stat.values[kPerfFlops] / stat.time_ns;
+    } else {
+      os << "n/a";
+    }
+    os << ",";
+    if (has_flops && stat.valid[kPerfLLCMisses]) {
+      os << stat.values[kPerfLLCMisses] * 64. / stat.values[kPerfFlops];
+    } else {
+      os << "n/a";
+    }
+    os << "\n";
+  }
+  return os.str();
+}
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,115 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>  // NOLINT
+#include <string>
+
+// Enables hardware counter sampling at startup when set to true/1.
+#define PERF_COUNTERS_ENABLED "PADDLE_LITE_PERF_COUNTERS"
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+enum PerfCounter {
+  kPerfCycles = 0,
+  kPerfInstructions,
+  kPerfLLCMisses,
+  kPerfBranchMisses,
+  // Single precision floating point operations, FMA counts as two. Only
+  // available on Intel CPUs exposing FP_ARITH_INST_RETIRED.
+  kPerfFlops,
+  kNumPerfCounters,
+};
+
+struct PerfCounterSample {
+  int64_t time_ns{0};
+  double values[kNumPerfCounters]{};
+  bool valid[kNumPerfCounters]{};
+};
+
+/*
+ * Samples hardware performance counters of the calling thread around each
+ * instruction with perf_event_open(2) and aggregates them per (op type,
+ * kernel), using the ids of TraceProfiler. Work done by thread pool workers
+ * is not counted.
+ *
+ * Counters which can not be opened, e.g. because of perf_event_paranoid or
+ * a missing PMU in a VM, are reported as n/a. Enable() fails on platforms
+ * other than Linux or when not even the cycle counter is available.
+ */
+class PerfCounterProfiler final {
+ public:
+  static PerfCounterProfiler& Global();
+
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  bool Enable();
+  void Disable();
+  void Clear();
+
+  // Reads the counters of the calling thread, opening them on first use.
+  bool Read(PerfCounterSample* sample);
+  void Record(int id,
+              const PerfCounterSample& begin,
+              const PerfCounterSample& end);
+
+  // One CSV row per (name, category) with the raw counters, IPC, achieved
+  // GFLOPS and LLC bytes per flop (64 bytes per LLC miss).
+  std::string Summary();
+
+ private:
+  struct Stat {
+    int64_t calls{0};
+    int64_t time_ns{0};
+    double values[kNumPerfCounters]{};
+    bool valid[kNumPerfCounters]{};
+  };
+
+  PerfCounterProfiler();
+
+  static std::atomic<bool> enabled_;
+  std::mutex mutex_;
+  std::map<int, Stat> stats_;
+};
+
+class PerfCounterScope final {
+ public:
+  explicit PerfCounterScope(int id)
+      : id_(id >= 0 && PerfCounterProfiler::enabled() &&
+                    PerfCounterProfiler::Global().Read(&begin_)
+                ? id
+                : -1) {}
+  ~PerfCounterScope() {
+    PerfCounterSample end;
+    if (id_ >= 0 && PerfCounterProfiler::Global().Read(&end)) {
+      PerfCounterProfiler::Global().Record(id_, begin_, end);
+    }
+  }
+
+ private:
+  PerfCounterScope(const PerfCounterScope&) = delete;
+  PerfCounterScope& operator=(const PerfCounterScope&) = delete;
+
+  PerfCounterSample begin_;
+  int id_;
+};
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,55 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/profile/perf_counter.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "lite/core/profile/trace_profiler.h"
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+TEST(perf_counter, sample_or_fallback) {
+  auto& profiler = PerfCounterProfiler::Global();
+  int id = TraceProfiler::Global().Register("perf_counter_test", "host");
+  profiler.Clear();
+  // Counters are often not permitted in containers, which must not fail.
+  bool available = profiler.Enable();
+  EXPECT_EQ(available, PerfCounterProfiler::enabled());
+
+  std::vector<float> data(1 << 16, 1.f);
+  for (int i = 0; i < 3; ++i) {
+    PerfCounterScope scope(id);
+    float sum = 0.f;
+    for (float v : data) {
+      sum += v;
+    }
+    data[0] = sum;
+  }
+  profiler.Disable();
+
+  std::string summary = profiler.Summary();
+  EXPECT_EQ(summary.find("name,category,calls,"), 0u);
+  if (available) {
+    EXPECT_NE(summary.find("perf_counter_test,\"host\",3,"), std::string::npos);
+  } else {
+    EXPECT_EQ(summary.find("perf_counter_test"), std::string::npos);
+  }
+}
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,277 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/profile/trace_profiler.h"
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <thread>  // NOLINT
+#include "lite/utils/env.h"
+#include "lite/utils/log/cp_logging.h"
+#include "lite/utils/macros.h"
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+struct TraceProfiler::ThreadBuffer {
+  std::thread::id thread_id;
+  int index{0};
+  std::mutex mutex;
+  std::vector<TraceEvent> events;
+  // Number of events recorded since the last Clear(), may exceed the size of
+  // `events` once the ring buffer wraps around.
+  uint64_t count{0};
+};
+
+std::atomic<bool> TraceProfiler::enabled_{false};
+
+namespace {
+
+std::string EscapeJson(const std::string& str) {
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+void SaveTraceAtExit() {
+  auto prefix = GetStringFromEnv(TRACE_PROFILE_OUTPUT_PREFIX);
+  TraceProfiler::Global().SaveChromeTrace(prefix + ".json");
+  TraceProfiler::Global().SaveSummary(prefix + ".csv");
+}
+
+bool SaveString(const std::string& path, const std::string& content) {
+  std::ofstream file(path, std::ios::out | std::ios::trunc);
+  if (!file.is_open()) {
+    LOG(WARNING) << "Failed to open " << path << " for the trace profile.";
+    return false;
+  }
+  file << content;
+  return file.good();
+}
+
+}  // namespace
+
+TraceProfiler& TraceProfiler::Global() {
+  // Never destroyed, so threads may still record while the process exits.
+  static TraceProfiler* profiler = new TraceProfiler();
+  return *profiler;
+}
+
+TraceProfiler::TraceProfiler() : start_ns_(NowNs()) {
+  if (GetBoolFromEnv(TRACE_PROFILE_ENABLED)) {
+    Enable(static_cast<size_t>(GetIntFromEnv(
+        TRACE_PROFILE_BUFFER_SIZE, static_cast<int>(kDefaultEventsPerThread))));
+  }
+  if (!GetStringFromEnv(TRACE_PROFILE_OUTPUT_PREFIX).empty()) {
+    std::atexit(SaveTraceAtExit);
+  }
+}
+
+int64_t TraceProfiler::NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void TraceProfiler::Enable(size_t events_per_thread) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  events_per_thread_ = std::max<size_t>(events_per_thread, 1);
+  for (auto& buffer : buffers_) {
+    std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+    if (buffer->events.size() != events_per_thread_) {
+      buffer->events.assign(events_per_thread_, TraceEvent());
+      buffer->count = 0;
+    }
+  }
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void TraceProfiler::Disable() {
+  enabled_.store(false, std::memory_order_relaxed);
+}
+
+void TraceProfiler::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& buffer : buffers_) {
+    std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+    buffer->count = 0;
+  }
+}
+
+int TraceProfiler::Register(const std::string& name,
+                            const std::string& category) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto key = std::make_pair(name, category);
+  auto it = name_ids_.find(key);
+  if (it != name_ids_.end()) {
+    return it->second;
+  }
+  int id = static_cast<int>(names_.size());
+  names_.push_back(key);
+  name_ids_[key] = id;
+  return id;
+}
+
+std::pair<std::string, std::string> TraceProfiler::Name(int id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK(id >= 0 && id < static_cast<int>(names_.size()))
+      << "Invalid trace id " << id;
+  return names_[id];
+}
+
+TraceProfiler::ThreadBuffer* TraceProfiler::LocalBuffer() {
+  // The thread id is checked as well because LITE_THREAD_LOCAL is empty on
+  // platforms without thread local storage.
+  static LITE_THREAD_LOCAL ThreadBuffer* local = nullptr;
+  auto thread_id = std::this_thread::get_id();
+  if (local != nullptr && local->thread_id == thread_id) {
+    return local;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& buffer : buffers_) {
+    if (buffer->thread_id == thread_id) {
+      local = buffer.get();
+      return local;
+    }
+  }
+  std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+  buffer->thread_id = thread_id;
+  buffer->index = static_cast<int>(buffers_.size());
+  buffer->events.resize(events_per_thread_);
+  local = buffer.get();
+  buffers_.push_back(std::move(buffer));
+  return local;
+}
+
+void TraceProfiler::Record(int id, int64_t begin_ns, int64_t end_ns) {
+  auto* buffer = LocalBuffer();
+  std::lock_guard<std::mutex> lock(buffer->mutex);
+  auto& event = buffer->events[buffer->count % buffer->events.size()];
+  event.id = id;
+  event.begin_ns = begin_ns;
+  event.end_ns = end_ns;
+  ++buffer->count;
+}
+
+std::vector<std::pair<int, TraceEvent>> TraceProfiler::Collect() {
+  std::vector<std::pair<int, TraceEvent>> events;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& buffer : buffers_) {
+    std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+    uint64_t size = buffer->events.size();
+    uint64_t num = std::min(buffer->count, size);
+    uint64_t first = buffer->count - num;
+    for (uint64_t i = first; i < buffer->count; ++i) {
+      events.emplace_back(buffer->index, buffer->events[i % size]);
+    }
+  }
+  return events;
+}
+
+std::string TraceProfiler::ChromeTrace() {
+  auto events = Collect();
+  std::vector<std::pair<std::string, std::string>> names;
+  int num_threads = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    names = names_;
+    num_threads = static_cast<int>(buffers_.size());
+  }
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(3);
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (int tid = 0; tid < num_threads; ++tid) {
+    os << (tid == 0 ? "\n" : ",\n");
+    os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << tid
+       << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+  }
+  for (auto& item : events) {
+    const auto& event = item.second;
+    const auto& name = names[event.id];
+    os << ",\n{\"name\":\"" << EscapeJson(name.first) << "\",\"cat\":\""
+       << EscapeJson(name.second) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+       << item.first << ",\"ts\":" << (event.begin_ns - start_ns_) / 1000.0
+       << ",\"dur\":" << (event.end_ns - event.begin_ns) / 1000.0 << "}";
+  }
+  os << "\n]}\n";
+  return os.str();
+}
+
+std::string TraceProfiler::Summary() {
+  struct Stat {
+    int64_t calls{0};
+    int64_t total_ns{0};
+    int64_t min_ns{std::numeric_limits<int64_t>::max()};
+    int64_t max_ns{0};
+  };
+  auto events = Collect();
+  std::vector<std::pair<std::string, std::string>> names;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    names = names_;
+  }
+  std::vector<Stat> stats(names.size());
+  for (auto& item : events) {
+    auto& stat = stats[item.second.id];
+    int64_t duration = item.second.end_ns - item.second.begin_ns;
+    stat.calls++;
+    stat.total_ns += duration;
+    stat.min_ns = std::min(stat.min_ns, duration);
+    stat.max_ns = std::max(stat.max_ns, duration);
+  }
+  std::vector<int> order;
+  for (size_t i = 0; i < stats.size(); ++i) {
+    if (stats[i].calls > 0) {
+      order.push_back(static_cast<int>(i));
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    return stats[a].total_ns > stats[b].total_ns;
+  });
+
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(3);
+  os << "name,category,calls,total_ms,avg_us,min_us,max_us\n";
+  for (int id : order) {
+    const auto& stat = stats[id];
+    os << names[id].first << ",\"" << names[id].second << "\"," << stat.calls
+       << "," << stat.total_ns / 1e6 << ","
+       << stat.total_ns / 1e3 / stat.calls << "," << stat.min_ns / 1e3 << ","
+       << stat.max_ns / 1e3 << "\n";
+  }
+  return os.str();
+}
+
+bool TraceProfiler::SaveChromeTrace(const std::string& path) {
+  return SaveString(path, ChromeTrace());
+}
+
+bool TraceProfiler::SaveSummary(const std::string& path) {
+  return SaveString(path, Summary());
+}
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
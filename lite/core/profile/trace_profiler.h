@@ -0,0 +1,117 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <utility>
+#include <vector>
+
+// Enables the trace profiler at startup when set to true/1.
+#define TRACE_PROFILE_ENABLED "PADDLE_LITE_TRACE_PROFILE"
+// Number of events kept per thread, older events are overwritten.
+#define TRACE_PROFILE_BUFFER_SIZE "PADDLE_LITE_TRACE_PROFILE_BUFFER_SIZE"
+// When set, the trace is written to <prefix>.json and <prefix>.csv at exit.
+#define TRACE_PROFILE_OUTPUT_PREFIX "PADDLE_LITE_TRACE_PROFILE_OUTPUT_PREFIX"
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+struct TraceEvent {
+  int id{-1};
+  int64_t begin_ns{0};
+  int64_t end_ns{0};
+};
+
+/*
+ * A process-wide span recorder that is compiled into every build, unlike the
+ * LITE_WITH_PROFILE Profiler. When disabled, recording a span costs a single
+ * relaxed atomic load. When enabled, every thread appends to its own ring
+ * buffer, so the newest `events_per_thread` spans of each thread are kept.
+ *
+ * Spans are identified by ids returned from Register(name, category), e.g.
+ * (op type, kernel name) for instructions.
+ */
+class TraceProfiler final {
+ public:
+  static const size_t kDefaultEventsPerThread = 65536;
+
+  static TraceProfiler& Global();
+
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+  static int64_t NowNs();
+
+  void Enable(size_t events_per_thread = kDefaultEventsPerThread);
+  void Disable();
+  // Drops all recorded events, registered ids stay valid.
+  void Clear();
+
+  int Register(const std::string& name, const std::string& category);
+  // (name, category) of a registered id.
+  std::pair<std::string, std::string> Name(int id);
+  void Record(int id, int64_t begin_ns, int64_t end_ns);
+
+  // Chrome trace-event JSON, viewable in chrome://tracing or Perfetto.
+  std::string ChromeTrace();
+  // One CSV row per (name, category): calls and total/avg/min/max time.
+  std::string Summary();
+  bool SaveChromeTrace(const std::string& path);
+  bool SaveSummary(const std::string& path);
+
+ private:
+  struct ThreadBuffer;
+
+  TraceProfiler();
+  ThreadBuffer* LocalBuffer();
+  // Recorded events of all threads as (thread index, event), oldest first.
+  std::vector<std::pair<int, TraceEvent>> Collect();
+
+  static std::atomic<bool> enabled_;
+  std::mutex mutex_;
+  size_t events_per_thread_{kDefaultEventsPerThread};
+  int64_t start_ns_{0};
+  std::vector<std::pair<std::string, std::string>> names_;
+  std::map<std::pair<std::string, std::string>, int> name_ids_;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+};
+
+// Records the lifetime of the scope as one span when the profiler is enabled
+// and `id` is valid.
+class TraceScope final {
+ public:
+  explicit TraceScope(int id)
+      : id_(TraceProfiler::enabled() ? id : -1),
+        begin_ns_(id_ >= 0 ? TraceProfiler::NowNs() : 0) {}
+  ~TraceScope() {
+    if (id_ >= 0) {
+      TraceProfiler::Global().Record(id_, begin_ns_, TraceProfiler::NowNs());
+    }
+  }
+
+ private:
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+  int id_;
+  int64_t begin_ns_;
+};
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
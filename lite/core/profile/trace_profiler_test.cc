@@ -0,0 +1,61 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/profile/trace_profiler.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>  // NOLINT
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+TEST(trace_profiler, ring_buffer_and_export) {
+  auto& profiler = TraceProfiler::Global();
+  int conv = profiler.Register("conv2d", "conv2d:x86/float/NCHW(def)");
+  int relu = profiler.Register("relu", "relu:x86/float/NCHW(def)");
+  EXPECT_EQ(conv, profiler.Register("conv2d", "conv2d:x86/float/NCHW(def)"));
+
+  profiler.Disable();
+  profiler.Clear();
+  { TraceScope scope(conv); }
+  EXPECT_EQ(profiler.Summary().find("conv2d"), std::string::npos);
+
+  profiler.Enable(4);
+  for (int i = 0; i < 6; ++i) {
+    TraceScope scope(relu);
+  }
+  std::thread worker([&]() { TraceScope scope(conv); });
+  worker.join();
+  profiler.Disable();
+
+  // Only the newest 4 relu spans of this thread are kept.
+  std::string summary = profiler.Summary();
+  EXPECT_NE(summary.find("relu,\"relu:x86/float/NCHW(def)\",4,"),
+            std::string::npos);
+  EXPECT_NE(summary.find("conv2d,\"conv2d:x86/float/NCHW(def)\",1,"),
+            std::string::npos);
+
+  std::string trace = profiler.ChromeTrace();
+  EXPECT_EQ(trace.find("{\"displayTimeUnit\""), 0u);
+  EXPECT_NE(trace.find("\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"thread_name\""), std::string::npos);
+
+  profiler.Clear();
+  EXPECT_EQ(profiler.Summary().find("relu"), std::string::npos);
+}
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
@@ -348,10 +348,12 @@ RuntimeProgram::RuntimeProgram(
           op_type + "' is not supported by Paddle-Lite.";
 #endif
 
-      auto kernels = op->CreateKernels({place});
+      // Only the kernel named by kKernelTypeAttr is instantiated.
+      auto kernels = op->CreateKernels({place}, kernel_type);
       if (kernels.size() == 0 && place.target == TargetType::kARM) {
         place.target = TargetType::kHost;
-        kernels = op->CreateKernels({place});
+        kernels = op->CreateKernels(
+            {place}, KernelBase::SerializeKernelType(op_type, alias, place));
       }
       CHECK_GT(kernels.size(), 0) << kernels_error_message;
       auto it = std::find_if(
@@ -441,6 +443,10 @@ void RuntimeProgram::SaveOutput() {
 #endif
 
 void RuntimeProgram::Run() {
+  static const int trace_id = profile::TraceProfiler::Global().Register(
+      "RuntimeProgram::Run", "runtime");
+  profile::TraceScope trace_scope(trace_id);
+
 #ifdef LITE_WITH_PRECISION_PROFILE
   auto inst_precision_profiler = paddle::lite::profile::PrecisionProfiler();
   std::string precision_profiler_summary =
@@ -676,7 +682,44 @@ void Instruction::SaveOutput() {
 }
 #endif
 
+int Instruction::trace_id() {
+  if (trace_id_ < 0) {
+    trace_id_ = profile::TraceProfiler::Global().Register(op_->Type(),
+                                                          kernel_->summary());
+  }
+  return trace_id_;
+}
+
+void Instruction::AnnotateMemory() {
+  auto* scope = op_->scope();
+  auto* op_info = op_->op_info();
+  if (scope == nullptr || op_info == nullptr) {
+    return;
+  }
+  auto annotate = [&](const std::vector<std::string>& var_names) {
+    for (auto& var_name : var_names) {
+      auto* var = scope->FindVar(var_name);
+      if (var == nullptr || !var->IsType<Tensor>()) {
+        continue;
+      }
+      auto* tensor = var->GetMutable<Tensor>();
+      if (tensor->IsInitialized()) {
+        profile::MemoryProfiler::Global().Annotate(
+            tensor->raw_data(), var_name, profile::MemoryTag::kActivation);
+      }
+    }
+  };
+  annotate(op_info->input_names());
+  annotate(op_info->output_names());
+}
+
 void Instruction::Run() {
+  profile::TraceScope trace_scope(
+      profile::TraceProfiler::enabled() ? trace_id() : -1);
+  profile::PerfCounterScope perf_scope(
+      profile::PerfCounterProfiler::enabled() ? trace_id() : -1);
+  profile::MemoryInstructionScope memory_scope(
+      profile::MemoryProfiler::enabled() ? trace_id() : -1);
 #ifdef LITE_WITH_PROFILE
   CHECK(profiler_) << "Profiler pointer of kernel can not be nullptr. "
                       "When LITE_WITH_PROFILE is defined, please set a "
@@ -699,6 +742,9 @@ void Instruction::Run() {
   op_->InferShape();
   kernel_->Launch();
   has_run_ = true;
+  if (profile::MemoryProfiler::enabled()) {
+    AnnotateMemory();
+  }
 
 #ifdef LITE_WITH_PROFILE
   if (first_epoch_for_profiler_) {
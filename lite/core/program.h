@@ -22,6 +22,9 @@
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
+#include "lite/core/profile/memory_profiler.h"
+#include "lite/core/profile/perf_counter.h"
+#include "lite/core/profile/trace_profiler.h"
 #include "lite/model_parser/cpp_desc.h"
 #ifdef LITE_WITH_PROFILE
 #include "lite/core/profile/profiler.h"
@@ -180,11 +183,18 @@ struct Instruction {
 #endif
 
  private:
+  // Id of this instruction in the trace profiler, registered on first use.
+  // Also used by the PerfCounterProfiler and the MemoryProfiler.
+  int trace_id();
+  // Names the allocations backing the variables of this instruction.
+  void AnnotateMemory();
+
   std::shared_ptr<OpLite> op_;
   std::unique_ptr<KernelBase> kernel_;
   bool is_feed_fetch_op_{false};
   bool first_epoch_{true};
   bool has_run_{false};
+  int trace_id_{-1};
 
 #ifdef LITE_WITH_PROFILE
   profile::Profiler* profiler_;
@@ -222,6 +232,9 @@ class LITE_API RuntimeProgram {
     if (instructions_.empty()) {
       LOG(FATAL) << "no instructions";
     }
+    // The runtime profilers read their environment variables when created.
+    profile::TraceProfiler::Global();
+    profile::PerfCounterProfiler::Global();
 #ifdef LITE_WITH_PROFILE
     set_profiler();
 #endif
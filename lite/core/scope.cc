@@ -13,14 +13,12 @@
 // limitations under the License.
 
 #include "lite/core/scope.h"
+#include <algorithm>
+#include <functional>
 #define SCOPE_KIDS_READER_LOCK \
   lite::fluid::AutoRDLock auto_lock(kids_lock_.get());
 #define SCOPE_KIDS_WRITER_LOCK \
   lite::fluid::AutoWRLock auto_lock(kids_lock_.get());
-#define SCOPE_VARS_READER_LOCK \
-  lite::fluid::AutoRDLock auto_lock(vars_lock_.get());
-#define SCOPE_VARS_WRITER_LOCK \
-  lite::fluid::AutoWRLock auto_lock(vars_lock_.get());
 
 namespace paddle {
 namespace lite {
@@ -41,48 +39,95 @@ Scope &Scope::NewScope() const {
   return *kids_.back();
 }
 
+namespace {
+constexpr size_t kMinTableCapacity = 64;
+}  // namespace
+
+void Scope::VarTable::Insert(VarEntry *entry) {
+  size_t idx = entry->hash & mask;
+  while (slots[idx].load(std::memory_order_relaxed)) {
+    idx = (idx + 1) & mask;
+  }
+  slots[idx].store(entry, std::memory_order_release);
+}
+
 Variable *Scope::Var(const std::string &name) {
-  SCOPE_VARS_WRITER_LOCK
-  auto *var = FindVar(name);
+  size_t hash = std::hash<std::string>()(name);
+  auto *var = FindVar(name, hash);
   if (var) return var;
-  // create a new variable.
-  vars_.emplace(name, std::unique_ptr<Variable>(new Variable));
-  return vars_[name].get();
+  return NewLocalVar(name, hash);
 }
 
 Variable *Scope::LocalVar(const std::string &name) {
-  SCOPE_VARS_WRITER_LOCK
-  auto *var = FindLocalVar(name);
+  size_t hash = std::hash<std::string>()(name);
+  auto *var = FindLocalVar(name, hash);
+  if (var) return var;
+  return NewLocalVar(name, hash);
+}
+
+Variable *Scope::NewLocalVar(const std::string &name, size_t hash) {
+  std::lock_guard<std::mutex> lock(vars_mutex_);
+  // Another thread may have created it in the meantime.
+  auto *var = FindLocalVar(name, hash);
   if (var) return var;
-  // create a new variable.
-  vars_.emplace(name, std::unique_ptr<Variable>(new Variable));
-  return vars_[name].get();
+
+  // Keep the table at most half full so probe sequences stay short.
+  VarTable *table = vars_.load(std::memory_order_relaxed);
+  if (!table || (entries_.size() + 1) * 2 > table->capacity()) {
+    size_t capacity = table ? table->capacity() * 2 : kMinTableCapacity;
+    std::unique_ptr<VarTable> grown(new VarTable(capacity));
+    for (auto &entry : entries_) {
+      grown->Insert(entry.get());
+    }
+    table = grown.get();
+    tables_.push_back(std::move(grown));
+    vars_.store(table, std::memory_order_release);
+  }
+  std::unique_ptr<VarEntry> entry(new VarEntry);
+  entry->name = name;
+  entry->hash = hash;
+  entry->var.reset(new Variable);
+  table->Insert(entry.get());
+  entries_.push_back(std::move(entry));
+  return entries_.back()->var.get();
 }
 
 Variable *Scope::FindVar(const std::string &name) const {
-  Variable *var{nullptr};
-  var = FindLocalVar(name);
-  const Scope *cur_scope = this;
-  rwlock_->RDLock();
-  while (!var && cur_scope->parent()) {
-    cur_scope = cur_scope->parent();
-    var = cur_scope->FindLocalVar(name);
+  return FindVar(name, std::hash<std::string>()(name));
+}
+
+Variable *Scope::FindVar(const std::string &name, size_t hash) const {
+  for (const Scope *cur_scope = this; cur_scope;
+       cur_scope = cur_scope->parent()) {
+    auto *var = cur_scope->FindLocalVar(name, hash);
+    if (var) return var;
   }
-  rwlock_->UNLock();
-  return var;
+  return nullptr;
 }
 
 Variable *Scope::FindLocalVar(const std::string &name) const {
-  rwlock_->RDLock();
-  auto it = vars_.find(name);
-  if (it != vars_.end()) {
-    rwlock_->UNLock();
-    return it->second.get();
+  return FindLocalVar(name, std::hash<std::string>()(name));
+}
+
+Variable *Scope::FindLocalVar(const std::string &name, size_t hash) const {
+  const VarTable *table = vars_.load(std::memory_order_acquire);
+  if (!table) return nullptr;
+  size_t idx = hash & table->mask;
+  while (const VarEntry *entry =
+             table->slots[idx].load(std::memory_order_acquire)) {
+    if (entry->hash == hash && entry->name == name) {
+      return entry->var.get();
+    }
+    idx = (idx + 1) & table->mask;
   }
-  rwlock_->UNLock();
   return nullptr;
 }
 
+size_t Scope::LocalVarCount() const {
+  std::lock_guard<std::mutex> lock(vars_mutex_);
+  return entries_.size();
+}
+
 // AttributeVarNames will get persistive attribute names stored in parent scope
 std::vector<std::string> Scope::AttributeVarNames() const {
   std::vector<std::string> resulted_keys;
@@ -109,12 +154,13 @@ std::vector<std::string> Scope::AttributeVarNames() const {
 std::vector<std::string> Scope::LocalVarNames() const {
   std::vector<std::string> keys;
   {
-    rwlock_->RDLock();
-    for (const auto &item : vars_) {
-      keys.push_back(item.first);
+    std::lock_guard<std::mutex> lock(vars_mutex_);
+    for (const auto &entry : entries_) {
+      keys.push_back(entry->name);
     }
-    rwlock_->UNLock();
   }
+  // Callers used to get the names in the order of a std::map.
+  std::sort(keys.begin(), keys.end());
   return keys;
 }
 
@@ -13,9 +13,11 @@
 // limitations under the License.
 
 #pragma once
+#include <atomic>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <utility>
 #include <vector>
@@ -25,12 +27,13 @@
 namespace paddle {
 namespace lite {
 
+// Variables are kept in an open-addressing hash table. Lookups take no lock:
+// entries are never moved or removed, and a growing table is published as a
+// whole while the previous one stays alive until the scope is destroyed.
+// Creating variables is serialized by a mutex.
 class Scope final {
  public:
-  Scope()
-      : kids_lock_{new lite::fluid::RWLock},
-        vars_lock_{new lite::fluid::RWLock},
-        rwlock_{new lite::fluid::RWLock} {}
+  Scope() : kids_lock_{new lite::fluid::RWLock} {}
   // delete below two functions to allow pybind to recognise it cannot make a
   // copy
   // link:
@@ -51,6 +54,8 @@ class Scope final {
 
   const Scope* parent() const { return parent_; }
 
+  size_t LocalVarCount() const;
+
   // Get attribute params stored in parent scopes.
   std::vector<std::string> AttributeVarNames() const;
   // Following the legacy scope interface.
@@ -94,13 +99,42 @@ class Scope final {
   }
 
  private:
+  struct VarEntry {
+    std::string name;
+    size_t hash;
+    std::unique_ptr<Variable> var;
+  };
+
+  struct VarTable {
+    explicit VarTable(size_t capacity)
+        : mask(capacity - 1), slots(new std::atomic<VarEntry*>[capacity]) {
+      for (size_t i = 0; i < capacity; i++) {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+    size_t capacity() const { return mask + 1; }
+    // Only called with `vars_mutex_` held.
+    void Insert(VarEntry* entry);
+
+    size_t mask;
+    std::unique_ptr<std::atomic<VarEntry*>[]> slots;
+  };
+
+  // The name is hashed once and the hash reused along the parent chain.
+  Variable* FindVar(const std::string& name, size_t hash) const;
+  Variable* FindLocalVar(const std::string& name, size_t hash) const;
+  Variable* NewLocalVar(const std::string& name, size_t hash);
+
   // Scope in `kids_` are owned by this class.
   mutable std::list<Scope*> kids_;
   const Scope* parent_{nullptr};
-  std::map<std::string, std::unique_ptr<Variable>> vars_;
+  std::atomic<VarTable*> vars_{nullptr};
+  // Own the entries in insertion order and every table ever published, as
+  // readers may still probe a table that has been replaced.
+  std::vector<std::unique_ptr<VarEntry>> entries_;
+  std::vector<std::unique_ptr<VarTable>> tables_;
+  mutable std::mutex vars_mutex_;
   std::unique_ptr<lite::fluid::RWLock> kids_lock_{nullptr};
-  std::unique_ptr<lite::fluid::RWLock> vars_lock_{nullptr};
-  std::unique_ptr<lite::fluid::RWLock> rwlock_{nullptr};
 };
 
 }  // namespace lite
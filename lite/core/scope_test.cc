@@ -14,6 +14,10 @@
 
 #include "lite/core/scope.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
 
 namespace paddle {
 namespace lite {
@@ -33,5 +37,58 @@ TEST(Scope, FindVar) {
   ASSERT_TRUE(scope.FindVar("x"));
 }
 
+TEST(Scope, ManyVars) {
+  Scope scope;
+  std::vector<Variable*> vars;
+  for (int i = 0; i < 1000; i++) {
+    vars.push_back(scope.Var("var_" + std::to_string(i)));
+  }
+  ASSERT_EQ(scope.LocalVarCount(), 1000UL);
+  // Growing the table keeps the variables in place.
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_EQ(scope.FindVar("var_" + std::to_string(i)), vars[i]);
+  }
+  ASSERT_EQ(scope.Var("var_7"), vars[7]);
+  ASSERT_FALSE(scope.FindVar("var_1000"));
+
+  auto names = scope.LocalVarNames();
+  ASSERT_EQ(names.size(), 1000UL);
+  ASSERT_TRUE(std::is_sorted(names.begin(), names.end()));
+}
+
+TEST(Scope, Parent) {
+  Scope scope;
+  auto* w = scope.Var("w");
+  auto& kid = scope.NewScope();
+  ASSERT_EQ(kid.FindVar("w"), w);
+  ASSERT_FALSE(kid.FindLocalVar("w"));
+  ASSERT_EQ(kid.Var("w"), w);
+  auto* local = kid.LocalVar("w");
+  ASSERT_NE(local, w);
+  ASSERT_EQ(kid.FindVar("w"), local);
+  ASSERT_FALSE(scope.FindVar("x"));
+}
+
+TEST(Scope, ConcurrentFind) {
+  Scope scope;
+  auto* w = scope.Var("w");
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; t++) {
+    readers.emplace_back([&] {
+      for (int i = 0; i < 20000; i++) {
+        ASSERT_EQ(scope.FindVar("w"), w);
+      }
+    });
+  }
+  // The writer grows the table while the readers probe it.
+  for (int i = 0; i < 2000; i++) {
+    scope.Var("tmp_" + std::to_string(i));
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  ASSERT_EQ(scope.LocalVarCount(), 2001UL);
+}
+
 }  // namespace lite
 }  // namespace paddle
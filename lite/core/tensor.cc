@@ -31,6 +31,19 @@ void TensorLite::ShareDataWith(const TensorLite &other) {
   offset_ = other.offset_;
 }
 
+void TensorLite::ShareDataWith(const TensorLite &other,
+                               size_t offset,
+                               size_t size) {
+  CHECK_LE(other.offset_ + offset + size, other.buffer_->space())
+      << "The view is out of the memory of the tensor.";
+  buffer_ = std::make_shared<ViewBuffer>(
+      other.buffer_, other.offset_ + offset, size);
+  target_ = other.target_;
+  memory_size_ = size;
+  precision_ = other.precision_;
+  offset_ = 0;
+}
+
 void TensorLite::CopyDataFrom(const TensorLite &other) {
   dims_ = other.dims_;
   target_ = other.target_;
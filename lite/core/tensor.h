@@ -224,10 +224,19 @@ class TensorLite {
   // Other share data to this.
   void ShareDataWith(const TensorLite &other);
 
+  // Makes this tensor a view of |size| bytes of |other| from byte |offset|,
+  // keeping its own dims and lod. A later mutable_data() asking for more
+  // than |size| bytes gives it a buffer of its own, see ViewBuffer.
+  void ShareDataWith(const TensorLite &other, size_t offset, size_t size);
+
   void CopyDataFrom(const TensorLite &other);
 
   void ResetBuffer(std::shared_ptr<Buffer> buffer, size_t memory_size);
 
+  // False when the memory belongs to someone else, e.g. it was set by
+  // ResetBuffer with external memory.
+  bool own_data() const { return buffer_->own_data(); }
+
   TargetType target() const { return target_; }
   void set_target(TargetType target) { target_ = target; }
 
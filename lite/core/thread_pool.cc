@@ -14,6 +14,7 @@
 
 #include "lite/core/thread_pool.h"
 #include <string.h>
+#include "lite/core/profile/trace_profiler.h"
 #include "lite/utils/log/logging.h"
 
 namespace paddle {
@@ -45,14 +46,19 @@ ThreadPool::ThreadPool(int number) {
   for (int i = 0; i < thread_num_; ++i) {
     tasks_.second.emplace_back(new std::atomic<bool>{false});
   }
+  int trace_id =
+      profile::TraceProfiler::Global().Register("ThreadPool::Task", "worker");
   for (int thread_index = 1; thread_index < thread_num_; ++thread_index) {
-    workers_.emplace_back([this, thread_index]() {
+    workers_.emplace_back([this, thread_index, trace_id]() {
       while (!stop_) {
         // if (*tasks_.second[thread_index]) {
         while (!(*tasks_.second[thread_index])) {
           std::this_thread::yield();
         }
-        tasks_.first(thread_index, thread_index);
+        {
+          profile::TraceScope trace_scope(trace_id);
+          tasks_.first(thread_index, thread_index);
+        }
         *tasks_.second[thread_index] = false;
       }
     });
@@ -24,6 +24,8 @@
 #include <set>
 #include <string>
 #include <typeinfo>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include "lite/core/kernel_version.h"
 #include "lite/core/tensor.h"
@@ -356,8 +358,7 @@ class ParamTypeRegistry {
                 const std::string& arg_name,
                 ParamType data_type) {
     KernelIdTy key{kernel_type, place, io, arg_name};
-    types_[key] = data_type;
-    CHECK(types_.count(key));
+    types_[key.hash()] = std::make_pair(key, data_type);
   }
 
   void SetVersion(const int64_t version,
@@ -441,7 +442,8 @@ class ParamTypeRegistry {
   friend STL::ostream& operator<<(STL::ostream& os,
                                   const ParamTypeRegistry& other) {
     for (auto& item : other.types_) {
-      os << item.first << " " << item.second.DebugString() << "\n";
+      os << item.second.first << " " << item.second.second.DebugString()
+         << "\n";
     }
     return os;
   }
@@ -452,9 +454,9 @@ class ParamTypeRegistry {
                             const std::string& op_type,
                             const std::string& arg_name) {
     KernelIdTy key{op_type, place, io, arg_name};
-    auto it = types_.find(key);
+    auto it = types_.find(key.hash());
     if (it == types_.end()) return nullptr;
-    return &it->second;
+    return &it->second.second;
   }
 
  private:
@@ -478,7 +480,10 @@ class ParamTypeRegistry {
   };
 
  private:
-  std::map<key_t, ParamType, ParamTypeRegistry::KeyCmp> types_;
+  // Keyed by the key hash, which KeyCmp also compares. Every kernel
+  // registers its arguments from a static initializer, hashing the key once
+  // keeps that cheap.
+  std::unordered_map<size_t, std::pair<key_t, ParamType>> types_;
   std::map<key_t, KernelVersion, ParamTypeRegistry::KeyCmp> kernel_versions_;
   std::map<key_t, int64_t, ParamTypeRegistry::KeyCmp> versions_;
 };
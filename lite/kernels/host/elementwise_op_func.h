@@ -525,6 +525,10 @@ void common_elmentwise_op_naive_cpu(
       }
       break;
     }
+    default: {
+      LOG(FATAL) << "Unsupported broadcast type";
+      break;
+    }
   }
 }
 
@@ -14,6 +14,7 @@
 
 #pragma once
 #include <stdint.h>
+#include "lite/backends/host/math/reduce.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 
@@ -22,7 +23,7 @@ namespace lite {
 namespace kernels {
 namespace host {
 
-template <typename T, typename Functor>
+template <typename T, lite::host::math::ReduceType type>
 class ReduceCompute : public KernelLite<TARGET(kHost), PRECISION(kFloat)> {
  public:
   void Run() override;
@@ -38,6 +38,26 @@ void SplitCompute<T, PType>::Run() {
     axis += static_cast<int>(param.x->dims().size());
   }
 
+  // Split along the outermost axis that is not 1: the outputs are just
+  // consecutive pieces of the input.
+  if (param.inplace && in_dim.count(0, axis) == 1) {
+    size_t offset = 0;
+    for (auto* out : dout) {
+      size_t size = out->numel() * sizeof(T);
+      out->ShareDataWith(*param.x, offset, size);
+      offset += size;
+    }
+    views_ = true;
+    return;
+  }
+  if (views_) {
+    // Let go of the input before writing the outputs.
+    for (auto* out : dout) {
+      out->clear();
+    }
+    views_ = false;
+  }
+
   lite::host::math::split(din, dout, axis, in_strides);
 }
 
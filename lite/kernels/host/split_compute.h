@@ -27,6 +27,10 @@ class SplitCompute : public KernelLite<TARGET(kHost), PType> {
   void Run() override;
 
   virtual ~SplitCompute() = default;
+
+ private:
+  // Whether the outputs were left as views of the input.
+  bool views_{false};
 };
 
 }  // namespace host
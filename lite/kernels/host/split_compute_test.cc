@@ -0,0 +1,94 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/host/split_compute.h"
+#include <gtest/gtest.h>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace host {
+
+static void fill(lite::Tensor* x, float base) {
+  auto* data = x->mutable_data<float>();
+  for (int64_t i = 0; i < x->numel(); ++i) {
+    data[i] = base + i;
+  }
+}
+
+TEST(split_host, inplace) {
+  lite::Tensor x, out0, out1, out2;
+  x.Resize({1, 6, 4});
+  fill(&x, 0.f);
+  const float* x_data = x.data<float>();
+  out0.Resize({1, 2, 4});
+  out1.Resize({1, 3, 4});
+  out2.Resize({1, 1, 4});
+
+  SplitFloat split;
+  operators::SplitParam param;
+  param.x = &x;
+  param.output = {&out0, &out1, &out2};
+  param.axis = 1;
+  param.sections = {2, 3, 1};
+  param.inplace = true;
+  split.SetParam(param);
+  split.Run();
+
+  // Each output is a view of its piece of the input.
+  EXPECT_EQ(out0.data<float>(), x_data);
+  EXPECT_EQ(out1.data<float>(), x_data + 8);
+  EXPECT_EQ(out2.data<float>(), x_data + 20);
+  for (int i = 0; i < 12; ++i) {
+    EXPECT_EQ(out1.data<float>()[i], 8.f + i);
+  }
+
+  // An output growing past its piece moves out, the input is left alone.
+  out1.Resize({1, 5, 4});
+  fill(&out1, 100.f);
+  EXPECT_NE(out1.data<float>(), x_data + 8);
+  EXPECT_EQ(x.data<float>(), x_data);
+  for (int i = 0; i < 24; ++i) {
+    EXPECT_EQ(x_data[i], static_cast<float>(i));
+  }
+  EXPECT_EQ(out2.data<float>(), x_data + 20);
+
+  // Not split along the outermost axis: the outputs get memory of their
+  // own before they are written.
+  out0.Resize({1, 6, 1});
+  out1.Resize({1, 6, 3});
+  param.output = {&out0, &out1};
+  param.axis = 2;
+  param.sections = {1, 3};
+  split.SetParam(param);
+  split.Run();
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(out0.data<float>()[i], 4.f * i);
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_EQ(out1.data<float>()[i * 3 + j], 4.f * i + 1 + j);
+    }
+  }
+  for (int i = 0; i < 24; ++i) {
+    EXPECT_EQ(x_data[i], static_cast<float>(i));
+  }
+}
+
+}  // namespace host
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(split, kHost, kFloat, kNCHW, def);
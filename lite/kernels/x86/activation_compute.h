@@ -25,6 +25,7 @@
 #include "lite/backends/x86/fluid/eigen.h"
 #include "lite/backends/x86/math/activation.h"
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/parallel.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
@@ -64,15 +65,28 @@ struct BaseActivationFunctor {
   bool Inplace() const { return false; }
 };
 
+// Evaluates the Eigen functor over the flattened tensor, one slice per
+// thread.
 template <typename Functor>
-bool Activate(const lite::Tensor* X, lite::Tensor* Out) {
+bool Activate(const lite::Tensor* X,
+              lite::Tensor* Out,
+              const Functor& functor = Functor()) {
   using T = typename Functor::ELEMENT_TYPE;
   auto place = lite::fluid::EigenDeviceType<TARGET(kX86)>();
   CHECK_OR_FALSE(X)
   CHECK_OR_FALSE(Out)
-  auto x = lite::fluid::EigenVector<T>::Flatten(*X);
-  auto out = lite::fluid::EigenVector<T>::Flatten(*Out);
-  Functor()(place, x, out);
+  const T* x_data = X->template data<T>();
+  T* out_data = Out->template mutable_data<T>();
+  lite::x86::RunParallelFor(
+      0,
+      X->numel(),
+      lite::x86::math::kActGrainLight,
+      [&](int64_t begin, int64_t end) {
+        auto dim = lite::fluid::EigenDim<1>::From(end - begin);
+        typename lite::fluid::EigenVector<T>::ConstType x(x_data + begin, dim);
+        typename lite::fluid::EigenVector<T>::Type out(out_data + begin, dim);
+        functor(place, x, out);
+      });
   return true;
 }
 
@@ -93,8 +107,13 @@ class SquareCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   void Run() override {
     auto& param = *param_.get_mutable<operators::ActivationParam>();
 
-    param.Out->template mutable_data<T>();
-    Activate<SquareFunctor<T>>(param.X, param.Out);
+    const T* x_data = param.X->template data<T>();
+    T* out_data = param.Out->template mutable_data<T>();
+    lite::x86::math::ParallelActivate(x_data,
+                                      out_data,
+                                      param.X->numel(),
+                                      lite::x86::math::kActGrainLight,
+                                      lite::x86::math::vsquare<T>);
   }
 
   virtual ~SquareCompute() = default;
@@ -117,8 +136,13 @@ class ReluCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   void Run() override {
     auto& param = *param_.get_mutable<operators::ActivationParam>();
 
-    param.Out->template mutable_data<T>();
-    Activate<ReluFunctor<T>>(param.X, param.Out);
+    const T* x_data = param.X->template data<T>();
+    T* out_data = param.Out->template mutable_data<T>();
+    lite::x86::math::ParallelActivate(x_data,
+                                      out_data,
+                                      param.X->numel(),
+                                      lite::x86::math::kActGrainLight,
+                                      lite::x86::math::vrelu<T>);
   }
 
   virtual ~ReluCompute() = default;
@@ -126,6 +150,8 @@ class ReluCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
 
 template <typename T>
 struct LeakyReluFunctor {
+  using ELEMENT_TYPE = T;
+
   float alpha;
   explicit LeakyReluFunctor(float alpha_) : alpha(alpha_) {}
 
@@ -143,16 +169,8 @@ class LeakyReluCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   void Run() override {
     auto& param = *param_.get_mutable<operators::ActivationParam>();
 
-    param.Out->template mutable_data<T>();
-    auto X = param.X;
-    auto Out = param.Out;
-    auto place = lite::fluid::EigenDeviceType<TARGET(kX86)>();
-    CHECK(X);
-    CHECK(Out);
-    auto x = lite::fluid::EigenVector<T>::Flatten(*X);
-    auto out = lite::fluid::EigenVector<T>::Flatten(*Out);
-    LeakyReluFunctor<T> functor(param.Leaky_relu_alpha);
-    functor(place, x, out);
+    CHECK(Activate(
+        param.X, param.Out, LeakyReluFunctor<T>(param.Leaky_relu_alpha)));
   }
 
   virtual ~LeakyReluCompute() = default;
@@ -175,44 +193,19 @@ class TanhCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   void Run() override {
     auto& param = *param_.get_mutable<operators::ActivationParam>();
 
-    param.Out->template mutable_data<T>();
-    Activate<TanhFunctor<T>>(param.X, param.Out);
+    const T* x_data = param.X->template data<T>();
+    T* out_data = param.Out->template mutable_data<T>();
+    lite::x86::math::ParallelActivate(x_data,
+                                      out_data,
+                                      param.X->numel(),
+                                      lite::x86::math::kActGrainHeavy,
+                                      lite::x86::math::vtanh<T>);
   }
 
   virtual ~TanhCompute() = default;
 };
 
-// gelu(x) = 0.5 * x *  (1 + erf(x / sqrt(2)))
-template <typename T>
-struct GeluFunctor : public BaseActivationFunctor<T> {
-  template <typename Device, typename X, typename Out>
-  void operator()(Device d, X x, Out out) const {
-// Because the execute or device context can not be deliver here, it keep the
-// marco for NVCC.
-#if defined(PADDLE_WITH_MKLML) && !defined(_WIN32) && !defined(__APPLE__) && \
-    !defined(__OSX__) && !defined(PADDLE_WITH_CUDA)
-    auto x_data = x.data();
-    auto out_data = out.data();
-    int n = std::min(x.size(), out.size());
-
-    std::memset(out_data, 0, n * sizeof(T));
-    paddle::lite::x86::math::CBlas<T>::AXPY(
-        n, static_cast<T>(M_SQRT1_2), x_data, 1, out_data, 1);
-    paddle::lite::x86::math::CBlas<T>::VMERF(n, out_data, out_data, VML_LA);
-    for (int i = 0; i < n; i++) {
-      out_data[i] += static_cast<T>(1);
-    }
-    paddle::lite::x86::math::CBlas<T>::VMUL(n, x_data, out_data, out_data);
-    for (int i = 0; i < n; i++) {
-      out_data[i] *= static_cast<T>(0.5);
-    }
-#else
-    auto temp = (x * static_cast<T>(M_SQRT1_2)).erf();
-    out.device(d) = x * static_cast<T>(0.5) * (static_cast<T>(1) + temp);
-#endif
-  }
-};
-
+// gelu(x) = 0.5 * x * (1 + erf(x / sqrt(2)))
 template <typename T>
 class GeluCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
@@ -221,8 +214,13 @@ class GeluCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   void Run() override {
     auto& param = *param_.get_mutable<operators::ActivationParam>();
 
-    param.Out->template mutable_data<T>();
-    Activate<GeluFunctor<T>>(param.X, param.Out);
+    const T* x_data = param.X->template data<T>();
+    T* out_data = param.Out->template mutable_data<T>();
+    lite::x86::math::ParallelActivate(x_data,
+                                      out_data,
+                                      param.X->numel(),
+                                      lite::x86::math::kActGrainHeavy,
+                                      lite::x86::math::gelu<T>);
   }
 
   virtual ~GeluCompute() = default;
@@ -235,15 +233,20 @@ class SoftsignCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   using param_t = operators::ActivationParam;
 
   void Run() override {
-    // auto& context = ctx_->As<X86Context>();
     auto& param = *param_.get_mutable<operators::ActivationParam>();
 
     const T* x_data = param.X->template data<T>();
     T* out_data = param.Out->template mutable_data<T>();
-    size_t x_size = param.X->numel();
-    for (size_t i = 0; i < x_size; i++) {
-      out_data[i] = x_data[i] / (static_cast<T>(1) + std::abs(x_data[i]));
-    }
+    lite::x86::math::ParallelActivate(
+        x_data,
+        out_data,
+        param.X->numel(),
+        lite::x86::math::kActGrainLight,
+        [](const T* din, T* dout, int size) {
+          for (int i = 0; i < size; i++) {
+            dout[i] = din[i] / (static_cast<T>(1) + std::abs(din[i]));
+          }
+        });
   }
 
   virtual ~SoftsignCompute() = default;
@@ -265,8 +268,13 @@ class SigmoidCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
 
   void Run() override {
     auto& param = this->Param<param_t>();
-    param.Out->template mutable_data<T>();
-    Activate<SigmoidFunctor<T>>(param.X, param.Out);
+    const T* x_data = param.X->template data<T>();
+    T* out_data = param.Out->template mutable_data<T>();
+    lite::x86::math::ParallelActivate(x_data,
+                                      out_data,
+                                      param.X->numel(),
+                                      lite::x86::math::kActGrainHeavy,
+                                      lite::x86::math::vsigmoid<T>);
   }
 
   virtual ~SigmoidCompute() = default;
@@ -275,6 +283,8 @@ class SigmoidCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
 // relu6(x) = min(max(0, x), 6)
 template <typename T>
 struct Relu6Functor {
+  using ELEMENT_TYPE = T;
+
   float threshold;
   explicit Relu6Functor(float threshold_) : threshold(threshold_) {}
 
@@ -293,16 +303,7 @@ class Relu6Compute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   void Run() override {
     auto& param = *param_.get_mutable<operators::ActivationParam>();
 
-    param.Out->template mutable_data<T>();
-    auto X = param.X;
-    auto Out = param.Out;
-    auto place = lite::fluid::EigenDeviceType<TARGET(kX86)>();
-    CHECK(X);
-    CHECK(Out);
-    auto x = lite::fluid::EigenVector<T>::Flatten(*X);
-    auto out = lite::fluid::EigenVector<T>::Flatten(*Out);
-    Relu6Functor<T> functor(param.threshold);
-    functor(place, x, out);
+    CHECK(Activate(param.X, param.Out, Relu6Functor<T>(param.threshold)));
   }
 
   virtual ~Relu6Compute() = default;
@@ -359,18 +360,73 @@ class MishCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
 
   void Run() override {
     auto& param = *param_.get_mutable<operators::ActivationParam>();
-    param.Out->template mutable_data<T>();
-    auto x_dims = param.X->dims();
-    auto x_data = param.X->template data<T>();
-    auto output_data = param.Out->template mutable_data<T>();
+    const T* x_data = param.X->template data<T>();
+    T* out_data = param.Out->template mutable_data<T>();
     float threshold = param.threshold;
-    lite::x86::math::mish<T>(
-        x_data, output_data, x_dims.production(), threshold);
+    lite::x86::math::ParallelActivate(
+        x_data,
+        out_data,
+        param.X->numel(),
+        lite::x86::math::kActGrainHeavy,
+        [threshold](const T* din, T* dout, int size) {
+          lite::x86::math::mish<T>(din, dout, size, threshold);
+        });
   }
 
   virtual ~MishCompute() = default;
 };
 
+// swish(x) = x / (1 + exp(-beta * x))
+template <typename T>
+class SwishCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::ActivationParam;
+
+  void Run() override {
+    auto& param = *param_.get_mutable<operators::ActivationParam>();
+    const T* x_data = param.X->template data<T>();
+    T* out_data = param.Out->template mutable_data<T>();
+    float beta = param.Swish_beta;
+    lite::x86::math::ParallelActivate(
+        x_data,
+        out_data,
+        param.X->numel(),
+        lite::x86::math::kActGrainHeavy,
+        [beta](const T* din, T* dout, int size) {
+          lite::x86::math::swish<T>(din, dout, size, beta);
+        });
+  }
+
+  virtual ~SwishCompute() = default;
+};
+
+// hard_swish(x) = min(max(0, x + offset), threshold) * x / scale
+template <typename T>
+class HardSwishCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::ActivationParam;
+
+  void Run() override {
+    auto& param = *param_.get_mutable<operators::ActivationParam>();
+    const T* x_data = param.X->template data<T>();
+    T* out_data = param.Out->template mutable_data<T>();
+    float threshold = param.hard_swish_threshold;
+    float scale = param.hard_swish_scale;
+    float offset = param.hard_swish_offset;
+    lite::x86::math::ParallelActivate(
+        x_data,
+        out_data,
+        param.X->numel(),
+        lite::x86::math::kActGrainLight,
+        [=](const T* din, T* dout, int size) {
+          lite::x86::math::hard_swish<T>(
+              din, dout, size, threshold, scale, offset);
+        });
+  }
+
+  virtual ~HardSwishCompute() = default;
+};
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <cstring>
 #include <vector>
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
@@ -56,10 +57,19 @@ class ConcatCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     }
 
     auto* out = param.output;
+    int num_concat = count(0, axis, x_dims);
+    if (param.inplace && num_concat == 1) {
+      ConcatInPlace(param.x, out);
+      return;
+    }
+    if (in_place_) {
+      // The inputs may still live in the output, write a new one.
+      ResetOutput(out);
+      in_place_ = false;
+    }
     T* output_data = param.output->template mutable_data<T>();
 
     int offset_concat_axis = 0;
-    int num_concat = count(0, axis, x_dims);
     int concat_input_size = count(axis + 1, x_dims.size(), x_dims);
     const int top_concat_axis = out->dims()[axis];
     for (size_t i = 0; i < param.x.size(); ++i) {
@@ -76,6 +86,51 @@ class ConcatCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     }
   }
   virtual ~ConcatCompute() = default;
+
+ private:
+  // Stacked along the outermost axis, every input has a contiguous piece of
+  // the output. The inputs are made views of their pieces, so once their
+  // ops write there directly, there is nothing left to copy.
+  void ConcatInPlace(const std::vector<lite::Tensor*>& inputs,
+                     lite::Tensor* out) {
+    bool same_layout = in_place_ && out->dims() == out_dims_;
+    for (size_t i = 0; same_layout && i < inputs.size(); ++i) {
+      same_layout = inputs[i]->dims() == in_dims_[i];
+    }
+    if (!same_layout) {
+      // The views keep the old output alive while it is copied from.
+      ResetOutput(out);
+      out_dims_ = out->dims();
+      in_dims_.clear();
+      for (auto* x : inputs) {
+        in_dims_.push_back(x->dims());
+      }
+    }
+    auto* out_data = reinterpret_cast<char*>(out->template mutable_data<T>());
+    size_t offset = 0;
+    for (auto* x : inputs) {
+      size_t size = x->numel() * sizeof(T);
+      if (x->raw_data() != out_data + offset) {
+        std::memcpy(out_data + offset, x->raw_data(), size);
+        x->ShareDataWith(*out, offset, size);
+      }
+      offset += size;
+    }
+    in_place_ = true;
+  }
+
+  // Gives |out| memory of its own, leaving the old one to its views.
+  void ResetOutput(lite::Tensor* out) {
+    lite::Tensor fresh;
+    fresh.Resize(out->dims());
+    fresh.set_lod(out->lod());
+    fresh.template mutable_data<T>(out->target());
+    out->ShareDataWith(fresh);
+  }
+
+  bool in_place_{false};
+  DDim out_dims_;
+  std::vector<DDim> in_dims_;
 };
 
 }  // namespace x86
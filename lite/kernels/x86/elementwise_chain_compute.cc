@@ -0,0 +1,327 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/elementwise_chain_compute.h"
+#include <algorithm>
+#include <map>
+#include <string>
+#include "lite/backends/x86/math/activation.h"
+#include "lite/backends/x86/math/elementwise.h"
+#include "lite/backends/x86/parallel.h"
+#include "lite/kernels/host/elementwise_op_func.h"
+#include "lite/kernels/x86/elementwise_compute.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+namespace x86_math = paddle::lite::x86::math;
+using ChainOp = FusionElementwiseChainCompute::ChainOp;
+using Stage = FusionElementwiseChainCompute::Stage;
+
+namespace {
+
+// Elements each block carries through the whole chain. The block and the
+// gathered operand take 8 KB, well inside L1.
+constexpr int kChainBlock = 1024;
+
+ChainOp ParseChainOp(const std::string& op_type) {
+  static const std::map<std::string, ChainOp> kOps = {
+      {"elementwise_add", ChainOp::kAdd},
+      {"elementwise_sub", ChainOp::kSub},
+      {"elementwise_mul", ChainOp::kMul},
+      {"elementwise_div", ChainOp::kDiv},
+      {"elementwise_max", ChainOp::kMax},
+      {"elementwise_min", ChainOp::kMin},
+      {"scale", ChainOp::kScale},
+      {"relu", ChainOp::kRelu},
+      {"relu6", ChainOp::kRelu6},
+      {"leaky_relu", ChainOp::kLeakyRelu},
+      {"sigmoid", ChainOp::kSigmoid},
+      {"tanh", ChainOp::kTanh},
+      {"swish", ChainOp::kSwish},
+      {"hard_swish", ChainOp::kHardSwish},
+      {"square", ChainOp::kSquare},
+      {"gelu", ChainOp::kGelu},
+  };
+  auto it = kOps.find(op_type);
+  CHECK(it != kOps.end()) << "unsupported op in elementwise chain: "
+                          << op_type;
+  return it->second;
+}
+
+template <template <class> class OpConfig>
+void RangeToRange(const float* x, const float* y, float* out, int len) {
+  using Config = x86_math::MergeConfig<
+      OpConfig<float>,
+      x86_math::ActiveConfig<x86_math::ActiveType::NO_ACTIVE, float>>;
+  x86_math::elementwise_range_to_range<Config>(x, y, out, len);
+}
+
+void ApplyBinary(
+    ChainOp op, const float* x, const float* y, float* out, int len) {
+  switch (op) {
+    case ChainOp::kAdd:
+      RangeToRange<x86_math::AddConfig>(x, y, out, len);
+      break;
+    case ChainOp::kSub:
+      RangeToRange<x86_math::SubConfig>(x, y, out, len);
+      break;
+    case ChainOp::kMul:
+      RangeToRange<x86_math::MulConfig>(x, y, out, len);
+      break;
+    case ChainOp::kDiv:
+      RangeToRange<x86_math::DivConfig>(x, y, out, len);
+      break;
+    case ChainOp::kMax:
+      RangeToRange<x86_math::MaxConfig>(x, y, out, len);
+      break;
+    case ChainOp::kMin:
+      RangeToRange<x86_math::MinConfig>(x, y, out, len);
+      break;
+    default:
+      LOG(FATAL) << "not a binary op";
+  }
+}
+
+host::BinaryOpFn<float>* NaiveBinary(ChainOp op) {
+  switch (op) {
+    case ChainOp::kAdd:
+      return host::naive_add<float>;
+    case ChainOp::kSub:
+      return host::naive_sub<float>;
+    case ChainOp::kMul:
+      return host::naive_mul<float>;
+    case ChainOp::kDiv:
+      return host::naive_div<float>;
+    case ChainOp::kMax:
+      return host::naive_max<float>;
+    case ChainOp::kMin:
+      return host::naive_min<float>;
+    default:
+      LOG(FATAL) << "not a binary op";
+  }
+  return nullptr;
+}
+
+// |in| may alias |out|.
+void ApplyUnary(const Stage& stage, const float* in, float* out, int len) {
+  const float* attrs = stage.attrs;
+  switch (stage.op) {
+    case ChainOp::kScale:
+      if (attrs[2] != 0.f) {
+        for (int i = 0; i < len; ++i) out[i] = in[i] * attrs[0] + attrs[1];
+      } else {
+        for (int i = 0; i < len; ++i) out[i] = (in[i] + attrs[1]) * attrs[0];
+      }
+      break;
+    case ChainOp::kRelu:
+      x86_math::vrelu(in, out, len);
+      break;
+    case ChainOp::kRelu6:
+      for (int i = 0; i < len; ++i) {
+        out[i] = (std::min)((std::max)(in[i], 0.f), attrs[0]);
+      }
+      break;
+    case ChainOp::kLeakyRelu:
+      for (int i = 0; i < len; ++i) {
+        out[i] = in[i] > 0.f ? in[i] : in[i] * attrs[0];
+      }
+      break;
+    case ChainOp::kSigmoid:
+      x86_math::vsigmoid(in, out, len);
+      break;
+    case ChainOp::kTanh:
+      x86_math::vtanh(in, out, len);
+      break;
+    case ChainOp::kSwish:
+      x86_math::swish(in, out, len, attrs[0]);
+      break;
+    case ChainOp::kHardSwish:
+      x86_math::hard_swish(in, out, len, attrs[0], attrs[1], attrs[2]);
+      break;
+    case ChainOp::kSquare:
+      x86_math::vsquare(in, out, len);
+      break;
+    case ChainOp::kGelu:
+      x86_math::gelu(in, out, len);
+      break;
+    default:
+      LOG(FATAL) << "not a unary op";
+  }
+}
+
+// Copies ext[(i / post) % n] for i in [offset, offset + len) to |dst|.
+void GatherOperand(const float* ext,
+                   int n,
+                   int post,
+                   int64_t offset,
+                   int len,
+                   float* dst) {
+  int64_t r = offset % post;
+  int64_t j = (offset / post) % n;
+  for (int i = 0; i < len; ++i) {
+    dst[i] = ext[j];
+    if (++r == post) {
+      r = 0;
+      if (++j == n) j = 0;
+    }
+  }
+}
+
+}  // namespace
+
+void FusionElementwiseChainCompute::PrepareForRun() {
+  auto& param = Param<operators::FusionElementwiseChainParam>();
+  stages_.clear();
+  size_t y_idx = 0;
+  for (size_t i = 0; i < param.op_types.size(); ++i) {
+    Stage stage;
+    stage.op = ParseChainOp(param.op_types[i]);
+    stage.binary = stage.op <= ChainOp::kMin;
+    stage.chain_is_x = param.chain_is_x[i] != 0;
+    stage.axis = param.axes[i];
+    std::copy(param.op_attrs.begin() + 3 * i,
+              param.op_attrs.begin() + 3 * i + 3,
+              stage.attrs);
+    if (stage.binary) {
+      CHECK_LT(y_idx, param.Y.size());
+      stage.ext = param.Y[y_idx++];
+    }
+    stages_.push_back(stage);
+  }
+}
+
+// Works out the broadcast of every operand against the output. Returns
+// false when some op changes the shape of the chain value or broadcasts in
+// a way a single index stride can not express.
+bool FusionElementwiseChainCompute::PrepareBlocked() {
+  auto& param = Param<operators::FusionElementwiseChainParam>();
+  auto x_dims = param.X->dims();
+  if (param.Out->dims() != x_dims) return false;
+  for (auto& stage : stages_) {
+    if (!stage.binary) continue;
+    auto ext_dims = stage.ext->dims();
+    int pre;
+    if (ext_dims == x_dims) {
+      stage.n = static_cast<int>(x_dims.production());
+      stage.post = 1;
+    } else if (!stage.chain_is_x && stage.axis != -1) {
+      return false;
+    } else if (!is_fast_broadcast(
+                   x_dims, ext_dims, stage.axis, &pre, &stage.n, &stage.post)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void FusionElementwiseChainCompute::RunBlocked() {
+  auto& param = Param<operators::FusionElementwiseChainParam>();
+  const float* x = param.X->data<float>();
+  float* out = param.Out->mutable_data<float>();
+  int64_t numel = param.Out->numel();
+  int64_t blocks = (numel + kChainBlock - 1) / kChainBlock;
+  // Longer chains do more work per element and are worth splitting sooner.
+  int64_t grain = (std::max<int64_t>)(
+      1,
+      x86_math::kElementwiseGrain /
+          (kChainBlock * static_cast<int64_t>(stages_.size())));
+  lite::x86::RunParallelFor(0, blocks, grain, [&](int64_t begin, int64_t end) {
+    float operand[kChainBlock];
+    for (int64_t block = begin; block < end; ++block) {
+      int64_t offset = block * kChainBlock;
+      int len = static_cast<int>(
+          (std::min<int64_t>)(kChainBlock, numel - offset));
+      const float* src = x + offset;
+      float* dst = out + offset;
+      for (auto& stage : stages_) {
+        if (stage.binary) {
+          const float* ext = stage.ext->data<float>();
+          const float* y = ext + offset;
+          if (stage.n != numel) {
+            GatherOperand(ext, stage.n, stage.post, offset, len, operand);
+            y = operand;
+          }
+          if (stage.chain_is_x) {
+            ApplyBinary(stage.op, src, y, dst, len);
+          } else {
+            ApplyBinary(stage.op, y, src, dst, len);
+          }
+        } else {
+          ApplyUnary(stage, src, dst, len);
+        }
+        src = dst;
+      }
+    }
+  });
+}
+
+void FusionElementwiseChainCompute::RunStepwise() {
+  auto& param = Param<operators::FusionElementwiseChainParam>();
+  const lite::Tensor* src = param.X;
+  for (size_t i = 0; i < stages_.size(); ++i) {
+    auto& stage = stages_[i];
+    lite::Tensor* dst =
+        i + 1 == stages_.size() ? param.Out : &buffers_[i % 2];
+    dst->Resize(param.stage_dims[i]);
+    if (stage.binary) {
+      auto* x = stage.chain_is_x ? src : stage.ext;
+      auto* y = stage.chain_is_x ? stage.ext : src;
+      auto batch_arg =
+          host::GenBatchElementWiseArg<float>(x, y, dst, stage.axis);
+      host::common_elmentwise_op_naive_cpu<float, int64_t>(
+          batch_arg, NaiveBinary(stage.op));
+    } else {
+      const float* din = src->data<float>();
+      float* dout = dst->mutable_data<float>();
+      lite::x86::RunParallelFor(
+          0,
+          dst->numel(),
+          x86_math::kElementwiseGrain,
+          [&](int64_t begin, int64_t end) {
+            ApplyUnary(stage,
+                       din + begin,
+                       dout + begin,
+                       static_cast<int>(end - begin));
+          });
+    }
+    src = dst;
+  }
+}
+
+void FusionElementwiseChainCompute::Run() {
+  if (PrepareBlocked()) {
+    RunBlocked();
+  } else {
+    RunStepwise();
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fusion_elementwise_chain,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::FusionElementwiseChainCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
@@ -0,0 +1,85 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+// Evaluates a fused elementwise/activation chain. When every operand is
+// either as large as the output or broadcast along it, the whole chain runs
+// over one L1-sized block before moving to the next, so the intermediate
+// results never leave the cache. Other shapes run the ops one after another.
+// No code is generated for the chain: each block still takes one call of the
+// existing jit or AVX routine per op.
+class FusionElementwiseChainCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
+ public:
+  enum class ChainOp {
+    kAdd,
+    kSub,
+    kMul,
+    kDiv,
+    kMax,
+    kMin,
+    kScale,
+    kRelu,
+    kRelu6,
+    kLeakyRelu,
+    kSigmoid,
+    kTanh,
+    kSwish,
+    kHardSwish,
+    kSquare,
+    kGelu,
+  };
+
+  struct Stage {
+    ChainOp op;
+    bool binary{false};
+    bool chain_is_x{true};
+    int axis{-1};
+    float attrs[3];
+    // Operand of a binary op, and its broadcast: element i of the output
+    // reads ext[(i / post) % n].
+    const lite::Tensor* ext{nullptr};
+    int n{1};
+    int post{1};
+  };
+
+  void PrepareForRun() override;
+
+  void Run() override;
+
+  virtual ~FusionElementwiseChainCompute() = default;
+
+ private:
+  bool PrepareBlocked();
+  void RunBlocked();
+  void RunStepwise();
+
+  std::vector<Stage> stages_;
+  lite::Tensor buffers_[2];
+};
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
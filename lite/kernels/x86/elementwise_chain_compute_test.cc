@@ -0,0 +1,227 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "lite/core/op_registry.h"
+#include "lite/kernels/x86/elementwise_chain_compute.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+// Aligns |dims| to |rank| dims by the elementwise axis rule.
+static std::vector<int64_t> align_dims(const DDim& dims, int rank, int axis) {
+  if (axis == -1) axis = rank - static_cast<int>(dims.size());
+  std::vector<int64_t> aligned(rank, 1);
+  for (size_t i = 0; i < dims.size(); ++i) aligned[axis + i] = dims[i];
+  return aligned;
+}
+
+// Broadcasts |t| to |out_dims| as a flat array.
+static std::vector<float> expand(const Tensor& t,
+                                 const DDim& out_dims,
+                                 int axis) {
+  int rank = static_cast<int>(out_dims.size());
+  auto dims = align_dims(t.dims(), rank, axis);
+  std::vector<float> out(out_dims.production());
+  for (int64_t i = 0; i < out_dims.production(); ++i) {
+    int64_t rest = i;
+    int64_t src = 0;
+    int64_t stride = 1;
+    for (int d = rank - 1; d >= 0; --d) {
+      int64_t idx = rest % out_dims[d];
+      rest /= out_dims[d];
+      src += (dims[d] == 1 ? 0 : idx) * stride;
+      stride *= dims[d];
+    }
+    out[i] = t.data<float>()[src];
+  }
+  return out;
+}
+
+static float unary_ref(const std::string& type, float x, const float* a) {
+  if (type == "scale") return a[2] != 0.f ? x * a[0] + a[1] : (x + a[1]) * a[0];
+  if (type == "relu") return std::max(x, 0.f);
+  if (type == "relu6") return std::min(std::max(x, 0.f), a[0]);
+  if (type == "leaky_relu") return x > 0.f ? x : x * a[0];
+  if (type == "sigmoid") return 1.f / (1.f + std::exp(-x));
+  if (type == "tanh") return std::tanh(x);
+  if (type == "swish") return x / (1.f + std::exp(-a[0] * x));
+  if (type == "hard_swish") {
+    return std::min(std::max(0.f, x + a[2]), a[0]) * x / a[1];
+  }
+  if (type == "square") return x * x;
+  if (type == "gelu") return 0.5f * x * (1.f + std::erf(x / std::sqrt(2.f)));
+  LOG(FATAL) << "unknown op " << type;
+  return 0.f;
+}
+
+static float binary_ref(const std::string& type, float x, float y) {
+  if (type == "elementwise_add") return x + y;
+  if (type == "elementwise_sub") return x - y;
+  if (type == "elementwise_mul") return x * y;
+  if (type == "elementwise_div") return x / y;
+  if (type == "elementwise_max") return std::max(x, y);
+  if (type == "elementwise_min") return std::min(x, y);
+  LOG(FATAL) << "unknown op " << type;
+  return 0.f;
+}
+
+static void fill(Tensor* t, const DDim& dims, float lo, float hi) {
+  t->Resize(dims);
+  auto* data = t->mutable_data<float>();
+  for (int64_t i = 0; i < t->numel(); ++i) {
+    data[i] = lo + (hi - lo) * static_cast<float>((i * 37 + 11) % 101) / 100.f;
+  }
+}
+
+struct ChainOpDesc {
+  ChainOpDesc(const std::string& type,  // NOLINT
+              const std::vector<float>& attrs = {},
+              const DDim& ext_dims = DDim(),
+              int axis = -1,
+              bool chain_is_x = true)
+      : type(type),
+        attrs(attrs),
+        ext_dims(ext_dims),
+        axis(axis),
+        chain_is_x(chain_is_x) {}
+
+  std::string type;
+  std::vector<float> attrs;
+  // For binary ops: dims of the external operand and its placement.
+  DDim ext_dims;
+  int axis;
+  bool chain_is_x;
+};
+
+static void test_chain(const DDim& x_dims,
+                       const DDim& out_dims,
+                       const std::vector<ChainOpDesc>& ops) {
+  Tensor x, out;
+  std::vector<std::unique_ptr<Tensor>> ys;
+  fill(&x, x_dims, -3.f, 3.f);
+  operators::FusionElementwiseChainParam param;
+  param.X = &x;
+  param.Out = &out;
+  for (auto& op : ops) {
+    param.op_types.push_back(op.type);
+    param.axes.push_back(op.axis);
+    param.chain_is_x.push_back(op.chain_is_x);
+    for (size_t i = 0; i < 3; ++i) {
+      param.op_attrs.push_back(i < op.attrs.size() ? op.attrs[i] : 0.f);
+    }
+    if (op.type.compare(0, 12, "elementwise_") == 0) {
+      ys.emplace_back(new Tensor);
+      // Keep divisors away from zero.
+      fill(ys.back().get(), op.ext_dims, 0.5f, 2.f);
+      param.Y.push_back(ys.back().get());
+    }
+    param.stage_dims.push_back(out_dims);
+  }
+  out.Resize(out_dims);
+
+  FusionElementwiseChainCompute chain;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  chain.SetContext(std::move(ctx));
+  chain.SetParam(param);
+  chain.PrepareForRun();
+  chain.Run();
+
+  auto ref = expand(x, out_dims, -1);
+  size_t y_idx = 0;
+  for (auto& op : ops) {
+    float attrs[3] = {0.f, 0.f, 0.f};
+    std::copy(op.attrs.begin(), op.attrs.end(), attrs);
+    if (op.type.compare(0, 12, "elementwise_") == 0) {
+      auto y = expand(*param.Y[y_idx++], out_dims, op.axis);
+      for (size_t i = 0; i < ref.size(); ++i) {
+        ref[i] = op.chain_is_x ? binary_ref(op.type, ref[i], y[i])
+                               : binary_ref(op.type, y[i], ref[i]);
+      }
+    } else {
+      for (auto& v : ref) v = unary_ref(op.type, v, attrs);
+    }
+  }
+
+  ASSERT_EQ(out.dims(), out_dims);
+  const float* out_data = out.data<float>();
+  for (size_t i = 0; i < ref.size(); ++i) {
+    EXPECT_NEAR(out_data[i], ref[i], 1e-4 * std::max(1.f, std::fabs(ref[i])))
+        << "at " << i;
+  }
+}
+
+TEST(elementwise_chain_x86, retrive_op) {
+  auto chain = KernelRegistry::Global().Create("fusion_elementwise_chain");
+  ASSERT_FALSE(chain.empty());
+  ASSERT_TRUE(chain.front());
+}
+
+TEST(elementwise_chain_x86, residual) {
+  // Several blocks and a tail.
+  DDim dims({2, 3, 33, 35});
+  test_chain(dims,
+             dims,
+             {{"elementwise_add", {}, dims},
+              {"scale", {2.f, 0.5f, 1.f}},
+              {"relu"},
+              {"elementwise_mul", {}, dims},
+              {"sigmoid"}});
+}
+
+TEST(elementwise_chain_x86, broadcast) {
+  DDim dims({2, 16, 7, 9});
+  test_chain(dims,
+             dims,
+             {{"elementwise_add", {}, DDim({16}), 1},
+              {"hard_swish", {6.f, 6.f, 3.f}},
+              {"elementwise_sub", {}, dims, -1, false},
+              {"leaky_relu", {0.1f}},
+              {"swish", {1.5f}},
+              {"elementwise_div", {}, DDim({16, 7, 9})},
+              {"gelu"},
+              {"scale", {0.5f, 1.f, 0.f}},
+              {"tanh"},
+              {"elementwise_min", {}, DDim({9}), -1, false},
+              {"square"},
+              {"relu6", {6.f}},
+              {"elementwise_max", {}, DDim({2, 16, 1, 1}), 0}});
+}
+
+TEST(elementwise_chain_x86, stepwise) {
+  // The chain value grows from [3, 1, 5] to [3, 4, 5].
+  test_chain(DDim({3, 1, 5}),
+             DDim({3, 4, 5}),
+             {{"elementwise_add", {}, DDim({3, 4, 5})},
+              {"relu"},
+              {"elementwise_mul", {}, DDim({4, 5})}});
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(fusion_elementwise_chain, kX86, kFloat, kNCHW, def);
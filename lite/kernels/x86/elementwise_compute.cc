@@ -16,6 +16,7 @@
 // by 0 will get the correct result in ElementWise OP.
 
 #include "lite/kernels/x86/elementwise_compute.h"
+#include <algorithm>
 #include <string>
 #include <vector>
 #include "lite/backends/x86/math/elementwise.h"
@@ -135,35 +136,46 @@ struct X86CommonElementWise {
     int batch_num = batch_arg.BatchNum();
     auto bcast_type = batch_arg.BcastType();
     int range_length = batch_arg.ElemNumPerBatch();
+    int64_t grain = (std::max<int64_t>)(
+        1, x86_math::kElementwiseGrain / (std::max)(range_length, 1));
     switch (bcast_type) {
       case (lite::kernels::host::BroadcastType::X_AS_CONTINUOUS): {
-        for (int batch_id = 0; batch_id < batch_num; ++batch_id) {
-          paddle::lite::x86::math::elementwise_range_to_one<X86Config>(
-              batch_arg.XAtBatch(batch_id),
-              batch_arg.YAtBatch(batch_id),
-              batch_arg.ZAtBatch(batch_id),
-              range_length);
-        }
+        lite::x86::RunParallelFor(
+            0, batch_num, grain, [&](int64_t begin, int64_t end) {
+              for (int64_t batch_id = begin; batch_id < end; ++batch_id) {
+                paddle::lite::x86::math::elementwise_range_to_one<X86Config>(
+                    batch_arg.XAtBatch(batch_id),
+                    batch_arg.YAtBatch(batch_id),
+                    batch_arg.ZAtBatch(batch_id),
+                    range_length);
+              }
+            });
         break;
       }
       case (lite::kernels::host::BroadcastType::Y_AS_CONTINUOUS): {
-        for (int batch_id = 0; batch_id < batch_num; ++batch_id) {
-          paddle::lite::x86::math::elementwise_one_to_range<X86Config>(
-              batch_arg.XAtBatch(batch_id),
-              batch_arg.YAtBatch(batch_id),
-              batch_arg.ZAtBatch(batch_id),
-              range_length);
-        }
+        lite::x86::RunParallelFor(
+            0, batch_num, grain, [&](int64_t begin, int64_t end) {
+              for (int64_t batch_id = begin; batch_id < end; ++batch_id) {
+                paddle::lite::x86::math::elementwise_one_to_range<X86Config>(
+                    batch_arg.XAtBatch(batch_id),
+                    batch_arg.YAtBatch(batch_id),
+                    batch_arg.ZAtBatch(batch_id),
+                    range_length);
+              }
+            });
         break;
       }
       case (lite::kernels::host::BroadcastType::BOTH_CONTINUOUS): {
-        for (int batch_id = 0; batch_id < batch_num; ++batch_id) {
-          paddle::lite::x86::math::elementwise_range_to_range<X86Config>(
-              batch_arg.XAtBatch(batch_id),
-              batch_arg.YAtBatch(batch_id),
-              batch_arg.ZAtBatch(batch_id),
-              range_length);
-        }
+        lite::x86::RunParallelFor(
+            0, batch_num, grain, [&](int64_t begin, int64_t end) {
+              for (int64_t batch_id = begin; batch_id < end; ++batch_id) {
+                paddle::lite::x86::math::elementwise_range_to_range<X86Config>(
+                    batch_arg.XAtBatch(batch_id),
+                    batch_arg.YAtBatch(batch_id),
+                    batch_arg.ZAtBatch(batch_id),
+                    range_length);
+              }
+            });
         break;
       }
       default: {
@@ -22,6 +22,14 @@ namespace lite {
 namespace kernels {
 namespace x86 {
 
+// Checks whether y broadcasts over x as [pre, n, post] with y of size n.
+bool is_fast_broadcast(const DDim& x_dims,
+                       const DDim& y_dims,
+                       int axis,
+                       int* pre,
+                       int* n,
+                       int* post);
+
 template <typename T>
 class ElementwiseAddCompute
     : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
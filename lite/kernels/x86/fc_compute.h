@@ -19,6 +19,7 @@
 #include "lite/backends/x86/jit/kernel_base.h"
 #include "lite/backends/x86/jit/kernels.h"
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/gemm_bf16.h"
 #include "lite/backends/x86/parallel.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
@@ -141,10 +142,43 @@ class FcCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     int M = output->dims().production() / w_dims1;
 
     const T* input_data = input->template data<T>();
-    const T* w_data = w->template data<T>();
     T* output_data = output->template mutable_data<T>();
 
     auto& context = ctx_->As<X86Context>();
+    if (param.weight_bf16) {
+      // Padded bf16 weights are read in place through their row stride.
+      auto* w_bf16 = reinterpret_cast<const uint16_t*>(w->data<int16_t>());
+      lite::x86::math::matmul_bf16(context,
+                                   M,
+                                   w_dims1,
+                                   w_dims0,
+                                   input_data,
+                                   w_bf16,
+                                   w_dims[1],
+                                   output_data);
+      if (bias) {
+        const int N = w_dims1;
+        const T* bias_data = bias->template data<T>();
+        typename jit::VAddTuple<T>::func_type compute = nullptr;
+        if (with_relu) {
+          compute = jit::KernelFuncs<jit::VAddReluTuple<T>,
+                                     fluid::CPUPlace>::Cache()
+                        .At(N);
+        } else {
+          compute =
+              jit::KernelFuncs<jit::VAddTuple<T>, fluid::CPUPlace>::Cache().At(
+                  N);
+        }
+        lite::x86::RunParallelFor(0, M, [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; i++) {
+            compute(bias_data, output_data + i * N, output_data + i * N, N);
+          }
+        });
+      }
+      return;
+    }
+
+    const T* w_data = w->template data<T>();
     FCFunctor<lite::TargetType::kX86, T> fc;
     fc(context,
        M,
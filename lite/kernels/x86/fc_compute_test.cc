@@ -0,0 +1,147 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "lite/core/op_registry.h"
+#include "lite/kernels/x86/fc_compute.h"
+#include "lite/utils/bfloat16.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+namespace {
+
+void RunFc(lite::Tensor* input,
+           lite::Tensor* w,
+           lite::Tensor* bias,
+           lite::Tensor* output,
+           const std::string& activation_type,
+           bool padding_weights,
+           bool weight_bf16) {
+  FcCompute<float> fc;
+  operators::FcParam param;
+  param.input = input;
+  param.w = w;
+  param.bias = bias;
+  param.output = output;
+  param.activation_type = activation_type;
+  param.padding_weights = padding_weights;
+  param.weight_bf16 = weight_bf16;
+
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  fc.SetContext(std::move(ctx));
+  fc.SetParam(param);
+  fc.Run();
+}
+
+}  // namespace
+
+TEST(fc_x86, retrive_op) {
+  auto fc = KernelRegistry::Global().Create("fc");
+  ASSERT_FALSE(fc.empty());
+  ASSERT_TRUE(fc.front());
+}
+
+// Runs the kernel once on fp32 weights and once on the same weights rounded
+// to bf16 as x86_bf16_weight_pass stores them. A rounded weight is off by at
+// most 2^-8 of its value, so every output stays within 2^-8 * sum|x * w| of
+// the fp32 one.
+TEST(fc_x86, run_bf16_test) {
+  struct FcCase {
+    int M;
+    int K;
+    int N;
+    bool padding_weights;
+  };
+  // Batches up to 4 take the streaming kernel, the larger ones the GEMM
+  // panels, the 512 x 1000 weights are split into several of them.
+  for (auto& fc_case : std::vector<FcCase>{{1, 37, 75, false},
+                                           {3, 64, 33, false},
+                                           {4, 37, 75, true},
+                                           {9, 37, 75, false},
+                                           {9, 37, 75, true},
+                                           {17, 512, 1000, false}}) {
+    for (std::string act : {"", "relu"}) {
+      const int M = fc_case.M;
+      const int K = fc_case.K;
+      const int N = fc_case.N;
+      const int pad = fc_case.padding_weights ? 4 : 0;
+      lite::Tensor input, w, w_bf16, bias, out, out_bf16;
+      input.Resize({M, K});
+      w.Resize({K + pad, N + pad});
+      w_bf16.Resize({K + pad, N + pad});
+      bias.Resize({N});
+      out.Resize({M, N});
+      out_bf16.Resize({M, N});
+
+      auto* input_data = input.mutable_data<float>();
+      for (int64_t i = 0; i < input.numel(); i++) {
+        input_data[i] = static_cast<float>(i % 13) * 0.25f - 1.5f;
+      }
+      auto* w_data = w.mutable_data<float>();
+      auto* w_bf16_data =
+          reinterpret_cast<uint16_t*>(w_bf16.mutable_data<int16_t>());
+      for (int64_t i = 0; i < w.numel(); i++) {
+        w_data[i] = static_cast<float>(i % 11) * 0.0137f - 0.07f;
+        w_bf16_data[i] = FloatToBFloat16(w_data[i]);
+      }
+      auto* bias_data = bias.mutable_data<float>();
+      for (int i = 0; i < N; i++) {
+        bias_data[i] = static_cast<float>(i % 5) * 0.1f - 0.2f;
+      }
+
+      RunFc(&input, &w, &bias, &out, act, fc_case.padding_weights, false);
+      RunFc(&input,
+            &w_bf16,
+            &bias,
+            &out_bf16,
+            act,
+            fc_case.padding_weights,
+            true);
+
+      const float* out_data = out.data<float>();
+      const float* out_bf16_data = out_bf16.data<float>();
+      for (int m = 0; m < M; m++) {
+        for (int n = 0; n < N; n++) {
+          float magnitude = 0.f;
+          for (int k = 0; k < K; k++) {
+            magnitude +=
+                std::fabs(input_data[m * K + k] * w_data[k * (N + pad) + n]);
+          }
+          EXPECT_NEAR(out_bf16_data[m * N + n],
+                      out_data[m * N + n],
+                      magnitude / 256.f + 1e-5f)
+              << "M " << M << " K " << K << " N " << N << " act " << act;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(fc, kX86, kFloat, kNCHW, def);
@@ -50,7 +50,8 @@ void BilinearInterpCompute::Run() {
                                out_w,
                                align_mode,
                                align_corners,
-                               interp_method);
+                               interp_method,
+                               &table_);
 }
 
 void NearestInterpCompute::Run() {
@@ -81,7 +82,8 @@ void NearestInterpCompute::Run() {
                                out_w,
                                align_mode,
                                align_corners,
-                               interp_method);
+                               interp_method,
+                               &table_);
 }
 
 }  // namespace x86
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include "lite/backends/x86/math/interpolate.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 
@@ -27,6 +28,9 @@ class BilinearInterpCompute
   void Run() override;
 
   virtual ~BilinearInterpCompute() = default;
+
+ private:
+  lite::x86::math::InterpTable table_;
 };
 
 class NearestInterpCompute
@@ -35,6 +39,9 @@ class NearestInterpCompute
   void Run() override;
 
   virtual ~NearestInterpCompute() = default;
+
+ private:
+  lite::x86::math::InterpTable table_;
 };
 
 }  // namespace x86
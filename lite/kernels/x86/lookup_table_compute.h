@@ -15,6 +15,7 @@
 
 #include <vector>
 #include "lite/backends/x86/fluid/eigen.h"
+#include "lite/backends/x86/math/gemm_bf16.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 
@@ -40,9 +41,21 @@ class LookupTableCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     int64_t row_number = table_t->dims()[0];
     int64_t row_width = table_t->dims()[1];
 
-    const T *table = table_t->template data<T>();
     T *output = output_t->template mutable_data<T>();
     memset(output, 0, output_t->dims().production() * sizeof(T));
+    if (param.weight_bf16) {
+      auto *table =
+          reinterpret_cast<const uint16_t *>(table_t->data<int16_t>());
+      for (int64_t i = 0; i < ids_numel; ++i) {
+        if (padding_idx != -1 && ids[i] == padding_idx) continue;
+        CHECK_LT(ids[i], row_number);
+        CHECK_GE(ids[i], 0);
+        lite::x86::math::bf16_to_fp32(
+            table + ids[i] * row_width, output + i * row_width, row_width);
+      }
+      return;
+    }
+    const T *table = table_t->template data<T>();
     for (int64_t i = 0; i < ids_numel; ++i) {
       if (padding_idx != -1 && ids[i] == padding_idx) {
         memset(output + i * row_width, 0, row_width * sizeof(T));
@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 #include "lite/core/op_registry.h"
+#include "lite/utils/bfloat16.h"
 
 namespace paddle {
 namespace lite {
@@ -74,9 +75,68 @@ TEST(lookup_table_x86, compute) {
   }
 }
 
+// The table as x86_bf16_weight_pass stores it. Each gathered row is the
+// fp32 row rounded to bf16, so it is within 2^-8 of the fp32 value.
+TEST(lookup_table_x86, compute_bf16) {
+  int vocab_size = 40;
+  int emb_size = 75;
+  int64_t padding_idx = 3;
+  auto w_dim = DDim({vocab_size, emb_size});
+  auto ids_dim = DDim({6, 5});
+  auto out_dim = DDim({6, 5, emb_size});
+
+  lite::Tensor w, w_bf16, ids;
+  w.Resize(w_dim);
+  w_bf16.Resize(w_dim);
+  ids.Resize(ids_dim);
+  auto* w_data = w.mutable_data<float>();
+  auto* w_bf16_data =
+      reinterpret_cast<uint16_t*>(w_bf16.mutable_data<int16_t>());
+  for (int64_t i = 0; i < w.numel(); i++) {
+    w_data[i] = static_cast<float>(i % 97) * 0.0173f - 0.8f;
+    w_bf16_data[i] = FloatToBFloat16(w_data[i]);
+  }
+  auto* ids_data = ids.mutable_data<int64_t>();
+  for (int64_t i = 0; i < ids.numel(); i++) {
+    ids_data[i] = (i * 7) % vocab_size;
+  }
+
+  for (std::string op_type : {"lookup_table", "lookup_table_v2"}) {
+    for (int64_t pad : {int64_t(-1), padding_idx}) {
+      auto kernels = KernelRegistry::Global().Create(
+          op_type, TARGET(kX86), PRECISION(kFloat), DATALAYOUT(kNCHW));
+      ASSERT_FALSE(kernels.empty());
+      lite::Tensor out;
+      out.Resize(out_dim);
+      operators::LookupTableParam param;
+      param.W = &w_bf16;
+      param.Ids = &ids;
+      param.Out = &out;
+      param.padding_idx = pad;
+      param.weight_bf16 = true;
+      kernels.front()->SetParam(param);
+      kernels.front()->Run();
+
+      const float* out_data = out.data<float>();
+      for (int64_t i = 0; i < ids.numel(); i++) {
+        for (int j = 0; j < emb_size; j++) {
+          float value = out_data[i * emb_size + j];
+          if (ids_data[i] == pad) {
+            EXPECT_EQ(value, 0.f);
+          } else {
+            float ref = w_data[ids_data[i] * emb_size + j];
+            EXPECT_NEAR(value, ref, std::fabs(ref) / 256.f);
+          }
+        }
+      }
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
 }  // namespace paddle
 
 USE_LITE_KERNEL(lookup_table, kX86, kFloat, kNCHW, def);
+USE_LITE_KERNEL(lookup_table_v2, kX86, kFloat, kNCHW, def);
@@ -14,6 +14,7 @@
 #pragma once
 
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/gemm_bf16.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -70,9 +71,22 @@ class MulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
       z->Resize({x_matrix.dims()[0], y_matrix.dims()[1]});
     }
 
-    auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
-
-    blas.MatMul(x_matrix, y_matrix, z);
+    if (param.weight_bf16) {
+      const auto& y_mat_dims = y_matrix.dims();
+      lite::x86::math::matmul_bf16(
+          context,
+          x_matrix.dims()[0],
+          y_mat_dims[1],
+          y_mat_dims[0],
+          x_matrix.data<float>(),
+          reinterpret_cast<const uint16_t*>(y_matrix.data<int16_t>()),
+          y_mat_dims[1],
+          z->template mutable_data<float>());
+    } else {
+      auto blas =
+          lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
+      blas.MatMul(x_matrix, y_matrix, z);
+    }
     if (z_dim.size() != 2) {
       z->Resize(z_dim);
     }
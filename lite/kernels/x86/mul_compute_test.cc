@@ -21,6 +21,7 @@
 
 #include "lite/core/op_registry.h"
 #include "lite/kernels/x86/mul_compute.h"
+#include "lite/utils/bfloat16.h"
 
 namespace paddle {
 namespace lite {
@@ -80,6 +81,52 @@ TEST(mul_x86, run_test) {
   }
 }
 
+TEST(mul_x86, run_bf16_test) {
+  constexpr int K = 37;
+  constexpr int N = 75;
+  for (int M : {1, 3, 9}) {
+    lite::Tensor x, y, out;
+    x.Resize({M, K});
+    y.Resize({K, N});
+    out.Resize({M, N});
+    auto x_data = x.mutable_data<float>();
+    for (int64_t i = 0; i < x.numel(); i++) {
+      x_data[i] = static_cast<float>(i % 13) * 0.25f - 1.f;
+    }
+    // The weights as the bf16 pass leaves them, plus their exact values.
+    auto y_data = reinterpret_cast<uint16_t*>(y.mutable_data<int16_t>());
+    std::vector<float> y_ref(K * N);
+    for (int64_t i = 0; i < y.numel(); i++) {
+      y_data[i] = FloatToBFloat16(static_cast<float>(i % 7) * 0.3f - 0.9f);
+      y_ref[i] = BFloat16ToFloat(y_data[i]);
+    }
+
+    MulCompute<float> mul;
+    operators::MulParam param;
+    param.x = &x;
+    param.y = &y;
+    param.output = &out;
+    param.weight_bf16 = true;
+
+    std::unique_ptr<KernelContext> ctx(new KernelContext);
+    ctx->As<X86Context>();
+    mul.SetContext(std::move(ctx));
+    mul.SetParam(param);
+    mul.Run();
+
+    auto out_data = out.data<float>();
+    for (int m = 0; m < M; m++) {
+      for (int n = 0; n < N; n++) {
+        float ref = 0.f;
+        for (int k = 0; k < K; k++) {
+          ref += x_data[m * K + k] * y_ref[k * N + n];
+        }
+        EXPECT_NEAR(out_data[m * N + n], ref, 1e-3);
+      }
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
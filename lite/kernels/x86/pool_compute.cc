@@ -13,6 +13,119 @@
 // limitations under the License.
 
 #include "lite/kernels/x86/pool_compute.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+#ifdef LITE_WITH_AVX
+#include "lite/backends/x86/math/avx/conv_utils.h"
+#include "lite/backends/x86/math/avx/pooling.h"
+#endif
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+bool pool2d_m256(const operators::PoolParam& param,
+                 lite::Tensor* packed_x,
+                 lite::Tensor* packed_out) {
+#ifdef LITE_WITH_AVX
+  const auto& in_dims = param.x->dims();
+  const auto& out_dims = param.output->dims();
+  const std::string& pooling_type = param.pooling_type;
+  if (in_dims.size() != 4 || (pooling_type != "max" && pooling_type != "avg")) {
+    return false;
+  }
+  const int num = in_dims[0];
+  const int ch = in_dims[1];
+  const int hin = in_dims[2];
+  const int win = in_dims[3];
+  const int hout = out_dims[2];
+  const int wout = out_dims[3];
+  const std::vector<int>& ksize = param.ksize;
+  const std::vector<int>& strides = param.strides;
+  const std::vector<int>& paddings = *param.paddings;
+  // Max pooling is always exclusive.
+  const bool exclusive = pooling_type == "max" || param.exclusive;
+  const float* din = param.x->data<float>();
+  float* dout = param.output->mutable_data<float>();
+
+  if (param.adaptive) {
+    if (hout == 1 && wout == 1) {
+      lite::x86::math::pooling_global_m256(
+          din, dout, num, ch, hin, win, pooling_type);
+    } else {
+      lite::x86::math::pooling_adaptive_m256(
+          din, dout, num, ch, hin, win, hout, wout, pooling_type);
+    }
+    return true;
+  }
+
+  const bool zero_pads =
+      std::all_of(paddings.begin(), paddings.end(), [](int p) { return !p; });
+  if (ksize[0] == hin && ksize[1] == win && hout == 1 && wout == 1 &&
+      zero_pads) {
+    lite::x86::math::pooling_global_m256(
+        din, dout, num, ch, hin, win, pooling_type);
+    return true;
+  }
+
+  using PoolFunc = decltype(&lite::x86::math::pooling2x2s2_m256);
+  PoolFunc pool = nullptr;
+  if (ksize[0] == ksize[1] && strides[0] == strides[1]) {
+    if (ksize[0] == 2 && strides[0] == 2) {
+      pool = lite::x86::math::pooling2x2s2_m256;
+    } else if (ksize[0] == 3 && strides[0] == 1) {
+      pool = lite::x86::math::pooling3x3s1_m256;
+    } else if (ksize[0] == 3 && strides[0] == 2) {
+      pool = lite::x86::math::pooling3x3s2_m256;
+    }
+  }
+  if (pool) {
+    pool(din,
+         dout,
+         num,
+         ch,
+         hin,
+         win,
+         hout,
+         wout,
+         paddings[0],
+         paddings[2],
+         exclusive,
+         pooling_type);
+    return true;
+  }
+
+  // Any other window runs on eight channels at a time.
+  if (ch % 8 == 0) {
+    lite::x86::math::pack8_m256(param.x, packed_x, ch / 8, false);
+    packed_out->Resize({num, ch / 8, hout, wout, 8});
+    lite::x86::math::pooling_pack8_m256(packed_x->data<float>(),
+                                        packed_out->mutable_data<float>(),
+                                        num,
+                                        ch / 8,
+                                        hin,
+                                        win,
+                                        hout,
+                                        wout,
+                                        ksize,
+                                        strides,
+                                        paddings,
+                                        exclusive,
+                                        false,
+                                        pooling_type);
+    lite::x86::math::unpack8_m256(packed_out, param.output);
+    return true;
+  }
+#endif
+  return false;
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
 
 REGISTER_LITE_KERNEL(pool2d,
                      kX86,
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <type_traits>
 #include "lite/backends/x86/fluid/eigen.h"
 #include "lite/backends/x86/math/math_function.h"
 #include "lite/backends/x86/math/pooling.h"
@@ -26,6 +27,13 @@ namespace lite {
 namespace kernels {
 namespace x86 {
 
+// Runs the AVX pooling kernels of lite/backends/x86/math/avx/pooling.h when
+// one covers the shape, using |packed_x| and |packed_out| for the blocked
+// layout. Returns false to fall back to Pool2dFunctor.
+bool pool2d_m256(const operators::PoolParam& param,
+                 lite::Tensor* packed_x,
+                 lite::Tensor* packed_out);
+
 template <typename T>
 class PoolCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
@@ -40,6 +48,10 @@ class PoolCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     }
     switch (param.ksize.size()) {
       case 2: {
+        if (std::is_same<T, float>::value &&
+            pool2d_m256(param, &packed_x_, &packed_out_)) {
+          return;
+        }
         if (param.pooling_type == "max") {
           paddle::lite::x86::math::Pool2dFunctor<
               lite::TargetType::kX86,
@@ -54,7 +66,7 @@ class PoolCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
                          *param.paddings,
                          pool_process,
                          true,
-                         false,
+                         param.adaptive,
                          param.output);
         } else if (param.pooling_type == "avg") {
           paddle::lite::x86::math::Pool2dFunctor<
@@ -79,6 +91,10 @@ class PoolCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     }
   }
   virtual ~PoolCompute() = default;
+
+ private:
+  lite::Tensor packed_x_;
+  lite::Tensor packed_out_;
 };
 
 }  // namespace x86
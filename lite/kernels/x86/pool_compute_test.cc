@@ -14,8 +14,12 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -79,6 +83,161 @@ TEST(pool2d_x86, run_test) {
   }
 }
 
+static int adapt_start(int i, int in, int out) {
+  return static_cast<int>(std::floor(static_cast<double>(i * in) / out));
+}
+
+static int adapt_end(int i, int in, int out) {
+  return static_cast<int>(std::ceil(static_cast<double>((i + 1) * in) / out));
+}
+
+static void pool_ref(const Tensor& x,
+                     Tensor* out,
+                     const operators::PoolParam& param) {
+  const int num = x.dims()[0];
+  const int ch = x.dims()[1];
+  const int hin = x.dims()[2];
+  const int win = x.dims()[3];
+  const int hout = out->dims()[2];
+  const int wout = out->dims()[3];
+  const auto& k = param.ksize;
+  const auto& s = param.strides;
+  const auto& p = *param.paddings;
+  const bool is_max = param.pooling_type == "max";
+  const float* din = x.data<float>();
+  float* dout = out->mutable_data<float>();
+  for (int nc = 0; nc < num * ch; ++nc) {
+    for (int oh = 0; oh < hout; ++oh) {
+      for (int ow = 0; ow < wout; ++ow) {
+        int hs, he, ws, we;
+        if (param.adaptive) {
+          hs = adapt_start(oh, hin, hout);
+          he = adapt_end(oh, hin, hout);
+          ws = adapt_start(ow, win, wout);
+          we = adapt_end(ow, win, wout);
+        } else {
+          hs = oh * s[0] - p[0];
+          ws = ow * s[1] - p[2];
+          he = std::min(hs + k[0], hin);
+          we = std::min(ws + k[1], win);
+          hs = std::max(hs, 0);
+          ws = std::max(ws, 0);
+        }
+        float res = is_max ? -FLT_MAX : 0.f;
+        for (int h = hs; h < he; ++h) {
+          for (int w = ws; w < we; ++w) {
+            float v = din[(nc * hin + h) * win + w];
+            res = is_max ? std::max(res, v) : res + v;
+          }
+        }
+        if (!is_max) {
+          res /= (param.exclusive || param.adaptive) ? (he - hs) * (we - ws)
+                                                     : k[0] * k[1];
+        }
+        dout[(nc * hout + oh) * wout + ow] = res;
+      }
+    }
+  }
+}
+
+static int pool_out_size(int in, int k, int s, int pad0, int pad1, bool ceil) {
+  return (in + pad0 + pad1 - k + (ceil ? s - 1 : 0)) / s + 1;
+}
+
+static void test_pool(const DDim& x_dims,
+                      const std::string& pooling_type,
+                      const std::vector<int>& ksize,
+                      const std::vector<int>& strides,
+                      const std::vector<int>& paddings,
+                      bool exclusive,
+                      bool ceil_mode = false,
+                      bool adaptive = false) {
+  Tensor x, out, out_ref;
+  x.Resize(x_dims);
+  auto* x_data = x.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); ++i) {
+    x_data[i] = static_cast<float>((i * 37 + 11) % 101) / 10.f - 5.f;
+  }
+  std::vector<int64_t> out_shape{x_dims[0], x_dims[1], ksize[0], ksize[1]};
+  if (!adaptive) {
+    for (int i = 0; i < 2; ++i) {
+      out_shape[i + 2] = pool_out_size(x_dims[i + 2],
+                                       ksize[i],
+                                       strides[i],
+                                       paddings[2 * i],
+                                       paddings[2 * i + 1],
+                                       ceil_mode);
+    }
+  }
+  out.Resize(DDim(out_shape));
+  out_ref.Resize(DDim(out_shape));
+
+  operators::PoolParam param;
+  param.x = &x;
+  param.output = &out;
+  param.pooling_type = pooling_type;
+  param.ksize = ksize;
+  param.strides = strides;
+  param.paddings = std::make_shared<std::vector<int>>(paddings);
+  param.exclusive = exclusive;
+  param.adaptive = adaptive;
+  param.ceil_mode = ceil_mode;
+
+  PoolCompute<float> pool2d;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  pool2d.SetContext(std::move(ctx));
+  pool2d.SetParam(param);
+  pool2d.Run();
+
+  pool_ref(x, &out_ref, param);
+  const float* out_data = out.data<float>();
+  const float* ref_data = out_ref.data<float>();
+  for (int64_t i = 0; i < out.numel(); ++i) {
+    EXPECT_NEAR(out_data[i], ref_data[i], 1e-5) << "at " << i;
+  }
+}
+
+TEST(pool2d_x86, fixed_windows) {
+  for (auto type : {"max", "avg"}) {
+    for (bool exclusive : {true, false}) {
+      // Wide enough rows for the vector body, odd sizes for the tails.
+      DDim dims({2, 3, 19, 45});
+      test_pool(dims, type, {2, 2}, {2, 2}, {0, 0, 0, 0}, exclusive);
+      test_pool(dims, type, {2, 2}, {2, 2}, {1, 1, 1, 1}, exclusive);
+      test_pool(dims, type, {2, 2}, {2, 2}, {0, 0, 0, 0}, exclusive, true);
+      test_pool(dims, type, {3, 3}, {1, 1}, {1, 1, 1, 1}, exclusive);
+      test_pool(dims, type, {3, 3}, {1, 1}, {0, 0, 0, 0}, exclusive);
+      test_pool(dims, type, {3, 3}, {2, 2}, {0, 0, 0, 0}, exclusive);
+      test_pool(dims, type, {3, 3}, {2, 2}, {1, 1, 1, 1}, exclusive, true);
+      test_pool(dims, type, {3, 3}, {2, 2}, {0, 1, 0, 1}, exclusive);
+    }
+  }
+}
+
+TEST(pool2d_x86, global_and_adaptive) {
+  for (auto type : {"max", "avg"}) {
+    DDim dims({2, 5, 13, 11});
+    test_pool(dims, type, {13, 11}, {1, 1}, {0, 0, 0, 0}, true);
+    test_pool(dims, type, {1, 1}, {1, 1}, {0, 0, 0, 0}, true, false, true);
+    test_pool(dims, type, {4, 3}, {1, 1}, {0, 0, 0, 0}, true, false, true);
+    test_pool(dims, type, {7, 7}, {1, 1}, {0, 0, 0, 0}, false, false, true);
+  }
+}
+
+TEST(pool2d_x86, other_windows) {
+  for (auto type : {"max", "avg"}) {
+    for (bool exclusive : {true, false}) {
+      // Blocked on eight channels, then the plain NCHW path.
+      for (int ch : {16, 3}) {
+        DDim dims({2, ch, 17, 15});
+        test_pool(dims, type, {5, 5}, {1, 1}, {2, 2, 2, 2}, exclusive);
+        test_pool(dims, type, {3, 2}, {2, 1}, {1, 1, 0, 0}, exclusive, true);
+      }
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -13,429 +13,374 @@
 // limitations under the License.
 
 #include "lite/kernels/x86/rnn_compute.h"
-#include <cmath>
-#include <memory>
+#include <cstring>
 #include <string>
 #include <vector>
-#include "lite/backends/host/math/split.h"
+#include "lite/backends/x86/jit/helper.h"
+#include "lite/backends/x86/jit/kernel_base.h"
+#include "lite/backends/x86/jit/kernels.h"
 #include "lite/backends/x86/math/blas.h"
-#include "lite/backends/x86/math/concat_and_split.h"
 #include "lite/backends/x86/math/rnn.h"
-#include "lite/kernels/x86/rnn_compute.h"
+#include "lite/backends/x86/parallel.h"
 
 namespace paddle {
 namespace lite {
 namespace kernels {
 namespace x86 {
 
-#define RUN_LSTM_LAYER(x, y, z, w) \
-  runLSTMLayer(&ctx,               \
-               input_temp_holder,  \
-               parameter_lists[x], \
-               init_h_unbind,      \
-               init_c_unbind,      \
-               sequence_length,    \
-               &last_h_unbind,     \
-               &last_c_unbind,     \
-               y,                  \
-               x,                  \
-               &gate_value,        \
-               z,                  \
-               w)
-
-void reset_parameter_vector(const std::vector<Tensor*>& raw_params_vec,
-                            const int& num_layers,
-                            const int& gate_num,
-                            const bool& is_bidirec,
-                            std::vector<std::vector<Tensor>>* params_vec) {
-  // the parameter raw seuquence is [FWhi, FWhh, BWhi, BWhh] * num_layers
-  // + [FBhi, FBhh, BBhi, BBhh] * num_layers, we will reset the parameter to
-  // ([FWhi, FWhh, FBhi, FBhh] + [BWhi, BWhh, BBhi, BBhh]) * num_layers
-  const int& direction_num = is_bidirec ? 2 : 1;
-  const int& layer_weight_size = 4 * direction_num;
-  const int& all_weight_size = num_layers * layer_weight_size;
-  const int& bias_start_idx = all_weight_size / 2;
-  for (int i = 0; i < num_layers; i++) {
-    std::vector<Tensor> tensor_list;
-    tensor_list.reserve(layer_weight_size);
-    for (int j = 0; j < layer_weight_size; j++) {
-      Tensor tensor_holder;
-      tensor_list.emplace_back(tensor_holder);
-    }
-    for (int j = 0; j < layer_weight_size; j++) {
-      int k = j % 4;
-      const int& section = j / 4;
-      int tensor_idx = i * 2 * direction_num + section * 2 + k % 2;
-      if (k >= 2) {
-        tensor_idx += bias_start_idx;
-      }
-      tensor_list[j].ShareDataWith(*raw_params_vec[tensor_idx]);
-    }
-    params_vec->emplace_back(tensor_list);
+namespace {
+
+RnnMode GetRnnMode(const std::string& mode) {
+  if (mode == "LSTM") {
+    return RnnMode::kLSTM;
+  } else if (mode == "GRU") {
+    return RnnMode::kGRU;
+  } else if (mode == "RNN_TANH") {
+    return RnnMode::kRNNTanh;
+  } else if (mode == "RNN_RELU") {
+    return RnnMode::kRNNRelu;
   }
+  LOG(FATAL) << "Unsupported rnn mode: " << mode;
+  return RnnMode::kLSTM;
 }
 
-void SwapPoniter(Tensor** a, Tensor** b) {
-  Tensor* c = *a;
-  *a = *b;
-  *b = c;
-}
-
-void preprocess(X86Context* ctx,
-                const Tensor* input,
-                const Tensor& weight,
-                const Tensor& bias_ih,
-                const Tensor& bias_hh,
-                Tensor* cache_input,
-                bool is_test) {
-  const int& hidden_size = weight.dims()[0];
-  int time_step = input->dims()[0];
-  int batch = input->dims()[1];
-
-  std::vector<int64_t> cache_input_dim = {time_step, batch, hidden_size};
-  DDim gate_dim;
-  gate_dim.ConstructFrom(cache_input_dim);
-  cache_input->Resize(gate_dim);
-
-  auto* i_data = input->data<float>();
-  auto* w_data = weight.data<float>();
-  auto* o_data = cache_input->mutable_data<float>();
-  auto input_dims = input->dims();
-  auto weight_input_dims = weight.dims();
-  int m = input_dims[0] * input_dims[1];
-  int k = input_dims[2];
-  int n = weight_input_dims[0];
-
-  paddle::lite::x86::math::Blas<lite::TargetType::kX86> matmul(*ctx);
-  matmul.GEMM<float>(
-      false, true, m, n, k, 1.f, i_data, k, w_data, k, 0.f, o_data, n);
-  lite::x86::math::fill_bias_fc(o_data, bias_ih.data<float>(), m, n);
-  lite::x86::math::fill_bias_fc(o_data, bias_hh.data<float>(), m, n);
-}
-
-void cell(X86Context* ctx,
-          Tensor* input,
-          Tensor* weight_hh,
-          Tensor* init_h,
-          Tensor* init_c,
-          Tensor* last_h,
-          Tensor* last_c,
-          Tensor* last_c_act,
-          Tensor* output,
-          const Tensor* bias_hh) {
-  auto h_dims = init_h->dims();
-  auto weight_input_dims = weight_hh->dims();
-  int m = h_dims[0];
-  int k = h_dims[1];
-  int n = weight_input_dims[0];
-  auto i_data = input->data<float>();
-  auto w_data = weight_hh->data<float>();
-  auto h_data = init_h->data<float>();
-
-  Tensor tmp_gate;
-  tmp_gate.Resize(input->dims());
-  auto tmp_data = tmp_gate.mutable_data<float>();
-
-  paddle::lite::x86::math::Blas<lite::TargetType::kX86> matmul(*ctx);
-  matmul.GEMM<float>(
-      false, true, m, n, k, 1.f, h_data, k, w_data, k, 0.f, tmp_data, n);
-  for (int i = 0; i < input->dims()[0] * input->dims()[1]; i++) {
-    tmp_data[i] += i_data[i];
-  }
-
-  Tensor tmp_init_c;
-  tmp_init_c.Resize(init_c->dims());
-  auto tmp_init_c_data = tmp_init_c.mutable_data<float>();
-  for (int i = 0; i < tmp_init_c.dims()[0] * tmp_init_c.dims()[1]; i++) {
-    tmp_init_c_data[i] = init_c->data<float>()[i];
+int GetGateNum(RnnMode mode) {
+  switch (mode) {
+    case RnnMode::kLSTM:
+      return 4;
+    case RnnMode::kGRU:
+      return 3;
+    default:
+      return 1;
   }
+}
 
-  lite::x86::math::LstmMetaValue<float> lstm_value;
-  lstm_value.check_ig = nullptr;
-  lstm_value.check_fg = nullptr;
-  lstm_value.check_og = nullptr;
-  lite_api::ActivationType gate_act = lite_api::ActivationType::kSigmoid_v2;
-  lite_api::ActivationType cell_act = lite_api::ActivationType::kTanh_v2;
-  lite_api::ActivationType cand_act = lite_api::ActivationType::kTanh_v2;
-
-  size_t frame_size = init_h->dims()[1];
-  size_t batch_size = init_h->dims()[0];
-  Tensor cell_pre_act;
-  if (last_c_act == nullptr) {
-    cell_pre_act.Resize(init_h->dims());
-    cell_pre_act.mutable_data<float>();
-    last_c_act = &cell_pre_act;
+// Step GEMMs of at most this many multiply-adds gain little from threads, so
+// the directions of a bidirectional layer run side by side instead. Larger
+// ones keep all the threads and the directions run one after the other.
+constexpr int64_t kSerialStepGemm = 1 << 18;
+
+// Copies the gate blocks of `src` ([gate_num * hidden]) so that block `k` of
+// `dst` is block `order[k]` of `src`.
+void ReorderGates(const Tensor& src,
+                  const std::vector<int>& order,
+                  int hidden,
+                  Tensor* dst) {
+  dst->Resize(src.dims());
+  const float* src_data = src.data<float>();
+  float* dst_data = dst->mutable_data<float>();
+  int64_t block = src.numel() / static_cast<int64_t>(order.size());
+  CHECK_EQ(block % hidden, 0);
+  for (size_t k = 0; k < order.size(); ++k) {
+    std::memcpy(dst_data + k * block,
+                src_data + order[k] * block,
+                block * sizeof(float));
   }
-
-  lstm_value.prev_state_value = tmp_init_c_data;
-  lstm_value.gate_value = tmp_data;
-  lstm_value.output_value = output->mutable_data<float>();
-  lstm_value.state_value = last_c->mutable_data<float>();
-  lstm_value.state_active_value = last_c_act->mutable_data<float>();
-  float cell_clip = 0.0;
-  lite::x86::math::RnnLstmUnitFunctor<float>::compute(lstm_value,
-                                                      frame_size,
-                                                      batch_size,
-                                                      cell_clip,
-                                                      cand_act,
-                                                      gate_act,
-                                                      cell_act,
-                                                      1);
 }
 
-void runLSTMLayer(X86Context* ctx,
-                  const Tensor* input,
-                  std::vector<Tensor> vec,
-                  std::vector<Tensor> init_h,
-                  std::vector<Tensor> init_c,
-                  const Tensor* sequence_length,
-                  std::vector<Tensor>* last_h_ptr,
-                  std::vector<Tensor>* last_c_ptr,
-                  Tensor* output,
-                  int layer_idx,
-                  Tensor* gate_value,
-                  bool is_bidirect,
-                  int offset) {
-  bool is_reverse = false;
-  if (is_bidirect) {
-    layer_idx = 2 * layer_idx + offset;
-    if (offset > 0) {
-      is_reverse = true;
+}  // namespace
+
+void RnnCompute::PrepareForRun() {
+  auto& param = this->Param<operators::RnnParam>();
+  mode_ = GetRnnMode(param.mode);
+  gate_num_ = GetGateNum(mode_);
+  hidden_size_ = param.hidden_size;
+  direction_num_ = param.is_bidirec ? 2 : 1;
+  const int num_layers = param.num_layers;
+  const int weight_num = num_layers * direction_num_;
+  CHECK_EQ(param.WeightList.size(), static_cast<size_t>(weight_num * 4));
+
+  // cuDNN layout is {i, f, c, o} for LSTM, the jit kernel takes {c, i, f, o}.
+  gate_order_.clear();
+  if (mode_ == RnnMode::kLSTM) {
+    gate_order_ = {2, 0, 1, 3};
+  } else {
+    for (int k = 0; k < gate_num_; ++k) {
+      gate_order_.push_back(k);
     }
   }
 
-  const int& time_step = input->dims()[0];
-  preprocess(ctx,
-             input,
-             vec[0 + offset * 4],
-             vec[2 + offset * 4],
-             vec[3 + offset * 4],
-             gate_value,
-             true);
-  std::vector<Tensor> input_tensors, output_tensors;
-  std::vector<Tensor *> input_tensors_t, output_tensors_t;
-  std::vector<int> stride1, stride2;
-  input_tensors.resize(gate_value->dims()[0]);  // time_step
-  output_tensors.resize(output->dims()[0]);
-
-  // alloc input
-  for (int i = 0; i < gate_value->dims()[0]; i++) {
-    stride1.push_back(1);
-    int dim1 = gate_value->dims()[1];  // batch
-    int dim2 = gate_value->dims()[2];  // hidden
-    DDimLite dims(std::vector<int64_t>{dim1, dim2});
-    input_tensors[i].Resize(dims);
-    input_tensors_t.push_back(&input_tensors[i]);
+  // WeightList is [W_ih, W_hh] of every direction of every layer followed by
+  // [b_ih, b_hh] in the same order.
+  weights_.resize(weight_num);
+  for (int i = 0; i < weight_num; ++i) {
+    const Tensor* weight_ih = param.WeightList[2 * i];
+    const Tensor* weight_hh = param.WeightList[2 * i + 1];
+    const Tensor* bias_ih = param.WeightList[2 * weight_num + 2 * i];
+    const Tensor* bias_hh = param.WeightList[2 * weight_num + 2 * i + 1];
+    CHECK_EQ(weight_hh->dims()[0], gate_num_ * hidden_size_);
+    CHECK_EQ(weight_hh->dims()[1], hidden_size_);
+
+    auto& weights = weights_[i];
+    weights.weight_ih = weight_ih;
+    weights.weight_hh = weight_hh;
+    Tensor bias_ih_reordered, bias_hh_reordered;
+    ReorderGates(*bias_ih, gate_order_, hidden_size_, &bias_ih_reordered);
+    ReorderGates(*bias_hh, gate_order_, hidden_size_, &bias_hh_reordered);
+    const float* b_ih = bias_ih_reordered.data<float>();
+    const float* b_hh = bias_hh_reordered.data<float>();
+
+    const int gate_width = gate_num_ * hidden_size_;
+    weights.bias.Resize({gate_width});
+    float* bias = weights.bias.mutable_data<float>();
+    int shared = mode_ == RnnMode::kGRU ? 2 * hidden_size_ : gate_width;
+    for (int j = 0; j < gate_width; ++j) {
+      bias[j] = j < shared ? b_ih[j] + b_hh[j] : b_ih[j];
+    }
+    if (mode_ == RnnMode::kGRU) {
+      weights.bias_hn.Resize({hidden_size_});
+      std::memcpy(weights.bias_hn.mutable_data<float>(),
+                  b_hh + shared,
+                  hidden_size_ * sizeof(float));
+    }
   }
+  gates_.resize(direction_num_);
+  hidden_gates_.resize(direction_num_);
+}
 
-  // alloc output
-  for (int i = 0; i < output->dims()[0]; i++) {
-    stride2.push_back(1);
-    int dim1 = output->dims()[1];
-    int dim2 = output->dims()[2];
-    DDimLite dims(std::vector<int64_t>{dim1, dim2});
-    output_tensors[i].Resize(dims);
-    output_tensors_t.push_back(&output_tensors[i]);
+void RnnCompute::GateGemm(int m,
+                          int k,
+                          const float* a,
+                          const Tensor& weight,
+                          float beta,
+                          float* c) {
+  auto& ctx = this->ctx_->As<X86Context>();
+  lite::x86::math::Blas<lite::TargetType::kX86> blas(ctx);
+  const int hidden = hidden_size_;
+  const int gate_width = gate_num_ * hidden;
+  const float* w = weight.data<float>();
+  if (mode_ != RnnMode::kLSTM) {
+    blas.GEMM<float>(
+        false, true, m, gate_width, k, 1.f, a, k, w, k, beta, c, gate_width);
+    return;
   }
-
-  lite::host::math::split(
-      gate_value->data<float>(), input_tensors_t, 0, stride1);
-  lite::host::math::split(output->data<float>(), output_tensors_t, 0, stride2);
-  auto sd = output->mutable_data<float>();
-
-  if (is_reverse) {
-    std::reverse(input_tensors.begin(), input_tensors.end());
+  // The weight keeps the cuDNN gate order, so each gate block goes to its
+  // place in `c` with a GEMM of its own.
+  for (int g = 0; g < gate_num_; ++g) {
+    blas.GEMM<float>(false,
+                     true,
+                     m,
+                     hidden,
+                     k,
+                     1.f,
+                     a,
+                     k,
+                     w + static_cast<int64_t>(gate_order_[g]) * hidden * k,
+                     k,
+                     beta,
+                     c + g * hidden,
+                     gate_width);
   }
-  bool has_sequence_length = false;
-  /*
-    TODO has_sequence_length
-  */
+}
 
-  int mask_min_length = time_step;
-  if (is_reverse) {
-    mask_min_length = mask_min_length - time_step + 1;
-  }
-  bool has_allocate_mem_c = false;
-  bool has_use_last_h_holder = false;
-  const int& reverse_flag = is_reverse ? -1 : 1;
-  Tensor init_h_temp;
-  init_h_temp.CopyDataFrom(init_h[layer_idx]);
-  Tensor* init_h_holder = &init_h_temp;
-  Tensor* last_h_holder = nullptr;
+void RnnCompute::ProjectInput(const float* input,
+                              int input_size,
+                              const DirectionWeights& weights,
+                              Tensor* gates) {
+  const int gate_width = gate_num_ * hidden_size_;
+  gates->Resize({time_step_ * batch_size_, gate_width});
+  float* gates_data = gates->mutable_data<float>();
+  GateGemm(time_step_ * batch_size_,
+           input_size,
+           input,
+           *weights.weight_ih,
+           0.f,
+           gates_data);
+  lite::x86::math::fill_bias_fc(gates_data,
+                                weights.bias.data<float>(),
+                                time_step_ * batch_size_,
+                                gate_width);
+}
 
-  if (0 < mask_min_length) {
-    last_h_holder = &(output_tensors[0]);
-  } else {
-    last_h_holder = &(*last_h_ptr)[layer_idx];
-    has_use_last_h_holder = true;
+void RnnCompute::RunSteps(const DirectionWeights& weights,
+                          bool is_reverse,
+                          float* h,
+                          float* c,
+                          float* output,
+                          int output_stride,
+                          Tensor* gates,
+                          Tensor* hidden_gates) {
+  const int hidden = hidden_size_;
+  const int batch = batch_size_;
+  const int gate_width = gate_num_ * hidden;
+  float* gates_data = gates->mutable_data<float>();
+
+  hidden_gates->Resize({batch, gate_width});
+  float* hh = hidden_gates->mutable_data<float>();
+  std::vector<float> cell(hidden);
+  const bool is_gru = mode_ == RnnMode::kGRU;
+
+  // The jit kernel caches are thread local.
+  jit::lstm_attr_t lstm_attr(
+      hidden, jit::kVSigmoid, jit::kVTanh, jit::kVTanh, false);
+  jit::LSTMCtHtTuple<float>::func_type lstm_cell = nullptr;
+  if (mode_ == RnnMode::kLSTM) {
+    lstm_cell =
+        jit::KernelFuncs<jit::LSTMCtHtTuple<float>, fluid::CPUPlace>::Cache()
+            .At(lstm_attr);
   }
-
-  Tensor* init_c_holder = nullptr;
-  Tensor* init_c_temp_holder = nullptr;
-  Tensor init_c_temp;
-  Tensor* last_c_holder = nullptr;
-  Tensor last_c_temp;
-  last_c_holder = &(*last_c_ptr)[layer_idx];
-  init_c_temp_holder = &init_c[layer_idx];
-
-  for (int i = 0; i < time_step; i++) {
-    bool in_mask = (reverse_flag * i) >= mask_min_length;
-    if (i > 0) {
-      if (!has_allocate_mem_c) {
-        init_c_temp.Resize(init_h[layer_idx].dims());
-        init_c_temp.mutable_data<float>();
-        init_c_holder = &init_c_temp;
-        has_allocate_mem_c = true;
+  auto vadd =
+      jit::KernelFuncs<jit::VAddTuple<float>, fluid::CPUPlace>::Cache().At(
+          hidden);
+  auto vadd_rz =
+      jit::KernelFuncs<jit::VAddTuple<float>, fluid::CPUPlace>::Cache().At(
+          2 * hidden);
+  auto vsub =
+      jit::KernelFuncs<jit::VSubTuple<float>, fluid::CPUPlace>::Cache().At(
+          hidden);
+  auto vmul =
+      jit::KernelFuncs<jit::VMulTuple<float>, fluid::CPUPlace>::Cache().At(
+          hidden);
+  auto vsigmoid =
+      jit::KernelFuncs<jit::VSigmoidTuple<float>, fluid::CPUPlace>::Cache().At(
+          is_gru ? 2 * hidden : hidden);
+  auto vtanh =
+      jit::KernelFuncs<jit::VTanhTuple<float>, fluid::CPUPlace>::Cache().At(
+          hidden);
+  auto vrelu =
+      jit::KernelFuncs<jit::VReluTuple<float>, fluid::CPUPlace>::Cache().At(
+          hidden);
+
+  for (int step = 0; step < time_step_; ++step) {
+    const int t = is_reverse ? time_step_ - 1 - step : step;
+    float* step_gates = gates_data + t * batch * gate_width;
+    // GRU keeps the recurrent projection apart since its reset gate scales
+    // the candidate part, other modes accumulate it into the gates.
+    GateGemm(batch,
+             hidden,
+             h,
+             *weights.weight_hh,
+             is_gru ? 0.f : 1.f,
+             is_gru ? hh : step_gates);
+
+    for (int b = 0; b < batch; ++b) {
+      float* out = output + (t * batch + b) * output_stride;
+      if (!sequence_length_.empty() && t >= sequence_length_[b]) {
+        std::memset(out, 0, hidden * sizeof(float));
+        continue;
       }
-      SwapPoniter(&init_c_holder, &last_c_holder);
-      init_c_temp_holder = init_c_holder;
-    }
-
-    // LSTMCELL
-    cell(ctx,
-         &input_tensors[i],
-         &vec[1 + offset * 4],
-         init_h_holder,
-         init_c_temp_holder,
-         last_h_holder,
-         last_c_holder,
-         nullptr,
-         &output_tensors[i],
-         &vec[3 + offset * 4]);
-
-    if (in_mask) {
-      /*
-        TODO in_mask
-      */
-    }
-
-    // prepare next step
-    if (i + 1 < time_step) {
-      bool next_step_mask = (reverse_flag * (i + 1)) >= mask_min_length;
-      if (next_step_mask) {
-        if (!has_use_last_h_holder) {
-          init_h_holder = &(*last_h_ptr)[layer_idx];
+      float* g = step_gates + b * gate_width;
+      float* h_b = h + b * hidden;
+      switch (mode_) {
+        case RnnMode::kLSTM: {
+          float* c_b = c + b * hidden;
+          jit::lstm_t lstm;
+          lstm.gates = g;
+          lstm.ct_1 = c_b;
+          lstm.ct = cell.data();
+          lstm.ht = h_b;
+          lstm_cell(&lstm, &lstm_attr);
+          std::memcpy(c_b, cell.data(), hidden * sizeof(float));
+          break;
+        }
+        case RnnMode::kGRU: {
+          // r, z = sigmoid(x_rz + h W_rz)
+          // n = tanh(x_n + r * (h W_n + b_hn))
+          // h = n + z * (h - n)
+          float* g_hh = hh + b * gate_width;
+          float* r = g;
+          float* z = g + hidden;
+          float* n = g + 2 * hidden;
+          float* h_n = g_hh + 2 * hidden;
+          vadd_rz(g, g_hh, g, 2 * hidden);
+          vsigmoid(g, g, 2 * hidden);
+          vadd(h_n, weights.bias_hn.data<float>(), h_n, hidden);
+          vmul(r, h_n, h_n, hidden);
+          vadd(n, h_n, n, hidden);
+          vtanh(n, n, hidden);
+          vsub(h_b, n, g_hh, hidden);
+          vmul(z, g_hh, g_hh, hidden);
+          vadd(n, g_hh, h_b, hidden);
+          break;
         }
-      } else {
-        init_h_holder = &(output_tensors[i + 1]);
+        case RnnMode::kRNNTanh:
+          vtanh(g, h_b, hidden);
+          break;
+        case RnnMode::kRNNRelu:
+          vrelu(g, h_b, hidden);
+          break;
       }
-      SwapPoniter(&init_h_holder, &last_h_holder);
-    }
-  }
-  if (is_reverse) {
-    std::reverse(output_tensors.begin(), output_tensors.end());
-  }
-  for (int i = 0; i < time_step; i++) {
-    int st = output_tensors[i].dims()[0] * output_tensors[i].dims()[1];
-    for (int j = 0; j < st; j++) {
-      sd[i * st + j] = output_tensors[i].data<float>()[j];
+      std::memcpy(out, h_b, hidden * sizeof(float));
     }
   }
-
-  if (has_sequence_length) {
-    if (last_h_holder != &(*last_h_ptr)[layer_idx]) {
-      (*last_h_ptr)[layer_idx].CopyDataFrom(*last_h_holder);
-    }
-  } else {
-    (*last_h_ptr)[layer_idx].CopyDataFrom(output_tensors[time_step - 1]);
-  }
-  if (time_step % 2 == 0) {
-    (*last_c_ptr)[layer_idx].CopyDataFrom(*last_c_holder);
-  }
 }
 
 void RnnCompute::Run() {
   auto& param = this->Param<operators::RnnParam>();
-  auto& ctx = this->ctx_->As<X86Context>();
-  std::string mode = param.mode;
-  auto input = param.Input;
-  auto weight_list = param.WeightList;
-  auto pre_state = param.PreState;
-  auto state = param.State;
-  auto output = param.Out;
-  bool is_bidirec = param.is_bidirec;
-  int num_layers = param.num_layers;
-  const Tensor* sequence_length = param.SequenceLength;
-
-  state[0]->mutable_data<float>();
-  state[1]->mutable_data<float>();
-
-  // lstmCell begin
-  int gate_num = 4;
-  std::vector<std::vector<Tensor>> parameter_lists;
-  parameter_lists.reserve(num_layers);
-  reset_parameter_vector(
-      weight_list, num_layers, gate_num, is_bidirec, &parameter_lists);
-  Tensor* input_holder;
-  Tensor* output_holder = output;
-  Tensor temp, gate_value;
-  bool has_allocate_mem = false;
-
-  std::vector<Tensor> init_h_unbind, init_c_unbind, last_h_unbind,
-      last_c_unbind;
-  std::vector<Tensor *> init_h_unbind_t, init_c_unbind_t, last_h_unbind_t,
-      last_c_unbind_t;
-  init_h_unbind.resize(4);
-  init_c_unbind.resize(pre_state[1]->dims()[0]);
-  last_h_unbind.resize(state[0]->dims()[0]);
-  last_c_unbind.resize(state[1]->dims()[0]);
-  std::vector<int> stride;
-  for (int i = 0; i < pre_state[0]->dims()[0]; i++) {
-    stride.push_back(1);
-    int dim1 = pre_state[0]->dims()[1];
-    int dim2 = pre_state[0]->dims()[2];
-    DDimLite dims(std::vector<int64_t>{dim1, dim2});
-    init_h_unbind[i].Resize(dims);
-    init_c_unbind[i].Resize(dims);
-    last_h_unbind[i].Resize(dims);
-    last_c_unbind[i].Resize(dims);
-    init_h_unbind_t.push_back(&init_h_unbind[i]);
-    init_c_unbind_t.push_back(&init_c_unbind[i]);
-    last_h_unbind_t.push_back(&last_h_unbind[i]);
-    last_c_unbind_t.push_back(&last_c_unbind[i]);
+  const auto& in_dims = param.Input->dims();
+  time_step_ = in_dims[0];
+  batch_size_ = in_dims[1];
+  sequence_length_.clear();
+  if (param.SequenceLength) {
+    const Tensor* lengths = param.SequenceLength;
+    CHECK_EQ(lengths->numel(), batch_size_);
+    if (lengths->precision() == PRECISION(kInt64)) {
+      const int64_t* data = lengths->data<int64_t>();
+      sequence_length_.assign(data, data + batch_size_);
+    } else {
+      const int* data = lengths->data<int>();
+      sequence_length_.assign(data, data + batch_size_);
+    }
+  }
+  const int num_layers = param.num_layers;
+  const int output_width = direction_num_ * hidden_size_;
+  const int64_t state_size = batch_size_ * hidden_size_;
+  bool has_cell = mode_ == RnnMode::kLSTM;
+  const int64_t step_gemm_size = static_cast<int64_t>(batch_size_) *
+                                 gate_num_ * hidden_size_ * hidden_size_;
+
+  // The states are updated in place in State, starting from PreState.
+  float* last_h = param.State[0]->mutable_data<float>();
+  std::memcpy(last_h,
+              param.PreState[0]->data<float>(),
+              param.PreState[0]->numel() * sizeof(float));
+  float* last_c = nullptr;
+  if (has_cell) {
+    last_c = param.State[1]->mutable_data<float>();
+    std::memcpy(last_c,
+                param.PreState[1]->data<float>(),
+                param.PreState[1]->numel() * sizeof(float));
   }
-  lite::host::math::split(
-      pre_state[0]->data<float>(), init_h_unbind_t, 0, stride);
-  lite::host::math::split(
-      pre_state[1]->data<float>(), init_c_unbind_t, 0, stride);
-  lite::host::math::split(state[0]->data<float>(), last_h_unbind_t, 0, stride);
-  lite::host::math::split(state[1]->data<float>(), last_c_unbind_t, 0, stride);
 
-  for (int i = 0; i < num_layers; i++) {
-    if (i > 0) {
-      if (!has_allocate_mem) {
-        temp.Resize(output->dims());
-        temp.mutable_data<float>();
-        input_holder = &temp;
-        has_allocate_mem = true;
-      }
-      SwapPoniter(&output_holder, &input_holder);
+  const float* layer_input = param.Input->data<float>();
+  int layer_input_size = in_dims[2];
+  for (int layer = 0; layer < num_layers; ++layer) {
+    float* layer_output = nullptr;
+    if (layer == num_layers - 1) {
+      layer_output = param.Out->mutable_data<float>();
+    } else {
+      Tensor* buffer = &layer_output_[layer % 2];
+      buffer->Resize({time_step_, batch_size_, output_width});
+      layer_output = buffer->mutable_data<float>();
     }
-
-    const Tensor* input_temp_holder = input;
-    if (i > 0) {
-      input_temp_holder = input_holder;
+    // The input projections are the large GEMMs, they run one after the
+    // other with all the threads.
+    for (int d = 0; d < direction_num_; ++d) {
+      ProjectInput(layer_input,
+                   layer_input_size,
+                   weights_[layer * direction_num_ + d],
+                   &gates_[d]);
     }
-
-    if (is_bidirec) {
-      std::vector<Tensor> output_vec(2);
-      int time_step = input->dims()[0];
-      int batch_size = input->dims()[1];
-      int hidden_size = output->dims()[2];
-      for (int i = 0; i < 2; ++i) {
-        output_vec[i].Resize({time_step, batch_size, hidden_size / 2});
-        output_vec[i].mutable_data<float>();
+    auto run_directions = [&](int64_t begin, int64_t end) {
+      for (int64_t d = begin; d < end; ++d) {
+        int64_t index = layer * direction_num_ + d;
+        RunSteps(weights_[index],
+                 d == 1,
+                 last_h + index * state_size,
+                 has_cell ? last_c + index * state_size : nullptr,
+                 layer_output + d * hidden_size_,
+                 output_width,
+                 &gates_[d],
+                 &hidden_gates_[d]);
       }
-
-      RUN_LSTM_LAYER(i, &output_vec[0], true, 0);
-      RUN_LSTM_LAYER(i, &output_vec[1], true, 1);
-
-      paddle::lite::x86::math::ConcatFunctor<lite::TargetType::kX86, float>
-          concat_x86;
-      concat_x86(ctx, output_vec, 2, output);
+    };
+    if (step_gemm_size <= kSerialStepGemm) {
+      lite::x86::RunParallelFor(0, direction_num_, run_directions);
     } else {
-      RUN_LSTM_LAYER(i, output_holder, false, 0);
+      run_directions(0, direction_num_);
     }
+    layer_input = layer_output;
+    layer_input_size = output_width;
   }
 }
 
@@ -449,7 +394,8 @@ REGISTER_LITE_KERNEL(
     .BindInput("Input", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindInput("WeightList", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindInput("PreState", {LiteType::GetTensorTy(TARGET(kX86))})
-    .BindInput("SequenceLength", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("SequenceLength",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kAny))})
     .BindOutput("DropoutState", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindOutput("Reserve", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
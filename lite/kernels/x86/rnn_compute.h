@@ -14,6 +14,7 @@
 
 #pragma once
 #include <algorithm>
+#include <vector>
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 
@@ -22,14 +23,83 @@ namespace lite {
 namespace kernels {
 namespace x86 {
 
+enum class RnnMode { kLSTM, kGRU, kRNNTanh, kRNNRelu };
+
+/*
+ * Multi-layer LSTM/GRU/simple RNN with the cuDNN gate layout, i.e. the
+ * `rnn` op of Paddle 2.x.
+ *
+ * Per direction of a layer, the input projection of all time steps is one
+ * GEMM and each step runs one [batch, hidden] x [hidden, gates] GEMM followed
+ * by the jit cell kernels. The two directions of a bidirectional layer run
+ * concurrently only when the step GEMM is small, so that they do not take
+ * the threads of the GEMMs. Steps at or beyond SequenceLength keep the
+ * previous state and output zeros.
+ */
 class RnnCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
+  void PrepareForRun() override;
+
   void Run() override;
 
   virtual ~RnnCompute() = default;
+
+ private:
+  // Weights of one direction of one layer. The weights are the ones of the
+  // op, GateGemm writes their gate blocks in the layout of the jit cell
+  // kernels: {c, i, f, o} for LSTM and the original {r, z, n} for GRU. The
+  // biases are reordered copies.
+  struct DirectionWeights {
+    const Tensor* weight_ih{nullptr};  // [gate_num * hidden, input]
+    const Tensor* weight_hh{nullptr};  // [gate_num * hidden, hidden]
+    // b_ih + b_hh, except the candidate part of b_hh for GRU which is added
+    // before the reset gate is applied.
+    Tensor bias;
+    Tensor bias_hn;  // GRU only, [hidden]
+  };
+
+  // c[m, gate_num * hidden] = a[m, k] * weight^T + beta * c, with the gate
+  // blocks of c in the jit layout.
+  void GateGemm(int m,
+                int k,
+                const float* a,
+                const Tensor& weight,
+                float beta,
+                float* c);
+
+  // Input projection of all the time steps of one direction, bias included.
+  void ProjectInput(const float* input,
+                    int input_size,
+                    const DirectionWeights& weights,
+                    Tensor* gates);
+
+  void RunSteps(const DirectionWeights& weights,
+                bool is_reverse,
+                float* h,
+                float* c,
+                float* output,
+                int output_stride,
+                Tensor* gates,
+                Tensor* hidden_gates);
+
+  RnnMode mode_{RnnMode::kLSTM};
+  int gate_num_{4};
+  int hidden_size_{0};
+  int direction_num_{1};
+  // Block k of the jit gate layout is block gate_order_[k] of the op's.
+  std::vector<int> gate_order_;
+  std::vector<int> sequence_length_;
+  int time_step_{0};
+  int batch_size_{0};
+  // [num_layers * direction_num]
+  std::vector<DirectionWeights> weights_;
+  // Scratch of each direction: input projections and recurrent projections.
+  std::vector<Tensor> gates_;
+  std::vector<Tensor> hidden_gates_;
+  Tensor layer_output_[2];
 };
 
-}  // namespace arm
+}  // namespace x86
 }  // namespace kernels
 }  // namespace lite
 }  // namespace paddle
@@ -0,0 +1,240 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "lite/core/op_registry.h"
+#include "lite/kernels/x86/rnn_compute.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+static float sigmoid(float x) { return 1.f / (1.f + std::exp(-x)); }
+
+// One direction of one layer with the cuDNN gate layout, straight from the
+// definitions.
+static void rnn_direction_ref(const std::string& mode,
+                              const std::vector<float>& x,
+                              int time_step,
+                              int batch,
+                              int input_size,
+                              int hidden,
+                              const float* w_ih,
+                              const float* w_hh,
+                              const float* b_ih,
+                              const float* b_hh,
+                              const std::vector<int>& lengths,
+                              bool is_reverse,
+                              float* h,
+                              float* c,
+                              std::vector<float>* out,
+                              int out_width,
+                              int out_offset) {
+  int gate_num = mode == "LSTM" ? 4 : (mode == "GRU" ? 3 : 1);
+  std::vector<float> gx(gate_num * hidden), gh(gate_num * hidden);
+  for (int s = 0; s < time_step; ++s) {
+    int t = is_reverse ? time_step - 1 - s : s;
+    for (int b = 0; b < batch; ++b) {
+      float* o = out->data() + (t * batch + b) * out_width + out_offset;
+      if (t >= lengths[b]) {
+        for (int j = 0; j < hidden; ++j) o[j] = 0.f;
+        continue;
+      }
+      const float* xt = x.data() + (t * batch + b) * input_size;
+      float* hb = h + b * hidden;
+      for (int g = 0; g < gate_num * hidden; ++g) {
+        gx[g] = b_ih[g];
+        gh[g] = b_hh[g];
+        for (int k = 0; k < input_size; ++k) {
+          gx[g] += xt[k] * w_ih[g * input_size + k];
+        }
+        for (int k = 0; k < hidden; ++k) {
+          gh[g] += hb[k] * w_hh[g * hidden + k];
+        }
+      }
+      for (int j = 0; j < hidden; ++j) {
+        if (mode == "LSTM") {
+          float i = sigmoid(gx[j] + gh[j]);
+          float f = sigmoid(gx[hidden + j] + gh[hidden + j]);
+          float g = std::tanh(gx[2 * hidden + j] + gh[2 * hidden + j]);
+          float og = sigmoid(gx[3 * hidden + j] + gh[3 * hidden + j]);
+          float* cb = c + b * hidden;
+          cb[j] = f * cb[j] + i * g;
+          o[j] = og * std::tanh(cb[j]);
+        } else if (mode == "GRU") {
+          float r = sigmoid(gx[j] + gh[j]);
+          float z = sigmoid(gx[hidden + j] + gh[hidden + j]);
+          float n = std::tanh(gx[2 * hidden + j] + r * gh[2 * hidden + j]);
+          o[j] = (1.f - z) * n + z * hb[j];
+        } else if (mode == "RNN_TANH") {
+          o[j] = std::tanh(gx[j] + gh[j]);
+        } else {
+          o[j] = std::max(gx[j] + gh[j], 0.f);
+        }
+      }
+      for (int j = 0; j < hidden; ++j) hb[j] = o[j];
+    }
+  }
+}
+
+static void test_rnn(const std::string& mode,
+                     int num_layers,
+                     bool is_bidirec,
+                     bool with_lengths) {
+  const int time_step = 5, batch = 3, input_size = 6, hidden = 4;
+  const int direction_num = is_bidirec ? 2 : 1;
+  const int gate_num = mode == "LSTM" ? 4 : (mode == "GRU" ? 3 : 1);
+  const int out_width = direction_num * hidden;
+  const int state_num = num_layers * direction_num;
+  bool has_cell = mode == "LSTM";
+
+  auto fill = [](Tensor* tensor, int seed) {
+    float* data = tensor->mutable_data<float>();
+    for (int64_t i = 0; i < tensor->numel(); ++i) {
+      data[i] = std::sin(0.37f * i + seed) * 0.5f;
+    }
+  };
+
+  Tensor input, out, lengths_tensor;
+  input.Resize({time_step, batch, input_size});
+  fill(&input, 1);
+  out.Resize({time_step, batch, out_width});
+  std::vector<int> lengths(batch, time_step);
+  if (with_lengths) {
+    lengths = {time_step, 2, 4};
+    lengths_tensor.Resize({batch});
+    int* data = lengths_tensor.mutable_data<int>();
+    for (int b = 0; b < batch; ++b) data[b] = lengths[b];
+  }
+
+  std::vector<Tensor> weights(state_num * 4);
+  for (int i = 0; i < state_num; ++i) {
+    int layer_input = i < direction_num ? input_size : out_width;
+    weights[2 * i].Resize({gate_num * hidden, layer_input});
+    weights[2 * i + 1].Resize({gate_num * hidden, hidden});
+    weights[2 * state_num + 2 * i].Resize({gate_num * hidden});
+    weights[2 * state_num + 2 * i + 1].Resize({gate_num * hidden});
+  }
+  for (size_t i = 0; i < weights.size(); ++i) fill(&weights[i], 3 + i);
+
+  std::vector<Tensor> pre_state(has_cell ? 2 : 1), state(pre_state.size());
+  for (size_t i = 0; i < pre_state.size(); ++i) {
+    pre_state[i].Resize({state_num, batch, hidden});
+    fill(&pre_state[i], 11 + i);
+    state[i].Resize({state_num, batch, hidden});
+  }
+
+  operators::RnnParam param;
+  param.Input = &input;
+  param.Out = &out;
+  for (auto& w : weights) param.WeightList.push_back(&w);
+  for (auto& s : pre_state) param.PreState.push_back(&s);
+  for (auto& s : state) param.State.push_back(&s);
+  param.SequenceLength = with_lengths ? &lengths_tensor : nullptr;
+  param.is_bidirec = is_bidirec;
+  param.input_size = input_size;
+  param.hidden_size = hidden;
+  param.num_layers = num_layers;
+  param.mode = mode;
+  param.is_test = true;
+
+  RnnCompute rnn;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  rnn.SetContext(std::move(ctx));
+  rnn.SetParam(param);
+  rnn.PrepareForRun();
+  rnn.Run();
+
+  // Reference.
+  std::vector<float> layer_in(input.data<float>(),
+                              input.data<float>() + input.numel());
+  std::vector<float> h(pre_state[0].data<float>(),
+                       pre_state[0].data<float>() + pre_state[0].numel());
+  std::vector<float> c;
+  if (has_cell) {
+    c.assign(pre_state[1].data<float>(),
+             pre_state[1].data<float>() + pre_state[1].numel());
+  }
+  std::vector<float> layer_out(time_step * batch * out_width);
+  for (int l = 0; l < num_layers; ++l) {
+    int layer_input = l == 0 ? input_size : out_width;
+    for (int d = 0; d < direction_num; ++d) {
+      int i = l * direction_num + d;
+      rnn_direction_ref(mode,
+                        layer_in,
+                        time_step,
+                        batch,
+                        layer_input,
+                        hidden,
+                        weights[2 * i].data<float>(),
+                        weights[2 * i + 1].data<float>(),
+                        weights[2 * state_num + 2 * i].data<float>(),
+                        weights[2 * state_num + 2 * i + 1].data<float>(),
+                        lengths,
+                        d == 1,
+                        h.data() + i * batch * hidden,
+                        has_cell ? c.data() + i * batch * hidden : nullptr,
+                        &layer_out,
+                        out_width,
+                        d * hidden);
+    }
+    layer_in = layer_out;
+  }
+
+  for (int64_t i = 0; i < out.numel(); ++i) {
+    EXPECT_NEAR(out.data<float>()[i], layer_out[i], 1e-4) << mode << " " << i;
+  }
+  for (int64_t i = 0; i < state[0].numel(); ++i) {
+    EXPECT_NEAR(state[0].data<float>()[i], h[i], 1e-4) << mode << " " << i;
+  }
+  if (has_cell) {
+    for (int64_t i = 0; i < state[1].numel(); ++i) {
+      EXPECT_NEAR(state[1].data<float>()[i], c[i], 1e-4) << mode << " " << i;
+    }
+  }
+}
+
+TEST(rnn_x86, retrive_op) {
+  auto rnn = KernelRegistry::Global().Create("rnn");
+  ASSERT_FALSE(rnn.empty());
+  ASSERT_TRUE(rnn.front());
+}
+
+TEST(rnn_x86, run_test) {
+  for (std::string mode : {"LSTM", "GRU", "RNN_TANH", "RNN_RELU"}) {
+    for (int num_layers : {1, 2}) {
+      for (bool is_bidirec : {false, true}) {
+        for (bool with_lengths : {false, true}) {
+          test_rnn(mode, num_layers, is_bidirec, with_lengths);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(rnn, kX86, kFloat, kNCHW, def);
@@ -0,0 +1,52 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/shuffle_channel_compute.h"
+#include <vector>
+#include "lite/backends/x86/math/transpose.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+// [N, G, C/G, H*W] -> [N, C/G, G, H*W], which the transpose runs as
+// parallel copies of H*W floats.
+void ShuffleChannelCompute::Run() {
+  auto& param = Param<operators::ShuffleChannelParam>();
+  const float* x_data = param.X->data<float>();
+  float* output_data = param.Out->mutable_data<float>();
+  auto x_dims = param.X->dims();
+  int64_t group = param.group;
+  std::vector<int64_t> dims{x_dims[0],
+                            group,
+                            x_dims[1] / group,
+                            x_dims.count(2, x_dims.size())};
+  lite::x86::math::transpose(x_data, output_data, dims, {0, 2, 1, 3});
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(shuffle_channel,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::ShuffleChannelCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
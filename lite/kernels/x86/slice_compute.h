@@ -79,8 +79,9 @@ inline std::vector<int> GetIntDataFromTensor(const Tensor* tensor) {
   return vec_data;
 }
 
+// Returns whether |out| was left as a view of |in|.
 template <class T, size_t D>
-void slice_compute(const lite::Tensor* in,
+bool slice_compute(const lite::Tensor* in,
                    lite::Tensor* out,
                    std::vector<int> axes,
                    std::vector<int> starts,
@@ -90,7 +91,8 @@ void slice_compute(const lite::Tensor* in,
                    const lite::Tensor* EndsTensor,
                    std::vector<lite::Tensor*> StartsTensorList,
                    std::vector<lite::Tensor*> EndsTensorList,
-                   std::vector<int> infer_flags) {
+                   std::vector<int> infer_flags,
+                   bool inplace) {
   auto out_dims = out->dims();
   auto in_dims = in->dims();
 
@@ -187,8 +189,6 @@ void slice_compute(const lite::Tensor* in,
     }
   }
 
-  out->mutable_data<T>();
-
   auto new_out_dims = out->dims();
   auto offsets = Eigen::array<int, D>();
   auto extents = Eigen::array<int, D>();
@@ -205,6 +205,31 @@ void slice_compute(const lite::Tensor* in,
     start = (std::max)(start, 0);
     offsets[axes[i]] = start;
   }
+
+  // The slice is one contiguous piece of the input when the axes after some
+  // axis k are whole and the ones before it are cut down to 1.
+  if (inplace) {
+    int k = D - 1;
+    while (k >= 0 && extents[k] == in_dims[k]) --k;
+    bool contiguous = true;
+    for (int i = 0; i < k; ++i) {
+      contiguous = contiguous && extents[i] == 1;
+    }
+    if (contiguous) {
+      int64_t offset = 0;
+      int64_t stride = 1;
+      for (int i = D - 1; i >= 0; --i) {
+        offset += offsets[i] * stride;
+        stride *= in_dims[i];
+      }
+      out->ShareDataWith(
+          *in, offset * sizeof(T), new_out_dims.production() * sizeof(T));
+      out->Resize(out_dims);
+      return true;
+    }
+  }
+
+  out->mutable_data<T>();
   auto in_t =
       lite::fluid::EigenTensor<T, D, Eigen::RowMajor, Eigen::DenseIndex>::From(
           *in, in->dims());
@@ -214,10 +239,11 @@ void slice_compute(const lite::Tensor* in,
   out_t = in_t.slice(offsets, extents);
 
   out->Resize(out_dims);
+  return false;
 }
 
 template <class T>
-void slice_compute_(const lite::Tensor* Input,
+bool slice_compute_(const lite::Tensor* Input,
                     lite::Tensor* Out,
                     std::vector<int> axes,
                     std::vector<int> starts,
@@ -227,88 +253,90 @@ void slice_compute_(const lite::Tensor* Input,
                     const lite::Tensor* EndsTensor,
                     std::vector<lite::Tensor*> StartsTensorList,
                     std::vector<lite::Tensor*> EndsTensorList,
-                    std::vector<int> infer_flags) {
+                    std::vector<int> infer_flags,
+                    bool inplace = false) {
   int rank = Input->dims().size();
   switch (rank) {
     case 1:
-      slice_compute<T, 1>(Input,
-                          Out,
-                          axes,
-                          starts,
-                          ends,
-                          decrease_axis,
-                          StartsTensor,
-                          EndsTensor,
-                          StartsTensorList,
-                          EndsTensorList,
-                          infer_flags);
-      break;
+      return slice_compute<T, 1>(Input,
+                                 Out,
+                                 axes,
+                                 starts,
+                                 ends,
+                                 decrease_axis,
+                                 StartsTensor,
+                                 EndsTensor,
+                                 StartsTensorList,
+                                 EndsTensorList,
+                                 infer_flags,
+                                 inplace);
     case 2:
-      slice_compute<T, 2>(Input,
-                          Out,
-                          axes,
-                          starts,
-                          ends,
-                          decrease_axis,
-                          StartsTensor,
-                          EndsTensor,
-                          StartsTensorList,
-                          EndsTensorList,
-                          infer_flags);
-      break;
+      return slice_compute<T, 2>(Input,
+                                 Out,
+                                 axes,
+                                 starts,
+                                 ends,
+                                 decrease_axis,
+                                 StartsTensor,
+                                 EndsTensor,
+                                 StartsTensorList,
+                                 EndsTensorList,
+                                 infer_flags,
+                                 inplace);
     case 3:
-      slice_compute<T, 3>(Input,
-                          Out,
-                          axes,
-                          starts,
-                          ends,
-                          decrease_axis,
-                          StartsTensor,
-                          EndsTensor,
-                          StartsTensorList,
-                          EndsTensorList,
-                          infer_flags);
-      break;
+      return slice_compute<T, 3>(Input,
+                                 Out,
+                                 axes,
+                                 starts,
+                                 ends,
+                                 decrease_axis,
+                                 StartsTensor,
+                                 EndsTensor,
+                                 StartsTensorList,
+                                 EndsTensorList,
+                                 infer_flags,
+                                 inplace);
     case 4:
-      slice_compute<T, 4>(Input,
-                          Out,
-                          axes,
-                          starts,
-                          ends,
-                          decrease_axis,
-                          StartsTensor,
-                          EndsTensor,
-                          StartsTensorList,
-                          EndsTensorList,
-                          infer_flags);
-      break;
+      return slice_compute<T, 4>(Input,
+                                 Out,
+                                 axes,
+                                 starts,
+                                 ends,
+                                 decrease_axis,
+                                 StartsTensor,
+                                 EndsTensor,
+                                 StartsTensorList,
+                                 EndsTensorList,
+                                 infer_flags,
+                                 inplace);
     case 5:
-      slice_compute<T, 5>(Input,
-                          Out,
-                          axes,
-                          starts,
-                          ends,
-                          decrease_axis,
-                          StartsTensor,
-                          EndsTensor,
-                          StartsTensorList,
-                          EndsTensorList,
-                          infer_flags);
-      break;
+      return slice_compute<T, 5>(Input,
+                                 Out,
+                                 axes,
+                                 starts,
+                                 ends,
+                                 decrease_axis,
+                                 StartsTensor,
+                                 EndsTensor,
+                                 StartsTensorList,
+                                 EndsTensorList,
+                                 infer_flags,
+                                 inplace);
     case 6:
-      slice_compute<T, 6>(Input,
-                          Out,
-                          axes,
-                          starts,
-                          ends,
-                          decrease_axis,
-                          StartsTensor,
-                          EndsTensor,
-                          StartsTensorList,
-                          EndsTensorList,
-                          infer_flags);
-      break;
+      return slice_compute<T, 6>(Input,
+                                 Out,
+                                 axes,
+                                 starts,
+                                 ends,
+                                 decrease_axis,
+                                 StartsTensor,
+                                 EndsTensor,
+                                 StartsTensorList,
+                                 EndsTensorList,
+                                 infer_flags,
+                                 inplace);
   }
+  return false;
 }
 
 template <typename T>
@@ -318,20 +346,29 @@ class SliceCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
 
   void Run() override {
     auto& param = *param_.get_mutable<param_t>();
-    slice_compute_<T>(param.X,
-                      param.Out,
-                      param.axes,
-                      param.starts,
-                      param.ends,
-                      param.decrease_axis,
-                      param.StartsTensor,
-                      param.EndsTensor,
-                      param.StartsTensorList,
-                      param.EndsTensorList,
-                      param.infer_flags);
+    if (view_) {
+      // Let go of the input before the output may be written.
+      param.Out->clear();
+    }
+    view_ = slice_compute_<T>(param.X,
+                              param.Out,
+                              param.axes,
+                              param.starts,
+                              param.ends,
+                              param.decrease_axis,
+                              param.StartsTensor,
+                              param.EndsTensor,
+                              param.StartsTensorList,
+                              param.EndsTensorList,
+                              param.infer_flags,
+                              param.inplace);
   }
 
   virtual ~SliceCompute() = default;
+
+ private:
+  // Whether the output was left as a view of the input.
+  bool view_{false};
 };
 
 }  // namespace x86
@@ -0,0 +1,105 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/slice_compute.h"
+#include <gtest/gtest.h>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+static void fill(lite::Tensor* x, float base) {
+  auto* data = x->mutable_data<float>();
+  for (int64_t i = 0; i < x->numel(); ++i) {
+    data[i] = base + i;
+  }
+}
+
+static void run_slice(SliceCompute<float>* slice,
+                      operators::SliceParam* param,
+                      const DDim& out_dims,
+                      const std::vector<int>& axes,
+                      const std::vector<int>& starts,
+                      const std::vector<int>& ends,
+                      const std::vector<int>& decrease_axis) {
+  param->Out->Resize(out_dims);
+  param->axes = axes;
+  param->starts = starts;
+  param->ends = ends;
+  param->decrease_axis = decrease_axis;
+  param->infer_flags = std::vector<int>(axes.size(), 1);
+  slice->SetParam(*param);
+  slice->Run();
+}
+
+TEST(slice_x86, inplace) {
+  lite::Tensor x, out;
+  x.Resize({3, 4, 5});
+  fill(&x, 0.f);
+  const float* x_data = x.data<float>();
+
+  SliceCompute<float> slice;
+  operators::SliceParam param;
+  param.X = &x;
+  param.Out = &out;
+  param.inplace = true;
+
+  // x[1, 1:3, :] is one contiguous piece of the input.
+  run_slice(&slice, &param, DDim({1, 2, 5}), {0, 1}, {1, 1}, {2, 3}, {});
+  EXPECT_EQ(out.data<float>(), x_data + 25);
+  EXPECT_EQ(out.dims(), DDim({1, 2, 5}));
+
+  // So is x[2], with the sliced axis dropped.
+  run_slice(&slice, &param, DDim({4, 5}), {0}, {2}, {3}, {0});
+  EXPECT_EQ(out.data<float>(), x_data + 40);
+  EXPECT_EQ(out.dims(), DDim({4, 5}));
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_EQ(out.data<float>()[i], 40.f + i);
+  }
+
+  // The output growing past its piece moves out, the input is left alone.
+  out.Resize({2, 4, 5});
+  fill(&out, 100.f);
+  EXPECT_NE(out.data<float>(), x_data + 40);
+  EXPECT_EQ(x.data<float>(), x_data);
+  for (int i = 0; i < 60; ++i) {
+    EXPECT_EQ(x_data[i], static_cast<float>(i));
+  }
+
+  // x[:, 1:3, :] is not contiguous: the output gets memory of its own
+  // before it is written.
+  run_slice(&slice, &param, DDim({1, 2, 5}), {0, 1}, {1, 1}, {2, 3}, {});
+  EXPECT_EQ(out.data<float>(), x_data + 25);
+  run_slice(&slice, &param, DDim({3, 2, 5}), {1}, {1}, {3}, {});
+  const float* out_data = out.data<float>();
+  EXPECT_TRUE(out_data + 30 <= x_data || out_data >= x_data + 60);
+  for (int n = 0; n < 3; ++n) {
+    for (int i = 0; i < 10; ++i) {
+      EXPECT_EQ(out_data[n * 10 + i], n * 20.f + 5 + i);
+    }
+  }
+  for (int i = 0; i < 60; ++i) {
+    EXPECT_EQ(x_data[i], static_cast<float>(i));
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(slice, kX86, kFloat, kNCHW, def);
@@ -29,22 +29,6 @@ static inline int CanonicalAxis(const int axis, const int rank) {
   return axis;
 }
 
-static inline int SizeToAxis(const int axis, const DDim& dims) {
-  int size = 1;
-  for (int i = 0; i < axis; i++) {
-    size *= dims[i];
-  }
-  return size;
-}
-
-static inline int SizeFromAxis(const int axis, const DDim& dims) {
-  int size = 1;
-  for (size_t i = axis; i < dims.size(); i++) {
-    size *= dims[i];
-  }
-  return size;
-}
-
 template <typename T>
 class SoftmaxCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
@@ -52,39 +36,32 @@ class SoftmaxCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
 
   void Run() override {
     auto& param = *param_.get_mutable<operators::SoftmaxParam>();
-    auto& context = ctx_->As<X86Context>();
     CHECK(param.output);
     CHECK(param.x);
 
-    auto* x = param.x;
-    auto* output = param.output;
-    output->template mutable_data<T>();
-
-    const int rank = x->dims().size();
+    const auto& x_dims = param.x->dims();
+    const int rank = x_dims.size();
     const int axis = CanonicalAxis(param.axis, rank);
-    int axis_dim = x->dims()[axis];
-    if (rank == 2 && axis == 1) {
-      lite::x86::math::SoftmaxFunctor<lite::TargetType::kX86, T, true>()(
-          context, axis_dim, x, output);
-    } else {
-      const int n = SizeToAxis(axis, x->dims());
-      const int d = SizeFromAxis(axis, x->dims());
-
-      DDim x_dims = x->dims();
-      DDim out_dims = output->dims();
-
-      DDim shape_2d(std::vector<DDim::value_type>{n, d});
-      x->Resize(shape_2d);
-      output->Resize(shape_2d);
-
-      lite::x86::math::SoftmaxFunctor<lite::TargetType::kX86, T, true>()(
-          context, axis_dim, x, output);
-      x->Resize(x_dims);
-      output->Resize(out_dims);
-    }
+    lite::x86::math::softmax(param.x->template data<T>(),
+                             param.output->template mutable_data<T>(),
+                             x_dims.count(0, axis),
+                             x_dims[axis],
+                             x_dims.count(axis + 1, rank),
+                             log_);
   }
 
   virtual ~SoftmaxCompute() = default;
+
+ protected:
+  bool log_{false};
+};
+
+// log_softmax shares the softmax param and its kernel, writing
+// x - max - log(sum(exp(x - max))) instead.
+template <typename T>
+class LogSoftmaxCompute : public SoftmaxCompute<T> {
+ public:
+  LogSoftmaxCompute() { this->log_ = true; }
 };
 
 }  // namespace x86
@@ -14,6 +14,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -76,9 +79,139 @@ TEST(softmax_x86, run_test) {
   }
 }
 
+// Softmax of [outer, axis_dim, inner] along the middle axis, or log_softmax.
+static void softmax_ref(const float* x,
+                        float* out,
+                        int64_t outer,
+                        int64_t axis_dim,
+                        int64_t inner,
+                        bool log) {
+  for (int64_t o = 0; o < outer; ++o) {
+    for (int64_t i = 0; i < inner; ++i) {
+      const float* src = x + o * axis_dim * inner + i;
+      float* dst = out + o * axis_dim * inner + i;
+      float max = std::numeric_limits<float>::lowest();
+      for (int64_t k = 0; k < axis_dim; ++k) {
+        max = std::max(max, src[k * inner]);
+      }
+      float sum = 0.f;
+      for (int64_t k = 0; k < axis_dim; ++k) {
+        sum += std::exp(src[k * inner] - max);
+      }
+      for (int64_t k = 0; k < axis_dim; ++k) {
+        dst[k * inner] = log ? src[k * inner] - max - std::log(sum)
+                             : std::exp(src[k * inner] - max) / sum;
+      }
+    }
+  }
+}
+
+template <typename Kernel>
+static void check_axes(bool log) {
+  for (auto x_dims : std::vector<std::vector<int64_t>>{
+           {2, 3, 4, 5}, {4, 37, 70}, {1, 130, 19}, {3, 1000}, {2, 0, 5}}) {
+    lite::Tensor x, out;
+    x.Resize(DDim(x_dims));
+    auto* x_data = x.mutable_data<float>();
+    for (int64_t i = 0; i < x.numel(); ++i) {
+      x_data[i] = static_cast<float>((i * 37) % 101) / 10.f - 5.f;
+    }
+    std::vector<float> ref(x.numel());
+    int rank = x_dims.size();
+    for (int axis = -1; axis < rank; ++axis) {
+      int a = axis < 0 ? axis + rank : axis;
+      out.Resize(DDim(x_dims));
+      Kernel softmax;
+      std::unique_ptr<KernelContext> ctx(new KernelContext);
+      ctx->As<X86Context>();
+      softmax.SetContext(std::move(ctx));
+      operators::SoftmaxParam param;
+      param.x = &x;
+      param.output = &out;
+      param.axis = axis;
+      softmax.SetParam(param);
+      softmax.Run();
+
+      softmax_ref(x_data,
+                  ref.data(),
+                  x.dims().count(0, a),
+                  x_dims[a],
+                  x.dims().count(a + 1, rank),
+                  log);
+      const float* out_data = out.data<float>();
+      for (int64_t i = 0; i < x.numel(); ++i) {
+        ASSERT_NEAR(out_data[i], ref[i], 1e-5) << "axis " << axis;
+      }
+
+      // In place.
+      lite::Tensor y;
+      y.CopyDataFrom(x);
+      param.x = &y;
+      param.output = &y;
+      softmax.SetParam(param);
+      softmax.Run();
+      const float* y_data = y.data<float>();
+      for (int64_t i = 0; i < x.numel(); ++i) {
+        ASSERT_NEAR(y_data[i], ref[i], 1e-5) << "in place, axis " << axis;
+      }
+    }
+  }
+}
+
+TEST(softmax_x86, axes) { check_axes<SoftmaxCompute<float>>(false); }
+
+TEST(log_softmax_x86, axes) { check_axes<LogSoftmaxCompute<float>>(true); }
+
+TEST(softmax_x86, attention) {
+  const int64_t batch = 2, heads = 3, rows = 5, cols = 11;
+  std::vector<float> x(batch * heads * rows * cols);
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i] = static_cast<float>((i * 13) % 29) / 7.f;
+  }
+  // The last two columns of the second batch are padding.
+  std::vector<float> mask(batch * cols, 0.f);
+  mask[2 * cols - 1] = mask[2 * cols - 2] = -1e9f;
+  std::vector<float> out(x.size());
+  std::vector<float> ref(cols);
+  for (bool causal : {false, true}) {
+    lite::x86::math::attention_softmax(x.data(),
+                                       mask.data(),
+                                       out.data(),
+                                       batch,
+                                       heads,
+                                       rows,
+                                       cols,
+                                       causal);
+    for (int64_t i = 0; i < batch * heads * rows; ++i) {
+      int64_t b = i / (heads * rows);
+      int64_t valid = causal ? i % rows + cols - rows + 1 : cols;
+      if (b == 1) {
+        valid = std::min<int64_t>(valid, cols - 2);
+      }
+      softmax_ref(&x[i * cols], ref.data(), 1, valid, 1, false);
+      for (int64_t j = 0; j < cols; ++j) {
+        float expected = j < valid ? ref[j] : 0.f;
+        ASSERT_NEAR(out[i * cols + j], expected, 1e-5) << i << " " << j;
+      }
+    }
+
+    // In place.
+    std::vector<float> y(x);
+    lite::x86::math::attention_softmax(
+        y.data(), mask.data(), y.data(), batch, heads, rows, cols, causal);
+    for (size_t i = 0; i < y.size(); ++i) {
+      ASSERT_NEAR(y[i], out[i], 1e-6) << "in place " << i;
+    }
+  }
+  // Empty scores.
+  lite::x86::math::attention_softmax(
+      x.data(), mask.data(), out.data(), batch, heads, rows, 0, true);
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
 }  // namespace paddle
 
 USE_LITE_KERNEL(softmax, kX86, kFloat, kNCHW, def);
+USE_LITE_KERNEL(log_softmax, kX86, kFloat, kNCHW, def);
@@ -74,6 +74,76 @@ TEST(transpose_x86, run_test) {
   }
 }
 
+static void transpose_ref(const lite::Tensor& x,
+                          const std::vector<int>& axis,
+                          lite::Tensor* out) {
+  auto x_dims = x.dims();
+  int rank = axis.size();
+  std::vector<int64_t> out_shape(rank);
+  std::vector<int64_t> x_strides(rank, 1);
+  for (int i = 0; i < rank; ++i) out_shape[i] = x_dims[axis[i]];
+  for (int i = rank - 2; i >= 0; --i) {
+    x_strides[i] = x_strides[i + 1] * x_dims[i + 1];
+  }
+  out->Resize(lite::DDim(out_shape));
+  auto* x_data = x.data<float>();
+  auto* out_data = out->mutable_data<float>();
+  std::vector<int64_t> idx(rank, 0);
+  for (int64_t j = 0; j < out->numel(); ++j) {
+    int64_t offset = 0;
+    for (int i = 0; i < rank; ++i) offset += idx[i] * x_strides[axis[i]];
+    out_data[j] = x_data[offset];
+    for (int i = rank - 1; i >= 0 && ++idx[i] == out_shape[i]; --i) {
+      idx[i] = 0;
+    }
+  }
+}
+
+TEST(transpose_x86, compare_ref) {
+  // Shapes with unit axes, merged axes, tiles with tails and batches.
+  std::vector<std::pair<std::vector<int64_t>, std::vector<int>>> cases{
+      {{67, 131}, {1, 0}},
+      {{2, 3, 17, 9}, {0, 2, 3, 1}},
+      {{2, 19, 9, 33}, {0, 3, 1, 2}},
+      {{3, 24, 13, 15}, {0, 2, 1, 3}},
+      {{4, 1, 70, 1, 66}, {4, 1, 3, 0, 2}},
+      {{2, 3, 4, 5, 6, 7}, {5, 3, 1, 4, 2, 0}},
+      {{1, 8, 1, 16}, {2, 0, 1, 3}},
+      // Empty tensors.
+      {{2, 3, 0}, {1, 0, 2}},
+      {{0, 5, 7}, {2, 1, 0}},
+  };
+  for (auto& c : cases) {
+    lite::Tensor x;
+    lite::Tensor out;
+    lite::Tensor out_ref;
+    x.Resize(lite::DDim(c.first));
+    auto* x_data = x.mutable_data<float>();
+    for (int64_t i = 0; i < x.numel(); ++i) {
+      x_data[i] = static_cast<float>(i);
+    }
+    transpose_ref(x, c.second, &out_ref);
+    out.Resize(out_ref.dims());
+
+    TransposeCompute<float> transpose;
+    operators::TransposeParam param;
+    param.x = &x;
+    param.output = &out;
+    param.axis = c.second;
+    std::unique_ptr<KernelContext> ctx(new KernelContext);
+    ctx->As<X86Context>();
+    transpose.SetContext(std::move(ctx));
+    transpose.SetParam(param);
+    transpose.Run();
+
+    auto* out_data = out.data<float>();
+    auto* ref_data = out_ref.data<float>();
+    for (int64_t i = 0; i < out.numel(); ++i) {
+      ASSERT_EQ(out_data[i], ref_data[i]) << "at " << i;
+    }
+  }
+}
+
 // transpose2
 TEST(transpose2_x86, retrive_op) {
   auto transpose2 = KernelRegistry::Global().Create("transpose2");
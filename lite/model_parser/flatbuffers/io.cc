@@ -121,21 +121,44 @@ void ParamDeserializer::ForwardRead(lite::Scope* scope) {
   ReadBytesToBuffer(header_size);
   char const* data = static_cast<char const*>(buf_->data());
   uint16_t params_size = *reinterpret_cast<uint16_t const*>(data);
-  uint32_t max_tensor_size =
-      *reinterpret_cast<uint32_t const*>(data + sizeof(uint16_t));
 
-  buf_->ResetLazy(max_tensor_size);
+  // Each param is read into a buffer of its own, which then becomes the
+  // storage of the tensor. The peak memory stays at the size of the params,
+  // without a staging copy of the largest tensor.
   for (size_t i = 0; i < params_size; ++i) {
     uint32_t total_size = reader_->Read<uint32_t>();
     uint32_t offset = reader_->Read<uint32_t>();
     uint32_t param_bytes = total_size - offset;
     ReadBytesToBuffer(offset - sizeof(offset));
-    ReadBytesToBuffer(param_bytes);
-    fbs::ParamDescView param(buf_.get());
-    FillTensor(scope->Var(param.Name())->GetMutable<lite::Tensor>(), param);
+    model_parser::Buffer param_buf(param_bytes);
+    reader_->Read(param_buf.data(), param_bytes);
+    FillTensorInPlace(&param_buf, scope);
   }
 }
 
+void ParamDeserializer::FillTensorInPlace(model_parser::Buffer* buf,
+                                          lite::Scope* scope) {
+  fbs::ParamDescView param(buf);
+  auto* tensor = scope->Var(param.Name())->GetMutable<lite::Tensor>();
+  CHECK(tensor);
+  if (tensor->offset() != 0 || tensor->memory_size() > buf->capacity()) {
+    // A view of another tensor, or holding more than the param needs, keep
+    // its buffer and copy into it.
+    FillTensor(tensor, param);
+    return;
+  }
+  const size_t byte_size = param.byte_size();
+  tensor->Resize(param.Dim());
+  tensor->set_precision(lite::ConvertPrecisionType(param.GetDataType()));
+  // Move the data to the head of the buffer, which is aligned by the
+  // allocator, the descriptor before it is not used any more.
+  CHECK(param.GetData());
+  std::memmove(buf->data(), param.GetData(), byte_size);
+  std::shared_ptr<lite::Buffer> storage(buf->Release());
+  tensor->ResetBuffer(storage, byte_size);
+  tensor->set_persistable(true);
+}
+
 void ParamDeserializer::ReadHeader() {
   // 1. version id
   uint16_t version = reader_->Read<uint16_t>();
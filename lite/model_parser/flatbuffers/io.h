@@ -70,6 +70,8 @@ class ParamDeserializer {
     reader_->Read(buf_->data(), size);
   }
   void ReadHeader();
+  // Set the tensor of the param in buf, taking over buf as its storage.
+  void FillTensorInPlace(model_parser::Buffer* buf, lite::Scope* scope);
   model_parser::ByteReader* reader_{nullptr};
   std::unique_ptr<model_parser::Buffer> buf_;
 };
@@ -128,6 +128,17 @@ TEST(CombinedParamsDesc, Scope) {
     deserializer.ForwardRead(&scope_3);
     check_params(scope_3);
   }
+
+  {
+    Scope scope_4;
+    LOG(INFO) << "Load params into tensors holding memory...";
+    set_tensor<float>(scope_4.Var(param_names[0])->GetMutable<Tensor>(),
+                      std::vector<int64_t>({64, 64}));
+    model_parser::BinaryFileReader reader(path);
+    fbs::ParamDeserializer deserializer(&reader);
+    deserializer.ForwardRead(&scope_4);
+    check_params(scope_4);
+  }
 }
 #endif  // LITE_WITH_FLATBUFFERS_DESC
 
@@ -217,15 +217,12 @@ void LoadNonCombinedParamsPb(const std::string &model_dir,
   OPT_LOG << log_info;
 }
 
-void LoadModelPb(const std::string &model_dir,
-                 const std::string &model_file,
-                 const std::string &param_file,
-                 Scope *scope,
-                 cpp::ProgramDesc *cpp_prog,
-                 bool combined,
-                 const lite_api::CxxModelBuffer &model_buffer) {
+void LoadProgramPb(const std::string &model_dir,
+                   const std::string &model_file,
+                   cpp::ProgramDesc *cpp_prog,
+                   bool combined,
+                   const lite_api::CxxModelBuffer &model_buffer) {
   CHECK(cpp_prog) << "The input cpp program pointer var is nullptr.";
-  CHECK(scope) << "The input scope var is nullptr.";
   cpp_prog->ClearBlocks();
 
   // Load model topology data from file.
@@ -240,6 +237,17 @@ void LoadModelPb(const std::string &model_dir,
   // Transform to cpp::ProgramDesc
   TransformProgramDescAnyToCpp(pb_prog, cpp_prog);
   general::ssa::ConvertToSSA(cpp_prog);
+}
+
+void LoadModelPb(const std::string &model_dir,
+                 const std::string &model_file,
+                 const std::string &param_file,
+                 Scope *scope,
+                 cpp::ProgramDesc *cpp_prog,
+                 bool combined,
+                 const lite_api::CxxModelBuffer &model_buffer) {
+  CHECK(scope) << "The input scope var is nullptr.";
+  LoadProgramPb(model_dir, model_file, cpp_prog, combined, model_buffer);
 
   // Load params data from file.
   // NOTE: Only main block be used now.
@@ -59,6 +59,14 @@ void LoadCombinedParamsPb(
     const cpp::ProgramDesc& prog,
     const lite_api::CxxModelBuffer& model_buffer = lite_api::CxxModelBuffer());
 
+// Read only the topology of a model in pb format, as LoadModelPb does.
+void LoadProgramPb(
+    const std::string& model_dir,
+    const std::string& model_file,
+    cpp::ProgramDesc* prog,
+    bool combined = false,
+    const lite_api::CxxModelBuffer& model_buffer = lite_api::CxxModelBuffer());
+
 // Read a model and files of parameters in pb format.
 void LoadModelPb(
     const std::string& model_dir,
@@ -89,6 +89,9 @@ bool ConcatOpLite::AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) {
       }
     }
   }
+  if (op_desc.HasAttr("inplace")) {
+    param_.inplace = op_desc.GetAttr<bool>("inplace");
+  }
   return true;
 }
 
@@ -107,6 +107,9 @@ bool FcOpLite::AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) {
   } else {
     param_.padding_weights = false;
   }
+  if (op_desc.HasAttr("weight_bf16")) {
+    param_.weight_bf16 = op_desc.GetAttr<bool>("weight_bf16");
+  }
 
   if (param_.activation_type == "prelu") {
     param_.Prelu_mode = op_desc.GetAttr<std::string>("prelu_mode");
@@ -0,0 +1,122 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fusion_elementwise_chain_op.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+// The attributes of each op are packed into `op_attrs`, three per op:
+//   scale:      scale, bias, bias_after_scale
+//   leaky_relu: alpha
+//   relu6:      threshold
+//   swish:      beta
+//   hard_swish: threshold, scale, offset
+// Unused slots are zero.
+
+namespace {
+
+bool IsElementwise(const std::string& op_type) {
+  return op_type.compare(0, 12, "elementwise_") == 0;
+}
+
+// Output dims of an elementwise op, following ElementwiseOp::InferShapeImpl.
+DDim BroadcastDims(const DDim& x_dim, const DDim& y_dim, int axis) {
+  if (x_dim == y_dim) return x_dim;
+  const DDim& big = x_dim.size() >= y_dim.size() ? x_dim : y_dim;
+  const DDim& small = x_dim.size() >= y_dim.size() ? y_dim : x_dim;
+  size_t max_dim = big.size();
+  axis = (axis == -1 ? static_cast<int>(big.size() - small.size()) : axis);
+  std::vector<int64_t> small_dims(max_dim, 1);
+  for (size_t i = 0; i < small.size(); ++i) {
+    small_dims[i + axis] = small[i];
+  }
+  std::vector<int64_t> out_dims(max_dim);
+  for (size_t i = 0; i < max_dim; i++) {
+    if (big[i] == -1 || small_dims[i] == -1) {
+      out_dims[i] = -1;
+    } else {
+      out_dims[i] = (std::max)(big[i], small_dims[i]);
+    }
+  }
+  return DDim(out_dims);
+}
+
+}  // namespace
+
+bool FusionElementwiseChainOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.X);
+  CHECK_OR_FALSE(param_.Out);
+  CHECK_OR_FALSE(!param_.op_types.empty());
+  size_t num_ops = param_.op_types.size();
+  CHECK_EQ_OR_FALSE(param_.axes.size(), num_ops);
+  CHECK_EQ_OR_FALSE(param_.chain_is_x.size(), num_ops);
+  CHECK_EQ_OR_FALSE(param_.op_attrs.size(), 3 * num_ops);
+  size_t num_binary = std::count_if(
+      param_.op_types.begin(), param_.op_types.end(), IsElementwise);
+  CHECK_EQ_OR_FALSE(param_.Y.size(), num_binary);
+  return true;
+}
+
+bool FusionElementwiseChainOp::InferShapeImpl() const {
+  DDim dims = param_.X->dims();
+  size_t y_idx = 0;
+  param_.stage_dims.clear();
+  for (size_t i = 0; i < param_.op_types.size(); ++i) {
+    if (IsElementwise(param_.op_types[i])) {
+      auto y_dims = param_.Y[y_idx++]->dims();
+      dims = param_.chain_is_x[i]
+                 ? BroadcastDims(dims, y_dims, param_.axes[i])
+                 : BroadcastDims(y_dims, dims, param_.axes[i]);
+    }
+    param_.stage_dims.push_back(dims);
+  }
+  param_.Out->Resize(dims);
+  param_.Out->set_lod(param_.X->lod());
+  return true;
+}
+
+bool FusionElementwiseChainOp::AttachImpl(const cpp::OpDesc& opdesc,
+                                          lite::Scope* scope) {
+  AttachParam(&param_);
+  auto X_name = opdesc.Input("X").front();
+  auto Out_name = opdesc.Output("Out").front();
+
+  param_.X = GetVar<lite::Tensor>(scope, X_name);
+  param_.Y.clear();
+  if (opdesc.HasInput("Y")) {
+    for (auto& name : opdesc.Input("Y")) {
+      param_.Y.push_back(GetVar<lite::Tensor>(scope, name));
+    }
+  }
+  param_.Out = GetMutableVar<lite::Tensor>(scope, Out_name);
+  param_.op_types = opdesc.GetAttr<std::vector<std::string>>("op_types");
+  param_.axes = opdesc.GetAttr<std::vector<int>>("axes");
+  param_.chain_is_x = opdesc.GetAttr<std::vector<int>>("chain_is_x");
+  param_.op_attrs = opdesc.GetAttr<std::vector<float>>("op_attrs");
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_elementwise_chain,
+                 paddle::lite::operators::FusionElementwiseChainOp);
@@ -0,0 +1,61 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <string>
+#include "lite/core/op_lite.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+// Runs a linear chain of elementwise, scale and activation ops, produced by
+// lite_elementwise_chain_fuse_pass, as a single op.
+class FusionElementwiseChainOp : public OpLite {
+ public:
+  explicit FusionElementwiseChainOp(const std::string& type) : OpLite(type) {}
+
+  bool CheckShape() const override;
+
+  bool InferShapeImpl() const override;
+
+  bool AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) override;
+
+  void AttachKernel(KernelBase* kernel) override { kernel->SetParam(param_); }
+
+  std::string DebugString() const override {
+    return "fusion_elementwise_chain_op";
+  }
+
+#ifdef LITE_WITH_PROFILE
+  void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter* ch) {
+    ch->input_shape = ch->DimToStr(param_.X->dims());
+    ch->output_shape = ch->DimToStr(param_.Out->dims());
+    std::string remark;
+    for (auto& type : param_.op_types) {
+      remark += (remark.empty() ? "" : "+") + type;
+    }
+    ch->remark = remark;
+    ch->macs = 1.0f * param_.Out->numel() * param_.op_types.size();
+  }
+#endif
+
+ private:
+  mutable operators::FusionElementwiseChainParam param_;
+};
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
@@ -69,6 +69,9 @@ bool LookupTableOpLite::AttachImpl(const cpp::OpDesc& op_desc,
   if (op_desc.HasAttr("entry")) {
     param_.entry = op_desc.GetAttr<std::string>("entry");
   }
+  if (op_desc.HasAttr("weight_bf16")) {
+    param_.weight_bf16 = op_desc.GetAttr<bool>("weight_bf16");
+  }
 
   return true;
 }
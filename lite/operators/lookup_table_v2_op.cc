@@ -57,6 +57,9 @@ bool LookupTableV2OpLite::AttachImpl(const cpp::OpDesc &op_desc,
   param_.Out = scope->FindMutableTensor(out);
 
   param_.padding_idx = op_desc.GetAttr<int64_t>("padding_idx");
+  if (op_desc.HasAttr("weight_bf16")) {
+    param_.weight_bf16 = op_desc.GetAttr<bool>("weight_bf16");
+  }
 
   return true;
 }
@@ -58,6 +58,9 @@ class MulOpLite : public OpLite {
     param_.output = var->GetMutable<Tensor>();
     param_.x_num_col_dims = op_desc.GetAttr<int>("x_num_col_dims");
     param_.y_num_col_dims = op_desc.GetAttr<int>("y_num_col_dims");
+    if (op_desc.HasAttr("weight_bf16")) {
+      param_.weight_bf16 = op_desc.GetAttr<bool>("weight_bf16");
+    }
     return true;
   }
 
@@ -129,6 +129,8 @@ struct FcParam : ParamBase {
   int in_num_col_dims{1};
   std::string activation_type{""};
   bool padding_weights{false};
+  // w holds bfloat16 bits, set by x86_bf16_weight_pass
+  bool weight_bf16{false};
   std::string Prelu_mode{
       "channel"};  // prelu param, can be "all", "channel" or "element"
   // for int8
@@ -184,6 +186,8 @@ struct MulParam : ParamBase {
 
   int x_num_col_dims{1};
   int y_num_col_dims{1};
+  // y holds bfloat16 bits, set by x86_bf16_weight_pass
+  bool weight_bf16{false};
   // for int8
   WITH_INT8_CONFIG
   ///////////////////////////////////////////////////////////////////////////////////
@@ -379,6 +383,7 @@ struct ConcatParam : ParamBase {
   lite::Tensor* output{};
   int axis{0};
   lite::Tensor* axis_tensor{};
+  bool inplace{false};
   // get a vector of input tensors
   const std::vector<const Tensor*>* input_tensor_ptrs() override {
     if (!input_tensor_ptrs_cache_) {
@@ -665,6 +670,7 @@ struct SplitParam : ParamBase {
   int axis{-1};
   int num{0};
   std::vector<int> sections;
+  bool inplace{false};
   ///////////////////////////////////////////////////////////////////////////////////
   // get a vector of input tensors
   const std::vector<const Tensor*>* input_tensor_ptrs() override {
@@ -790,6 +796,23 @@ struct FusionElementwiseActivationGradParam : public ElementwiseGradParam {
   std::string act_type;
 };
 
+// A chain of elementwise, scale and activation ops fused into one kernel.
+// Each op takes the result of the previous one, binary ops take their other
+// operand from Y in order.
+struct FusionElementwiseChainParam : ParamBase {
+  const lite::Tensor* X{};
+  std::vector<const lite::Tensor*> Y;
+  lite::Tensor* Out{};
+  std::vector<std::string> op_types;
+  // Per op: the elementwise axis, whether the chain value is the X operand,
+  // and three float attributes (see fusion_elementwise_chain_op.cc).
+  std::vector<int> axes;
+  std::vector<int> chain_is_x;
+  std::vector<float> op_attrs;
+  // Dims of the chain value after each op, set by InferShape.
+  std::vector<DDim> stage_dims;
+};
+
 /// ----------------------- mean operators ----------------------
 struct MeanParam : ParamBase {
   const lite::Tensor* X{};
@@ -1197,6 +1220,8 @@ struct LookupTableParam : ParamBase {
   bool is_test{true};
   std::string entry_config{""};  // used in distributed training
   std::string entry{"none"};
+  // W holds bfloat16 bits, set by x86_bf16_weight_pass
+  bool weight_bf16{false};
 };
 
 struct LookupTableDequantParam : ParamBase {
@@ -1502,6 +1527,7 @@ struct SliceParam : ParamBase {
   std::vector<lite::Tensor*> EndsTensorList{};
   const lite::Tensor* StartsTensor{nullptr};
   const lite::Tensor* EndsTensor{nullptr};
+  bool inplace{false};
   ///////////////////////////////////////////////////////////////////////////////////
   // get a vector of input tensors
   const std::vector<const Tensor*>* input_tensor_ptrs() override {
@@ -104,6 +104,9 @@ bool SplitOp::AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) {
   for (auto name : outs_name) {
     param_.output.push_back(scope->FindMutableTensor(name));
   }
+  if (opdesc.HasAttr("inplace")) {
+    param_.inplace = opdesc.GetAttr<bool>("inplace");
+  }
   return true;
 }
 
@@ -0,0 +1,200 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Throughput of the x86 elementwise and activation kernels across tensor
+// sizes and broadcast patterns. The thread count follows OMP_NUM_THREADS.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "lite/backends/x86/math/activation.h"
+#include "lite/backends/x86/math/elementwise.h"
+
+namespace x86_math = paddle::lite::x86::math;
+
+static void elementwise_args(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N"});
+  int N = 15;
+  int N_Max = 16 * 1024 * 1024;
+  for (int i = N; i < N_Max; i *= 16) {
+    b->Arg(i);
+  }
+}
+
+// Feature-map shaped broadcasts, from a 1x1 bias to a per-row scale.
+static void fast_bcast_args(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"batch", "channel", "num", "inv"});
+  for (auto batch : {1, 16}) {
+    for (auto channel : {1, 64, 512}) {
+      for (auto num : {1, 49, 3136}) {
+        for (auto inv : {0, 1}) {
+          b->Args({batch, channel, num, inv});
+        }
+      }
+    }
+  }
+}
+
+static std::vector<float> random_data(int n) {
+  std::vector<float> data(n);
+  for (auto& v : data) {
+    v = static_cast<float>(std::rand()) / RAND_MAX * 8.f - 4.f;
+  }
+  return data;
+}
+
+template <void elementwise_op(const float* dinx,
+                              const float* diny,
+                              float* dout,
+                              int num,
+                              bool has_active,
+                              std::string act_type)>
+void do_element_perf(const benchmark::State& state_in,
+                     std::string act_type) {
+  // google benchmark only accepts a `benchmark::State &` here
+  benchmark::State& state = const_cast<benchmark::State&>(state_in);
+  int N = state.range(0);
+  auto x = random_data(N);
+  auto y = random_data(N);
+  std::vector<float> z(N);
+
+  for (auto _ : state) {
+    elementwise_op(x.data(), y.data(), z.data(), N, false, act_type);
+  }
+
+  state.counters["OPS"] = benchmark::Counter(
+      uint64_t(state.iterations()) * N, benchmark::Counter::kIsRate);
+}
+
+template <void broadcast_op(const float* dinx,
+                            const float* diny,
+                            float* dout,
+                            int batch,
+                            int channels,
+                            int num,
+                            bool has_active,
+                            std::string act_type,
+                            bool inv)>
+void do_broadcast_perf(const benchmark::State& state_in,
+                       std::string act_type) {
+  benchmark::State& state = const_cast<benchmark::State&>(state_in);
+  int batch = state.range(0);
+  int channel = state.range(1);
+  int num = state.range(2);
+  bool inv = state.range(3) != 0;
+  auto big = random_data(batch * channel * num);
+  auto small = random_data(channel);
+  std::vector<float> z(batch * channel * num);
+  const float* x = inv ? small.data() : big.data();
+  const float* y = inv ? big.data() : small.data();
+
+  for (auto _ : state) {
+    broadcast_op(x, y, z.data(), batch, channel, num, false, act_type, inv);
+  }
+
+  state.counters["OPS"] =
+      benchmark::Counter(uint64_t(state.iterations()) * batch * channel * num,
+                         benchmark::Counter::kIsRate);
+}
+
+template <class Act>
+void do_activation_perf(const benchmark::State& state_in,
+                        int64_t grain,
+                        Act act) {
+  benchmark::State& state = const_cast<benchmark::State&>(state_in);
+  int N = state.range(0);
+  auto x = random_data(N);
+  std::vector<float> y(N);
+
+  for (auto _ : state) {
+    x86_math::ParallelActivate(x.data(), y.data(), N, grain, act);
+  }
+
+  state.counters["OPS"] = benchmark::Counter(
+      uint64_t(state.iterations()) * N, benchmark::Counter::kIsRate);
+}
+
+#define BENCHMARK_ELEMENTWISE(op, act_type)                                 \
+  static constexpr auto op##_##act_type =                                   \
+      do_element_perf<x86_math::Elementwise_##op<float>>;                   \
+  BENCHMARK_CAPTURE(op##_##act_type, normal, std::string(#act_type))        \
+      ->Apply(elementwise_args)                                             \
+      ->UseRealTime();
+
+#define BENCHMARK_ELEMENTWISE_FAST_BCAST(op, act_type)                      \
+  static constexpr auto op##_##act_type##_bcast =                           \
+      do_broadcast_perf<x86_math::Elementwise_Broadcast_##op<float>>;       \
+  BENCHMARK_CAPTURE(                                                        \
+      op##_##act_type##_bcast, fast_broadcast, std::string(#act_type))      \
+      ->Apply(fast_bcast_args)                                              \
+      ->UseRealTime();
+
+BENCHMARK_ELEMENTWISE(Add, none);
+BENCHMARK_ELEMENTWISE(Mul, none);
+BENCHMARK_ELEMENTWISE(Add, relu);
+BENCHMARK_ELEMENTWISE(Add, sigmoid);
+
+BENCHMARK_ELEMENTWISE_FAST_BCAST(Add, none);
+BENCHMARK_ELEMENTWISE_FAST_BCAST(Mul, none);
+BENCHMARK_ELEMENTWISE_FAST_BCAST(Add, relu);
+
+static void relu(const float* x, float* y, int n) {
+  x86_math::vrelu(x, y, n);
+}
+static void sigmoid(const float* x, float* y, int n) {
+  x86_math::vsigmoid(x, y, n);
+}
+static void tanh_act(const float* x, float* y, int n) {
+  x86_math::vtanh(x, y, n);
+}
+static void gelu(const float* x, float* y, int n) { x86_math::gelu(x, y, n); }
+static void mish(const float* x, float* y, int n) {
+  x86_math::mish(x, y, n, 20.f);
+}
+static void swish(const float* x, float* y, int n) {
+  x86_math::swish(x, y, n, 1.f);
+}
+static void hard_swish(const float* x, float* y, int n) {
+  x86_math::hard_swish(x, y, n, 6.f, 6.f, 3.f);
+}
+
+BENCHMARK_CAPTURE(do_activation_perf, relu, x86_math::kActGrainLight, relu)
+    ->Apply(elementwise_args)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(
+    do_activation_perf, sigmoid, x86_math::kActGrainHeavy, sigmoid)
+    ->Apply(elementwise_args)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(do_activation_perf, tanh, x86_math::kActGrainHeavy, tanh_act)
+    ->Apply(elementwise_args)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(do_activation_perf, gelu, x86_math::kActGrainHeavy, gelu)
+    ->Apply(elementwise_args)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(do_activation_perf, mish, x86_math::kActGrainHeavy, mish)
+    ->Apply(elementwise_args)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(do_activation_perf, swish, x86_math::kActGrainHeavy, swish)
+    ->Apply(elementwise_args)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(
+    do_activation_perf, hard_swish, x86_math::kActGrainLight, hard_swish)
+    ->Apply(elementwise_args)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,271 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Runs every implementation of the x86 jit kernels that can serve a shape,
+// e.g. Refer, JitCode, AVX512 and the other more kernels, side by side.
+// Benchmarks are named <kernel>/<shape>/<impl>.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lite/backends/x86/jit/helper.h"
+#include "lite/backends/x86/jit/kernel_base.h"
+#include "lite/backends/x86/jit/kernels.h"
+
+namespace jit = paddle::lite::jit;
+using CPUPlace = paddle::lite::fluid::CPUPlace;
+
+using Buffer = std::shared_ptr<std::vector<float>>;
+
+static Buffer random_data(int64_t n, float lo = -2.f, float hi = 2.f) {
+  Buffer data(new std::vector<float>(n));
+  for (auto& v : *data) {
+    v = lo + static_cast<float>(std::rand()) / RAND_MAX * (hi - lo);
+  }
+  return data;
+}
+
+// Registers one benchmark per candidate of |KernelTuple| for |attr|.
+// |call| runs the kernel function once on buffers it owns.
+template <typename KernelTuple, typename Call>
+static void register_candidates(const std::string& name,
+                                const typename KernelTuple::attr_type& attr,
+                                int64_t items,
+                                Call call) {
+  auto funcs = jit::GetAllCandidateFuncsWithTypes<KernelTuple, CPUPlace>(attr);
+  for (auto& impl : funcs) {
+    auto func = impl.second;
+    benchmark::RegisterBenchmark(
+        (name + "/" + impl.first).c_str(),
+        [=](benchmark::State& state) {
+          for (auto _ : state) {
+            call(func);
+          }
+          state.counters["OPS"] = benchmark::Counter(
+              uint64_t(state.iterations()) * items,
+              benchmark::Counter::kIsRate);
+        })
+        ->UseRealTime();
+  }
+}
+
+template <typename KernelTuple>
+static void register_xyn(const std::string& name) {
+  for (int d : {64, 1024, 16384}) {
+    auto x = random_data(d);
+    auto y = random_data(d);
+    register_candidates<KernelTuple>(
+        name + "/" + std::to_string(d),
+        d,
+        d,
+        [=](typename KernelTuple::func_type func) {
+          func(x->data(), y->data(), d);
+        });
+  }
+}
+
+static void register_vbroadcast() {
+  for (int64_t w : {64, 512}) {
+    const int64_t h = 64;
+    auto x = random_data(w);
+    auto y = random_data(h * w);
+    register_candidates<jit::VBroadcastTuple<float>>(
+        "VBroadcast/" + std::to_string(w),
+        w,
+        h * w,
+        [=](jit::VBroadcastTuple<float>::func_type func) {
+          func(x->data(), y->data(), h, w);
+        });
+  }
+}
+
+static void register_matmul() {
+  const int shapes[][3] = {{1, 64, 64}, {8, 128, 128}, {32, 256, 256}};
+  for (auto& s : shapes) {
+    jit::matmul_attr_t attr(s[0], s[1], s[2]);
+    auto a = random_data(attr.m * attr.k);
+    auto b = random_data(attr.k * attr.n);
+    auto c = random_data(attr.m * attr.n);
+    register_candidates<jit::MatMulTuple<float>>(
+        "MatMul/" + std::to_string(s[0]) + "x" + std::to_string(s[1]) + "x" +
+            std::to_string(s[2]),
+        attr,
+        int64_t(attr.m) * attr.n * attr.k,
+        [=](jit::MatMulTuple<float>::func_type func) {
+          func(a->data(), b->data(), c->data(), &attr);
+        });
+  }
+}
+
+static void register_seqpool() {
+  for (int w : {64, 512}) {
+    jit::seq_pool_attr_t attr(w, jit::SeqPoolType::kSum);
+    attr.h = 32;
+    auto x = random_data(attr.h * w);
+    auto y = random_data(w);
+    register_candidates<jit::SeqPoolTuple<float>>(
+        "SeqPool/" + std::to_string(w),
+        attr,
+        attr.h * w,
+        [=](jit::SeqPoolTuple<float>::func_type func) {
+          func(x->data(), y->data(), &attr);
+        });
+  }
+}
+
+static void register_embseqpool() {
+  const int64_t table_height = 10000;
+  for (int64_t table_width : {64, 256}) {
+    const int64_t index_height = 32;
+    const int64_t index_width = 4;
+    jit::emb_seq_pool_attr_t attr(table_height,
+                                  table_width,
+                                  index_height,
+                                  index_width,
+                                  table_width * index_width,
+                                  jit::SeqPoolType::kSum);
+    auto table = random_data(table_height * table_width);
+    auto out = random_data(attr.out_width);
+    std::shared_ptr<std::vector<int64_t>> idx(
+        new std::vector<int64_t>(index_height * index_width));
+    for (auto& i : *idx) i = std::rand() % table_height;
+    register_candidates<jit::EmbSeqPoolTuple<float>>(
+        "EmbSeqPool/" + std::to_string(table_width),
+        attr,
+        index_height * attr.out_width,
+        [=](jit::EmbSeqPoolTuple<float>::func_type func) {
+          func(table->data(), idx->data(), out->data(), &attr);
+        });
+  }
+}
+
+static void register_layer_norm() {
+  for (int right : {256, 768}) {
+    const int height = 32;
+    auto x = random_data(height * right);
+    auto out = random_data(height * right);
+    auto mean = random_data(height);
+    auto var = random_data(height);
+    auto scale = random_data(right);
+    auto bias = random_data(right);
+    register_candidates<jit::LayerNormTuple<float>>(
+        "LayerNorm/" + std::to_string(right),
+        right,
+        height * right,
+        [=](jit::LayerNormTuple<float>::func_type func) {
+          func(x->data(),
+               out->data(),
+               mean->data(),
+               var->data(),
+               scale->data(),
+               bias->data(),
+               height,
+               1e-5f,
+               right);
+        });
+  }
+}
+
+static void register_softmax() {
+  for (int n : {128, 1000}) {
+    const int bs = 32;
+    auto x = random_data(bs * n);
+    auto y = random_data(bs * n);
+    register_candidates<jit::SoftmaxTuple<float>>(
+        "Softmax/" + std::to_string(n),
+        n,
+        bs * n,
+        [=](jit::SoftmaxTuple<float>::func_type func) {
+          func(x->data(), y->data(), n, bs, 1);
+        });
+  }
+}
+
+template <typename KernelTuple>
+static void register_lstm(const std::string& name) {
+  for (int d : {64, 256}) {
+    for (bool use_peephole : {false, true}) {
+      jit::lstm_attr_t attr(
+          d, jit::kVSigmoid, jit::kVTanh, jit::kVTanh, use_peephole);
+      auto gates = random_data(4 * d);
+      auto ct_1 = random_data(d);
+      auto ct = random_data(d);
+      auto ht = random_data(d);
+      auto wp = random_data(3 * d);
+      auto checked = random_data(2 * d);
+      register_candidates<KernelTuple>(
+          name + "/" + std::to_string(d) + (use_peephole ? "/peephole" : ""),
+          attr,
+          d,
+          [=](typename KernelTuple::func_type func) {
+            jit::lstm_t step;
+            step.gates = gates->data();
+            step.ct_1 = ct_1->data();
+            step.ct = ct->data();
+            step.ht = ht->data();
+            step.wp = wp->data();
+            step.checked = checked->data();
+            func(&step, &attr);
+          });
+    }
+  }
+}
+
+template <typename KernelTuple>
+static void register_gru(const std::string& name) {
+  for (int d : {64, 256}) {
+    jit::gru_attr_t attr(d, jit::kVSigmoid, jit::kVTanh);
+    auto gates = random_data(3 * d);
+    auto ht_1 = random_data(d);
+    auto ht = random_data(d);
+    register_candidates<KernelTuple>(
+        name + "/" + std::to_string(d),
+        attr,
+        d,
+        [=](typename KernelTuple::func_type func) {
+          jit::gru_t step;
+          step.gates = gates->data();
+          step.ht_1 = ht_1->data();
+          step.ht = ht->data();
+          func(&step, &attr);
+        });
+  }
+}
+
+int main(int argc, char** argv) {
+  register_xyn<jit::VReluTuple<float>>("VRelu");
+  register_xyn<jit::VSquareTuple<float>>("VSquare");
+  register_xyn<jit::VExpTuple<float>>("VExp");
+  register_xyn<jit::VSigmoidTuple<float>>("VSigmoid");
+  register_xyn<jit::VTanhTuple<float>>("VTanh");
+  register_vbroadcast();
+  register_matmul();
+  register_seqpool();
+  register_embseqpool();
+  register_layer_norm();
+  register_softmax();
+  register_lstm<jit::LSTMCtHtTuple<float>>("LSTMCtHt");
+  register_lstm<jit::LSTMC1H1Tuple<float>>("LSTMC1H1");
+  register_gru<jit::GRUH1Tuple<float>>("GRUH1");
+  register_gru<jit::GRUHtPart1Tuple<float>>("GRUHtPart1");
+  register_gru<jit::GRUHtPart2Tuple<float>>("GRUHtPart2");
+
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
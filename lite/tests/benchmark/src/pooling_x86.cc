@@ -0,0 +1,149 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Runs the pool2d x86 kernel, which picks the AVX kernels when it can, and
+// the plain Pool2dFunctor on the pooling layers of common CNNs.
+// Benchmarks are named <layer>/<impl>.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "lite/backends/x86/math/pooling.h"
+#include "lite/kernels/x86/pool_compute.h"
+
+namespace lite = paddle::lite;
+namespace math = paddle::lite::x86::math;
+
+struct PoolConfig {
+  std::string name;
+  std::vector<int64_t> x_dims;
+  std::string pooling_type;
+  std::vector<int> ksize;
+  std::vector<int> strides;
+  std::vector<int> paddings;
+  bool adaptive;
+};
+
+static const std::vector<PoolConfig> kConfigs = {
+    // ResNet stem.
+    {"resnet_max3x3s2", {1, 64, 112, 112}, "max", {3, 3}, {2, 2}, {1, 1, 1, 1},
+     false},
+    // VGG blocks.
+    {"vgg_max2x2s2", {1, 128, 112, 112}, "max", {2, 2}, {2, 2}, {0, 0, 0, 0},
+     false},
+    // Inception branch.
+    {"inception_avg3x3s1", {1, 192, 28, 28}, "avg", {3, 3}, {1, 1},
+     {1, 1, 1, 1}, false},
+    // Classifier heads.
+    {"resnet_global_avg", {1, 2048, 7, 7}, "avg", {7, 7}, {1, 1},
+     {0, 0, 0, 0}, false},
+    {"vgg_adaptive_avg7x7", {1, 512, 14, 14}, "avg", {7, 7}, {1, 1},
+     {0, 0, 0, 0}, true},
+    // Any other window goes through the blocked layout.
+    {"max5x5s1", {1, 64, 28, 28}, "max", {5, 5}, {1, 1}, {2, 2, 2, 2}, false},
+};
+
+static std::vector<int64_t> out_dims(const PoolConfig& config) {
+  std::vector<int64_t> dims{config.x_dims[0], config.x_dims[1]};
+  for (int i = 0; i < 2; ++i) {
+    dims.push_back(config.adaptive
+                       ? config.ksize[i]
+                       : (config.x_dims[i + 2] + config.paddings[2 * i] +
+                          config.paddings[2 * i + 1] - config.ksize[i]) /
+                                 config.strides[i] +
+                             1);
+  }
+  return dims;
+}
+
+struct PoolBench {
+  explicit PoolBench(const PoolConfig& config) {
+    x.Resize(lite::DDim(config.x_dims));
+    auto* x_data = x.mutable_data<float>();
+    for (int64_t i = 0; i < x.numel(); ++i) {
+      x_data[i] = static_cast<float>(std::rand()) / RAND_MAX - 0.5f;
+    }
+    out.Resize(lite::DDim(out_dims(config)));
+    param.x = &x;
+    param.output = &out;
+    param.pooling_type = config.pooling_type;
+    param.ksize = config.ksize;
+    param.strides = config.strides;
+    param.paddings = std::make_shared<std::vector<int>>(config.paddings);
+    param.adaptive = config.adaptive;
+    std::unique_ptr<lite::KernelContext> ctx(new lite::KernelContext);
+    ctx->As<lite::X86Context>();
+    kernel.SetContext(std::move(ctx));
+    kernel.SetParam(param);
+  }
+
+  lite::Tensor x;
+  lite::Tensor out;
+  lite::operators::PoolParam param;
+  lite::kernels::x86::PoolCompute<float> kernel;
+  lite::X86Context context;
+};
+
+template <typename PoolProcess>
+static void run_functor(PoolBench* bench) {
+  math::Pool2dFunctor<lite::TargetType::kX86, PoolProcess, float> pool2d;
+  PoolProcess process;
+  auto& param = bench->param;
+  pool2d(bench->context,
+         param.x,
+         param.ksize,
+         param.strides,
+         *param.paddings,
+         process,
+         param.exclusive,
+         param.adaptive,
+         param.output);
+}
+
+static void register_config(const PoolConfig& config) {
+  std::shared_ptr<PoolBench> bench(new PoolBench(config));
+  int64_t items = bench->x.numel();
+  auto add = [&](const std::string& impl, std::function<void()> run) {
+    benchmark::RegisterBenchmark(
+        (config.name + "/" + impl).c_str(),
+        [=](benchmark::State& state) {
+          for (auto _ : state) {
+            run();
+          }
+          state.SetItemsProcessed(uint64_t(state.iterations()) * items);
+        })
+        ->UseRealTime();
+  };
+  add("kernel", [bench] { bench->kernel.Run(); });
+  if (config.pooling_type == "max") {
+    add("functor", [bench] { run_functor<math::MaxPool<float>>(bench.get()); });
+  } else {
+    add("functor", [bench] { run_functor<math::AvgPool<float>>(bench.get()); });
+  }
+}
+
+int main(int argc, char** argv) {
+  for (auto& config : kConfigs) {
+    register_config(config);
+  }
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
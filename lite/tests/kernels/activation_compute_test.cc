@@ -687,6 +687,8 @@ TEST(Activation_swish, precision) {
 #endif
 #elif defined(LITE_WITH_ARM)
   place = TARGET(kARM);
+#elif defined(LITE_WITH_X86)
+  place = TARGET(kX86);
 #else
   return;
 #endif
@@ -980,6 +982,8 @@ TEST(Activation_hard_swish, precision) {
   abs_error = 1e-2;  // Using fp16 in OPENCL
 #elif defined(LITE_WITH_ARM)
   place = TARGET(kARM);
+#elif defined(LITE_WITH_X86)
+  place = TARGET(kX86);
 #else
   return;
 #endif
@@ -1183,6 +1187,43 @@ TEST(Activation_hard_sigmoid_fp32, performance) {
   }
 }
 
+#if defined(LITE_WITH_X86)
+// The x86 kernels feed the jit code in 1024 element blocks and split
+// tensors across threads above 4096 (transcendental) or 32768 (cheap)
+// elements. These shapes are past both grains and not block multiples.
+TEST(Activation_x86_parallel, precision) {
+  Place place = TARGET(kX86);
+  float abs_error = 2e-5;
+  struct ActCase {
+    std::string type;
+    activation_type_test act_type;
+  };
+  for (auto& act : std::vector<ActCase>{{"relu", RELU},
+                                        {"sigmoid", SIGMOID},
+                                        {"tanh", TANH},
+                                        {"square", SQUARE},
+                                        {"gelu", GELU},
+                                        {"swish", SWISH},
+                                        {"hard_swish", HARD_SWISH},
+                                        {"mish", MISH}}) {
+    for (auto dims : std::vector<std::vector<int64_t>>{
+             {1025}, {3, 1500}, {33, 1025}, {2, 3, 97, 101}}) {
+      TestAct(place,
+              "def",
+              0.01,
+              6.,
+              "all",
+              0.5,
+              1.0,
+              DDim(dims),
+              act.type,
+              act.act_type,
+              abs_error);
+    }
+  }
+}
+#endif
+
 #if defined(LITE_WITH_ARM) && defined(ENABLE_ARM_FP16)
 TEST(Activation_relu_fp16, precision) {
   Place place(TARGET(kARM), PRECISION(kFP16));
@@ -14,8 +14,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "lite/api/paddle_use_kernels.h"
@@ -303,6 +306,55 @@ bool RunOnRandomArgs(const Place& place,
   return arena.TestPrecision();
 }
 
+// Runs one fixed broadcast. The operand of lower rank is aligned at |axis|,
+// or at the trailing dimensions when |axis| is -1.
+template <class T>
+bool RunOnShapes(const Place& place,
+                 const std::string& alias,
+                 const std::string& elt_type,
+                 const std::string& act_type,
+                 const std::function<T(T, T)> op,
+                 const std::vector<int64_t>& x_dim,
+                 const std::vector<int64_t>& y_dim,
+                 int axis,
+                 double abs_error = 1e-3) {
+  size_t dim_size = std::max(x_dim.size(), y_dim.size());
+  auto expand = [&](const std::vector<int64_t>& dim) {
+    size_t start = axis;
+    if (dim.size() == dim_size) {
+      start = 0;
+    } else if (axis == -1) {
+      start = dim_size - dim.size();
+    }
+    std::vector<int> dim_full(dim_size, 1);
+    for (size_t i = 0; i < dim.size(); ++i) {
+      dim_full[start + i] = dim[i];
+    }
+    return dim_full;
+  };
+  std::vector<int> x_dim_full = expand(x_dim);
+  std::vector<int> y_dim_full = expand(y_dim);
+  std::vector<int64_t> out_dim(dim_size);
+  for (size_t i = 0; i < dim_size; ++i) {
+    out_dim[i] = std::max(x_dim_full[i], y_dim_full[i]);
+  }
+
+  std::unique_ptr<arena::TestCase> tester(
+      new ElementwiseComputeTester<T>(place,
+                                      alias,
+                                      elt_type,
+                                      x_dim,
+                                      y_dim,
+                                      out_dim,
+                                      x_dim_full,
+                                      y_dim_full,
+                                      axis,
+                                      act_type,
+                                      op));
+  arena::Arena arena(std::move(tester), place, abs_error);
+  return arena.TestPrecision();
+}
+
 }  // namespace lite
 }  // namespace paddle
 
@@ -402,6 +454,42 @@ TEST(elementwise_broadcast, compute_fp32) {
   }
 }
 
+// Every shape is past the 32768 element grain of the x86 kernels, so the
+// same-shape, fast broadcast (both operand orders, with and without a
+// trailing dimension) and generic paths all split across threads.
+TEST(elementwise_broadcast, compute_fp32_parallel) {
+  struct ShapeCase {
+    std::vector<int64_t> x_dim;
+    std::vector<int64_t> y_dim;
+    int axis;
+  };
+  std::vector<ShapeCase> shape_cases{
+      {{3, 37, 17, 19}, {3, 37, 17, 19}, -1},
+      {{65, 1031}, {1031}, -1},
+      {{1031}, {65, 1031}, -1},
+      {{3, 37, 17, 19}, {37}, 1},
+      {{37, 1}, {3, 37, 323}, -1},
+      {{4, 37, 17, 19}, {4, 1, 17, 1}, -1}};
+  std::vector<std::pair<std::string, std::function<float(float, float)>>> ops{
+      {"add", [](float l, float r) { return l + r; }},
+      {"sub", [](float l, float r) { return l - r; }},
+      {"mul", [](float l, float r) { return l * r; }},
+      {"div", [](float l, float r) { return l / r; }},
+      {"max", [](float l, float r) { return l > r ? l : r; }}};
+  for (auto& shape_case : shape_cases) {
+    for (auto& op : ops) {
+      EXPECT_TRUE(paddle::lite::RunOnShapes<float>(TARGET(kX86),
+                                                   "def",
+                                                   op.first,
+                                                   "",
+                                                   op.second,
+                                                   shape_case.x_dim,
+                                                   shape_case.y_dim,
+                                                   shape_case.axis));
+    }
+  }
+}
+
 TEST(elementwise_broadcast, compute_i32) {
   const int TEST_RETEAT_NUM = 2;
   for (int repeat_count = 0; repeat_count < TEST_RETEAT_NUM; ++repeat_count) {
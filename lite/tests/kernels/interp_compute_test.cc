@@ -470,6 +470,31 @@ void TestInterpAlignMode(Place place, float abs_error = 2e-5) {
   }
 }
 
+void TestInterpIntegerScale(Place place, float abs_error = 2e-5) {
+  // Rows wide enough for the vector paths.
+  for (auto x_dims : std::vector<std::vector<int64_t>>{{2, 3, 13, 17}}) {
+    for (float scale : {2.f, 4.f}) {
+      for (bool align_corners : {true, false}) {
+        std::unique_ptr<arena::TestCase> tester(
+            new NearestInterpComputeTester(place,
+                                           "def",
+                                           DDim(x_dims),
+                                           "nearest",
+                                           scale,
+                                           -1,
+                                           -1,
+                                           align_corners));
+        arena::Arena arena(std::move(tester), place, abs_error);
+        arena.TestPrecision();
+      }
+      std::unique_ptr<arena::TestCase> tester(new NearestInterpComputeTester(
+          place, "def", DDim(x_dims), "bilinear", scale));
+      arena::Arena arena(std::move(tester), place, abs_error);
+      arena.TestPrecision();
+    }
+  }
+}
+
 #ifdef ENABLE_ARM_FP16
 void TestInterpOuthw_fp16(Place place, float abs_error = 2e-5) {
   for (auto x_dims : std::vector<std::vector<int64_t>>{{3, 4, 8, 9}}) {
@@ -528,6 +553,7 @@ TEST(Interp, precision) {
   TestInterpOutsize(place, abs_error);
   TestInterpAlignCorners(place, abs_error);
   TestInterpAlignMode(place, abs_error);
+  TestInterpIntegerScale(place, abs_error);
 }
 
 #if defined(LITE_WITH_NNADAPTER) && defined(NNADAPTER_WITH_HUAWEI_ASCEND_NPU)
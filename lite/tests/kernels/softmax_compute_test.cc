@@ -119,6 +119,8 @@ TEST(Softmax, precision) {
   abs_error = 1e-2;  // precision_mode default is force_fp16
 #elif defined(LITE_WITH_XPU)
   place = TARGET(kXPU);
+#elif defined(LITE_WITH_X86)
+  place = TARGET(kX86);
 #else
   return;
 #endif
@@ -0,0 +1,115 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/backends/x86/jit/helper.h"
+#include "lite/backends/x86/jit/kernels.h"
+
+namespace paddle {
+namespace lite {
+namespace jit {
+
+using SigmoidTuple = VSigmoidTuple<float>;
+
+static std::string SigmoidKey(int n) {
+  return TunedKernelKey(kVSigmoid, sizeof(float), JitCodeKey<int>(n));
+}
+
+static std::string ReadFile(const std::string& path) {
+  std::ifstream file(path);
+  std::stringstream ss;
+  ss << file.rdbuf();
+  return ss.str();
+}
+
+static bool FileExists(const std::string& path) {
+  return std::ifstream(path).is_open();
+}
+
+TEST(JitAutotune, cached_choice) {
+  const std::string cache_file = "jit_autotune_cache_test.txt";
+  const std::string model = x86::CpuModelName();
+  // Refer is never the default choice, as it goes last.
+  {
+    std::ofstream file(cache_file);
+    file << model << '\t' << SigmoidKey(64) << "\tRefer\n";
+    file << "other cpu\t" << SigmoidKey(8) << "\tMixed\n";
+  }
+  // The pool of the process reads the cache file on its first use.
+#ifdef _WIN32
+  _putenv_s("jit_autotune_cache", cache_file.c_str());
+#else
+  setenv("jit_autotune_cache", cache_file.c_str(), 1);
+#endif
+  auto& pool = TunedKernelPool::Instance();
+  ASSERT_GE(GetAllCandidateFuncs<SigmoidTuple>(64).size(), 2u);
+  EXPECT_EQ(GetTunedBestFunc<SigmoidTuple>(64), GetReferFunc<SigmoidTuple>());
+
+  // Another process saves a choice after the file was read.
+  {
+    std::ofstream file(cache_file, std::ios::app);
+    file << "another cpu\t" << SigmoidKey(16) << "\tRefer\n";
+  }
+  // Tune a new attr and save it.
+  GetTunedBestFunc<SigmoidTuple>(32);
+  std::string impl_type;
+  ASSERT_TRUE(pool.Find(SigmoidKey(32), &impl_type));
+  pool.Flush();
+
+  TunedKernelPool reloaded(cache_file);
+  std::string reloaded_type;
+  ASSERT_TRUE(reloaded.Find(SigmoidKey(32), &reloaded_type));
+  EXPECT_EQ(reloaded_type, impl_type);
+  ASSERT_TRUE(reloaded.Find(SigmoidKey(64), &reloaded_type));
+  EXPECT_EQ(reloaded_type, "Refer");
+  // The choices of the other cpus are kept, the later one included.
+  auto content = ReadFile(cache_file);
+  EXPECT_NE(content.find("other cpu\t" + SigmoidKey(8) + "\tMixed\n"),
+            std::string::npos);
+  EXPECT_NE(content.find("another cpu\t" + SigmoidKey(16) + "\tRefer\n"),
+            std::string::npos);
+  std::remove(cache_file.c_str());
+}
+
+TEST(JitAutotune, save_in_batches) {
+  const std::string cache_file = "jit_autotune_batch_test.txt";
+  std::remove(cache_file.c_str());
+  {
+    TunedKernelPool pool(cache_file);
+    for (int i = 0; i < 15; ++i) {
+      pool.Insert(SigmoidKey(i + 1), "Refer");
+    }
+    EXPECT_FALSE(FileExists(cache_file));
+    pool.Insert(SigmoidKey(16), "Refer");
+    EXPECT_TRUE(FileExists(cache_file));
+    pool.Insert(SigmoidKey(17), "Mixed");
+  }
+  // The last choice is saved when the pool goes away.
+  TunedKernelPool reloaded(cache_file);
+  std::string impl_type;
+  ASSERT_TRUE(reloaded.Find(SigmoidKey(17), &impl_type));
+  EXPECT_EQ(impl_type, "Mixed");
+  std::remove(cache_file.c_str());
+}
+
+}  // namespace jit
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,370 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/backends/x86/jit/helper.h"
+#include "lite/backends/x86/jit/kernels.h"
+
+namespace paddle {
+namespace lite {
+namespace jit {
+
+using CPUPlace = lite::fluid::CPUPlace;
+
+// The AVX512 implementation among the candidates of |attr|, or nullptr when
+// it can not be used for |attr|.
+template <typename KernelTuple>
+typename KernelTuple::func_type GetAVX512Func(
+    const typename KernelTuple::attr_type& attr) {
+  for (auto& func :
+       GetAllCandidateFuncsWithTypes<KernelTuple, CPUPlace>(attr)) {
+    if (func.first == "AVX512") return func.second;
+  }
+  return nullptr;
+}
+
+static bool HasAVX512() {
+  if (x86::MayIUse(x86::avx512f)) return true;
+  LOG(INFO) << "avx512f is not supported, skip the test.";
+  return false;
+}
+
+static std::vector<float> RandomVec(int n, float min, float max) {
+  static std::mt19937 engine(2021);
+  std::uniform_real_distribution<float> dist(min, max);
+  std::vector<float> res(n);
+  for (auto& v : res) v = dist(engine);
+  return res;
+}
+
+static void ExpectNear(const std::vector<float>& ref,
+                       const std::vector<float>& out,
+                       const std::string& what) {
+  ASSERT_EQ(ref.size(), out.size());
+  for (size_t i = 0; i < ref.size(); ++i) {
+    ASSERT_NEAR(ref[i], out[i], 1e-5f * std::max(1.f, std::abs(ref[i])))
+        << what << ", element " << i;
+  }
+}
+
+// Sizes around the 16-float zmm block, so the masked tails are covered.
+const std::vector<int> kSizes = {1, 7, 15, 16, 17, 31, 33, 64, 100, 257};
+
+const std::vector<KernelType> kActs = {kVSigmoid, kVRelu, kVTanh, kVIdentity};
+
+template <typename KernelTuple>
+void TestXYN(float min, float max) {
+  for (int n : kSizes) {
+    auto tgt = GetAVX512Func<KernelTuple>(n);
+    ASSERT_TRUE(tgt != nullptr) << "n " << n;
+    auto x = RandomVec(n, min, max);
+    std::vector<float> ref(n), out(n);
+    GetReferFunc<KernelTuple>()(x.data(), ref.data(), n);
+    tgt(x.data(), out.data(), n);
+    ExpectNear(ref, out, "n " + std::to_string(n));
+    // In place.
+    tgt(x.data(), x.data(), n);
+    ExpectNear(ref, x, "inplace n " + std::to_string(n));
+  }
+}
+
+TEST(JitAVX512, xyn) {
+  if (!HasAVX512()) return;
+  TestXYN<VReluTuple<float>>(-2.f, 2.f);
+  TestXYN<VSquareTuple<float>>(-2.f, 2.f);
+  TestXYN<VExpTuple<float>>(-10.f, 10.f);
+  // Beyond the clamp thresholds of sigmoid on both sides.
+  TestXYN<VSigmoidTuple<float>>(-50.f, 50.f);
+  TestXYN<VTanhTuple<float>>(-20.f, 20.f);
+}
+
+TEST(JitAVX512, priority) {
+  if (!HasAVX512()) return;
+  // The avx512 kernels go first, whichever order the implementations were
+  // registered in. The ymm jitcode stays a candidate behind them.
+  auto funcs = GetAllCandidateFuncsWithTypes<VSigmoidTuple<float>, CPUPlace>(
+      16);
+  ASSERT_GE(funcs.size(), 3UL);
+  EXPECT_EQ(funcs.front().first, "AVX512");
+  EXPECT_EQ(funcs.back().first, "Refer");
+  bool seen_other = false;
+  bool seen_jitcode = false;
+  for (auto& func : funcs) {
+    if (func.first == "AVX512") {
+      EXPECT_FALSE(seen_other);
+    } else {
+      seen_other = true;
+    }
+    seen_jitcode = seen_jitcode || func.first == "JitCode";
+  }
+#ifdef PADDLE_WITH_XBYAK
+  EXPECT_TRUE(seen_jitcode);
+#endif
+}
+
+TEST(JitAVX512, vbroadcast) {
+  if (!HasAVX512()) return;
+  for (int64_t x_len : {1, 15, 16, 17, 40}) {
+    const int64_t y_h = 3;
+    auto tgt = GetAVX512Func<VBroadcastTuple<float>>(x_len);
+    ASSERT_TRUE(tgt != nullptr);
+    auto x = RandomVec(x_len, -2.f, 2.f);
+    std::vector<float> ref(y_h * x_len), out(y_h * x_len);
+    GetReferFunc<VBroadcastTuple<float>>()(x.data(), ref.data(), y_h, x_len);
+    tgt(x.data(), out.data(), y_h, x_len);
+    ExpectNear(ref, out, "x_len " + std::to_string(x_len));
+  }
+}
+
+TEST(JitAVX512, matmul) {
+  if (!HasAVX512()) return;
+  // Small n and large k are left to the other kernels.
+  EXPECT_TRUE(GetAVX512Func<MatMulTuple<float>>(matmul_attr_t(3, 15, 8)) ==
+              nullptr);
+  EXPECT_TRUE(GetAVX512Func<MatMulTuple<float>>(matmul_attr_t(3, 16, 512)) ==
+              nullptr);
+  const std::vector<std::vector<int>> shapes = {{1, 16, 1},
+                                                {3, 16, 511},
+                                                {3, 17, 7},
+                                                {2, 33, 64},
+                                                {4, 64, 9},
+                                                {5, 100, 5},
+                                                {2, 131, 20}};
+  for (auto& shape : shapes) {
+    matmul_attr_t attr(shape[0], shape[1], shape[2]);
+    auto tgt = GetAVX512Func<MatMulTuple<float>>(attr);
+    ASSERT_TRUE(tgt != nullptr);
+    auto a = RandomVec(attr.m * attr.k, -1.f, 1.f);
+    auto b = RandomVec(attr.k * attr.n, -1.f, 1.f);
+    std::vector<float> ref(attr.m * attr.n), out(attr.m * attr.n);
+    GetReferFunc<MatMulTuple<float>>()(a.data(), b.data(), ref.data(), &attr);
+    tgt(a.data(), b.data(), out.data(), &attr);
+    // Sums of up to 511 products, allow for the reordering.
+    for (size_t i = 0; i < ref.size(); ++i) {
+      ASSERT_NEAR(ref[i], out[i], 1e-4f)
+          << "m " << attr.m << " n " << attr.n << " k " << attr.k;
+    }
+  }
+}
+
+TEST(JitAVX512, seqpool) {
+  if (!HasAVX512()) return;
+  for (auto type : {SeqPoolType::kSum, SeqPoolType::kAvg, SeqPoolType::kSqrt}) {
+    for (int w : {1, 15, 16, 17, 50}) {
+      for (int h : {1, 3, 8}) {
+        seq_pool_attr_t attr(w, type, h);
+        auto tgt = GetAVX512Func<SeqPoolTuple<float>>(attr);
+        ASSERT_TRUE(tgt != nullptr);
+        auto x = RandomVec(h * w, -2.f, 2.f);
+        std::vector<float> ref(w), out(w);
+        GetReferFunc<SeqPoolTuple<float>>()(x.data(), ref.data(), &attr);
+        tgt(x.data(), out.data(), &attr);
+        ExpectNear(ref, out, "w " + std::to_string(w));
+      }
+    }
+  }
+}
+
+TEST(JitAVX512, embseqpool) {
+  if (!HasAVX512()) return;
+  const int64_t table_h = 10;
+  const int64_t idx_h = 4;
+  const int64_t idx_w = 3;
+  std::vector<int64_t> idx(idx_h * idx_w);
+  for (size_t i = 0; i < idx.size(); ++i) {
+    idx[i] = (i * 7) % table_h;
+  }
+  for (int64_t table_w : {1, 15, 16, 17, 32}) {
+    emb_seq_pool_attr_t attr(
+        table_h, table_w, idx_h, idx_w, table_w * idx_w, SeqPoolType::kSum);
+    auto tgt = GetAVX512Func<EmbSeqPoolTuple<float>>(attr);
+    ASSERT_TRUE(tgt != nullptr);
+    auto table = RandomVec(table_h * table_w, -2.f, 2.f);
+    std::vector<float> ref(attr.out_width), out(attr.out_width);
+    GetReferFunc<EmbSeqPoolTuple<float>>()(
+        table.data(), idx.data(), ref.data(), &attr);
+    tgt(table.data(), idx.data(), out.data(), &attr);
+    ExpectNear(ref, out, "table_w " + std::to_string(table_w));
+  }
+}
+
+TEST(JitAVX512, layernorm) {
+  if (!HasAVX512()) return;
+  // Rows shorter than a block are left to the other kernels.
+  EXPECT_TRUE(GetAVX512Func<LayerNormTuple<float>>(15) == nullptr);
+  const int height = 3;
+  const float epsilon = 1e-5f;
+  for (int right : {16, 17, 31, 64, 100}) {
+    auto tgt = GetAVX512Func<LayerNormTuple<float>>(right);
+    ASSERT_TRUE(tgt != nullptr);
+    auto x = RandomVec(height * right, -2.f, 2.f);
+    auto scale = RandomVec(right, 0.5f, 1.5f);
+    auto bias = RandomVec(right, -1.f, 1.f);
+    for (bool affine : {true, false}) {
+      const float* s = affine ? scale.data() : nullptr;
+      const float* b = affine ? bias.data() : nullptr;
+      std::vector<float> x_ref(x), x_tgt(x);
+      std::vector<float> ref(x.size()), out(x.size());
+      std::vector<float> mean_ref(height), mean(height);
+      std::vector<float> var_ref(height), var(height);
+      GetReferFunc<LayerNormTuple<float>>()(x_ref.data(),
+                                            ref.data(),
+                                            mean_ref.data(),
+                                            var_ref.data(),
+                                            s,
+                                            b,
+                                            height,
+                                            epsilon,
+                                            right);
+      tgt(x_tgt.data(),
+          out.data(),
+          mean.data(),
+          var.data(),
+          s,
+          b,
+          height,
+          epsilon,
+          right);
+      const std::string what = "right " + std::to_string(right);
+      ExpectNear(ref, out, what);
+      ExpectNear(mean_ref, mean, what + " mean");
+      ExpectNear(var_ref, var, what + " var");
+    }
+  }
+}
+
+TEST(JitAVX512, softmax) {
+  if (!HasAVX512()) return;
+  // {n, bs, remain}, remain > 1 is the strided softmax over a middle axis.
+  const std::vector<std::vector<int>> shapes = {{1, 1, 1},
+                                                {17, 3, 1},
+                                                {32, 2, 1},
+                                                {100, 2, 1},
+                                                {24, 2, 4},
+                                                {30, 1, 3},
+                                                {34, 2, 17},
+                                                {48, 3, 16}};
+  for (auto& shape : shapes) {
+    const int n = shape[0];
+    const int bs = shape[1];
+    const int remain = shape[2];
+    auto tgt = GetAVX512Func<SoftmaxTuple<float>>(n);
+    ASSERT_TRUE(tgt != nullptr);
+    auto x = RandomVec(n * bs, -5.f, 5.f);
+    std::vector<float> ref(x.size()), out(x.size());
+    GetReferFunc<SoftmaxTuple<float>>()(x.data(), ref.data(), n, bs, remain);
+    tgt(x.data(), out.data(), n, bs, remain);
+    ExpectNear(ref,
+               out,
+               "n " + std::to_string(n) + " remain " + std::to_string(remain));
+  }
+}
+
+template <typename KernelTuple>
+void TestLSTM(bool c1h1) {
+  for (int d : kSizes) {
+    for (auto act_gate : kActs) {
+      for (auto act_cand : kActs) {
+        for (auto act_cell : kActs) {
+          for (bool peephole : {false, true}) {
+            lstm_attr_t attr(d, act_gate, act_cand, act_cell, peephole);
+            auto tgt = GetAVX512Func<KernelTuple>(attr);
+            ASSERT_TRUE(tgt != nullptr);
+            auto gates = RandomVec(4 * d, -3.f, 3.f);
+            auto ct_1 = RandomVec(d, -2.f, 2.f);
+            auto wp = RandomVec(3 * d, -1.f, 1.f);
+            // The refer kernel works in the gates.
+            std::vector<float> gates_ref(gates), gates_tgt(gates);
+            std::vector<float> checked(2 * d);
+            std::vector<float> ct_ref(d), ht_ref(d), ct(d), ht(d);
+            lstm_t step;
+            step.gates = gates_ref.data();
+            step.ct_1 = ct_1.data();
+            step.ct = ct_ref.data();
+            step.ht = ht_ref.data();
+            step.wp = wp.data();
+            step.checked = checked.data();
+            GetReferFunc<KernelTuple>()(&step, &attr);
+            step.gates = gates_tgt.data();
+            step.ct = ct.data();
+            step.ht = ht.data();
+            tgt(&step, &attr);
+            const std::string what =
+                std::string(c1h1 ? "c1h1" : "ctht") + " d " +
+                std::to_string(d) + " acts " + std::to_string(act_gate) +
+                "," + std::to_string(act_cand) + "," +
+                std::to_string(act_cell) + " peephole " +
+                std::to_string(peephole);
+            ExpectNear(ct_ref, ct, what + " ct");
+            ExpectNear(ht_ref, ht, what + " ht");
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(JitAVX512, lstm) {
+  if (!HasAVX512()) return;
+  TestLSTM<LSTMCtHtTuple<float>>(false);
+  TestLSTM<LSTMC1H1Tuple<float>>(true);
+}
+
+template <typename KernelTuple>
+void TestGRU(const std::string& name) {
+  for (int d : kSizes) {
+    for (auto act_gate : kActs) {
+      for (auto act_cand : kActs) {
+        gru_attr_t attr(d, act_gate, act_cand);
+        auto tgt = GetAVX512Func<KernelTuple>(attr);
+        ASSERT_TRUE(tgt != nullptr);
+        auto gates = RandomVec(3 * d, -3.f, 3.f);
+        auto ht_1 = RandomVec(d, -2.f, 2.f);
+        std::vector<float> gates_ref(gates), gates_tgt(gates);
+        std::vector<float> ht_ref(d), ht(d);
+        gru_t step;
+        step.gates = gates_ref.data();
+        step.ht_1 = ht_1.data();
+        step.ht = ht_ref.data();
+        GetReferFunc<KernelTuple>()(&step, &attr);
+        step.gates = gates_tgt.data();
+        step.ht = ht.data();
+        tgt(&step, &attr);
+        ExpectNear(ht_ref,
+                   ht,
+                   name + " d " + std::to_string(d) + " acts " +
+                       std::to_string(act_gate) + "," +
+                       std::to_string(act_cand));
+      }
+    }
+  }
+}
+
+TEST(JitAVX512, gru) {
+  if (!HasAVX512()) return;
+  TestGRU<GRUH1Tuple<float>>("h1");
+  TestGRU<GRUHtPart1Tuple<float>>("part1");
+  TestGRU<GRUHtPart2Tuple<float>>("part2");
+}
+
+}  // namespace jit
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,91 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+#include <thread>  // NOLINT
+#include <vector>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/backends/x86/parallel.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+
+TEST(x86_cpu_info, parse_id_list) {
+  EXPECT_EQ(ParseIdList("0-3,8,10-11"),
+            std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+  EXPECT_EQ(ParseIdList("5"), std::vector<int>({5}));
+  EXPECT_TRUE(ParseIdList("").empty());
+}
+
+TEST(x86_cpu_info, parse_cache_size) {
+  EXPECT_EQ(ParseCacheSize("48K"), 48u << 10);
+  EXPECT_EQ(ParseCacheSize("32M"), 32u << 20);
+  EXPECT_EQ(ParseCacheSize("1G"), 1u << 30);
+  EXPECT_EQ(ParseCacheSize("512"), 512u);
+  EXPECT_EQ(ParseCacheSize(""), 0u);
+}
+
+TEST(x86_cpu_info, bind_order) {
+  // Two sockets of two cores with two threads each, numbered as Linux does:
+  // the first threads of all the cores, then their siblings.
+  CpuTopology topology;
+  for (int id = 0; id < 8; ++id) {
+    int core = id % 4;
+    topology.cpus.push_back({id, core, core / 2, core / 2});
+  }
+  topology.num_cores = 4;
+  topology.num_sockets = 2;
+  topology.num_nodes = 2;
+
+  EXPECT_TRUE(CpuBindOrder(topology, lite_api::X86_BIND_NONE).empty());
+  // Socket by socket, the siblings of a core next to each other.
+  EXPECT_EQ(CpuBindOrder(topology, lite_api::X86_BIND_COMPACT),
+            std::vector<int>({0, 4, 1, 5, 2, 6, 3, 7}));
+  // One thread of every core.
+  EXPECT_EQ(CpuBindOrder(topology, lite_api::X86_BIND_PHYSICAL),
+            std::vector<int>({0, 1, 2, 3}));
+  // The sockets in turn, the cores before their siblings.
+  EXPECT_EQ(CpuBindOrder(topology, lite_api::X86_BIND_SCATTER),
+            std::vector<int>({0, 2, 1, 3, 4, 6, 5, 7}));
+}
+
+#ifdef __linux__
+TEST(x86_cpu_info, bind_running_thread) {
+  auto order = CpuBindOrder(lite_api::X86_BIND_COMPACT);
+  ASSERT_FALSE(order.empty());
+  // A thread of its own, as a caller of Run would be, so that the test does
+  // not pin the main thread.
+  std::vector<int> cpus;
+  std::thread runner([&cpus] {
+    BindRunningThread(lite_api::X86_BIND_COMPACT, 1);
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    ASSERT_EQ(sched_getaffinity(0, sizeof(mask), &mask), 0);
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &mask)) cpus.push_back(cpu);
+    }
+  });
+  runner.join();
+  EXPECT_EQ(cpus, std::vector<int>({order[0]}));
+}
+#endif
+
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -346,6 +346,7 @@ function build_test_train {
 
     find -name "*.whl" | xargs pip2 install
     python ../lite/tools/python/lite_test.py
+    ctest -R test_share_numpy_py -V
 
 }
 
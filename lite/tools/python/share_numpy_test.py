@@ -0,0 +1,105 @@
+# Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Checks that inputs fed by sharing numpy memory stop using it once the run
+# is over. Registered with ctest on mobilenet_v1; to run it by hand on a model
+# directory or an optimized model (.nb) with one float input:
+#   python share_numpy_test.py --model=mobilenet_v1 --input_name=image \
+#       --shape=1,3,224,224
+
+import argparse
+import gc
+import sys
+import unittest
+
+import numpy as np
+try:
+    from paddlelite.lite import *
+except ImportError:
+    # The module built in the tree, as ctest runs it.
+    from lite import *
+
+parser = argparse.ArgumentParser()
+parser.add_argument(
+    "--model", required=True, type=str, help="Model dir or .nb file")
+parser.add_argument(
+    "--input_name", default="image", type=str, help="Float input to feed")
+parser.add_argument(
+    "--shape", default="1,3,224,224", type=str, help="Shape of the input")
+args, unittest_args = parser.parse_known_args()
+
+INPUT = args.input_name
+SHAPE = [int(d) for d in args.shape.split(",")]
+
+
+def create_predictor(model):
+    if model.endswith(".nb"):
+        config = MobileConfig()
+        config.set_model_from_file(model)
+    else:
+        config = CxxConfig()
+        config.set_model_dir(model)
+        config.set_valid_places([
+            Place(TargetType.X86, PrecisionType.FP32),
+            Place(TargetType.Host, PrecisionType.FP32)
+        ])
+    return create_paddle_predictor(config)
+
+
+class ShareNumpyTest(unittest.TestCase):
+    def setUp(self):
+        self.predictor = create_predictor(args.model)
+        np.random.seed(0)
+
+    def data(self, shape):
+        return np.random.rand(*shape).astype("float32")
+
+    def reference(self, data):
+        outputs = self.predictor.predict({INPUT: data}, share_memory=False)
+        return [outputs[name].copy() for name in sorted(outputs)]
+
+    def run_copied(self, data):
+        self.predictor.get_input(0).from_numpy(data)
+        self.predictor.run()
+        return self.predictor.get_output(0).numpy(copy=True)
+
+    def test_copy_after_shared_array_is_freed(self):
+        data = self.data(SHAPE)
+        expected = self.reference(data)[0]
+        # Share an array which dies right after the call.
+        self.predictor.predict({INPUT: self.data(SHAPE)})
+        gc.collect()
+        # Same size: copied into the tensor's own memory, not the freed array.
+        np.testing.assert_allclose(self.run_copied(data), expected, atol=1e-5)
+
+    def test_larger_copy_after_share(self):
+        self.predictor.predict({INPUT: self.data(SHAPE)})
+        gc.collect()
+        # Larger: used to abort with "Can not reset unowned buffer".
+        shape = [SHAPE[0] * 2] + SHAPE[1:]
+        data = self.data(shape)
+        expected = self.reference(data)[0]
+        self.predictor.predict({INPUT: self.data(SHAPE)})
+        np.testing.assert_allclose(self.run_copied(data), expected, atol=1e-5)
+
+    def test_shared_array_is_not_written(self):
+        shared = self.data(SHAPE)
+        kept = shared.copy()
+        self.predictor.predict({INPUT: shared})
+        self.run_copied(self.data(SHAPE))
+        np.testing.assert_array_equal(shared, kept)
+
+
+if __name__ == "__main__":
+    unittest.main(argv=sys.argv[:1] + unittest_args)
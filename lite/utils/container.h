@@ -13,10 +13,15 @@
 // limitations under the License.
 
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <deque>
 #include <map>
+#include <mutex>  // NOLINT
 #include <string>
 #include <utility>
 #include <vector>
+#include "lite/utils/log/cp_logging.h"
 
 namespace paddle {
 namespace lite {
@@ -47,5 +52,61 @@ class OrderedMap {
   const std::vector<Elem>& elements() const { return list_; }
 };
 
+// An append-only table that is sorted on the first lookup after an insert.
+// Registries fill it from static initializers, where appending is much
+// cheaper than keeping a tree ordered. Elements never move, pointers to them
+// stay valid, and equivalent elements keep their insertion order.
+// Lookups hand out the index without holding the lock, so every Insert has
+// to happen before the first lookup: an Insert after it rebuilds the index
+// under the readers.
+template <typename Elem, typename Less>
+class SortedTable {
+ public:
+  using const_iterator = typename std::vector<const Elem*>::const_iterator;
+
+  void Insert(Elem&& e) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    elements_.emplace_back(std::move(e));
+    sorted_.store(false, std::memory_order_release);
+  }
+
+  // Elements equivalent to `probe` under `cmp`, which has to be consistent
+  // with `Less`, e.g. compare a prefix of its key.
+  template <typename Cmp = Less>
+  std::pair<const_iterator, const_iterator> EqualRange(const Elem& probe,
+                                                       Cmp cmp = Cmp()) const {
+    const auto& index = Sorted();
+    return std::equal_range(
+        index.begin(),
+        index.end(),
+        &probe,
+        [&](const Elem* a, const Elem* b) { return cmp(*a, *b); });
+  }
+
+  const std::vector<const Elem*>& Sorted() const {
+    if (!sorted_.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!sorted_.load(std::memory_order_relaxed)) {
+        index_.clear();
+        for (const auto& e : elements_) {
+          index_.push_back(&e);
+        }
+        std::stable_sort(
+            index_.begin(), index_.end(), [](const Elem* a, const Elem* b) {
+              return Less()(*a, *b);
+            });
+        sorted_.store(true, std::memory_order_release);
+      }
+    }
+    return index_;
+  }
+
+ private:
+  std::deque<Elem> elements_;
+  mutable std::vector<const Elem*> index_;
+  mutable std::atomic<bool> sorted_{true};
+  mutable std::mutex mutex_;
+};
+
 }  // namespace lite
 }  // namespace paddle
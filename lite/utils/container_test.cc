@@ -0,0 +1,57 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/container.h"
+#include <gtest/gtest.h>
+#include <string>
+
+namespace paddle {
+namespace lite {
+
+struct Item {
+  std::string key;
+  int value;
+};
+
+struct KeyLess {
+  bool operator()(const Item& a, const Item& b) const { return a.key < b.key; }
+};
+
+TEST(SortedTable, EqualRange) {
+  SortedTable<Item, KeyLess> table;
+  table.Insert(Item{"relu", 0});
+  table.Insert(Item{"conv2d", 1});
+  table.Insert(Item{"relu", 2});
+  const Item* conv = table.Sorted()[0];
+  ASSERT_EQ(conv->key, "conv2d");
+
+  // Inserting after a lookup sorts again, elements do not move.
+  table.Insert(Item{"fc", 3});
+  table.Insert(Item{"relu", 4});
+  ASSERT_EQ(table.Sorted()[0], conv);
+  ASSERT_EQ(table.Sorted()[1]->key, "fc");
+
+  auto range = table.EqualRange(Item{"relu", 0});
+  ASSERT_EQ(range.second - range.first, 3);
+  // Equivalent elements keep their insertion order.
+  EXPECT_EQ((*range.first)->value, 0);
+  EXPECT_EQ((*(range.first + 1))->value, 2);
+  EXPECT_EQ((*(range.first + 2))->value, 4);
+
+  range = table.EqualRange(Item{"pool2d", 0});
+  EXPECT_EQ(range.first, range.second);
+}
+
+}  // namespace lite
+}  // namespace paddle